@@ -1,2 +1,3 @@
 cd obj
+python ../tool/embed_shader.py --compiler glslangValidator
 g++ -std=c++17 -pthread -c ../src/*.cpp -I./../inc/ -lglslang -lvulkan -lglfw -lGL -lXrandr -lX11 -lrt -ldl
@@ -0,0 +1,52 @@
+#pragma once
+#ifndef GEODESUKA_BUILTIN_EMBEDDED_SHADER_H
+#define GEODESUKA_BUILTIN_EMBEDDED_SHADER_H
+
+/*
+* Usage:
+*	Shaders owned by the engine, embedded in the library at build time by
+*	tool/embed_shader.py from res/shader/builtin. Shaders are looked up by file
+*	name, i.e. "triangle.vert".
+*
+*	If the build step had a SPIR-V compiler available, create() builds the
+*	shader module straight from the embedded SPIR-V and glslang is never
+*	invoked. Otherwise it falls back to compiling the embedded GLSL source.
+*/
+
+#include <stdint.h>
+
+#include <geodesuka/core/gcl/shader.h>
+
+namespace geodesuka::builtin {
+
+	class embedded_shader {
+	public:
+
+		struct source {
+			const char* Name;
+			core::gcl::shader::stage Stage;
+			const char* Source;
+		};
+
+		struct binary {
+			const char* Name;
+			size_t WordCount;
+			const uint32_t* Word;
+		};
+
+		// Creates built-in shader by name, nullptr if no such shader exists.
+		static core::gcl::shader* create(core::gcl::context* aContext, const char* aName);
+
+		// Returns true if the library was built with precompiled SPIR-V.
+		static bool is_precompiled();
+
+	private:
+
+		static const source* find_source(const char* aName);
+		static const binary* find_binary(const char* aName);
+
+	};
+
+}
+
+#endif // !GEODESUKA_BUILTIN_EMBEDDED_SHADER_H
@@ -14,7 +14,7 @@ namespace geodesuka::builtin::object {
 
 	protected:
 
-		virtual VkCommandBuffer draw(core::object::rendertarget* aRenderTarget) override;
+		virtual void record(core::object::rendertarget* aRenderTarget, uint32_t aFrameIndex, VkCommandBuffer aCommandBuffer) override;
 
 	private:
 
@@ -23,10 +23,6 @@ namespace geodesuka::builtin::object {
 		core::gcl::shader* PixelShader;
 
 		// Hardcoded section for debugging.
-		VkRenderPass RenderPass;
-		std::vector<VkFramebuffer> FrameBuffer;
-		std::vector<VkCommandBuffer> CommandBuffer;
-
 		VkPipelineLayout PipelineLayout;
 		VkPipeline Pipeline;
 
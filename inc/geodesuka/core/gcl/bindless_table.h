@@ -0,0 +1,114 @@
+#pragma once
+#ifndef GEODESUKA_CORE_GCL_BINDLESS_TABLE_H
+#define GEODESUKA_CORE_GCL_BINDLESS_TABLE_H
+
+/*
+* Usage:
+*	Global resource table of a context, see context::bindless(). One descriptor
+*	set holds large update-after-bind arrays of sampled images, samplers and
+*	storage buffers. Objects register a resource once and pass the returned slot
+*	index to shaders, usually through push constants, instead of binding a
+*	descriptor set per object.
+*
+*	GLSL side, with GL_EXT_nonuniform_qualifier:
+*		layout(set = N, binding = 0) uniform texture2D Image[];
+*		layout(set = N, binding = 1) uniform sampler Sampler[];
+*		layout(set = N, binding = 2) buffer Storage { uint Data[]; } Buffer[];
+*
+*	Include layout() as set N in the pipeline layout and bind() it once per
+*	command buffer. Writes to new slots are legal while the set is bound.
+*
+*	remove() does not free a slot immediately, a command buffer still in flight
+*	may read it. Slots are recycled after collect() has been called retire lag
+*	times, the engine calls collect() each time it has waited on all in flight
+*	work of the context.
+*/
+
+#include <stdint.h>
+
+#include <vector>
+#include <deque>
+#include <mutex>
+
+#include "../gcl.h"
+
+namespace geodesuka::core::gcl {
+
+	class context;
+
+	class bindless_table {
+	public:
+
+		enum type : int {
+			IMAGE,
+			SAMPLER,
+			BUFFER,
+			TYPE_COUNT
+		};
+
+		// Returned when no slot is available.
+		static const uint32_t invalid = UINT32_MAX;
+
+		bindless_table(context* aContext, uint32_t aRetireLag = 2);
+		~bindless_table();
+
+		// Registers resource and returns its slot index, invalid on failure.
+		uint32_t add(VkImageView aImageView, VkImageLayout aLayout);
+		uint32_t add(VkSampler aSampler);
+		uint32_t add(VkBuffer aBuffer, VkDeviceSize aOffset, VkDeviceSize aRange);
+
+		// Rewrites a slot in place, the old resource must not be in use anymore.
+		void update(uint32_t aSlot, VkImageView aImageView, VkImageLayout aLayout);
+		void update(uint32_t aSlot, VkSampler aSampler);
+		void update(uint32_t aSlot, VkBuffer aBuffer, VkDeviceSize aOffset, VkDeviceSize aRange);
+
+		// Retires slot, recycled after collect() was called retire lag times.
+		void remove(type aType, uint32_t aSlot);
+
+		// Advances retire clock, returns slots whose lag has passed to the free list.
+		void collect();
+
+		void bind(VkCommandBuffer aCommandBuffer, VkPipelineBindPoint aBindPoint, VkPipelineLayout aLayout, uint32_t aSetIndex);
+
+		VkDescriptorSetLayout layout();
+		VkDescriptorSet set();
+
+		// Array size of binding for type.
+		uint32_t capacity(type aType);
+
+		// Number of slots in use for type, retired slots included.
+		uint32_t size(type aType);
+
+	private:
+
+		struct retired {
+			uint64_t Epoch;
+			type Type;
+			uint32_t Slot;
+		};
+
+		struct slot_list {
+			uint32_t Capacity;
+			uint32_t Next;						// Slots below were handed out at least once.
+			std::vector<uint32_t> Free;
+			slot_list();
+		};
+
+		context* Context;
+		std::mutex Mutex;
+		VkDescriptorSetLayout Layout;
+		VkDescriptorPool Pool;
+		VkDescriptorSet Set;
+		uint32_t RetireLag;
+		uint64_t Epoch;
+		slot_list Slot[TYPE_COUNT];
+		std::deque<retired> Retired;
+
+		uint32_t allocate(type aType);
+		void write(type aType, uint32_t aSlot, const VkDescriptorImageInfo* aImage, const VkDescriptorBufferInfo* aBuffer);
+
+	};
+
+}
+
+#endif // !GEODESUKA_CORE_GCL_BINDLESS_TABLE_H
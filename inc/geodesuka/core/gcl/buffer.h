@@ -20,15 +20,18 @@
 
 #include "device.h"
 #include "context.h"
+#include "external.h"
 
 namespace geodesuka::core::gcl {
 
 	class image;
+	class ownership_transfer;
 
 	class buffer {
 	public:
 
 		friend class image;
+		friend class ownership_transfer;
 
 		enum usage {
 			TRANSFER_SRC			= 0x00000001,
@@ -46,6 +49,10 @@ namespace geodesuka::core::gcl {
 		buffer();
 		buffer(context* aContext, int aMemoryType, int aUsage, int aCount, util::variable aMemoryLayout, void* aBufferData);
 		buffer(context* aContext, int aMemoryType, int aUsage, size_t aMemorySize, void* aBufferData);
+		// Allocates memory which can be exported to other contexts on the same device.
+		buffer(context* aContext, int aMemoryType, int aUsage, size_t aMemorySize, void* aBufferData, bool aExportable);
+		// Imports memory exported by another context, aMemory.FD is consumed on success.
+		buffer(context* aContext, int aUsage, size_t aMemorySize, external_memory& aMemory);
 		~buffer();
 
 		buffer(buffer& aInp);																					// Copy Constructor
@@ -73,6 +80,15 @@ namespace geodesuka::core::gcl {
 		void read(size_t aMemOffset, size_t aMemSize, void* aData);
 		void read(uint32_t aRegionCount, VkBufferCopy* aRegion, void* aData);
 
+		// Exports memory of an exportable buffer, returned object owns the FD. FD = -1 on failure.
+		external_memory export_memory();
+		// Releases buffer from aQFS, its owner, to VK_QUEUE_FAMILY_EXTERNAL. Submit on
+		// aQFS in the same batch that signals the exported semaphore.
+		VkCommandBuffer release_external(device::qfs aQFS);
+		// Acquires buffer from VK_QUEUE_FAMILY_EXTERNAL on aQFS. Submit on aQFS
+		// waiting on the imported semaphore, before first use.
+		VkCommandBuffer acquire_external(device::qfs aQFS);
+
 		VkBuffer& handle();
 
 	private:
@@ -84,10 +100,17 @@ namespace geodesuka::core::gcl {
 		VkMemoryAllocateInfo AllocateInfo{};
 		VkDeviceMemory MemoryHandle;
 		int MemoryProperty;
+		int Owner; // Queue family index which owns the buffer, -1 if unowned.
+		bool isExportable;
 
 		int Count;
 		util::variable MemoryLayout;
 
+		// Records copy from aRhs on family aQFS.
+		VkCommandBuffer copy(device::qfs aQFS, buffer& aRhs);
+		// Copies aSource on the family owning it, then hands this buffer to graphics.
+		VkResult duplicate(buffer& aSource);
+		VkCommandBuffer external_barrier(device::qfs aQFS, uint32_t aSrcQFI, uint32_t aDstQFI);
 		void pmclearall();
 
 	};
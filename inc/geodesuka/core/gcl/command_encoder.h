@@ -0,0 +1,142 @@
+#pragma once
+#ifndef GEODESUKA_CORE_GCL_COMMAND_ENCODER_H
+#define GEODESUKA_CORE_GCL_COMMAND_ENCODER_H
+
+/*
+* Usage:
+*	Thin wrapper around a command buffer being recorded which remembers the
+*	state it has bound, pipelines, descriptor sets, vertex and index buffers,
+*	dynamic state and push constants. A call that would bind what is already
+*	bound is dropped before it reaches the driver.
+*		gcl::command_encoder Encoder(Context, CommandBuffer);
+*		for (...) {
+*			Encoder.bind_pipeline(VK_PIPELINE_BIND_POINT_GRAPHICS, Pipeline);
+*			Encoder.bind_descriptor_sets(VK_PIPELINE_BIND_POINT_GRAPHICS, Layout, 0, 1, &Set, 0, NULL);
+*			Encoder.draw_indexed(IndexCount, 1, 0, 0, 0);
+*		}
+*
+*	State is tracked from construction on, command buffer state is undefined at
+*	the start of every command buffer (secondaries included). Call invalidate()
+*	after recording anything through vkCmd* directly that may change state.
+*
+*	Binding a different graphics pipeline forgets dynamic state, because the
+*	pipeline may set it statically. Binding descriptor sets with a different
+*	layout forgets higher sets, and push constants are forgotten when the
+*	layout or stages change, both as the compatibility rules require.
+*
+*	issued() counts calls passed to the driver and filtered() those dropped.
+*/
+
+#include <vector>
+
+#include "../gcl.h"
+
+namespace geodesuka::core::gcl {
+
+	class context;
+
+	class command_encoder {
+	public:
+
+		// Largest push constant block shadowed, larger ranges are always issued.
+		static constexpr uint32_t PUSH_CONSTANT_SIZE = 256;
+
+		command_encoder(context* aContext, VkCommandBuffer aCommandBuffer);
+
+		VkCommandBuffer handle();
+
+		// Forgets all bound state, e.g. after recording commands directly.
+		void invalidate();
+
+		// ----- Binding ----- //
+
+		void bind_pipeline(VkPipelineBindPoint aBindPoint, VkPipeline aPipeline);
+		void bind_descriptor_sets(VkPipelineBindPoint aBindPoint, VkPipelineLayout aLayout, uint32_t aFirstSet, uint32_t aSetCount, const VkDescriptorSet* aSet, uint32_t aDynamicOffsetCount, const uint32_t* aDynamicOffset);
+		void bind_vertex_buffers(uint32_t aFirstBinding, uint32_t aBindingCount, const VkBuffer* aBuffer, const VkDeviceSize* aOffset);
+		void bind_index_buffer(VkBuffer aBuffer, VkDeviceSize aOffset, VkIndexType aIndexType);
+		void push_constants(VkPipelineLayout aLayout, VkShaderStageFlags aStage, uint32_t aOffset, uint32_t aSize, const void* aData);
+
+		// ----- Dynamic State ----- //
+
+		void set_viewport(uint32_t aFirstViewport, uint32_t aViewportCount, const VkViewport* aViewport);
+		void set_scissor(uint32_t aFirstScissor, uint32_t aScissorCount, const VkRect2D* aScissor);
+		void set_line_width(float aLineWidth);
+		void set_depth_bias(float aConstantFactor, float aClamp, float aSlopeFactor);
+		void set_blend_constants(const float aBlendConstant[4]);
+		void set_stencil_reference(VkStencilFaceFlags aFaceMask, uint32_t aReference);
+
+		// ----- Drawing, always issued ----- //
+
+		void draw(uint32_t aVertexCount, uint32_t aInstanceCount, uint32_t aFirstVertex, uint32_t aFirstInstance);
+		void draw_indexed(uint32_t aIndexCount, uint32_t aInstanceCount, uint32_t aFirstIndex, int32_t aVertexOffset, uint32_t aFirstInstance);
+		void draw_indirect(VkBuffer aBuffer, VkDeviceSize aOffset, uint32_t aDrawCount, uint32_t aStride);
+		void draw_indexed_indirect(VkBuffer aBuffer, VkDeviceSize aOffset, uint32_t aDrawCount, uint32_t aStride);
+		void dispatch(uint32_t aGroupX, uint32_t aGroupY, uint32_t aGroupZ);
+
+		// Calls passed to the driver, and calls dropped as redundant.
+		uint64_t issued();
+		uint64_t filtered();
+
+	private:
+
+		// Graphics and compute bind points.
+		static constexpr uint32_t BIND_POINT_COUNT = 2;
+
+		struct descriptor_set {
+			bool isBound;
+			VkPipelineLayout Layout;
+			VkDescriptorSet Handle;
+			uint32_t CallFirstSet;					// Range of the call that bound it.
+			uint32_t CallSetCount;
+			std::vector<uint32_t> DynamicOffset;	// All dynamic offsets of that call.
+		};
+
+		struct vertex_buffer {
+			bool isBound;
+			VkBuffer Handle;
+			VkDeviceSize Offset;
+		};
+
+		struct bind_point {
+			VkPipeline Pipeline;
+			std::vector<descriptor_set> Set;
+		};
+
+		context* Context;
+		VkCommandBuffer Handle;
+		uint64_t IssuedCount;
+		uint64_t FilteredCount;
+
+		bind_point BindPoint[BIND_POINT_COUNT];
+		std::vector<vertex_buffer> VertexBuffer;
+		bool isIndexBufferBound;
+		VkBuffer IndexBuffer;
+		VkDeviceSize IndexOffset;
+		VkIndexType IndexType;
+
+		VkPipelineLayout PushLayout;
+		VkShaderStageFlags PushStage;
+		uint8_t PushData[PUSH_CONSTANT_SIZE];
+		bool PushKnown[PUSH_CONSTANT_SIZE];			// Byte has been pushed since last layout or stage change.
+
+		std::vector<VkViewport> Viewport;
+		std::vector<bool> isViewportSet;
+		std::vector<VkRect2D> Scissor;
+		std::vector<bool> isScissorSet;
+		bool isLineWidthSet;
+		float LineWidth;
+		bool isDepthBiasSet;
+		float DepthBias[3];
+		bool isBlendConstantSet;
+		float BlendConstant[4];
+		bool isStencilReferenceSet[2];				// Front and back face.
+		uint32_t StencilReference[2];
+
+		void forget_dynamic_state();
+		bind_point* bind_point_of(VkPipelineBindPoint aBindPoint);
+
+	};
+
+}
+
+#endif // !GEODESUKA_CORE_GCL_COMMAND_ENCODER_H
@@ -0,0 +1,82 @@
+#pragma once
+#ifndef GEODESUKA_CORE_GCL_COMMAND_RECORDER_H
+#define GEODESUKA_CORE_GCL_COMMAND_RECORDER_H
+
+/*
+* Usage:
+*	Records command buffers on a fixed set of worker threads. One recorder is
+*	owned by the engine and shared by every rendertarget, so several windows or
+*	cameras do not each spawn their own workers. Every worker is a lane owning
+*	one command pool per context, command buffers allocated from pool(C, i) are
+*	only ever recorded by lane i, so lanes never contend for a pool.
+*
+*	run() spreads jobs over lanes by the lane each job names and blocks until
+*	all of them are done. Jobs of one lane run in ascending job order, results
+*	written by job index keep a deterministic order whatever lane ran them:
+*		Recorder->run(ObjectCount,
+*			[&](size_t i) -> uint32_t { return LaneOf[i]; },
+*			[&](size_t i) { Secondary[i] = Object[i]->draw(RenderTarget); }
+*		);
+*
+*	A single lane records on the calling thread. run() is not reentrant and is
+*	meant to be called from the render thread only, rendertargets take turns.
+*	Pools of a context are made on first use and freed by remove(), which the
+*	context calls on destruction.
+*/
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <map>
+#include <condition_variable>
+#include <functional>
+
+#include "../gcl.h"
+#include "context.h"
+#include "command_pool.h"
+
+namespace geodesuka::core::gcl {
+
+	class command_recorder {
+	public:
+
+		// Zero lane count uses hardware concurrency.
+		command_recorder(uint32_t aLaneCount);
+		~command_recorder();
+
+		uint32_t lane_count();
+
+		// Pool owned by a lane for aContext, lock its Mutex to free buffers from other threads.
+		command_pool* pool(context* aContext, uint32_t aLane);
+
+		// Frees the pools of aContext, all their command buffers must be freed.
+		void remove(context* aContext);
+
+		// Runs aJob(i) for every i < aJobCount on lane aLane(i) % lane_count().
+		void run(size_t aJobCount, const std::function<uint32_t(size_t)>& aLane, const std::function<void(size_t)>& aJob);
+
+	private:
+
+		struct lane {
+			std::vector<size_t> Job;
+		};
+
+		std::mutex PoolMutex;
+		std::map<context*, std::vector<command_pool*>> Pool;	// Per context, one per lane.
+		std::mutex Mutex;
+		std::condition_variable Condition;				// Wakes workers for a new run.
+		std::condition_variable Done;					// Wakes run() once every lane finished.
+		bool Shutdown;
+		uint64_t Generation;							// Incremented per run.
+		uint32_t Remaining;								// Lanes still working on current run.
+		const std::function<void(size_t)>* Job;
+		std::vector<lane> Lane;
+		std::vector<std::thread> Worker;
+
+		void work(uint32_t aLane);
+
+	};
+
+}
+
+#endif // !GEODESUKA_CORE_GCL_COMMAND_RECORDER_H
@@ -0,0 +1,95 @@
+#pragma once
+#ifndef GEODESUKA_CORE_GCL_COMPUTE_PIPELINE_H
+#define GEODESUKA_CORE_GCL_COMPUTE_PIPELINE_H
+
+/*
+* Usage:
+*	Compute pipeline built from a single COMPUTE stage shader. The pipeline
+*	layout is derived from shader reflection through the context layout cache,
+*	and the pipeline itself is shared through the context pipeline state cache.
+*
+*	Record work into a command buffer created with device::qfs::COMPUTE:
+*		Pipeline.bind(Cmd);
+*		vkCmdBindDescriptorSets(Cmd, VK_PIPELINE_BIND_POINT_COMPUTE, Pipeline.layout(), ...);
+*		Pipeline.dispatch_threads(Cmd, ParticleCount, 1, 1);
+*		Pipeline.barrier(Cmd, Particle.handle(), 0, VK_WHOLE_SIZE);
+*
+*	and return it from object_t::compute() with compute_pipeline::submission(),
+*	the engine aggregates it into the compute back batch of the context.
+*/
+
+#include "../gcl.h"
+
+#include "shader.h"
+#include "shader_reflection.h"
+#include "layout_cache.h"
+
+namespace geodesuka::core::gcl {
+
+	class context;
+
+	class compute_pipeline {
+	public:
+
+		VkResult ErrorCode;
+
+		// Compiles aSource as COMPUTE stage, shader is owned by the pipeline.
+		compute_pipeline(context* aContext, const char* aSource, const VkSpecializationInfo* aSpecialization = NULL);
+
+		// Uses existing COMPUTE stage shader, which must outlive the pipeline.
+		compute_pipeline(context* aContext, shader* aShader, const VkSpecializationInfo* aSpecialization = NULL);
+
+		~compute_pipeline();
+
+		bool is_valid();
+
+		VkPipeline handle();
+		VkPipelineLayout layout();
+		VkDescriptorSetLayout set_layout(uint32_t aSetIndex);
+		const shader_reflection& get_reflection();
+
+		// Work group size declared by the shader.
+		void get_local_size(uint32_t* aX, uint32_t* aY, uint32_t* aZ);
+
+		// Number of work groups needed to cover a thread grid.
+		void get_group_count(uint32_t aThreadX, uint32_t aThreadY, uint32_t aThreadZ, uint32_t* aGroupX, uint32_t* aGroupY, uint32_t* aGroupZ);
+
+		// ----- Recording ----- //
+
+		void bind(VkCommandBuffer aCommandBuffer);
+		void push(VkCommandBuffer aCommandBuffer, uint32_t aOffset, uint32_t aSize, const void* aData);
+
+		// Dispatch in work groups.
+		void dispatch(VkCommandBuffer aCommandBuffer, uint32_t aGroupX, uint32_t aGroupY, uint32_t aGroupZ);
+
+		// Dispatch enough work groups to cover a thread grid, shader must bounds check.
+		void dispatch_threads(VkCommandBuffer aCommandBuffer, uint32_t aThreadX, uint32_t aThreadY, uint32_t aThreadZ);
+
+		// Group counts read from a VkDispatchIndirectCommand in aBuffer.
+		void dispatch_indirect(VkCommandBuffer aCommandBuffer, VkBuffer aBuffer, VkDeviceSize aOffset);
+
+		// Buffer memory barrier, defaults make compute writes visible to the next dispatch.
+		void barrier(
+			VkCommandBuffer aCommandBuffer, VkBuffer aBuffer, VkDeviceSize aOffset, VkDeviceSize aSize,
+			VkPipelineStageFlags aSrcStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VkAccessFlags aSrcAccess = VK_ACCESS_SHADER_WRITE_BIT,
+			VkPipelineStageFlags aDstStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VkAccessFlags aDstAccess = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT
+		);
+
+		// Submission of recorded command buffers, for object_t::compute().
+		static VkSubmitInfo submission(uint32_t aCommandBufferCount, const VkCommandBuffer* aCommandBuffer);
+
+	private:
+
+		context* Context;
+		shader* Shader;
+		bool isShaderOwned;
+		layout_cache::layout Layout;
+		VkPipeline Handle;
+
+		void create(const VkSpecializationInfo* aSpecialization);
+
+	};
+
+}
+
+#endif // !GEODESUKA_CORE_GCL_COMPUTE_PIPELINE_H
@@ -4,14 +4,22 @@
 
 #include <atomic>
 #include <mutex>
+#include <vector>
+#include <string>
 
 #include "../gcl.h"
 #include "command_batch.h"
 #include "device.h"
+#include "device_table.h"
 
 namespace geodesuka::core::gcl {
 
 	class command_batch;
+	class layout_cache;
+	class pipeline_cache;
+	class pipeline_state_cache;
+	class renderpass_cache;
+	class bindless_table;
 
 	class context {
 	public:
@@ -56,6 +64,42 @@ namespace geodesuka::core::gcl {
 		// Simply presents images corresponding to indices.
 		VkResult present(VkPresentInfoKHR* aPresentation);
 
+		// Shared descriptor set and pipeline layouts of this context.
+		layout_cache* layouts();
+
+		// Persistent pipeline cache, pass its handle to all pipeline creation.
+		pipeline_cache* cache();
+
+		// Shared, reference counted pipelines of this context.
+		pipeline_state_cache* pipelines();
+
+		// Shared, reference counted render passes and framebuffers of this context.
+		renderpass_cache* renderpasses();
+
+		// Vulkan version usable on this context, the lower of instance and device.
+		uint32_t api_version();
+
+		// True if extension was enabled at device creation.
+		bool is_enabled(const char* aExtension);
+
+		// True if VK_EXT_graphics_pipeline_library and its feature are enabled.
+		bool is_pipeline_library_enabled();
+
+		// True if the descriptor indexing features needed for bindless are enabled.
+		bool is_descriptor_indexing_enabled();
+
+		// True if indirect count draws (drawIndirectCount feature or VK_KHR_draw_indirect_count) are enabled.
+		bool is_draw_indirect_count_enabled();
+
+		// True if dynamic rendering (core 1.3 or VK_KHR_dynamic_rendering) and its feature are enabled.
+		bool is_dynamic_rendering_enabled();
+
+		// Global bindless resource table, nullptr without descriptor indexing.
+		bindless_table* bindless();
+
+		// Device level entry points, use instead of loader functions.
+		const device_table& api();
+
 		VkInstance inst();
 		device* parent();
 		VkDevice handle();
@@ -93,6 +137,20 @@ namespace geodesuka::core::gcl {
 		VkDeviceQueueCreateInfo* QueueCreateInfo;
 		VkDeviceCreateInfo CreateInfo{};
 		VkDevice Handle;
+		device_table Table;
+		std::vector<std::string> Extension;
+		bool isPipelineLibraryEnabled;
+		bool isDescriptorIndexingEnabled;
+		bool isDrawIndirectCountEnabled;
+		bool isDynamicRenderingEnabled;
+#ifdef VK_EXT_graphics_pipeline_library
+		VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT GraphicsPipelineLibraryFeatures;
+#endif
+		VkPhysicalDeviceVulkan12Features Vulkan12Features;
+		VkPhysicalDeviceDescriptorIndexingFeatures DescriptorIndexingFeatures;
+#ifdef VK_KHR_dynamic_rendering
+		VkPhysicalDeviceDynamicRenderingFeaturesKHR DynamicRenderingFeatures;
+#endif
 
 		struct queue {
 			uint32_t i, j;		
@@ -112,6 +170,12 @@ namespace geodesuka::core::gcl {
 		uint32_t CommandBufferCount[3];
 		VkCommandBuffer *CommandBuffer[3];
 
+		layout_cache* LayoutCache;
+		pipeline_cache* PipelineCache;
+		pipeline_state_cache* PipelineStateCache;
+		renderpass_cache* RenderPassCache;
+		bindless_table* BindlessTable;
+
 	};
 
 }
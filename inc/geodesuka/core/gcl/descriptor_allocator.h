@@ -0,0 +1,99 @@
+#pragma once
+#ifndef GEODESUKA_CORE_GCL_DESCRIPTOR_ALLOCATOR_H
+#define GEODESUKA_CORE_GCL_DESCRIPTOR_ALLOCATOR_H
+
+/*
+* Usage:
+*	Descriptor set allocator for an owner with aFrameCount frames in flight,
+*	usually a rendertarget. Pools are created on demand, a full pool is followed
+*	by a larger one.
+*
+*	Transient sets are allocated from the pools of a frame slot and are valid
+*	until reset() of that slot. Reset the slot once the fence of the frame that
+*	last used it has signaled, all its pools are reset at once, no set is freed
+*	individually.
+*
+*	Persistent sets are cached by layout, update template and descriptor data.
+*	Identical requests return the same set. Keys compare handle values, call
+*	reset_persistent() after destroying resources referenced by persistent sets.
+*
+*	Sets are written with update templates, the descriptor data is a plain
+*	struct laid out as described by the template entries. Templates are cached
+*	per layout and entry list.
+*
+*	All calls are thread safe.
+*/
+
+#include <stdint.h>
+
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <string>
+#include <mutex>
+
+#include "../gcl.h"
+
+namespace geodesuka::core::gcl {
+
+	class context;
+
+	class descriptor_allocator {
+	public:
+
+		descriptor_allocator(context* aContext, uint32_t aFrameCount);
+		~descriptor_allocator();
+
+		// Returns cached update template for layout and entries.
+		VkDescriptorUpdateTemplate update_template(VkDescriptorSetLayout aLayout, uint32_t aEntryCount, const VkDescriptorUpdateTemplateEntry* aEntry);
+
+		// Transient set valid until reset(aFrame), VK_NULL_HANDLE on failure.
+		VkDescriptorSet allocate(uint32_t aFrame, VkDescriptorSetLayout aLayout);
+
+		// Transient set written from aData through aTemplate.
+		VkDescriptorSet allocate(uint32_t aFrame, VkDescriptorSetLayout aLayout, VkDescriptorUpdateTemplate aTemplate, const void* aData);
+
+		// Shared set for identical layout, template and data. aSize is the size of aData in bytes.
+		VkDescriptorSet acquire(VkDescriptorSetLayout aLayout, VkDescriptorUpdateTemplate aTemplate, const void* aData, size_t aSize);
+
+		// Writes any set through an update template.
+		void write(VkDescriptorSet aSet, VkDescriptorUpdateTemplate aTemplate, const void* aData);
+
+		// Resets all pools of a frame slot, its sets must no longer be in use.
+		void reset(uint32_t aFrame);
+
+		// Drops all persistent sets, they must no longer be in use.
+		void reset_persistent();
+
+		uint32_t frame_count();
+
+		// Number of pools created for frame slot.
+		size_t pool_count(uint32_t aFrame);
+
+	private:
+
+		// Pools of one frame slot, or the persistent pools.
+		struct pool_list {
+			std::vector<VkDescriptorPool> Pool;
+			size_t Active;
+			uint32_t SetCount;			// Sets per pool for the next pool created.
+			pool_list();
+		};
+
+		context* Context;
+		std::mutex Mutex;
+		std::vector<pool_list> Frame;
+		pool_list Persistent;
+		std::unordered_map<std::string, VkDescriptorSet> PersistentSet;
+		std::map<std::string, VkDescriptorUpdateTemplate> Template;
+
+		VkDescriptorSet allocate(pool_list& aList, VkDescriptorSetLayout aLayout);
+		VkDescriptorPool create_pool(uint32_t aSetCount);
+		void reset(pool_list& aList);
+		void destroy(pool_list& aList);
+
+	};
+
+}
+
+#endif // !GEODESUKA_CORE_GCL_DESCRIPTOR_ALLOCATOR_H
@@ -65,6 +65,8 @@ namespace geodesuka::core::gcl {
 		VkPhysicalDeviceProperties get_properties() const;
 		VkPhysicalDeviceFeatures get_features() const;
 		VkPhysicalDeviceMemoryProperties get_memory_properties() const;
+		// Device and driver UUIDs, used to verify external memory is shared on the same device.
+		VkPhysicalDeviceIDProperties get_id_properties() const;
 		const VkExtensionProperties* get_extensions(uint32_t* aExtensionCount) const;
 		int get_memory_type_index(VkMemoryRequirements aMemoryRequirements, int aMemoryType) const;
 		int get_memory_type(int aMemoryTypeIndex);
@@ -103,6 +105,7 @@ namespace geodesuka::core::gcl {
 		VkPhysicalDeviceProperties Properties{};
 		VkPhysicalDeviceFeatures Features{};
 		VkPhysicalDeviceMemoryProperties MemoryProperties{};
+		VkPhysicalDeviceIDProperties IDProperties{};
 
 	};
 
@@ -0,0 +1,187 @@
+#pragma once
+#ifndef GEODESUKA_CORE_GCL_DEVICE_TABLE_H
+#define GEODESUKA_CORE_GCL_DEVICE_TABLE_H
+
+/*
+* Usage:
+*	Device level entry points of a context, loaded once with vkGetDeviceProcAddr
+*	when the context is created. Calls through the table go straight to the
+*	driver instead of through the loader trampoline. All gcl code calls the
+*	device through context::api().
+*
+*		Context->api().vkCmdDraw(CommandBuffer, 3, 1, 0, 0);
+*
+*	Extension entry points are NULL unless the extension was enabled on the
+*	context, check the matching availability flag before calling them.
+*/
+
+#include "../gcl.h"
+
+namespace geodesuka::core::gcl {
+
+	class context;
+
+	class device_table {
+	public:
+
+		// ----- Availability ----- //
+
+		bool isSwapchainAvailable;				// VK_KHR_swapchain
+		bool isExternalMemoryFdAvailable;		// VK_KHR_external_memory_fd
+		bool isExternalSemaphoreFdAvailable;	// VK_KHR_external_semaphore_fd
+		bool isDrawIndirectCountAvailable;		// drawIndirectCount feature or VK_KHR_draw_indirect_count enabled
+		bool isPushDescriptorAvailable;			// VK_KHR_push_descriptor
+		bool isDynamicRenderingAvailable;		// Vulkan 1.3 or VK_KHR_dynamic_rendering
+
+		// ----- Device ----- //
+
+		PFN_vkDestroyDevice							vkDestroyDevice;
+		PFN_vkGetDeviceQueue						vkGetDeviceQueue;
+		PFN_vkDeviceWaitIdle						vkDeviceWaitIdle;
+
+		// ----- Queue ----- //
+
+		PFN_vkQueueSubmit							vkQueueSubmit;
+		PFN_vkQueueWaitIdle							vkQueueWaitIdle;
+
+		// ----- Synchronization ----- //
+
+		PFN_vkCreateFence							vkCreateFence;
+		PFN_vkDestroyFence							vkDestroyFence;
+		PFN_vkResetFences							vkResetFences;
+		PFN_vkGetFenceStatus						vkGetFenceStatus;
+		PFN_vkWaitForFences							vkWaitForFences;
+		PFN_vkCreateSemaphore						vkCreateSemaphore;
+		PFN_vkDestroySemaphore						vkDestroySemaphore;
+
+		// ----- Memory ----- //
+
+		PFN_vkAllocateMemory						vkAllocateMemory;
+		PFN_vkFreeMemory							vkFreeMemory;
+		PFN_vkMapMemory								vkMapMemory;
+		PFN_vkUnmapMemory							vkUnmapMemory;
+		PFN_vkFlushMappedMemoryRanges				vkFlushMappedMemoryRanges;
+		PFN_vkInvalidateMappedMemoryRanges			vkInvalidateMappedMemoryRanges;
+
+		// ----- Resources ----- //
+
+		PFN_vkCreateBuffer							vkCreateBuffer;
+		PFN_vkDestroyBuffer							vkDestroyBuffer;
+		PFN_vkGetBufferMemoryRequirements			vkGetBufferMemoryRequirements;
+		PFN_vkBindBufferMemory						vkBindBufferMemory;
+		PFN_vkCreateImage							vkCreateImage;
+		PFN_vkDestroyImage							vkDestroyImage;
+		PFN_vkGetImageMemoryRequirements			vkGetImageMemoryRequirements;
+		PFN_vkBindImageMemory						vkBindImageMemory;
+		PFN_vkCreateImageView						vkCreateImageView;
+		PFN_vkDestroyImageView						vkDestroyImageView;
+		PFN_vkCreateSampler							vkCreateSampler;
+		PFN_vkDestroySampler						vkDestroySampler;
+
+		// ----- Descriptors ----- //
+
+		PFN_vkCreateDescriptorSetLayout				vkCreateDescriptorSetLayout;
+		PFN_vkDestroyDescriptorSetLayout			vkDestroyDescriptorSetLayout;
+		PFN_vkCreateDescriptorPool					vkCreateDescriptorPool;
+		PFN_vkDestroyDescriptorPool					vkDestroyDescriptorPool;
+		PFN_vkResetDescriptorPool					vkResetDescriptorPool;
+		PFN_vkAllocateDescriptorSets				vkAllocateDescriptorSets;
+		PFN_vkFreeDescriptorSets					vkFreeDescriptorSets;
+		PFN_vkUpdateDescriptorSets					vkUpdateDescriptorSets;
+		PFN_vkCreateDescriptorUpdateTemplate		vkCreateDescriptorUpdateTemplate;
+		PFN_vkDestroyDescriptorUpdateTemplate		vkDestroyDescriptorUpdateTemplate;
+		PFN_vkUpdateDescriptorSetWithTemplate		vkUpdateDescriptorSetWithTemplate;
+
+		// ----- Pipelines ----- //
+
+		PFN_vkCreateShaderModule					vkCreateShaderModule;
+		PFN_vkDestroyShaderModule					vkDestroyShaderModule;
+		PFN_vkCreatePipelineLayout					vkCreatePipelineLayout;
+		PFN_vkDestroyPipelineLayout					vkDestroyPipelineLayout;
+		PFN_vkCreatePipelineCache					vkCreatePipelineCache;
+		PFN_vkDestroyPipelineCache					vkDestroyPipelineCache;
+		PFN_vkGetPipelineCacheData					vkGetPipelineCacheData;
+		PFN_vkMergePipelineCaches					vkMergePipelineCaches;
+		PFN_vkCreateGraphicsPipelines				vkCreateGraphicsPipelines;
+		PFN_vkCreateComputePipelines				vkCreateComputePipelines;
+		PFN_vkDestroyPipeline						vkDestroyPipeline;
+
+		// ----- Render Passes ----- //
+
+		PFN_vkCreateRenderPass						vkCreateRenderPass;
+		PFN_vkDestroyRenderPass						vkDestroyRenderPass;
+		PFN_vkCreateFramebuffer						vkCreateFramebuffer;
+		PFN_vkDestroyFramebuffer					vkDestroyFramebuffer;
+
+		// ----- Command Buffers ----- //
+
+		PFN_vkCreateCommandPool						vkCreateCommandPool;
+		PFN_vkDestroyCommandPool					vkDestroyCommandPool;
+		PFN_vkResetCommandPool						vkResetCommandPool;
+		PFN_vkAllocateCommandBuffers				vkAllocateCommandBuffers;
+		PFN_vkFreeCommandBuffers					vkFreeCommandBuffers;
+		PFN_vkBeginCommandBuffer					vkBeginCommandBuffer;
+		PFN_vkEndCommandBuffer						vkEndCommandBuffer;
+		PFN_vkResetCommandBuffer					vkResetCommandBuffer;
+
+		// ----- Commands ----- //
+
+		PFN_vkCmdBindPipeline						vkCmdBindPipeline;
+		PFN_vkCmdBindDescriptorSets					vkCmdBindDescriptorSets;
+		PFN_vkCmdBindVertexBuffers					vkCmdBindVertexBuffers;
+		PFN_vkCmdBindIndexBuffer					vkCmdBindIndexBuffer;
+		PFN_vkCmdPushConstants						vkCmdPushConstants;
+		PFN_vkCmdSetViewport						vkCmdSetViewport;
+		PFN_vkCmdSetScissor							vkCmdSetScissor;
+		PFN_vkCmdSetLineWidth						vkCmdSetLineWidth;
+		PFN_vkCmdSetDepthBias						vkCmdSetDepthBias;
+		PFN_vkCmdSetBlendConstants					vkCmdSetBlendConstants;
+		PFN_vkCmdSetStencilReference				vkCmdSetStencilReference;
+		PFN_vkCmdDraw								vkCmdDraw;
+		PFN_vkCmdDrawIndexed						vkCmdDrawIndexed;
+		PFN_vkCmdDrawIndirect						vkCmdDrawIndirect;
+		PFN_vkCmdDrawIndexedIndirect				vkCmdDrawIndexedIndirect;
+		PFN_vkCmdDispatch							vkCmdDispatch;
+		PFN_vkCmdDispatchIndirect					vkCmdDispatchIndirect;
+		PFN_vkCmdCopyBuffer							vkCmdCopyBuffer;
+		PFN_vkCmdCopyImage							vkCmdCopyImage;
+		PFN_vkCmdBlitImage							vkCmdBlitImage;
+		PFN_vkCmdCopyBufferToImage					vkCmdCopyBufferToImage;
+		PFN_vkCmdCopyImageToBuffer					vkCmdCopyImageToBuffer;
+		PFN_vkCmdUpdateBuffer						vkCmdUpdateBuffer;
+		PFN_vkCmdFillBuffer							vkCmdFillBuffer;
+		PFN_vkCmdPipelineBarrier					vkCmdPipelineBarrier;
+		PFN_vkCmdBeginRenderPass					vkCmdBeginRenderPass;
+		PFN_vkCmdNextSubpass						vkCmdNextSubpass;
+		PFN_vkCmdEndRenderPass						vkCmdEndRenderPass;
+		PFN_vkCmdExecuteCommands					vkCmdExecuteCommands;
+
+		// ----- Extensions ----- //
+
+		PFN_vkCreateSwapchainKHR					vkCreateSwapchainKHR;
+		PFN_vkDestroySwapchainKHR					vkDestroySwapchainKHR;
+		PFN_vkGetSwapchainImagesKHR					vkGetSwapchainImagesKHR;
+		PFN_vkAcquireNextImageKHR					vkAcquireNextImageKHR;
+		PFN_vkQueuePresentKHR						vkQueuePresentKHR;
+		PFN_vkCmdDrawIndirectCount					vkCmdDrawIndirectCount;
+		PFN_vkCmdDrawIndexedIndirectCount			vkCmdDrawIndexedIndirectCount;
+		PFN_vkCmdPushDescriptorSetKHR				vkCmdPushDescriptorSetKHR;
+		PFN_vkCmdPushDescriptorSetWithTemplateKHR	vkCmdPushDescriptorSetWithTemplateKHR;
+		PFN_vkGetMemoryFdKHR						vkGetMemoryFdKHR;
+		PFN_vkGetSemaphoreFdKHR						vkGetSemaphoreFdKHR;
+		PFN_vkImportSemaphoreFdKHR					vkImportSemaphoreFdKHR;
+#ifdef VK_KHR_dynamic_rendering
+		PFN_vkCmdBeginRenderingKHR					vkCmdBeginRenderingKHR;
+		PFN_vkCmdEndRenderingKHR					vkCmdEndRenderingKHR;
+#endif
+
+		device_table();
+
+		// Loads all entry points for aContext, which must have a valid device handle.
+		void load(context* aContext);
+
+	};
+
+}
+
+#endif // !GEODESUKA_CORE_GCL_DEVICE_TABLE_H
@@ -0,0 +1,128 @@
+#pragma once
+#ifndef GEODESUKA_CORE_GCL_DRAW_CULLER_H
+#define GEODESUKA_CORE_GCL_DRAW_CULLER_H
+
+/*
+* Usage:
+*	GPU driven culling for large static scenes. Bounding spheres and indexed
+*	draw arguments live in storage buffers, a compute pass frustum culls them
+*	per view and compacts the survivors into an indirect buffer, with their
+*	number in a count buffer. No per draw work is left on the CPU.
+*
+*	Fill the scene once, draws share the bound vertex and index buffers:
+*		uint32_t Draw = Culler->add(Center, Radius, Command);
+*
+*	Every frame, from object_t::prepare() before the frame scope opens:
+*		Culler->cull(CommandBuffer, RenderTarget, FrameIndex, RenderTarget->view_projection());
+*
+*	And once in object_t::record(), inside the frame scope:
+*		vkCmdBindPipeline(...);
+*		vkCmdBindVertexBuffers(...);
+*		vkCmdBindIndexBuffer(...);
+*		Culler->draw(CommandBuffer, RenderTarget, FrameIndex);
+*
+*	draw() uses vkCmdDrawIndexedIndirectCount if available, so the recorded
+*	secondary stays valid whatever survives. Without it the whole indirect
+*	buffer is drawn, slots past the count are zeroed by cull() and draw nothing.
+*
+*	Each view (rendertarget) has its own indirect and count buffers per frame.
+*	Scene buffers are device local and shared by all views and frames, scene
+*	changes are recorded as buffer updates by the next cull(), ordered after
+*	the passes of frames still in flight, so the scene may change any time.
+*/
+
+#include <vector>
+#include <map>
+#include <mutex>
+
+#include "../gcl.h"
+#include "../math.h"
+#include "context.h"
+#include "buffer.h"
+#include "shader.h"
+#include "compute_pipeline.h"
+#include "descriptor_allocator.h"
+
+namespace geodesuka::core::object {
+	class rendertarget;
+}
+
+namespace geodesuka::core::gcl {
+
+	class draw_culler {
+	public:
+
+		static constexpr uint32_t INVALID_DRAW = 0xFFFFFFFF;
+
+		VkResult ErrorCode;
+
+		// aCapacity is clamped to maxDrawIndirectCount, see capacity().
+		draw_culler(context* aContext, uint32_t aCapacity);
+		~draw_culler();
+
+		bool is_valid();
+
+		// ----- Scene ----- //
+
+		// Returns the draw slot, INVALID_DRAW if the culler is full.
+		uint32_t add(float3 aCenter, float aRadius, const VkDrawIndexedIndirectCommand& aCommand);
+		void update(uint32_t aDraw, float3 aCenter, float aRadius);
+		void remove(uint32_t aDraw);
+
+		uint32_t capacity();
+
+		// ----- Views ----- //
+
+		// Records the culling pass of aRenderTarget for frame aFrameIndex. Must be
+		// recorded outside of a render pass, on a queue supporting compute.
+		void cull(VkCommandBuffer aCommandBuffer, object::rendertarget* aRenderTarget, uint32_t aFrameIndex, const float4x4& aViewProjection);
+
+		// Records the indirect draws of aRenderTarget for frame aFrameIndex.
+		void draw(VkCommandBuffer aCommandBuffer, object::rendertarget* aRenderTarget, uint32_t aFrameIndex);
+
+		// Frees the buffers of a view, none of its frames may be in flight.
+		void forget(object::rendertarget* aRenderTarget);
+
+	private:
+
+		struct frustum {
+			float4 Plane[6];
+			uint32_t DrawCount;
+		};
+
+		struct view_frame {
+			buffer* Indirect;
+			buffer* Count;
+			VkDescriptorSet Set;
+		};
+
+		context* Context;
+		uint32_t Capacity;
+		std::mutex Mutex;
+
+		shader* Shader;
+		compute_pipeline* Pipeline;
+		descriptor_allocator* Descriptor;
+		VkDescriptorUpdateTemplate Template;
+
+		// Host copies, the dirty range is recorded into the next cull().
+		buffer* Bounds;
+		buffer* Command;
+		std::vector<float4> Sphere;
+		std::vector<VkDrawIndexedIndirectCommand> Draw;
+		std::vector<uint32_t> FreeDraw;
+		uint32_t DrawCount;				// Slots ever used, range the pass runs over.
+		uint32_t DirtyBegin;
+		uint32_t DirtyEnd;
+
+		std::map<object::rendertarget*, std::vector<view_frame>> View;
+
+		void mark(uint32_t aDraw);
+		void upload(VkCommandBuffer aCommandBuffer);
+		view_frame* view_of(object::rendertarget* aRenderTarget, uint32_t aFrameIndex);
+
+	};
+
+}
+
+#endif // !GEODESUKA_CORE_GCL_DRAW_CULLER_H
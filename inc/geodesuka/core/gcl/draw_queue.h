@@ -0,0 +1,135 @@
+#pragma once
+#ifndef GEODESUKA_CORE_GCL_DRAW_QUEUE_H
+#define GEODESUKA_CORE_GCL_DRAW_QUEUE_H
+
+/*
+* Usage:
+*	Collects draw packets from many objects and turns them into as few draws
+*	as possible. Every packet gets a 64 bit sort key, packets are radix sorted
+*	and runs sharing pipeline, material and mesh collapse into one instanced
+*	draw. Per instance data of each packet is copied into a per frame instance
+*	buffer in sorted order, bound at InstanceBinding.
+*
+*	Sort key, high to low bits:
+*		pass (4) | pipeline (12) | material (16) | mesh (16) | depth (16)
+*	Translucent packets sort by depth right after the pass, back to front:
+*		pass (4) | inverted depth (16) | pipeline (12) | material (16) | mesh (16)
+*	Opaque depth is ascending, so within a run instances go front to back.
+*
+*	The rendertarget owns one queue, see object_t::enqueue(). Each frame:
+*		Queue->clear();
+*		Queue->submit(Packet);	// Once per object.
+*		...
+*		Queue->record(Encoder, FrameIndex);
+*
+*	Passes can also be recorded apart, e.g. opaque before and translucent after
+*	draws made outside the queue, sort and upload once then record each range:
+*		Queue->prepare(FrameIndex);
+*		Queue->record(Encoder, FrameIndex, draw_queue::OPAQUE, draw_queue::MASKED);
+*		Queue->record(Encoder, FrameIndex, draw_queue::TRANSLUCENT, draw_queue::OVERLAY);
+*
+*	The material descriptor set is bound at set 0 and the mesh vertex buffer at
+*	binding 0. Pipelines must declare the instance binding with input rate
+*	VK_VERTEX_INPUT_RATE_INSTANCE and stride equal to the instance size. Not
+*	thread safe, submit from one thread.
+*/
+
+#include <vector>
+#include <map>
+#include <tuple>
+
+#include "../gcl.h"
+#include "context.h"
+#include "buffer.h"
+#include "command_encoder.h"
+
+namespace geodesuka::core::gcl {
+
+	class draw_queue {
+	public:
+
+		enum pass {
+			OPAQUE			= 0,
+			MASKED			= 1,
+			TRANSLUCENT		= 2,
+			OVERLAY			= 3
+		};
+
+		struct packet {
+			uint32_t Pass;
+			VkPipeline Pipeline;
+			VkPipelineLayout Layout;
+			VkDescriptorSet Material;		// Bound at set 0, VK_NULL_HANDLE for none.
+			VkBuffer VertexBuffer;			// Bound at binding 0, VK_NULL_HANDLE for none.
+			VkBuffer IndexBuffer;			// VK_NULL_HANDLE draws without indices.
+			VkIndexType IndexType;
+			uint32_t Count;					// Index count, or vertex count without indices.
+			float Depth;					// View space distance, non negative.
+			const void* Instance;			// Instance size bytes, copied on submit.
+		};
+
+		draw_queue(context* aContext, uint32_t aFrameCount, uint32_t aInstanceSize, uint32_t aInstanceBinding);
+		~draw_queue();
+
+		// Drops all packets, call at the start of a frame.
+		void clear();
+		void submit(const packet& aPacket);
+
+		size_t packet_count();
+
+		// Packets with a pass from aFirstPass to aLastPass.
+		size_t packet_count(uint32_t aFirstPass, uint32_t aLastPass);
+
+		// Sorts, uploads instance data of frame aFrameIndex and records one
+		// instanced draw per run.
+		void record(command_encoder& aEncoder, uint32_t aFrameIndex);
+
+		// Sorts and uploads instance data of frame aFrameIndex.
+		void prepare(uint32_t aFrameIndex);
+
+		// Records the runs of passes aFirstPass to aLastPass, after prepare().
+		void record(command_encoder& aEncoder, uint32_t aFrameIndex, uint32_t aFirstPass, uint32_t aLastPass);
+
+		// Draws recorded since the last prepare().
+		size_t draw_count();
+
+		// Sort key of a packet from the small ids of its pipeline, material and mesh.
+		static uint64_t sort_key(uint32_t aPass, uint32_t aPipeline, uint32_t aMaterial, uint32_t aMesh, float aDepth);
+
+	private:
+
+		typedef std::tuple<VkBuffer, VkBuffer, VkIndexType, uint32_t> mesh_key;
+
+		context* Context;
+		uint32_t InstanceSize;
+		uint32_t InstanceBinding;
+		size_t DrawCount;
+
+		std::vector<packet> Packet;
+		std::vector<uint8_t> InstanceData;				// Submission order.
+		std::vector<uint8_t> SortedInstanceData;
+
+		// Reused across frames.
+		std::vector<uint64_t> Key;
+		std::vector<uint64_t> KeyScratch;
+		std::vector<uint32_t> Order;
+		std::vector<uint32_t> OrderScratch;
+
+		std::vector<buffer*> InstanceBuffer;			// Per frame, frames in flight keep theirs.
+		std::vector<size_t> InstanceCapacity;
+
+		// Handles to small ids, only used for ordering.
+		std::map<VkPipeline, uint32_t> PipelineID;
+		std::map<VkDescriptorSet, uint32_t> MaterialID;
+		std::map<mesh_key, uint32_t> MeshID;
+
+		uint64_t key_of(const packet& aPacket);
+		void sort();
+
+		static bool is_same_run(const packet& aLhs, const packet& aRhs);
+
+	};
+
+}
+
+#endif // !GEODESUKA_CORE_GCL_DRAW_QUEUE_H
@@ -2,10 +2,61 @@
 #ifndef GEODESUKA_CORE_GCL_DRAWPACK_H
 #define GEODESUKA_CORE_GCL_DRAWPACK_H
 
+/*
+* Usage:
+*	Everything an object needs to record draw commands to one rendertarget.
+*	If the context has dynamic rendering enabled and the rendertarget exposes
+*	its frame images, the drawpack renders straight into the frame attachments
+*	and creates neither a render pass nor framebuffers. Otherwise it falls back
+*	to a render pass with one framebuffer per frame, both shared with other
+*	drawpacks through the context render pass cache.
+*
+*	Both paths are used the same way:
+*		DrawPack->pipeline(GraphicsPipelineCreateInfo);
+*		...
+*		DrawPack->begin(DrawPack->Command[i], i, 1, &ClearValue);
+*		vkCmdDraw(...);
+*		DrawPack->end(DrawPack->Command[i], i);
+*
+*	Objects should rather record into the frame scope a rendertarget opens once
+*	per frame, see rendertarget::frame_pack(). A drawpack made from just the
+*	rendertarget borrows that scope, Command holds secondary command buffers
+*	and begin()/end() record nothing, the scope is already open:
+*		DrawPack = new drawpack(Context, RenderTarget);
+*		DrawPack->pipeline(GraphicsPipelineCreateInfo);
+*		...
+*		DrawPack->inherit(BeginInfo);
+*		vkBeginCommandBuffer(DrawPack->Command[i], &BeginInfo);
+*		vkCmdDraw(...);
+*		vkEndCommandBuffer(DrawPack->Command[i]);
+*
+*	object_t::draw() does the recording part for objects and calls
+*	object_t::record() between begin and end.
+*
+*	All objects then share one render pass instance per frame, attachments are
+*	loaded and stored once instead of once per object.
+*
+*	The dynamic path does the attachment layout transitions the render pass
+*	would have done, from initialLayout to the subpass layout and then to
+*	finalLayout. It only covers a single subpass without input or resolve
+*	attachments, other descriptions always use the render pass path.
+*
+*	Command buffers are only re-recorded when dirty. Each frame remembers the
+*	generation it was recorded at, invalidate() and refresh() bump it, and a
+*	borrowed scope also follows the generation of the rendertarget scope. Keep
+*	per frame data such as transforms in buffers so recorded commands stay
+*	valid, and call invalidate() when pipelines, bindings or geometry change.
+*/
+
+#include <vector>
+#include <atomic>
+
 #include <vulkan/vulkan.h>
 
 #include "context.h"
+#include "command_pool.h"
 #include "renderpass.h"
+#include "renderpass_cache.h"
 #include "framebuffer.h"
 
 // Forward Declaration.
@@ -22,16 +73,77 @@ namespace geodesuka::core::gcl {
 		object::rendertarget* RenderTarget;
 
 		VkResult Result;
+		bool isDynamic;						// Dynamic rendering, no render pass or framebuffers.
+		drawpack* Parent;					// Borrowed frame scope, nullptr if this is a scope itself.
 		VkRenderPassCreateInfo CreateInfo{};
 		VkRenderPass RenderPass;
 		// This is created per frame.
 		//uint32_t FrameCount;
 		VkFramebuffer* Frame;
 		VkCommandBuffer* Command;
+		command_pool* Pool;					// Pool Command is allocated from.
+		uint32_t Lane;						// Recording lane of the rendertarget, see rendertarget::draw_pool().
 
 		drawpack(context *aContext, object::rendertarget* aRenderTarget, uint32_t aSubpassDescriptionCount, VkSubpassDescription* aSubpassDescriptionList, uint32_t aSubpassDependencyCount, VkSubpassDependency* aSubpassDependencyList);
+
+		// Secondary command buffers executed in the frame scope of the rendertarget.
+		drawpack(context* aContext, object::rendertarget* aRenderTarget);
+
 		~drawpack();
 
+		// Makes a graphics pipeline compatible with this drawpack. Sets the render
+		// pass, or on the dynamic path the attachment formats through pNext, which
+		// must be empty. The drawpack must outlive pipeline creation.
+		void pipeline(VkGraphicsPipelineCreateInfo& aCreateInfo);
+
+		// Reacquires framebuffers for the current frame attachments and
+		// resolution, call after the rendertarget has resized.
+		void refresh();
+
+		// Marks every frame for re-recording.
+		void invalidate();
+
+		// True if Command[aFrameIndex] must be recorded before it is used.
+		bool is_dirty(uint32_t aFrameIndex);
+
+		// Call once Command[aFrameIndex] has been recorded.
+		void recorded(uint32_t aFrameIndex);
+
+		// Sets up a begin info to continue the frame scope, secondaries only.
+		void inherit(VkCommandBufferBeginInfo& aBeginInfo);
+
+		// Scopes rendering to a frame, clear values are indexed by attachment. With
+		// aSecondaryContents the scope only takes vkCmdExecuteCommands.
+		void begin(VkCommandBuffer aCommandBuffer, uint32_t aFrameIndex, uint32_t aClearValueCount, const VkClearValue* aClearValue, bool aSecondaryContents = false);
+		void end(VkCommandBuffer aCommandBuffer, uint32_t aFrameIndex);
+
+	private:
+
+		std::atomic<uint64_t> Generation;				// Bumped by invalidate() and refresh().
+		std::vector<uint64_t> RecordedGeneration;		// Generation each frame was recorded at.
+
+		// Frame attachments referenced by the single subpass of the dynamic path.
+		std::vector<uint32_t> ColorAttachment;
+		std::vector<VkImageLayout> ColorLayout;
+		std::vector<VkFormat> ColorFormat;
+		uint32_t DepthAttachment;
+		VkImageLayout DepthLayout;
+		VkCommandBufferInheritanceInfo Inheritance;
+#ifdef VK_KHR_dynamic_rendering
+		VkPipelineRenderingCreateInfoKHR RenderingCreateInfo;
+		VkCommandBufferInheritanceRenderingInfoKHR InheritanceRendering;
+#endif
+
+		bool make_dynamic(uint32_t aSubpassDescriptionCount, const VkSubpassDescription* aSubpassDescriptionList);
+		void make_render_pass(uint32_t aSubpassDescriptionCount, VkSubpassDescription* aSubpassDescriptionList, uint32_t aSubpassDependencyCount, VkSubpassDependency* aSubpassDependencyList);
+		void make_framebuffers();
+
+		// Layout transitions around dynamic rendering.
+		void transition(VkCommandBuffer aCommandBuffer, uint32_t aFrameIndex, bool aBegin);
+
+		// Own generation plus that of the borrowed scope, both only grow.
+		uint64_t stamp();
+
 	};
 
 }
@@ -0,0 +1,82 @@
+#pragma once
+#ifndef GEODESUKA_CORE_GCL_EXTERNAL_H
+#define GEODESUKA_CORE_GCL_EXTERNAL_H
+
+/*
+* Usage:
+*	Allows a buffer or image allocated by one context to be used by another
+*	context on the same physical device without a host copy. Both contexts must
+*	be created with VK_KHR_external_memory_fd and VK_KHR_external_semaphore_fd
+*	enabled, exports and imports fail without them. The producing context
+*	exports, the consuming context imports. external_memory owns its file
+*	descriptor and closes it on destruction, a successful import consumes it.
+*	Both types are move only.
+*
+*	Access between contexts is synchronized with external semaphores. The producer
+*	signals an exportable semaphore after its last write, exports it, and the
+*	consumer waits on the imported semaphore before first use.
+*
+*	Resources are VK_SHARING_MODE_EXCLUSIVE, so ownership also moves through
+*	VK_QUEUE_FAMILY_EXTERNAL at every handoff. The producer submits the command
+*	buffer from release_external() in the batch that signals the semaphore, the
+*	consumer submits the one from acquire_external() in the batch that waits.
+*		Producer: vkCmd...(Image), Image.release_external(qfs), signal Semaphore.
+*		Consumer: wait Semaphore, Image.acquire_external(qfs), vkCmd...(Image).
+*
+*	Only opaque POSIX file descriptors are supported, on Windows the extensions
+*	are never loaded, so every export and import fails.
+*/
+
+#include "../gcl.h"
+
+namespace geodesuka::core::gcl {
+
+	class context;
+
+	struct external_memory {
+		int FD;								// Opaque POSIX file descriptor, -1 if invalid.
+		VkDeviceSize AllocationSize;		// Must match on import.
+		uint32_t MemoryTypeIndex;			// Must match on import.
+		VkBool32 Dedicated;					// Allocation was dedicated to a single resource.
+		VkImageLayout Layout;				// Images only, layout of all subresources when exported.
+		uint8_t DeviceUUID[VK_UUID_SIZE];	// Physical device the memory was allocated on.
+
+		external_memory();
+		~external_memory();
+
+		external_memory(const external_memory& aInput) = delete;
+		external_memory(external_memory&& aInput) noexcept;
+		external_memory& operator=(const external_memory& aRhs) = delete;
+		external_memory& operator=(external_memory&& aRhs) noexcept;
+	};
+
+	class external_semaphore {
+	public:
+
+		external_semaphore();
+		// Creates an exportable semaphore.
+		external_semaphore(context* aContext);
+		// Imports semaphore payload, takes ownership of aFD on success.
+		external_semaphore(context* aContext, int aFD);
+		~external_semaphore();
+
+		external_semaphore(const external_semaphore& aInput) = delete;
+		external_semaphore(external_semaphore&& aInput) noexcept;
+		external_semaphore& operator=(const external_semaphore& aRhs) = delete;
+		external_semaphore& operator=(external_semaphore&& aRhs) noexcept;
+
+		// Exports semaphore payload, caller owns file descriptor. -1 on failure.
+		int export_fd();
+
+		VkSemaphore& handle();
+
+	private:
+
+		context* Context;
+		VkSemaphore Handle;
+
+	};
+
+}
+
+#endif // !GEODESUKA_CORE_GCL_EXTERNAL_H
@@ -6,6 +6,7 @@
 
 #include "device.h"
 #include "context.h"
+#include "external.h"
 
 #include "buffer.h"
 
@@ -15,10 +16,13 @@ namespace geodesuka::core::object {
 
 namespace geodesuka::core::gcl {
 
+	class ownership_transfer;
+
 	class image {
 	public:
 
 		friend class buffer;
+		friend class ownership_transfer;
 		friend class object::system_window;
 
 		enum sample {
@@ -94,9 +98,15 @@ namespace geodesuka::core::gcl {
 		// Will yield the number of bits per pixel.
 		static size_t bytesperpixel(VkFormat aFormat);
 		static size_t bitsperpixel(VkFormat aFormat);
+		// Depth and/or stencil aspects of depth formats, color otherwise.
+		static VkImageAspectFlags aspect(VkFormat aFormat);
 
 		image();
 		image(context *aContext, int aMemoryType, prop aProperty, int aFormat, int aWidth, int aHeight, int aDepth, void *aTextureData);
+		// Allocates memory which can be exported to other contexts on the same device.
+		image(context *aContext, int aMemoryType, prop aProperty, int aFormat, int aWidth, int aHeight, int aDepth, void *aTextureData, bool aExportable);
+		// Imports memory exported by another context. Properties must match the exporting image, aMemory.FD is consumed on success.
+		image(context *aContext, prop aProperty, int aFormat, int aWidth, int aHeight, int aDepth, external_memory& aMemory);
 		~image();
 		
 		// Copy Constructor.
@@ -127,6 +137,16 @@ namespace geodesuka::core::gcl {
 
 		// MipIndex, ArrayLayer
 
+		// Exports memory of an exportable image, returned object owns the FD. FD = -1 on failure.
+		// All subresources must share the same layout.
+		external_memory export_memory();
+		// Releases image from aQFS, its owner, to VK_QUEUE_FAMILY_EXTERNAL, layouts are kept.
+		// Submit on aQFS in the same batch that signals the exported semaphore.
+		VkCommandBuffer release_external(device::qfs aQFS);
+		// Acquires image from VK_QUEUE_FAMILY_EXTERNAL on aQFS in its current layouts.
+		// Submit on aQFS waiting on the imported semaphore, before first use.
+		VkCommandBuffer acquire_external(device::qfs aQFS);
+
 		// Generates image views from texture instance. (YOU ARE RESPONSIBLE FOR DESTROYING VIEWS)
 		VkImageView view();
 		//VkImageView view(VkImageViewType aType, VkImageSubresourceRange aRange);
@@ -145,6 +165,8 @@ namespace geodesuka::core::gcl {
 		VkMemoryAllocateInfo AllocateInfo{};
 		VkDeviceMemory MemoryHandle;
 		int MemoryType;
+		int Owner; // Queue family index which owns the image, -1 if unowned.
+		bool isExportable;
 		size_t BytesPerPixel;
 		size_t MemorySize; // Size of the image
 
@@ -152,6 +174,7 @@ namespace geodesuka::core::gcl {
 		VkExtent3D* MipExtent; // TODO: Fill out MipExtent for easier blitting.
 
 		uint32_t miplevelcalc(VkImageType aImageType, VkExtent3D aExtent);
+		VkCommandBuffer external_barrier(device::qfs aQFS, uint32_t aSrcQFI, uint32_t aDstQFI);
 		void pmclearall();
 
 	};
@@ -0,0 +1,66 @@
+#pragma once
+#ifndef GEODESUKA_CORE_GCL_LAYOUT_CACHE_H
+#define GEODESUKA_CORE_GCL_LAYOUT_CACHE_H
+
+/*
+* Usage:
+*	Per context cache of descriptor set layouts and pipeline layouts. Identical
+*	layouts requested by different objects resolve to the same handle. Handles
+*	are owned by the cache and live until the context is destroyed, do not
+*	destroy them.
+*
+*	merge() builds layouts straight from shader reflection. Bindings used by
+*	several stages are merged into one binding with combined stage flags. Push
+*	constant blocks are merged into one range visible to all stages using them.
+*	Unused set indices below the highest used set receive an empty layout.
+*
+*	Immutable samplers are not part of the cache key and are not supported.
+*/
+
+#include <vector>
+#include <map>
+#include <string>
+#include <mutex>
+
+#include "../gcl.h"
+
+namespace geodesuka::core::gcl {
+
+	class context;
+	class shader;
+
+	class layout_cache {
+	public:
+
+		struct layout {
+			VkPipelineLayout					Handle;
+			std::vector<VkDescriptorSetLayout>	SetLayout;
+			std::vector<VkPushConstantRange>	PushConstantRange;
+			layout();
+		};
+
+		layout_cache(context* aContext);
+		~layout_cache();
+
+		// Returns cached descriptor set layout, created on first request.
+		VkDescriptorSetLayout set_layout(uint32_t aBindingCount, const VkDescriptorSetLayoutBinding* aBinding);
+
+		// Returns cached pipeline layout, created on first request.
+		VkPipelineLayout pipeline_layout(uint32_t aSetLayoutCount, const VkDescriptorSetLayout* aSetLayout, uint32_t aRangeCount, const VkPushConstantRange* aRange);
+
+		// Merges reflection of all stages into a pipeline layout. Fails with
+		// VK_ERROR_INITIALIZATION_FAILED if stages disagree on a binding.
+		VkResult merge(uint32_t aShaderCount, shader** aShader, layout& aLayout);
+
+	private:
+
+		context* Context;
+		std::mutex Mutex;
+		std::map<std::string, VkDescriptorSetLayout> SetLayout;
+		std::map<std::string, VkPipelineLayout> PipelineLayout;
+
+	};
+
+}
+
+#endif // !GEODESUKA_CORE_GCL_LAYOUT_CACHE_H
@@ -0,0 +1,95 @@
+#pragma once
+#ifndef GEODESUKA_CORE_GCL_OWNERSHIP_TRANSFER_H
+#define GEODESUKA_CORE_GCL_OWNERSHIP_TRANSFER_H
+
+/*
+* Usage:
+*	Resources are created with VK_SHARING_MODE_EXCLUSIVE, so a buffer or image
+*	written on the transfer queue family must be released by that family and
+*	acquired by the family that will consume it. This class batches the release
+*	and acquire barrier pairs of many resources into one command buffer per side,
+*	and ties them together with a semaphore.
+*
+*	The release submission must be submitted before the acquire submission, and
+*	the release submission should follow the commands that wrote the resources
+*	in submission order on the same queue (i.e. same vkQueueSubmit call).
+*
+*	Owner and layouts of the added resources are only updated by commit(), call
+*	it once both submissions have executed successfully.
+*
+*	If both queue family indices are the same, no ownership transfer is required.
+*	Only layout transitions are recorded on the acquire side in that case.
+*	Resources not yet owned by any family (Owner == -1) are not transferred,
+*	buffers are skipped and images only get their layout transition.
+*/
+
+#include <vector>
+
+#include "../gcl.h"
+
+#include "device.h"
+#include "context.h"
+
+namespace geodesuka::core::gcl {
+
+	class buffer;
+	class image;
+
+	class ownership_transfer {
+	public:
+
+		ownership_transfer();
+		ownership_transfer(context* aContext, device::qfs aSrcQFS, VkPipelineStageFlags aSrcStage, device::qfs aDstQFS, VkPipelineStageFlags aDstStage);
+		~ownership_transfer();
+
+		// Returns true if source and destination queue families differ.
+		bool is_required();
+
+		// Queues a buffer for transfer to destination queue family.
+		void add(buffer& aBuffer, VkAccessFlags aSrcAccess, VkAccessFlags aDstAccess);
+		// Queues all defined subresources of an image, transitions them to aNewLayout.
+		void add(image& aImage, VkImageLayout aNewLayout, VkAccessFlags aSrcAccess, VkAccessFlags aDstAccess);
+
+		// Records release barriers into a command buffer of the source family.
+		void release(VkCommandBuffer aCommandBuffer);
+		// Records acquire barriers into a command buffer of the destination family.
+		void acquire(VkCommandBuffer aCommandBuffer);
+
+		// Records release and acquire OTS command buffers, and creates the semaphore pairing them.
+		VkResult build();
+
+		// Sets owner and layouts of added resources, call after both submissions succeeded.
+		void commit();
+
+		// Release submission, signals semaphore. Append to source family batch.
+		VkSubmitInfo release();
+		// Acquire submission, waits on semaphore. Append to destination family batch.
+		VkSubmitInfo acquire();
+
+	private:
+
+		context* Context;
+
+		device::qfs SrcQFS;
+		device::qfs DstQFS;
+		int SrcQFI;
+		int DstQFI;
+		VkPipelineStageFlags SrcStage;
+		VkPipelineStageFlags DstStage;
+
+		std::vector<VkBufferMemoryBarrier> BufferBarrier;
+		std::vector<VkImageMemoryBarrier> ImageBarrier;
+
+		// Resources whose state is applied by commit().
+		std::vector<buffer*> Buffer;
+		std::vector<image*> Image;
+		std::vector<image*> ImageTarget;		// Image of each ImageBarrier.
+
+		VkCommandBuffer CommandBuffer[2];
+		VkSemaphore Semaphore;
+
+	};
+
+}
+
+#endif // !GEODESUKA_CORE_GCL_OWNERSHIP_TRANSFER_H
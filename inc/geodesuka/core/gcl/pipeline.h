@@ -2,12 +2,22 @@
 #ifndef GEODESUKA_CORE_GCL_PIPELINE_H
 #define GEODESUKA_CORE_GCL_PIPELINE_H
 
+/*
+* Usage:
+*	Graphics pipeline shared through the context pipeline state cache. Fixed
+*	function state defaults to filled triangle lists without culling, one
+*	sample, no depth test, dynamic viewport and scissor, and a single opaque
+*	color attachment. Vertices are pulled by the shaders, no vertex input is
+*	declared.
+*/
+
 #include "../gcl.h"
 
 #include "device.h"
 #include "context.h"
 #include "shader.h"
 #include "renderpass.h"
+#include "layout_cache.h"
 
 namespace geodesuka::core::gcl {
 
@@ -17,7 +27,7 @@ namespace geodesuka::core::gcl {
 		// Compute Pipeline
 		
 		pipeline();
-		// Graphics Pipeline
+		// Graphics Pipeline, zero aDSLCount derives the layout from shader reflection.
 		pipeline(
 			context* aContext,
 			uint32_t aShaderCount, shader* aShader,
@@ -25,8 +35,17 @@ namespace geodesuka::core::gcl {
 			renderpass& aRenderPass, uint32_t aSubpassIndex
 		);
 
+		// Owns its stage array and a pipeline reference.
+		pipeline(const pipeline&) = delete;
+		pipeline& operator=(const pipeline&) = delete;
+
 		~pipeline();
 
+		bool is_valid();
+
+		VkPipeline handle();
+		VkPipelineLayout layout();
+
 	protected:
 
 		context* Context;
@@ -34,8 +53,7 @@ namespace geodesuka::core::gcl {
 		uint32_t ShaderCount;
 		shader* Shader;
 
-		VkDescriptorPoolCreateInfo DescriptorPoolCreateInfo{};
-		VkDescriptorPool DescriptorPool;
+		// Descriptor sets are allocated by the owner through a descriptor_allocator.
 
 		// Graphics Options.
 		VkGraphicsPipelineCreateInfo			GraphicsCreateInfo{};
@@ -50,13 +68,16 @@ namespace geodesuka::core::gcl {
 		VkPipelineDepthStencilStateCreateInfo	DepthStencil{};
 		VkPipelineColorBlendStateCreateInfo		ColorBlend{};
 		VkPipelineDynamicStateCreateInfo		DynamicState{};
+		VkPipelineColorBlendAttachmentState		ColorBlendAttachment{};
+		VkDynamicState							DynamicStateList[2];
 
 		// Compute Options.
 		//VkComputePipelineCreateInfo				ComputeCreateInfo{};
 
-		VkPipelineLayoutCreateInfo				LayoutCreateInfo{};
-		VkPipelineLayout						Layout;
+		// Owned by context layout cache.
+		layout_cache::layout					Layout;
 
+		// Owned by context pipeline state cache.
 		VkPipeline Handle;
 
 		void gdefault();
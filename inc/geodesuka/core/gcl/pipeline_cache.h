@@ -0,0 +1,86 @@
+#pragma once
+#ifndef GEODESUKA_CORE_GCL_PIPELINE_CACHE_H
+#define GEODESUKA_CORE_GCL_PIPELINE_CACHE_H
+
+/*
+* Usage:
+*	Persistent VkPipelineCache of a context. Loaded from disk when the context is
+*	created and saved when it is destroyed. One file per physical device, named
+*	after vendor and device id. Saved data carries its own header and checksum,
+*	and the driver header (vendor, device, pipelineCacheUUID) is checked against
+*	the physical device before the data is handed to the driver. Rejected data
+*	is discarded and the cache starts empty. Saving merges with whatever is on
+*	disk at that time, so contexts sharing a device do not drop each others work.
+*
+*	Pass handle() to every vkCreate*Pipelines call. VkPipelineCache is internally
+*	synchronized, but threads creating many pipelines at once can use their own
+*	worker cache to avoid contention, then merge() it back when done.
+*
+*	Disk persistence is off until the application opts in with set_directory(),
+*	pick a per user cache directory. Until then the cache only lives as long as
+*	its context. NULL disables it again.
+*/
+
+#include <stdint.h>
+
+#include <vector>
+#include <string>
+#include <mutex>
+
+#include "../gcl.h"
+
+namespace geodesuka::core::gcl {
+
+	class context;
+
+	class pipeline_cache {
+	public:
+
+		pipeline_cache(context* aContext);
+		~pipeline_cache();
+
+		VkPipelineCache handle();
+
+		// Creates an empty cache for a worker thread.
+		VkPipelineCache create_worker();
+
+		// Merges worker caches into main cache and destroys them.
+		VkResult merge(uint32_t aWorkerCount, VkPipelineCache* aWorker);
+
+		// Merges with the cache on disk and writes it back, called on destruction.
+		VkResult save();
+
+		// Sets directory used by caches created afterwards, NULL disables persistence.
+		static void set_directory(const char* aDirectory);
+
+		// Reads a saved cache, empty and deleted if damaged or not made by this device.
+		static std::vector<uint8_t> load(const std::string& aPath, const VkPhysicalDeviceProperties& aProperties);
+
+		// Writes driver cache data with header and checksum, replaces aPath atomically.
+		static bool write(const std::string& aPath, const std::vector<uint8_t>& aData);
+
+		// Checks driver header of cache data against a physical device.
+		static bool is_compatible(const std::vector<uint8_t>& aData, const VkPhysicalDeviceProperties& aProperties);
+
+	private:
+
+		struct header {
+			uint32_t Magic;
+			uint32_t Version;
+			uint64_t DataSize;
+			uint64_t Checksum;
+		};
+
+		static std::mutex DirectoryMutex;
+		static std::string Directory;
+		static uint32_t TemporaryCount;
+
+		context* Context;
+		std::string Path;
+		VkPipelineCache Handle;
+
+	};
+
+}
+
+#endif // !GEODESUKA_CORE_GCL_PIPELINE_CACHE_H
@@ -0,0 +1,120 @@
+#pragma once
+#ifndef GEODESUKA_CORE_GCL_PIPELINE_STATE_CACHE_H
+#define GEODESUKA_CORE_GCL_PIPELINE_STATE_CACHE_H
+
+/*
+* Usage:
+*	Per context table of shared pipelines. Objects describe their pipeline with
+*	the usual create info and acquire() it, identical state resolves to the same
+*	VkPipeline. The key covers shader module contents, entry points, specialization data,
+*	vertex layout, all fixed function state, dynamic state list, pipeline layout,
+*	render pass and subpass. Render passes are compared by handle, shared render
+*	passes therefore share pipelines. Dynamic rendering pipelines are keyed by
+*	their VkPipelineRenderingCreateInfoKHR attachment formats instead.
+*
+*	Modules are keyed by a 64 bit hash of their SPIR-V, registered by gcl::shader
+*	with identify(), so objects with their own modules of the same shader still
+*	share pipelines. Modules created elsewhere are keyed by handle.
+*
+*	Pipelines are reference counted, release() each acquired pipeline once.
+*	Unreferenced pipelines stay cached until trim(), which must only be called
+*	when no command buffer using them is pending. Remaining pipelines are
+*	destroyed with the context.
+*
+*	Lookups are thread safe. If two threads request the same missing pipeline,
+*	one creates it and the other waits for the result. Create infos with any other
+*	pNext chain are not keyed and always create a new pipeline.
+*
+*	If the context has VK_EXT_graphics_pipeline_library enabled, graphics
+*	pipelines are linked from four independently cached parts: vertex input,
+*	pre-rasterization shaders, fragment shader and fragment output. A new
+*	combination of known parts only costs a fast link. Linking is done without
+*	link time optimization unless the create info flags request it. Parts live
+*	until the context is destroyed. Without the extension, or if linking fails,
+*	pipelines are created monolithically.
+*/
+
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <string>
+#include <mutex>
+#include <condition_variable>
+
+#include "../gcl.h"
+
+namespace geodesuka::core::gcl {
+
+	class context;
+
+	class pipeline_state_cache {
+	public:
+
+		pipeline_state_cache(context* aContext);
+		~pipeline_state_cache();
+
+		// Returns shared pipeline for create info, VK_NULL_HANDLE on failure.
+		VkPipeline acquire(const VkGraphicsPipelineCreateInfo& aCreateInfo);
+		VkPipeline acquire(const VkComputePipelineCreateInfo& aCreateInfo);
+
+		void release(VkPipeline aPipeline);
+
+		// Destroys pipelines without references.
+		void trim();
+
+		// Number of distinct pipelines held.
+		size_t size();
+
+		// Number of cached pipeline library parts.
+		size_t library_count();
+
+		// Keys aModule by its code from now on, forget() it before destroying it.
+		void identify(VkShaderModule aModule, size_t aWordCount, const uint32_t* aWord);
+		void forget(VkShaderModule aModule);
+
+	private:
+
+		// Graphics pipeline library parts, in link order.
+		enum part : int {
+			VERTEX_INPUT,
+			PRE_RASTERIZATION,
+			FRAGMENT_SHADER,
+			FRAGMENT_OUTPUT,
+			COUNT
+		};
+
+		struct entry {
+			VkPipeline Handle;
+			uint32_t ReferenceCount;
+			bool isReady;
+		};
+
+		context* Context;
+		std::mutex Mutex;
+		std::condition_variable Condition;
+		std::unordered_map<std::string, entry> Entry;
+		std::map<VkPipeline, std::string> Key;
+		uint64_t UncachedCount;
+		bool isLibraryEnabled;
+		std::unordered_map<std::string, VkPipeline> Library;
+
+		// Code hash of each registered module.
+		std::mutex ModuleMutex;
+		std::map<VkShaderModule, uint64_t> Module;
+
+		VkPipeline acquire(const std::string& aKey, const VkGraphicsPipelineCreateInfo* aGraphics, const VkComputePipelineCreateInfo* aCompute, bool aLinkable);
+
+		// Links pipeline from cached library parts, VK_NULL_HANDLE on failure.
+		VkPipeline link(const VkGraphicsPipelineCreateInfo& aCreateInfo, VkPipelineCache aCache);
+		VkPipeline library(const VkGraphicsPipelineCreateInfo& aCreateInfo, part aPart, VkPipelineCache aCache);
+
+		bool key_of(const VkGraphicsPipelineCreateInfo& aCreateInfo, std::string& aKey);
+		bool key_of(const VkGraphicsPipelineCreateInfo& aCreateInfo, part aPart, std::string& aKey);
+		bool key_of(const VkComputePipelineCreateInfo& aCreateInfo, std::string& aKey);
+		bool key_of(const VkPipelineShaderStageCreateInfo& aStage, std::string& aKey);
+
+	};
+
+}
+
+#endif // !GEODESUKA_CORE_GCL_PIPELINE_STATE_CACHE_H
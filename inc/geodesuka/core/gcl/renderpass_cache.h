@@ -0,0 +1,87 @@
+#pragma once
+#ifndef GEODESUKA_CORE_GCL_RENDERPASS_CACHE_H
+#define GEODESUKA_CORE_GCL_RENDERPASS_CACHE_H
+
+/*
+* Usage:
+*	Per context table of shared render passes and framebuffers, see
+*	context::renderpasses(). Many objects drawing to the same rendertarget
+*	describe the same render pass, acquire() resolves them to one handle.
+*
+*	Render passes are keyed by attachment formats, sample counts, load/store
+*	ops, layouts, subpasses and dependencies. They stay cached until the
+*	context is destroyed even when unreferenced, because pipelines are keyed by
+*	render pass handle. Framebuffers are keyed by render pass, image views and
+*	extent, and are destroyed when their last reference is released.
+*
+*	Every acquire() must be matched by one release(). A rendertarget calls
+*	invalidate() with its old image views before it destroys or replaces them,
+*	for example on resize. Framebuffers built on those views are no longer
+*	returned and are destroyed once their holders release them, holders then
+*	acquire new ones for the new views.
+*
+*	Create infos with a pNext chain are not keyed, they get a private handle.
+*/
+
+#include <vector>
+#include <map>
+#include <string>
+#include <mutex>
+
+#include "../gcl.h"
+
+namespace geodesuka::core::gcl {
+
+	class context;
+
+	class renderpass_cache {
+	public:
+
+		renderpass_cache(context* aContext);
+		~renderpass_cache();
+
+		// Returns shared handle for create info, VK_NULL_HANDLE on failure.
+		VkRenderPass acquire(const VkRenderPassCreateInfo& aCreateInfo);
+		VkFramebuffer acquire(const VkFramebufferCreateInfo& aCreateInfo);
+
+		void release(VkRenderPass aRenderPass);
+		void release(VkFramebuffer aFramebuffer);
+
+		// Retires all framebuffers using any of the image views.
+		void invalidate(uint32_t aImageViewCount, const VkImageView* aImageView);
+
+		// Number of distinct handles held.
+		size_t renderpass_count();
+		size_t framebuffer_count();
+
+	private:
+
+		struct renderpass_entry {
+			VkRenderPass Handle;
+			uint32_t ReferenceCount;
+			bool isShared;
+		};
+
+		struct framebuffer_entry {
+			VkFramebuffer Handle;
+			uint32_t ReferenceCount;
+			std::vector<VkImageView> View;
+		};
+
+		context* Context;
+		std::mutex Mutex;
+		uint64_t UncachedCount;
+		std::map<std::string, renderpass_entry> RenderPass;
+		std::map<VkRenderPass, std::string> RenderPassKey;
+		std::map<std::string, framebuffer_entry> Framebuffer;
+		std::map<VkFramebuffer, std::string> FramebufferKey;
+		std::map<VkFramebuffer, uint32_t> Retired;				// Invalidated, destroyed at zero references.
+
+		static bool key_of(const VkRenderPassCreateInfo& aCreateInfo, std::string& aKey);
+		static bool key_of(const VkFramebufferCreateInfo& aCreateInfo, std::string& aKey);
+
+	};
+
+}
+
+#endif // !GEODESUKA_CORE_GCL_RENDERPASS_CACHE_H
@@ -3,9 +3,12 @@
 #define GEODESUKA_CORE_GCL_SHADER_H
 
 #include <vector>
+#include <string>
+#include <mutex>
 
 #include "device.h"
 #include "context.h"
+#include "shader_reflection.h"
 
 #include "../io/file.h"
 
@@ -15,6 +18,7 @@ namespace geodesuka::core::gcl {
 	public:
 
 		friend class engine;
+		friend class shader_compiler;
 
 		enum stage {
 			UNKNOWN,
@@ -31,6 +35,12 @@ namespace geodesuka::core::gcl {
 		// Create a shader from provided source string.
 		shader(context* aDeviceContext, stage aStage, const char* aSource);
 
+		// Create a shader from provided source string, with a list of defines ("NAME" or "NAME=VALUE").
+		shader(context* aDeviceContext, stage aStage, const char* aSource, uint32_t aDefineCount, const char** aDefineList);
+
+		// Create a shader from SPIR-V binary, rejected if malformed or entry point does not match stage.
+		shader(context* aDeviceContext, stage aStage, size_t aWordCount, const uint32_t* aWord);
+
 		// Use for compiling a shader object and creating it.
 		shader(context* aDeviceContext, const char* aFilePath);
 
@@ -46,13 +56,27 @@ namespace geodesuka::core::gcl {
 		VkShaderStageFlagBits get_stage();
 		VkShaderModule get_handle();
 
+		// Returns false if compilation or module creation failed.
+		bool is_valid();
+		// Compiler messages, empty on success.
+		const char* get_log();
+		// Resource interface of compiled binary.
+		const shader_reflection& get_reflection();
+
 		VkPipelineShaderStageCreateInfo stageci();
 
 	private:
 
+		// glslang process state is initialized once, regardless of how many times called.
+		static std::mutex ProcessMutex;
+		static int ProcessCount;
+
 		static bool initialize();
 		static void terminate();
 
+		// Structural check of SPIR-V binary before module creation.
+		static bool validate(stage aStage, size_t aWordCount, const uint32_t* aWord, std::string& aLog);
+
 		io::file* FileHandle;						// Reference Asset File.
 		context* ParentDC;					// Parent Device Context of this Shader
 
@@ -60,7 +84,9 @@ namespace geodesuka::core::gcl {
 		VkShaderStageFlagBits VkStage;
 
 		bool isValid;
+		std::string Log;							// Compiler info log.
 		std::vector<unsigned int> Binary;			// Compiled SPIRV Binary
+		shader_reflection Reflection;				// Reflected resource interface.
 		VkShaderModuleCreateInfo CreateInfo{};		// Creation Info
 		VkShaderModule Handle;						// Simple Handle
 
@@ -0,0 +1,82 @@
+#pragma once
+#ifndef GEODESUKA_CORE_GCL_SHADER_CACHE_H
+#define GEODESUKA_CORE_GCL_SHADER_CACHE_H
+
+/*
+* Usage:
+*	Content addressed cache of compiled SPIR-V, used by shader to skip glslang
+*	when an identical source has already been compiled. Entries are keyed by a
+*	hash of the stage, source, define list, and compiler version string.
+*
+*	There are two tiers. The memory tier is bounded by a byte budget, the least
+*	recently used entries are evicted once it is exceeded. The disk tier is a
+*	directory of files named after the hash. Disk entries are written to a
+*	temporary file first, then renamed into place so readers never see a partial
+*	file. Entries with a bad header or checksum are treated as a miss and deleted.
+*
+*	Disk tier is off until the application opts in with set_directory(), pick a
+*	per user cache directory. NULL disables it again.
+*/
+
+#include <stdint.h>
+
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <string>
+#include <mutex>
+
+namespace geodesuka::core::gcl {
+
+	class shader_cache {
+	public:
+
+		// Hashes everything that affects the compiled output.
+		static uint64_t hash(int aStage, const char* aSource, uint32_t aDefineCount, const char** aDefineList, const char* aCompilerVersion);
+
+		// Sets directory of the disk tier, NULL disables it.
+		static void set_directory(const char* aDirectory);
+
+		// Sets byte budget of the memory tier, evicts immediately if exceeded.
+		static void set_budget(size_t aBytes);
+
+		// Searches memory tier then disk tier. Returns true on hit.
+		static bool load(uint64_t aHash, std::vector<unsigned int>& aBinary);
+
+		// Stores in memory tier and disk tier.
+		static void store(uint64_t aHash, const std::vector<unsigned int>& aBinary);
+
+		// Clears memory tier only.
+		static void clear();
+
+	private:
+
+		struct header {
+			uint32_t Magic;
+			uint32_t Version;
+			uint64_t Hash;
+			uint64_t WordCount;
+			uint64_t Checksum;
+		};
+
+		typedef std::list<std::pair<uint64_t, std::vector<unsigned int>>> entry_list;
+
+		static std::mutex Mutex;
+		static entry_list Recent;			// Most recently used first.
+		static std::unordered_map<uint64_t, entry_list::iterator> Memory;
+		static size_t MemorySize;
+		static size_t MemoryBudget;
+		static std::string Directory;
+		static uint32_t TemporaryCount;
+
+		static uint64_t fnv1a(uint64_t aHash, const void* aData, size_t aSize);
+		static std::string path(uint64_t aHash);
+		// Memory tier, Mutex must be held.
+		static void insert(uint64_t aHash, const std::vector<unsigned int>& aBinary);
+		static void evict();
+
+	};
+
+}
+
+#endif // !GEODESUKA_CORE_GCL_SHADER_CACHE_H
@@ -0,0 +1,69 @@
+#pragma once
+#ifndef GEODESUKA_CORE_GCL_SHADER_COMPILER_H
+#define GEODESUKA_CORE_GCL_SHADER_COMPILER_H
+
+/*
+* Usage:
+*	Compiles shaders on a pool of worker threads. Each submitted source returns
+*	a future to a newly allocated shader, which the caller owns once retrieved.
+*	Compilation errors are reported per shader, check is_valid() and get_log()
+*	on the result. A shader that fails to compile does not affect the rest of
+*	the batch.
+*
+*	Sources and define lists are copied on submission, the caller does not
+*	need to keep them alive. The context must outlive all pending futures.
+*
+*	The engine owns one compiler for its lifetime, see engine::get_shader_compiler().
+*	Destruction waits for all queued jobs to finish.
+*/
+
+#include <vector>
+#include <deque>
+#include <string>
+#include <future>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "shader.h"
+
+namespace geodesuka::core::gcl {
+
+	class shader_compiler {
+	public:
+
+		struct source {
+			shader::stage Stage;
+			const char* Source;
+			uint32_t DefineCount;
+			const char** DefineList;
+		};
+
+		// Zero thread count uses hardware concurrency.
+		shader_compiler(uint32_t aThreadCount);
+		~shader_compiler();
+
+		// Queues a single shader for compilation.
+		std::future<shader*> compile(context* aContext, shader::stage aStage, const char* aSource, uint32_t aDefineCount, const char** aDefineList);
+
+		// Queues a batch, futures are returned in the same order as aSourceList.
+		std::vector<std::future<shader*>> compile(context* aContext, size_t aSourceCount, const source* aSourceList);
+
+		uint32_t get_thread_count();
+
+	private:
+
+		bool isReady;
+		std::mutex Mutex;
+		std::condition_variable Condition;
+		bool Shutdown;
+		std::deque<std::packaged_task<shader*()>> Job;
+		std::vector<std::thread> Worker;
+
+		void work();
+
+	};
+
+}
+
+#endif // !GEODESUKA_CORE_GCL_SHADER_COMPILER_H
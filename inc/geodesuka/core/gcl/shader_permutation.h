@@ -0,0 +1,119 @@
+#pragma once
+#ifndef GEODESUKA_CORE_GCL_SHADER_PERMUTATION_H
+#define GEODESUKA_CORE_GCL_SHADER_PERMUTATION_H
+
+/*
+* Usage:
+*	Manages variants of a single shader source. Features are declared once,
+*	each gets a bit in a 64 bit feature mask. A feature is either a define,
+*	which selects a separately compiled module, or a specialization constant,
+*	which reuses the same module and is set through VkSpecializationInfo.
+*
+*	Prefer specialization constants for feature flags, they do not multiply
+*	the number of compiled binaries.
+*
+*	shader_permutation Lit(Context, shader::stage::FRAGMENT, Source);
+*	int Shadow		= Lit.add_define("SHADOW");
+*	int Fog			= Lit.add_constant("Fog", 0);		// layout (constant_id = 0) const bool Fog = false;
+*	shader_permutation::variant* V = Lit.acquire((1ull << Shadow) | (1ull << Fog));
+*	VkPipelineShaderStageCreateInfo Stage = V->stageci();
+*	...
+*	Lit.release(V);
+*
+*	Declare every feature before the first acquire, add_define() and
+*	add_constant() fail once variants exist, until trim() has removed them all.
+*
+*	Modules are compiled lazily on first acquire, and deduplicated by a hash of
+*	their define list. Compilation runs outside the lock, so threads acquiring
+*	different variants compile in parallel. Each variant counts its users, so
+*	usage() reports which permutations are actually used by live pipelines and
+*	trim() frees the rest.
+*/
+
+#include <stdint.h>
+
+#include <vector>
+#include <map>
+#include <string>
+#include <mutex>
+
+#include "shader.h"
+
+namespace geodesuka::core::gcl {
+
+	class shader_permutation {
+	public:
+
+		class variant {
+		public:
+
+			friend class shader_permutation;
+
+			uint64_t Feature;
+			shader* Shader;
+
+			// Stage create info with specialization info attached.
+			VkPipelineShaderStageCreateInfo stageci();
+
+		private:
+
+			uint32_t UseCount;
+			std::vector<VkSpecializationMapEntry> MapEntry;
+			std::vector<VkBool32> Data;
+			VkSpecializationInfo SpecializationInfo{};
+
+		};
+
+		struct usage {
+			uint64_t Feature;
+			uint32_t UseCount;
+		};
+
+		shader_permutation(context* aContext, shader::stage aStage, const char* aSource);
+		~shader_permutation();
+
+		// Declares a define feature, returns its bit index or -1 if all bits are taken
+		// or variants already exist.
+		int add_define(const char* aName);
+
+		// Declares a boolean specialization constant feature, returns its bit index or -1.
+		int add_constant(const char* aName, uint32_t aConstantID);
+
+		// Returns variant for feature mask, compiles module on first use. nullptr if compilation failed.
+		variant* acquire(uint64_t aFeature);
+		void release(variant* aVariant);
+
+		// Snapshot of all variants created so far and their current users.
+		std::vector<usage> usage_list();
+
+		// Destroys variants and modules without users.
+		void trim();
+
+		// Number of distinct compiled modules.
+		size_t module_count();
+
+	private:
+
+		struct feature {
+			std::string Name;
+			bool isConstant;
+			uint32_t ConstantID;
+		};
+
+		std::mutex Mutex;
+		context* Context;
+		shader::stage Stage;
+		std::string Source;
+		std::vector<feature> Feature;
+		uint64_t DefineMask;
+		std::map<uint64_t, variant*> Variant;		// Keyed by full feature mask.
+		std::map<uint64_t, shader*> Module;			// Keyed by hash of define list.
+		std::map<uint64_t, uint32_t> ModuleUseCount;
+
+		uint64_t module_key(uint64_t aFeature, std::vector<const char*>& aDefineList);
+
+	};
+
+}
+
+#endif // !GEODESUKA_CORE_GCL_SHADER_PERMUTATION_H
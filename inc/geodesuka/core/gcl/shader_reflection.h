@@ -0,0 +1,82 @@
+#pragma once
+#ifndef GEODESUKA_CORE_GCL_SHADER_REFLECTION_H
+#define GEODESUKA_CORE_GCL_SHADER_REFLECTION_H
+
+/*
+* Usage:
+*	Reflects the resource interface of a SPIR-V module. Reads the binary directly,
+*	so it works for freshly compiled and cached binaries alike. Every shader
+*	reflects itself after compilation, see shader::get_reflection().
+*
+*	Sizes and offsets are taken from the SPIR-V decorations (std140/std430/scalar
+*	as compiled). The util::variable trees describe names, types and array sizes,
+*	their own offsets are packed and should not be used for buffer layout.
+*
+*	Runtime sized arrays report a descriptor count of zero.
+*	Specialization constants (array lengths, work group size) resolve to their
+*	default values, values overridden at pipeline creation are not seen here.
+*/
+
+#include <stdint.h>
+
+#include <vector>
+#include <string>
+
+#include "../gcl.h"
+
+#include "../util/variable.h"
+
+namespace geodesuka::core::gcl {
+
+	class shader_reflection {
+	public:
+
+		// Descriptor set resource.
+		struct binding {
+			uint32_t			Set;
+			uint32_t			Binding;
+			VkDescriptorType	Type;
+			uint32_t			Count;			// Array size, zero if runtime sized.
+			VkShaderStageFlags	Stage;
+			uint32_t			Size;			// Block size in bytes, buffers only.
+			std::string			Name;
+			util::variable		Variable;		// Block layout, buffers only.
+		};
+
+		// Push constant block.
+		struct push_constant {
+			VkShaderStageFlags	Stage;
+			uint32_t			Offset;			// Offset of first member.
+			uint32_t			Size;			// Size from Offset to end of last member.
+			std::string			Name;
+			util::variable		Variable;
+		};
+
+		// Stage input or output, matrices occupy one location per column.
+		struct attribute {
+			uint32_t			Location;
+			VkFormat			Format;
+			uint32_t			Size;
+			std::string			Name;
+			util::variable		Variable;
+		};
+
+		VkShaderStageFlagBits		Stage;
+		std::vector<binding>		Binding;
+		std::vector<push_constant>	PushConstant;
+		std::vector<attribute>		Input;		// Vertex attributes if vertex stage.
+		std::vector<attribute>		Output;
+		uint32_t					LocalSize[3];	// Compute stage work group size.
+
+		shader_reflection();
+
+		// Parses SPIR-V binary, returns false if malformed.
+		bool reflect(VkShaderStageFlagBits aStage, size_t aWordCount, const uint32_t* aWord);
+
+		void clear();
+
+	};
+
+}
+
+#endif // !GEODESUKA_CORE_GCL_SHADER_REFLECTION_H
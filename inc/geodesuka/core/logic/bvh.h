@@ -0,0 +1,138 @@
+#pragma once
+#ifndef GEODESUKA_CORE_LOGIC_BVH_H
+#define GEODESUKA_CORE_LOGIC_BVH_H
+
+/*
+* Usage:
+*	Dynamic bounding volume hierarchy over axis aligned boxes, each leaf
+*	carries a user pointer. Leaves are inserted incrementally where they add
+*	the least surface area, moved leaves are refit bottom up in one pass, and
+*	the whole tree is rebuilt with a binned surface area heuristic once its
+*	cost drifts too far from the last build.
+*		uint32_t Handle = Tree.insert(Box, Object);
+*		Tree.move(Handle, NewBox);			// Every time it moves.
+*		Tree.maintain();					// Once per update.
+*
+*	Queries return user pointers, boxes overlapping a box, boxes inside or
+*	intersecting a frustum, and the nearest box along each ray of a batch.
+*		Tree.query(Plane, Visible);
+*		Tree.raycast(RayCount, Ray, Hit);
+*
+*	Writes take the lock exclusively, queries take it shared, so any number
+*	of threads can query while no write is in progress.
+*/
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <vector>
+#include <shared_mutex>
+
+#include "../math.h"
+
+namespace geodesuka::core::logic {
+
+	class bvh {
+	public:
+
+		static constexpr uint32_t INVALID_HANDLE = 0xFFFFFFFF;
+
+		struct aabb {
+			float3 Min;
+			float3 Max;
+		};
+
+		struct ray {
+			float3 Origin;
+			float3 Direction;
+			float MaxDistance;
+		};
+
+		struct hit {
+			uint32_t Handle;				// INVALID_HANDLE if nothing was hit.
+			void* UserData;
+			float Distance;					// Along the ray to the box, zero from inside.
+		};
+
+		bvh();
+		~bvh();
+
+		// ----- Writing ----- //
+
+		uint32_t insert(const aabb& aBounds, void* aUserData);
+
+		// Sets new bounds, the tree is refit by the next refit() or maintain().
+		void move(uint32_t aHandle, const aabb& aBounds);
+
+		void remove(uint32_t aHandle);
+		void clear();
+
+		// Refits the ancestors of every leaf moved since last refit.
+		void refit();
+
+		// Rebuilds the whole tree top down with a binned SAH.
+		void rebuild();
+
+		// Refits, then rebuilds if cost grew over aRatio times that of the last build.
+		void maintain(float aRatio = 1.5f);
+
+		// ----- Reading ----- //
+
+		size_t size();
+
+		// SAH cost, summed area of inner nodes relative to the root.
+		float cost();
+
+		void* user_data(uint32_t aHandle);
+
+		// Leaves overlapping aBounds.
+		size_t query(const aabb& aBounds, std::vector<void*>& aResult);
+
+		// Leaves inside or intersecting the frustum, planes point inwards.
+		size_t query(const float4 aPlane[6], std::vector<void*>& aResult);
+
+		// Nearest leaf along each ray, rays need not be normalized.
+		void raycast(size_t aRayCount, const ray* aRay, hit* aHit);
+
+	private:
+
+		struct node {
+			aabb Box;
+			uint32_t Parent;
+			uint32_t Child[2];
+			uint32_t Handle;				// Leaf handle, INVALID_HANDLE for inner nodes.
+		};
+
+		std::shared_mutex Mutex;
+
+		std::vector<node> Node;
+		std::vector<uint32_t> FreeNode;
+		uint32_t Root;
+
+		// Per leaf handle.
+		std::vector<uint32_t> LeafNode;
+		std::vector<void*> UserData;
+		std::vector<uint32_t> FreeHandle;
+		std::vector<uint32_t> Moved;
+		size_t LeafCount;
+
+		float BuiltCost;
+
+		uint32_t allocate_node();
+		void free_node(uint32_t aNode);
+		void insert_leaf(uint32_t aLeaf);
+		void remove_leaf(uint32_t aLeaf);
+		void refit_from(uint32_t aNode);
+		void refit_locked();
+		void rebuild_locked();
+		float cost_locked();
+		uint32_t build(std::vector<node>& aOutput, std::vector<uint32_t>& aHandle, const std::vector<aabb>& aBox, size_t aBegin, size_t aEnd, uint32_t aParent);
+
+		static aabb merge(const aabb& aLhs, const aabb& aRhs);
+		static float area(const aabb& aBox);
+
+	};
+
+}
+
+#endif // !GEODESUKA_CORE_LOGIC_BVH_H
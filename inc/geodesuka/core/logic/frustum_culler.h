@@ -0,0 +1,108 @@
+#pragma once
+#ifndef GEODESUKA_CORE_LOGIC_FRUSTUM_CULLER_H
+#define GEODESUKA_CORE_LOGIC_FRUSTUM_CULLER_H
+
+/*
+* Usage:
+*	CPU frustum culling of many bounding volumes. Bounds are kept as structure
+*	of arrays, center, radius and box half extents in separate arrays, and are
+*	tested four or eight at a time against the six planes of a view.
+*		uint32_t Handle = Culler.add(Center, Radius);
+*		uint32_t Handle = Culler.add(Center, HalfExtent);			// Axis aligned box.
+*		...
+*		frustum_culler::extract_planes(Camera->view_projection(), Plane);
+*		size_t Count = Culler.cull(Plane, Visible);
+*
+*	Visible receives the handles of the bounds intersecting the frustum, in
+*	storage order. A bound is rejected if it lies behind any plane using the
+*	smaller of its sphere radius and the projected box extent, spheres store
+*	their radius as box extent, boxes their half diagonal as radius.
+*
+*	Kernels are picked at runtime, AVX2 if the CPU has it, else SSE on x86 and
+*	NEON on ARM, with a scalar reference used for the remainder of a block and
+*	on other targets. A kernel can be forced for comparison, see benchmark().
+*
+*	Not thread safe, concurrent cull() calls on a const set are fine.
+*/
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <vector>
+
+#include "../math.h"
+
+namespace geodesuka::core::logic {
+
+	class frustum_culler {
+	public:
+
+		static constexpr uint32_t INVALID_HANDLE = 0xFFFFFFFF;
+
+		enum kernel {
+			AUTOMATIC,
+			SCALAR,
+			SSE,
+			AVX2,
+			NEON
+		};
+
+		frustum_culler();
+		~frustum_culler();
+
+		// Sphere bound.
+		uint32_t add(float3 aCenter, float aRadius);
+		// Axis aligned box bound.
+		uint32_t add(float3 aCenter, float3 aHalfExtent);
+
+		void update(uint32_t aHandle, float3 aCenter, float aRadius);
+		void update(uint32_t aHandle, float3 aCenter, float3 aHalfExtent);
+		void remove(uint32_t aHandle);
+		void clear();
+
+		size_t size() const;
+
+		// Writes handles of visible bounds to aVisible, returns their number.
+		size_t cull(const float4 aPlane[6], std::vector<uint32_t>& aVisible, kernel aKernel = AUTOMATIC) const;
+
+		// Best kernel supported by this CPU, and whether aKernel can run.
+		static kernel native_kernel();
+		static bool is_supported(kernel aKernel);
+
+		// Frustum planes of a clip from world transform, Vulkan depth range.
+		// Planes point inwards and are normalized, xyz normal and t distance.
+		static void extract_planes(const float4x4& aViewProjection, float4 aPlane[6]);
+
+		// Culls aCount random bounds aRepeat times with aKernel, returns the
+		// mean time of one cull in milliseconds, negative if not supported.
+		static double benchmark(kernel aKernel, size_t aCount, int aRepeat);
+
+	private:
+
+		// Bounds, one entry per slot.
+		std::vector<float> X;
+		std::vector<float> Y;
+		std::vector<float> Z;
+		std::vector<float> Radius;
+		std::vector<float> ExtentX;
+		std::vector<float> ExtentY;
+		std::vector<float> ExtentZ;
+		std::vector<uint32_t> Handle;
+
+		// Slot of a handle, removal moves the last slot into the hole.
+		std::vector<uint32_t> Slot;
+		std::vector<uint32_t> FreeHandle;
+
+		uint32_t insert(float3 aCenter, float aRadius, float3 aHalfExtent);
+		void set(uint32_t aSlot, float3 aCenter, float aRadius, float3 aHalfExtent);
+
+		size_t cull_scalar(const float4 aPlane[6], size_t aBegin, uint32_t* aVisible) const;
+		size_t cull_sse(const float4 aPlane[6], uint32_t* aVisible, size_t* aEnd) const;
+		size_t cull_avx2(const float4 aPlane[6], uint32_t* aVisible, size_t* aEnd) const;
+		size_t cull_neon(const float4 aPlane[6], uint32_t* aVisible, size_t* aEnd) const;
+
+	};
+
+}
+
+#endif // !GEODESUKA_CORE_LOGIC_FRUSTUM_CULLER_H
@@ -0,0 +1,94 @@
+#pragma once
+#ifndef GEODESUKA_CORE_LOGIC_RADIX_SORT_H
+#define GEODESUKA_CORE_LOGIC_RADIX_SORT_H
+
+/*
+* Usage:
+*	Stable LSD radix sort of unsigned integer keys, each key carrying a value
+*	along. Used to order draws by depth or state without comparisons, linear
+*	in the number of keys.
+*		radix_sort::depth_keys(Count, X, Y, Z, Origin, Forward, Key);
+*		radix_sort::sort(Count, Key, Object, KeyScratch, ObjectScratch);
+*
+*	Keys are sorted ascending, 8 bits per pass. Histograms of all passes are
+*	gathered in one read and passes which would not move anything are skipped.
+*	Scratch arrays must hold aCount elements, the result always ends up in
+*	aKey and aValue.
+*
+*	depth_key() maps a float to a key which orders like the float does, NaN
+*	aside. Inverting a key reverses the order, e.g. back to front.
+*/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include <utility>
+
+#include "../math.h"
+
+namespace geodesuka::core::logic {
+
+	class radix_sort {
+	public:
+
+		// Key ordering like aValue, negative floats flip all bits, others the sign bit.
+		static uint32_t depth_key(float aValue);
+
+		// Depth keys of points along aForward from aOrigin.
+		static void depth_keys(size_t aCount, const float* aX, const float* aY, const float* aZ, float3 aOrigin, float3 aForward, uint32_t* aKey);
+
+		template<typename K, typename V>
+		static void sort(size_t aCount, K* aKey, V* aValue, K* aKeyScratch, V* aValueScratch);
+
+	};
+
+	template<typename K, typename V>
+	void radix_sort::sort(size_t aCount, K* aKey, V* aValue, K* aKeyScratch, V* aValueScratch) {
+		static_assert((K)-1 > (K)0, "radix_sort keys must be unsigned");
+		const int PassCount = (int)sizeof(K);
+		if (aCount < 2) return;
+
+		size_t Histogram[sizeof(K)][256];
+		memset(Histogram, 0, sizeof(Histogram));
+		for (size_t i = 0; i < aCount; i++) {
+			for (int p = 0; p < PassCount; p++) {
+				Histogram[p][(aKey[i] >> (8 * p)) & 0xFF] += 1;
+			}
+		}
+
+		K* Key = aKey;
+		V* Value = aValue;
+		K* KeyOut = aKeyScratch;
+		V* ValueOut = aValueScratch;
+		for (int p = 0; p < PassCount; p++) {
+			uint32_t Shift = 8 * p;
+			if (Histogram[p][(Key[0] >> Shift) & 0xFF] == aCount) continue;
+
+			size_t Offset = 0;
+			for (size_t i = 0; i < 256; i++) {
+				size_t Bucket = Histogram[p][i];
+				Histogram[p][i] = Offset;
+				Offset += Bucket;
+			}
+			for (size_t i = 0; i < aCount; i++) {
+				size_t Destination = Histogram[p][(Key[i] >> Shift) & 0xFF]++;
+				KeyOut[Destination] = Key[i];
+				ValueOut[Destination] = Value[i];
+			}
+			std::swap(Key, KeyOut);
+			std::swap(Value, ValueOut);
+		}
+
+		// Odd number of passes ran, result is in scratch.
+		if (Key != aKey) {
+			for (size_t i = 0; i < aCount; i++) {
+				aKey[i] = Key[i];
+				aValue[i] = Value[i];
+			}
+		}
+	}
+
+}
+
+#endif // !GEODESUKA_CORE_LOGIC_RADIX_SORT_H
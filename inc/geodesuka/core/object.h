@@ -26,6 +26,7 @@
 #include "gcl/device.h"
 #include "gcl/context.h"
 #include "gcl/drawpack.h"
+#include "gcl/draw_queue.h"
 
 #include "graphics/mesh.h"
 #include "graphics/material.h"
@@ -55,6 +56,14 @@ namespace geodesuka::core {
 		virtual void set_position(float3 aPosition);
 		float3 get_position() const;
 
+		// Axis aligned bounds in stage space, indexed by the stage for spatial
+		// queries. Returns false if the object has no bounds, the default.
+		virtual bool get_bounds(float3& aMin, float3& aMax);
+
+		// Translucent objects are drawn after opaque ones, farthest first, by
+		// rendertargets which sort their objects (e.g. camera3d).
+		virtual bool is_translucent();
+
 		/*
 		* This function will be called by a particular rendertarget to gather Draw Commands
 		* from the object in question. Base object class must provide default render methods for generic
@@ -62,6 +71,8 @@ namespace geodesuka::core {
 		*/
 		// This is public for rendertargets to access object draw commands.
 		// This is public because it is needed for user defined rendertargets.
+		// Returns a secondary command buffer recorded against the frame scope of
+		// the rendertarget (see rendertarget::frame_pack()), VK_NULL_HANDLE if none.
 		virtual VkCommandBuffer draw(object::rendertarget* aRenderTarget);
 
 	protected:
@@ -126,10 +137,38 @@ namespace geodesuka::core {
 		virtual VkSubmitInfo update(double aDeltaTime);
 
 		/*
-		* Will produce compute operation submissions.
+		* Will produce compute operation submissions. Record dispatches with a
+		* gcl::compute_pipeline into a COMPUTE command buffer and return it with
+		* gcl::compute_pipeline::submission(), it is executed on the compute queue.
 		*/
 		virtual VkSubmitInfo compute();
 
+		/*
+		* Records the draw commands of one frame into aCommandBuffer, already
+		* begun against the frame scope of aRenderTarget. Called by draw() only
+		* when the drawpack of aRenderTarget is dirty, so keep per frame data in
+		* buffers and let recorded commands be resubmitted as they are.
+		*/
+		virtual void record(object::rendertarget* aRenderTarget, uint32_t aFrameIndex, VkCommandBuffer aCommandBuffer);
+
+		// Draw commands for every rendertarget are recorded again before next use.
+		void invalidate_draw();
+
+		/*
+		* Called by aRenderTarget every frame before draw(). Submit packets to
+		* aQueue for draws which may be sorted and instanced with those of other
+		* objects, e.g. many objects sharing a mesh and a material. Packets are
+		* recorded by the rendertarget after all object secondaries.
+		*/
+		virtual void enqueue(object::rendertarget* aRenderTarget, gcl::draw_queue* aQueue);
+
+		/*
+		* Records work into the frame primary of aRenderTarget before its frame
+		* scope opens, e.g. a culling pass with gcl::draw_culler. Called every
+		* frame, nothing may be recorded that needs a render pass.
+		*/
+		virtual void prepare(object::rendertarget* aRenderTarget, uint32_t aFrameIndex, VkCommandBuffer aCommandBuffer);
+
 	};
 
 }
@@ -37,6 +37,9 @@ namespace geodesuka::core::object {
 
 		~camera();
 
+		// Returns PRT.
+		virtual float4x4 view_projection() override;
+
 	protected:
 
 		// Generates the Perspective Projection Matrix.
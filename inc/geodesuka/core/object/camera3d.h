@@ -55,13 +55,30 @@ namespace geodesuka::core::object {
 		// The depth list is a list of sorted objects based
 		// on the distance from the camera they are. The opaque
 		// objects nearest to the camera will be rendered first.
-		std::vector<object_t> OpaqueObject;
+		std::vector<object_t*> OpaqueObject;
 
 		// AlphaList:
 		// Objects with that have translucency or are transparent
 		// (i.e. Alpha != 1.0) will be drawn where the furthest objects
 		// are rendered first for appropriate ordering.
-		std::vector<object_t> TranslucentObject;
+		std::vector<object_t*> TranslucentObject;
+
+		// Scratch of sort_objects(), only grows so a frame does not allocate.
+		std::vector<float> PositionX;
+		std::vector<float> PositionY;
+		std::vector<float> PositionZ;
+		std::vector<uint32_t> DepthKey;
+		std::vector<uint32_t> OpaqueKey;
+		std::vector<uint32_t> TranslucentKey;
+		std::vector<uint32_t> SortKeyScratch;
+		std::vector<object_t*> SortObjectScratch;
+
+		// OpaqueObject followed by TranslucentObject.
+		std::vector<object_t*> DrawOrder;
+
+		// Fills the depth lists and DrawOrder, depth along DirectionZ from
+		// Position is computed in one batch and radix sorted, linear in aObjectCount.
+		void sort_objects(size_t aObjectCount, object_t** aObject);
 
 
 	};
@@ -11,6 +11,9 @@
 //#include "../gcl/command_list.h"
 #include "../gcl/command_pool.h"
 #include "../gcl/command_batch.h"
+#include "../gcl/command_recorder.h"
+#include "../gcl/command_encoder.h"
+#include "../gcl/draw_queue.h"
 
 #include "../logic/timer.h"
 
@@ -38,6 +41,8 @@ namespace geodesuka::core::object {
 		int FrameAttachmentCount;									// The number of attachments for each frame.
 		VkAttachmentDescription* FrameAttachmentDescription;		// The attachment descriptions of each frame.
 		VkImageView** FrameAttachment;								// The image view handles of each frame attachment.
+		VkImage** FrameImage;										// The image handles of each frame attachment, NULL if not exposed.
+		VkClearValue* FrameAttachmentClearValue;					// The clear value of each frame attachment, NULL clears to zero.
 
 		//uint32_t FrameReadIndex;
 		uint32_t FrameDrawIndex;
@@ -49,6 +54,24 @@ namespace geodesuka::core::object {
 		// Used for runtime rendertarget discrimination.
 		virtual int rtid() = 0;
 
+		// The frame scope every object records into, one render pass instance
+		// (or dynamic rendering scope) per frame over all frame attachments.
+		// Objects make their own drawpack with drawpack(Context, RenderTarget).
+		gcl::drawpack* frame_pack();
+
+		// Pool a new object drawpack allocates its secondaries from. Drawpacks
+		// are spread round robin over the recording lanes, aLane is set to the
+		// lane which records them.
+		gcl::command_pool* draw_pool(uint32_t& aLane);
+
+		// Packets of all objects for the current frame, see object_t::enqueue().
+		// Instance data is one float4x4 per packet, at vertex binding 1.
+		gcl::draw_queue* queue();
+
+		// Clip from world transform of the view, used for culling. The default
+		// zero matrix has no planes and culls nothing.
+		virtual float4x4 view_projection();
+
 		// -------------------- Called By Stage.render() ------------------------- \\
 
 		// Will acquire next frame index, if semephore is not VK_NULL_HANDLE, 
@@ -72,10 +95,48 @@ namespace geodesuka::core::object {
 		uint32_t* DrawCommandCount;
 		VkCommandBuffer** DrawCommandList;
 
+		// Opened once per frame, Command holds the primary executing the objects.
+		gcl::drawpack* FramePack;
+
+		// Worker lanes recording object secondaries in parallel, owned by the engine.
+		gcl::command_recorder* Recorder;
+		std::atomic<uint32_t> NextLane;
+
+		// Sorted and instanced packets, opaque and masked passes are recorded
+		// into the secondary of QueuePack, translucent and overlay into BlendQueuePack.
+		gcl::draw_queue* DrawQueue;
+		gcl::drawpack* QueuePack;
+		gcl::drawpack* BlendQueuePack;
+
 		rendertarget(engine* aEngine, gcl::context* aContext, stage_t* aStage/*, int aFrameCount, double aFrameRate*/);
 
+		// Call once frame attachments are set, describes a single subpass
+		// writing every color attachment and the depth stencil attachment.
+		// Also starts the recording lanes, before any object makes a drawpack.
+		void make_frame_pack();
+
+		// Destroys what make_frame_pack() made, before frame attachments go.
+		void clear_frame_pack();
+
+		// Records the primary of the current frame, it opens the frame scope and
+		// executes the secondary command buffers of the objects in order. Dirty
+		// secondaries are recorded in parallel, each on the lane of its drawpack.
+		// Packets enqueued by the objects are sorted and executed last. Work
+		// objects prepare, like culling, is recorded before the scope opens.
+		VkCommandBuffer record_frame(size_t aObjectCount, object_t** aObject);
+
+		// Same, where only the first aOpaqueCount objects are opaque. Opaque and
+		// masked packets are executed after them, before the remaining blended
+		// objects, translucent and overlay packets still go last. Blended objects
+		// and blended packets are therefore not depth sorted against each other.
+		VkCommandBuffer record_frame(size_t aObjectCount, object_t** aObject, size_t aOpaqueCount);
+
 	private:
 
+		// Records the packets of passes aFirstPass to aLastPass into the frame
+		// secondary of aPack, VK_NULL_HANDLE if there are none.
+		VkCommandBuffer record_queue(gcl::drawpack* aPack, uint32_t aFirstPass, uint32_t aLastPass);
+
 
 
 
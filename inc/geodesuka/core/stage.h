@@ -18,11 +18,14 @@
 // rendering and compute context.
 
 #include <vector>
+#include <map>
 
 #include <mutex>
 
 #include "gcl/context.h"
 
+#include "logic/bvh.h"
+
 #include "object.h"
 
 namespace geodesuka::core {
@@ -37,6 +40,19 @@ namespace geodesuka::core {
 
 		~stage_t();
 
+		// ----- Spatial Queries ----- //
+		// Objects are indexed by object_t::get_bounds() every update, queries
+		// are safe from any thread, also while the stage renders.
+
+		// Objects with bounds overlapping the box.
+		size_t query(float3 aMin, float3 aMax, std::vector<object_t*>& aObject);
+
+		// Objects with bounds intersecting the view, clip from stage space.
+		size_t query(const float4x4& aViewProjection, std::vector<object_t*>& aObject);
+
+		// Nearest object along each ray, nullptr and FLT_MAX if none was hit.
+		void pick(size_t aRayCount, const logic::bvh::ray* aRay, object_t** aObject, float* aDistance);
+
 	protected:
 
 		std::mutex Mutex;
@@ -45,6 +61,18 @@ namespace geodesuka::core {
 		engine* Engine;
 		gcl::context* Context;
 
+		// Spatial index of objects with bounds, and their leaves.
+		struct spatial_entry {
+			uint32_t Handle;
+			uint64_t Stamp;
+			logic::bvh::aabb Bounds;
+		};
+		logic::bvh Spatial;
+		std::map<object_t*, spatial_entry> SpatialEntry;
+		uint64_t SpatialStamp;
+
+		// Syncs the spatial index with Object, call with Mutex held.
+		void update_spatial();
 
 		stage_t(engine* aEngine, gcl::context* aContext);
 
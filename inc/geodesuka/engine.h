@@ -53,6 +53,8 @@ Include: $(ProjectDir)..\glslang
 #include "core/logic/timer.h"
 #include "core/logic/time_step.h"
 #include "core/logic/trap.h"
+#include "core/logic/frustum_culler.h"
+#include "core/logic/bvh.h"
 
 // ------------------------- File System Manager ------------------------- //
 #include "core/io/file.h"
@@ -63,17 +65,35 @@ Include: $(ProjectDir)..\glslang
 // ------------------------- Graphics & Computation API ------------------------- //
 #include "core/gcl.h"
 #include "core/gcl/device.h"
+#include "core/gcl/device_table.h"
 #include "core/gcl/context.h"
 #include "core/gcl/command_list.h"
 #include "core/gcl/command_pool.h"
 #include "core/gcl/command_batch.h"
+#include "core/gcl/command_recorder.h"
+#include "core/gcl/command_encoder.h"
+#include "core/gcl/draw_queue.h"
+#include "core/gcl/draw_culler.h"
+#include "core/gcl/external.h"
 #include "core/gcl/buffer.h"
 #include "core/gcl/shader.h"
+#include "core/gcl/shader_cache.h"
+#include "core/gcl/shader_compiler.h"
+#include "core/gcl/shader_permutation.h"
+#include "core/gcl/shader_reflection.h"
+#include "core/gcl/layout_cache.h"
+#include "core/gcl/descriptor_allocator.h"
+#include "core/gcl/bindless_table.h"
 #include "core/gcl/image.h"
+#include "core/gcl/ownership_transfer.h"
 #include "core/gcl/renderpass.h"
+#include "core/gcl/renderpass_cache.h"
 #include "core/gcl/framebuffer.h"
 #include "core/gcl/drawpack.h"
+#include "core/gcl/pipeline_cache.h"
+#include "core/gcl/pipeline_state_cache.h"
 #include "core/gcl/pipeline.h"
+#include "core/gcl/compute_pipeline.h"
 
 // ------------------------- Human Interface Devices ------------------------- //
 
@@ -159,6 +179,8 @@ namespace geodesuka {
 		core::gcl::device* get_primary_device();
 		core::object::system_display** get_display_list(size_t* aListSize);
 		core::object::system_display* get_primary_display();
+		core::gcl::shader_compiler* get_shader_compiler();
+		core::gcl::command_recorder* get_command_recorder();
 
 		VkInstance handle();
 		bool is_ready();
@@ -192,6 +214,8 @@ namespace geodesuka {
 		std::vector<core::gcl::device*> Device;
 		std::vector<core::object::system_display*> Display;
 		std::vector<core::object::system_window*> SystemWindow;
+		core::gcl::shader_compiler* ShaderCompiler;
+		core::gcl::command_recorder* Recorder;		// Shared by all rendertargets.
 
 		// ----- Memory Managed Items ----- //
 
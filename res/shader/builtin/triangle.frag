@@ -0,0 +1,9 @@
+#version 450
+
+layout (location = 0) in vec3 InterpColor;
+
+layout (location = 0) out vec4 PixelColor;
+
+void main() {
+	PixelColor = vec4(InterpColor, 1.0);
+}
@@ -0,0 +1,256 @@
+#include <geodesuka/core/gcl/bindless_table.h>
+
+#include <algorithm>
+
+#include <geodesuka/core/gcl/context.h>
+
+namespace geodesuka::core::gcl {
+
+	// Requested array sizes, clamped to device limits.
+	static const uint32_t DefaultCapacity[bindless_table::TYPE_COUNT] = { 16384, 1024, 16384 };
+
+	static const VkDescriptorType DescriptorType[bindless_table::TYPE_COUNT] = {
+		VkDescriptorType::VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+		VkDescriptorType::VK_DESCRIPTOR_TYPE_SAMPLER,
+		VkDescriptorType::VK_DESCRIPTOR_TYPE_STORAGE_BUFFER
+	};
+
+	bindless_table::slot_list::slot_list() {
+		this->Capacity = 0;
+		this->Next = 0;
+	}
+
+	bindless_table::bindless_table(context* aContext, uint32_t aRetireLag) {
+		VkResult Result = VkResult::VK_SUCCESS;
+
+		this->Context		= aContext;
+		this->Layout		= VK_NULL_HANDLE;
+		this->Pool			= VK_NULL_HANDLE;
+		this->Set			= VK_NULL_HANDLE;
+		this->RetireLag		= aRetireLag > 0 ? aRetireLag : 1;
+		this->Epoch			= 0;
+		if (this->Context == nullptr) return;
+
+		// Clamp array sizes to update-after-bind limits of the device.
+		VkPhysicalDeviceDescriptorIndexingProperties IndexingProperties{};
+		IndexingProperties.sType = VkStructureType::VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES;
+		IndexingProperties.pNext = NULL;
+		VkPhysicalDeviceProperties2 Properties{};
+		Properties.sType = VkStructureType::VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+		Properties.pNext = &IndexingProperties;
+		vkGetPhysicalDeviceProperties2(this->Context->parent()->handle(), &Properties);
+
+		this->Slot[IMAGE].Capacity		= std::min({ DefaultCapacity[IMAGE], IndexingProperties.maxDescriptorSetUpdateAfterBindSampledImages, IndexingProperties.maxPerStageDescriptorUpdateAfterBindSampledImages });
+		this->Slot[SAMPLER].Capacity	= std::min({ DefaultCapacity[SAMPLER], IndexingProperties.maxDescriptorSetUpdateAfterBindSamplers, IndexingProperties.maxPerStageDescriptorUpdateAfterBindSamplers });
+		this->Slot[BUFFER].Capacity		= std::min({ DefaultCapacity[BUFFER], IndexingProperties.maxDescriptorSetUpdateAfterBindStorageBuffers, IndexingProperties.maxPerStageDescriptorUpdateAfterBindStorageBuffers });
+
+		// All three arrays count against the per stage resource limit, scale down evenly.
+		uint64_t Total = (uint64_t)this->Slot[IMAGE].Capacity + this->Slot[SAMPLER].Capacity + this->Slot[BUFFER].Capacity;
+		if (Total > IndexingProperties.maxPerStageUpdateAfterBindResources) {
+			for (int i = 0; i < TYPE_COUNT; i++) {
+				this->Slot[i].Capacity = (uint32_t)(((uint64_t)this->Slot[i].Capacity * IndexingProperties.maxPerStageUpdateAfterBindResources) / Total);
+			}
+		}
+
+		VkDescriptorSetLayoutBinding Binding[TYPE_COUNT];
+		VkDescriptorBindingFlags BindingFlags[TYPE_COUNT];
+		VkDescriptorPoolSize PoolSize[TYPE_COUNT];
+		for (int i = 0; i < TYPE_COUNT; i++) {
+			Binding[i].binding				= i;
+			Binding[i].descriptorType		= DescriptorType[i];
+			Binding[i].descriptorCount		= this->Slot[i].Capacity;
+			Binding[i].stageFlags			= VkShaderStageFlagBits::VK_SHADER_STAGE_ALL;
+			Binding[i].pImmutableSamplers	= NULL;
+			BindingFlags[i]					= VkDescriptorBindingFlagBits::VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT | VkDescriptorBindingFlagBits::VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT | VkDescriptorBindingFlagBits::VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT;
+			PoolSize[i].type				= DescriptorType[i];
+			PoolSize[i].descriptorCount		= this->Slot[i].Capacity;
+		}
+
+		VkDescriptorSetLayoutBindingFlagsCreateInfo BindingFlagsCreateInfo{};
+		BindingFlagsCreateInfo.sType			= VkStructureType::VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+		BindingFlagsCreateInfo.pNext			= NULL;
+		BindingFlagsCreateInfo.bindingCount		= TYPE_COUNT;
+		BindingFlagsCreateInfo.pBindingFlags	= BindingFlags;
+
+		VkDescriptorSetLayoutCreateInfo LayoutCreateInfo{};
+		LayoutCreateInfo.sType			= VkStructureType::VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+		LayoutCreateInfo.pNext			= &BindingFlagsCreateInfo;
+		LayoutCreateInfo.flags			= VkDescriptorSetLayoutCreateFlagBits::VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+		LayoutCreateInfo.bindingCount	= TYPE_COUNT;
+		LayoutCreateInfo.pBindings		= Binding;
+		Result = this->Context->api().vkCreateDescriptorSetLayout(this->Context->handle(), &LayoutCreateInfo, NULL, &this->Layout);
+		if (Result != VkResult::VK_SUCCESS) return;
+
+		VkDescriptorPoolCreateInfo PoolCreateInfo{};
+		PoolCreateInfo.sType			= VkStructureType::VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+		PoolCreateInfo.pNext			= NULL;
+		PoolCreateInfo.flags			= VkDescriptorPoolCreateFlagBits::VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+		PoolCreateInfo.maxSets			= 1;
+		PoolCreateInfo.poolSizeCount	= TYPE_COUNT;
+		PoolCreateInfo.pPoolSizes		= PoolSize;
+		Result = this->Context->api().vkCreateDescriptorPool(this->Context->handle(), &PoolCreateInfo, NULL, &this->Pool);
+		if (Result != VkResult::VK_SUCCESS) return;
+
+		VkDescriptorSetAllocateInfo AllocateInfo{};
+		AllocateInfo.sType					= VkStructureType::VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		AllocateInfo.pNext					= NULL;
+		AllocateInfo.descriptorPool			= this->Pool;
+		AllocateInfo.descriptorSetCount		= 1;
+		AllocateInfo.pSetLayouts			= &this->Layout;
+		Result = this->Context->api().vkAllocateDescriptorSets(this->Context->handle(), &AllocateInfo, &this->Set);
+		if (Result != VkResult::VK_SUCCESS) {
+			this->Set = VK_NULL_HANDLE;
+		}
+	}
+
+	bindless_table::~bindless_table() {
+		if (this->Context == nullptr) return;
+		// Set is freed with its pool.
+		if (this->Pool != VK_NULL_HANDLE) {
+			this->Context->api().vkDestroyDescriptorPool(this->Context->handle(), this->Pool, NULL);
+		}
+		if (this->Layout != VK_NULL_HANDLE) {
+			this->Context->api().vkDestroyDescriptorSetLayout(this->Context->handle(), this->Layout, NULL);
+		}
+		this->Pool = VK_NULL_HANDLE;
+		this->Layout = VK_NULL_HANDLE;
+		this->Set = VK_NULL_HANDLE;
+		this->Context = nullptr;
+	}
+
+	uint32_t bindless_table::add(VkImageView aImageView, VkImageLayout aLayout) {
+		if (aImageView == VK_NULL_HANDLE) return invalid;
+		uint32_t Slot = this->allocate(IMAGE);
+		if (Slot != invalid) {
+			this->update(Slot, aImageView, aLayout);
+		}
+		return Slot;
+	}
+
+	uint32_t bindless_table::add(VkSampler aSampler) {
+		if (aSampler == VK_NULL_HANDLE) return invalid;
+		uint32_t Slot = this->allocate(SAMPLER);
+		if (Slot != invalid) {
+			this->update(Slot, aSampler);
+		}
+		return Slot;
+	}
+
+	uint32_t bindless_table::add(VkBuffer aBuffer, VkDeviceSize aOffset, VkDeviceSize aRange) {
+		if (aBuffer == VK_NULL_HANDLE) return invalid;
+		uint32_t Slot = this->allocate(BUFFER);
+		if (Slot != invalid) {
+			this->update(Slot, aBuffer, aOffset, aRange);
+		}
+		return Slot;
+	}
+
+	void bindless_table::update(uint32_t aSlot, VkImageView aImageView, VkImageLayout aLayout) {
+		VkDescriptorImageInfo ImageInfo{};
+		ImageInfo.sampler		= VK_NULL_HANDLE;
+		ImageInfo.imageView		= aImageView;
+		ImageInfo.imageLayout	= aLayout;
+		this->write(IMAGE, aSlot, &ImageInfo, NULL);
+	}
+
+	void bindless_table::update(uint32_t aSlot, VkSampler aSampler) {
+		VkDescriptorImageInfo ImageInfo{};
+		ImageInfo.sampler		= aSampler;
+		ImageInfo.imageView		= VK_NULL_HANDLE;
+		ImageInfo.imageLayout	= VkImageLayout::VK_IMAGE_LAYOUT_UNDEFINED;
+		this->write(SAMPLER, aSlot, &ImageInfo, NULL);
+	}
+
+	void bindless_table::update(uint32_t aSlot, VkBuffer aBuffer, VkDeviceSize aOffset, VkDeviceSize aRange) {
+		VkDescriptorBufferInfo BufferInfo{};
+		BufferInfo.buffer		= aBuffer;
+		BufferInfo.offset		= aOffset;
+		BufferInfo.range		= aRange;
+		this->write(BUFFER, aSlot, NULL, &BufferInfo);
+	}
+
+	void bindless_table::remove(type aType, uint32_t aSlot) {
+		if ((aType < 0) || (aType >= TYPE_COUNT)) return;
+		this->Mutex.lock();
+		if (aSlot < this->Slot[aType].Next) {
+			retired Entry;
+			Entry.Epoch		= this->Epoch;
+			Entry.Type		= aType;
+			Entry.Slot		= aSlot;
+			this->Retired.push_back(Entry);
+		}
+		this->Mutex.unlock();
+	}
+
+	void bindless_table::collect() {
+		this->Mutex.lock();
+		this->Epoch += 1;
+		// Retired in epoch order, stop at first entry still within lag.
+		while ((this->Retired.size() > 0) && (this->Retired.front().Epoch + this->RetireLag <= this->Epoch)) {
+			this->Slot[this->Retired.front().Type].Free.push_back(this->Retired.front().Slot);
+			this->Retired.pop_front();
+		}
+		this->Mutex.unlock();
+	}
+
+	void bindless_table::bind(VkCommandBuffer aCommandBuffer, VkPipelineBindPoint aBindPoint, VkPipelineLayout aLayout, uint32_t aSetIndex) {
+		if ((aCommandBuffer == VK_NULL_HANDLE) || (this->Set == VK_NULL_HANDLE)) return;
+		this->Context->api().vkCmdBindDescriptorSets(aCommandBuffer, aBindPoint, aLayout, aSetIndex, 1, &this->Set, 0, NULL);
+	}
+
+	VkDescriptorSetLayout bindless_table::layout() {
+		return this->Layout;
+	}
+
+	VkDescriptorSet bindless_table::set() {
+		return this->Set;
+	}
+
+	uint32_t bindless_table::capacity(type aType) {
+		if ((aType < 0) || (aType >= TYPE_COUNT)) return 0;
+		return this->Slot[aType].Capacity;
+	}
+
+	uint32_t bindless_table::size(type aType) {
+		if ((aType < 0) || (aType >= TYPE_COUNT)) return 0;
+		this->Mutex.lock();
+		uint32_t Size = this->Slot[aType].Next - (uint32_t)this->Slot[aType].Free.size();
+		this->Mutex.unlock();
+		return Size;
+	}
+
+	uint32_t bindless_table::allocate(type aType) {
+		uint32_t Slot = invalid;
+		if (this->Set == VK_NULL_HANDLE) return Slot;
+		this->Mutex.lock();
+		slot_list& List = this->Slot[aType];
+		if (List.Free.size() > 0) {
+			Slot = List.Free.back();
+			List.Free.pop_back();
+		}
+		else if (List.Next < List.Capacity) {
+			Slot = List.Next;
+			List.Next += 1;
+		}
+		this->Mutex.unlock();
+		return Slot;
+	}
+
+	void bindless_table::write(type aType, uint32_t aSlot, const VkDescriptorImageInfo* aImage, const VkDescriptorBufferInfo* aBuffer) {
+		if ((this->Set == VK_NULL_HANDLE) || (aSlot >= this->Slot[aType].Capacity)) return;
+
+		VkWriteDescriptorSet Write{};
+		Write.sType					= VkStructureType::VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		Write.pNext					= NULL;
+		Write.dstSet				= this->Set;
+		Write.dstBinding			= (uint32_t)aType;
+		Write.dstArrayElement		= aSlot;
+		Write.descriptorCount		= 1;
+		Write.descriptorType		= DescriptorType[aType];
+		Write.pImageInfo			= aImage;
+		Write.pBufferInfo			= aBuffer;
+		Write.pTexelBufferView		= NULL;
+		this->Context->api().vkUpdateDescriptorSets(this->Context->handle(), 1, &Write, 0, NULL);
+	}
+
+}
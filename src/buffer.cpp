@@ -7,6 +7,7 @@
 
 // Used to interact with texture class
 #include <geodesuka/core/gcl/image.h>
+#include <geodesuka/core/gcl/ownership_transfer.h>
 
 namespace geodesuka::core::gcl {
 
@@ -15,6 +16,8 @@ namespace geodesuka::core::gcl {
 		this->Handle = VK_NULL_HANDLE;
 		this->MemoryHandle = VK_NULL_HANDLE;
 		this->MemoryProperty = 0;
+		this->Owner = -1;
+		this->isExportable = false;
 		this->Count = 0;
 	}
 
@@ -34,18 +37,20 @@ namespace geodesuka::core::gcl {
 
 		this->Handle								= VK_NULL_HANDLE;
 		this->MemoryHandle							= VK_NULL_HANDLE;
+		this->Owner									= -1;
+		this->isExportable							= false;
 
 		this->Count									= aCount;
 		this->MemoryLayout							= aMemoryLayout;
 
 		// Create Device Buffer Object.
-		Result = vkCreateBuffer(aContext->handle(), &this->CreateInfo, NULL, &this->Handle);
+		Result = aContext->api().vkCreateBuffer(aContext->handle(), &this->CreateInfo, NULL, &this->Handle);
 
 		// Allocates Memory Handle
 		if (Result == VkResult::VK_SUCCESS) {
 			// Gathers memory requirements of the created buffer.
 			VkMemoryRequirements MemoryRequirement;
-			vkGetBufferMemoryRequirements(aContext->handle(), this->Handle, &MemoryRequirement);
+			aContext->api().vkGetBufferMemoryRequirements(aContext->handle(), this->Handle, &MemoryRequirement);
 
 			// Will search for exact then approximate type.
 			int MemoryTypeIndex = aContext->parent()->get_memory_type_index(MemoryRequirement, aMemoryType);
@@ -57,7 +62,7 @@ namespace geodesuka::core::gcl {
 				this->MemoryProperty				= aContext->parent()->get_memory_type(MemoryTypeIndex);
 
 				// Allocate Device Memory.
-				Result = vkAllocateMemory(this->Context->handle(), &this->AllocateInfo, NULL, &this->MemoryHandle);
+				Result = this->Context->api().vkAllocateMemory(this->Context->handle(), &this->AllocateInfo, NULL, &this->MemoryHandle);
 			}
 			else {
 				Result = VkResult::VK_ERROR_FORMAT_NOT_SUPPORTED;
@@ -66,15 +71,15 @@ namespace geodesuka::core::gcl {
 
 		// Bind memory to buffer
 		if (Result == VkResult::VK_SUCCESS) {
-			Result = vkBindBufferMemory(this->Context->handle(), this->Handle, this->MemoryHandle, 0);
+			Result = this->Context->api().vkBindBufferMemory(this->Context->handle(), this->Handle, this->MemoryHandle, 0);
 		}
 
 		if ((Result == VkResult::VK_SUCCESS) && (aBufferData != NULL) && ((this->MemoryProperty & (device::memory::HOST_VISIBLE)) == device::memory::HOST_VISIBLE)) {
 			void* nptr = NULL;
-			Result = vkMapMemory(this->Context->handle(), this->MemoryHandle, 0, this->CreateInfo.size, 0, &nptr);
+			Result = this->Context->api().vkMapMemory(this->Context->handle(), this->MemoryHandle, 0, this->CreateInfo.size, 0, &nptr);
 			if ((nptr != NULL) && (Result == VK_SUCCESS)) {
 				memcpy(nptr, aBufferData, this->CreateInfo.size);
-				vkUnmapMemory(this->Context->handle(), this->MemoryHandle);
+				this->Context->api().vkUnmapMemory(this->Context->handle(), this->MemoryHandle);
 			}
 		}
 		
@@ -94,14 +99,20 @@ namespace geodesuka::core::gcl {
 		this->CreateInfo.queueFamilyIndexCount		= 0;
 		this->CreateInfo.pQueueFamilyIndices		= NULL;
 
+		this->Handle								= VK_NULL_HANDLE;
+		this->MemoryHandle							= VK_NULL_HANDLE;
+		this->Owner									= -1;
+		this->isExportable							= false;
+		this->Count									= 0;
+
 		// Create Device Buffer Object.
-		Result = vkCreateBuffer(aContext->handle(), &this->CreateInfo, NULL, &this->Handle);
+		Result = aContext->api().vkCreateBuffer(aContext->handle(), &this->CreateInfo, NULL, &this->Handle);
 
 		// Allocates Memory Handle
 		if (Result == VkResult::VK_SUCCESS) {
 			// Gathers memory requirements of the created buffer.
 			VkMemoryRequirements MemoryRequirement;
-			vkGetBufferMemoryRequirements(aContext->handle(), this->Handle, &MemoryRequirement);
+			aContext->api().vkGetBufferMemoryRequirements(aContext->handle(), this->Handle, &MemoryRequirement);
 
 			// Will search for exact then approximate type.
 			int MemoryTypeIndex = aContext->parent()->get_memory_type_index(MemoryRequirement, aMemoryType);
@@ -113,7 +124,7 @@ namespace geodesuka::core::gcl {
 				this->MemoryProperty = aContext->parent()->get_memory_type(MemoryTypeIndex);
 
 				// Allocate Device Memory.
-				Result = vkAllocateMemory(this->Context->handle(), &this->AllocateInfo, NULL, &this->MemoryHandle);
+				Result = this->Context->api().vkAllocateMemory(this->Context->handle(), &this->AllocateInfo, NULL, &this->MemoryHandle);
 			}
 			else {
 				Result = VkResult::VK_ERROR_FORMAT_NOT_SUPPORTED;
@@ -122,18 +133,142 @@ namespace geodesuka::core::gcl {
 
 		// Bind memory to buffer
 		if (Result == VkResult::VK_SUCCESS) {
-			Result = vkBindBufferMemory(this->Context->handle(), this->Handle, this->MemoryHandle, 0);
+			Result = this->Context->api().vkBindBufferMemory(this->Context->handle(), this->Handle, this->MemoryHandle, 0);
 		}
 
 		if ((Result == VkResult::VK_SUCCESS) && (aBufferData != NULL) && ((this->MemoryProperty & (device::memory::HOST_VISIBLE)) == device::memory::HOST_VISIBLE)) {
 			void* nptr = NULL;
-			Result = vkMapMemory(this->Context->handle(), this->MemoryHandle, 0, this->CreateInfo.size, 0, &nptr);
+			Result = this->Context->api().vkMapMemory(this->Context->handle(), this->MemoryHandle, 0, this->CreateInfo.size, 0, &nptr);
 			if ((nptr != NULL) && (Result == VK_SUCCESS)) {
 				memcpy(nptr, aBufferData, this->CreateInfo.size);
-				vkUnmapMemory(this->Context->handle(), this->MemoryHandle);
+				this->Context->api().vkUnmapMemory(this->Context->handle(), this->MemoryHandle);
+			}
+		}
+
+	}
+
+	buffer::buffer(context* aContext, int aMemoryType, int aUsage, size_t aMemorySize, void* aBufferData, bool aExportable) : buffer() {
+		if (aContext == nullptr) return;
+		// Exporting needs VK_KHR_external_memory_fd.
+		if (aExportable && (!aContext->api().isExternalMemoryFdAvailable)) return;
+		VkResult Result = VK_SUCCESS;
+		VkExternalMemoryBufferCreateInfo ExternalCreateInfo{};
+		VkExportMemoryAllocateInfo ExportAllocateInfo{};
+		this->Context = aContext;
+
+		ExternalCreateInfo.sType					= VkStructureType::VK_STRUCTURE_TYPE_EXTERNAL_MEMORY_BUFFER_CREATE_INFO;
+		ExternalCreateInfo.pNext					= NULL;
+		ExternalCreateInfo.handleTypes				= VkExternalMemoryHandleTypeFlagBits::VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_FD_BIT;
+
+		ExportAllocateInfo.sType					= VkStructureType::VK_STRUCTURE_TYPE_EXPORT_MEMORY_ALLOCATE_INFO;
+		ExportAllocateInfo.pNext					= NULL;
+		ExportAllocateInfo.handleTypes				= VkExternalMemoryHandleTypeFlagBits::VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_FD_BIT;
+
+		this->CreateInfo.sType						= VkStructureType::VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+		this->CreateInfo.pNext						= aExportable ? &ExternalCreateInfo : NULL;
+		this->CreateInfo.flags						= 0;
+		this->CreateInfo.size						= aMemorySize;
+		this->CreateInfo.usage						= (VkBufferUsageFlags)(aUsage | buffer::usage::TRANSFER_SRC | buffer::usage::TRANSFER_DST); // Enable Transfer
+		this->CreateInfo.sharingMode				= VkSharingMode::VK_SHARING_MODE_EXCLUSIVE;
+		this->CreateInfo.queueFamilyIndexCount		= 0;
+		this->CreateInfo.pQueueFamilyIndices		= NULL;
+
+		Result = aContext->api().vkCreateBuffer(aContext->handle(), &this->CreateInfo, NULL, &this->Handle);
+
+		if (Result == VkResult::VK_SUCCESS) {
+			VkMemoryRequirements MemoryRequirement;
+			aContext->api().vkGetBufferMemoryRequirements(aContext->handle(), this->Handle, &MemoryRequirement);
+
+			int MemoryTypeIndex = aContext->parent()->get_memory_type_index(MemoryRequirement, aMemoryType);
+			if (MemoryTypeIndex >= 0) {
+				this->AllocateInfo.sType			= VkStructureType::VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+				this->AllocateInfo.pNext			= aExportable ? &ExportAllocateInfo : NULL;
+				this->AllocateInfo.allocationSize	= MemoryRequirement.size;
+				this->AllocateInfo.memoryTypeIndex	= MemoryTypeIndex;
+				this->MemoryProperty				= aContext->parent()->get_memory_type(MemoryTypeIndex);
+
+				Result = this->Context->api().vkAllocateMemory(this->Context->handle(), &this->AllocateInfo, NULL, &this->MemoryHandle);
+			}
+			else {
+				Result = VkResult::VK_ERROR_FORMAT_NOT_SUPPORTED;
+			}
+		}
+
+		if (Result == VkResult::VK_SUCCESS) {
+			Result = this->Context->api().vkBindBufferMemory(this->Context->handle(), this->Handle, this->MemoryHandle, 0);
+		}
+
+		// Do not keep pointers to stack.
+		this->CreateInfo.pNext		= NULL;
+		this->AllocateInfo.pNext	= NULL;
+		this->isExportable			= aExportable && (Result == VkResult::VK_SUCCESS);
+
+		if ((Result == VkResult::VK_SUCCESS) && (aBufferData != NULL) && ((this->MemoryProperty & (device::memory::HOST_VISIBLE)) == device::memory::HOST_VISIBLE)) {
+			void* nptr = NULL;
+			Result = this->Context->api().vkMapMemory(this->Context->handle(), this->MemoryHandle, 0, this->CreateInfo.size, 0, &nptr);
+			if ((nptr != NULL) && (Result == VK_SUCCESS)) {
+				memcpy(nptr, aBufferData, this->CreateInfo.size);
+				this->Context->api().vkUnmapMemory(this->Context->handle(), this->MemoryHandle);
+			}
+		}
+	}
+
+	buffer::buffer(context* aContext, int aUsage, size_t aMemorySize, external_memory& aMemory) : buffer() {
+		if ((aContext == nullptr) || (aMemory.FD < 0)) return;
+		if (!aContext->api().isExternalMemoryFdAvailable) return;
+		// Memory can only be shared on the same physical device.
+		VkPhysicalDeviceIDProperties IDProperties = aContext->parent()->get_id_properties();
+		if (memcmp(IDProperties.deviceUUID, aMemory.DeviceUUID, VK_UUID_SIZE) != 0) return;
+
+		VkResult Result = VK_SUCCESS;
+		VkExternalMemoryBufferCreateInfo ExternalCreateInfo{};
+		VkImportMemoryFdInfoKHR ImportInfo{};
+		this->Context = aContext;
+
+		ExternalCreateInfo.sType					= VkStructureType::VK_STRUCTURE_TYPE_EXTERNAL_MEMORY_BUFFER_CREATE_INFO;
+		ExternalCreateInfo.pNext					= NULL;
+		ExternalCreateInfo.handleTypes				= VkExternalMemoryHandleTypeFlagBits::VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_FD_BIT;
+
+		ImportInfo.sType							= VkStructureType::VK_STRUCTURE_TYPE_IMPORT_MEMORY_FD_INFO_KHR;
+		ImportInfo.pNext							= NULL;
+		ImportInfo.handleType						= VkExternalMemoryHandleTypeFlagBits::VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_FD_BIT;
+		ImportInfo.fd								= aMemory.FD;
+
+		this->CreateInfo.sType						= VkStructureType::VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+		this->CreateInfo.pNext						= &ExternalCreateInfo;
+		this->CreateInfo.flags						= 0;
+		this->CreateInfo.size						= aMemorySize;
+		this->CreateInfo.usage						= (VkBufferUsageFlags)(aUsage | buffer::usage::TRANSFER_SRC | buffer::usage::TRANSFER_DST); // Enable Transfer
+		this->CreateInfo.sharingMode				= VkSharingMode::VK_SHARING_MODE_EXCLUSIVE;
+		this->CreateInfo.queueFamilyIndexCount		= 0;
+		this->CreateInfo.pQueueFamilyIndices		= NULL;
+
+		Result = aContext->api().vkCreateBuffer(aContext->handle(), &this->CreateInfo, NULL, &this->Handle);
+
+		if (Result == VkResult::VK_SUCCESS) {
+			this->AllocateInfo.sType				= VkStructureType::VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+			this->AllocateInfo.pNext				= &ImportInfo;
+			this->AllocateInfo.allocationSize		= aMemory.AllocationSize;
+			this->AllocateInfo.memoryTypeIndex		= aMemory.MemoryTypeIndex;
+			this->MemoryProperty					= aContext->parent()->get_memory_type(aMemory.MemoryTypeIndex);
+
+			// On success, the implementation owns the file descriptor.
+			Result = this->Context->api().vkAllocateMemory(this->Context->handle(), &this->AllocateInfo, NULL, &this->MemoryHandle);
+			if (Result == VkResult::VK_SUCCESS) {
+				aMemory.FD = -1;
 			}
 		}
 
+		if (Result == VkResult::VK_SUCCESS) {
+			Result = this->Context->api().vkBindBufferMemory(this->Context->handle(), this->Handle, this->MemoryHandle, 0);
+		}
+
+		this->CreateInfo.pNext		= NULL;
+		this->AllocateInfo.pNext	= NULL;
+
+		if (Result != VkResult::VK_SUCCESS) {
+			this->pmclearall();
+		}
 	}
 
 	buffer::~buffer() {
@@ -146,46 +281,26 @@ namespace geodesuka::core::gcl {
 		this->CreateInfo		= aInp.CreateInfo;
 		this->AllocateInfo		= aInp.AllocateInfo;
 		this->MemoryProperty	= aInp.MemoryProperty;
+		this->Owner				= -1;
+		this->isExportable		= false;
 		this->Count				= aInp.Count;
 		this->MemoryLayout		= aInp.MemoryLayout;
 
+		// Copies are never shared.
+		this->CreateInfo.pNext		= NULL;
+		this->AllocateInfo.pNext	= NULL;
+
 		VkResult Result = VkResult::VK_SUCCESS;
 		if (this->Context != nullptr) {
-			Result = vkCreateBuffer(this->Context->handle(), &this->CreateInfo, NULL, &this->Handle);
+			Result = this->Context->api().vkCreateBuffer(this->Context->handle(), &this->CreateInfo, NULL, &this->Handle);
 			if (Result == VkResult::VK_SUCCESS) {
-				Result = vkAllocateMemory(this->Context->handle(), &this->AllocateInfo, NULL, &this->MemoryHandle);
+				Result = this->Context->api().vkAllocateMemory(this->Context->handle(), &this->AllocateInfo, NULL, &this->MemoryHandle);
 			}
 			if (Result == VkResult::VK_SUCCESS) {
-				Result = vkBindBufferMemory(this->Context->handle(), this->Handle, this->MemoryHandle, 0);
+				Result = this->Context->api().vkBindBufferMemory(this->Context->handle(), this->Handle, this->MemoryHandle, 0);
 			}
 			if (Result == VkResult::VK_SUCCESS) {
-				VkSubmitInfo Submission{};
-				VkCommandBuffer CommandBuffer = VK_NULL_HANDLE;
-				VkFenceCreateInfo FenceCreateInfo{};
-				VkFence Fence;
-
-				Submission.sType					= VkStructureType::VK_STRUCTURE_TYPE_SUBMIT_INFO;
-				Submission.pNext					= NULL;
-				Submission.waitSemaphoreCount		= 0;
-				Submission.pWaitSemaphores			= NULL;
-				Submission.pWaitDstStageMask		= 0;
-				Submission.commandBufferCount		= 1;
-				Submission.pCommandBuffers			= &CommandBuffer;
-				Submission.signalSemaphoreCount		= 0;
-				Submission.pSignalSemaphores		= NULL;
-
-				FenceCreateInfo.sType				= VkStructureType::VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-				FenceCreateInfo.pNext				= NULL;
-				FenceCreateInfo.flags				= 0;
-
-				CommandBuffer = (*this << aInp);
-				Result = vkCreateFence(this->Context->handle(), &FenceCreateInfo, NULL, &Fence);
-				Result = this->Context->submit(device::qfs::TRANSFER, 1, &Submission, Fence);
-				Result = vkWaitForFences(this->Context->handle(), 1, &Fence, VK_TRUE, UINT64_MAX);
-
-				this->Context->destroy(device::qfs::TRANSFER, CommandBuffer);
-				vkDestroyFence(this->Context->handle(), Fence, NULL);
-
+				Result = this->duplicate(aInp);
 			}
 		}
 	}
@@ -197,6 +312,8 @@ namespace geodesuka::core::gcl {
 		this->AllocateInfo		= aInp.AllocateInfo;
 		this->MemoryHandle		= aInp.MemoryHandle;
 		this->MemoryProperty	= aInp.MemoryProperty;
+		this->Owner				= aInp.Owner;
+		this->isExportable		= aInp.isExportable;
 		this->Count				= aInp.Count;
 		this->MemoryLayout		= aInp.MemoryLayout;
 
@@ -206,6 +323,8 @@ namespace geodesuka::core::gcl {
 		aInp.AllocateInfo		= {};
 		aInp.MemoryHandle		= VK_NULL_HANDLE;
 		aInp.MemoryProperty		= 0;
+		aInp.Owner				= -1;
+		aInp.isExportable		= false;
 		aInp.Count				= 0;
 		aInp.MemoryLayout		= util::variable();
 	}
@@ -220,45 +339,25 @@ namespace geodesuka::core::gcl {
 		this->AllocateInfo		= aRhs.AllocateInfo;
 		//this->MemoryHandle		= aRhs.MemoryHandle;
 		this->MemoryProperty	= aRhs.MemoryProperty;
+		this->isExportable		= false;
 		this->Count				= aRhs.Count;
 		this->MemoryLayout		= aRhs.MemoryLayout;
 
+		// Copies are never shared.
+		this->CreateInfo.pNext		= NULL;
+		this->AllocateInfo.pNext	= NULL;
+
 		VkResult Result = VkResult::VK_SUCCESS;
 		if (this->Context != nullptr) {
-			Result = vkCreateBuffer(this->Context->handle(), &this->CreateInfo, NULL, &this->Handle);
+			Result = this->Context->api().vkCreateBuffer(this->Context->handle(), &this->CreateInfo, NULL, &this->Handle);
 			if (Result == VkResult::VK_SUCCESS) {
-				Result = vkAllocateMemory(this->Context->handle(), &this->AllocateInfo, NULL, &this->MemoryHandle);
+				Result = this->Context->api().vkAllocateMemory(this->Context->handle(), &this->AllocateInfo, NULL, &this->MemoryHandle);
 			}
 			if (Result == VkResult::VK_SUCCESS) {
-				Result = vkBindBufferMemory(this->Context->handle(), this->Handle, this->MemoryHandle, 0);
+				Result = this->Context->api().vkBindBufferMemory(this->Context->handle(), this->Handle, this->MemoryHandle, 0);
 			}
 			if (Result == VkResult::VK_SUCCESS) {
-				VkSubmitInfo Submission{};
-				VkCommandBuffer CommandBuffer = VK_NULL_HANDLE;
-				VkFenceCreateInfo FenceCreateInfo{};
-				VkFence Fence;
-
-				Submission.sType					= VkStructureType::VK_STRUCTURE_TYPE_SUBMIT_INFO;
-				Submission.pNext					= NULL;
-				Submission.waitSemaphoreCount		= 0;
-				Submission.pWaitSemaphores			= NULL;
-				Submission.pWaitDstStageMask		= 0;
-				Submission.commandBufferCount		= 1;
-				Submission.pCommandBuffers			= &CommandBuffer;
-				Submission.signalSemaphoreCount		= 0;
-				Submission.pSignalSemaphores		= NULL;
-
-				FenceCreateInfo.sType				= VkStructureType::VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-				FenceCreateInfo.pNext				= NULL;
-				FenceCreateInfo.flags				= 0;
-
-				CommandBuffer = (*this << aRhs);
-				Result = vkCreateFence(this->Context->handle(), &FenceCreateInfo, NULL, &Fence);
-				Result = this->Context->submit(device::qfs::TRANSFER, 1, &Submission, Fence);
-				Result = vkWaitForFences(this->Context->handle(), 1, &Fence, VK_TRUE, UINT64_MAX);
-
-				this->Context->destroy(device::qfs::TRANSFER, CommandBuffer);
-				vkDestroyFence(this->Context->handle(), Fence, NULL);
+				Result = this->duplicate(aRhs);
 			}
 		}
 
@@ -274,6 +373,8 @@ namespace geodesuka::core::gcl {
 		this->AllocateInfo		= aRhs.AllocateInfo;
 		this->MemoryHandle		= aRhs.MemoryHandle;
 		this->MemoryProperty	= aRhs.MemoryProperty;
+		this->Owner				= aRhs.Owner;
+		this->isExportable		= aRhs.isExportable;
 		this->Count				= aRhs.Count;
 		this->MemoryLayout		= aRhs.MemoryLayout;
 
@@ -283,6 +384,8 @@ namespace geodesuka::core::gcl {
 		aRhs.AllocateInfo		= {};
 		aRhs.MemoryHandle		= VK_NULL_HANDLE;
 		aRhs.MemoryProperty		= 0;
+		aRhs.Owner				= -1;
+		aRhs.isExportable		= false;
 		aRhs.Count				= 0;
 		aRhs.MemoryLayout		= util::variable();
 
@@ -290,6 +393,10 @@ namespace geodesuka::core::gcl {
 	}
 
 	VkCommandBuffer buffer::operator<<(buffer& aRhs) {
+		return this->copy(device::qfs::TRANSFER, aRhs);
+	}
+
+	VkCommandBuffer buffer::copy(device::qfs aQFS, buffer& aRhs) {
 		VkCommandBuffer CommandBuffer = VK_NULL_HANDLE;
 		// Both operands must share the same parent context, and have same memory size.
 		if ((this->Context != aRhs.Context) || ((size_t)this->CreateInfo.size != aRhs.CreateInfo.size)) return CommandBuffer;
@@ -314,11 +421,11 @@ namespace geodesuka::core::gcl {
 		Region.size							= this->CreateInfo.size;
 
 		//Result = this->Context->create(context::cmdtype::TRANSFER_OTS, 1, &CommandBuffer);
-		CommandBuffer = this->Context->create(device::qfs::TRANSFER);
+		CommandBuffer = this->Context->create(aQFS);
 		if (CommandBuffer != VK_NULL_HANDLE) {
-			Result = vkBeginCommandBuffer(CommandBuffer, &BeginInfo);
-			vkCmdCopyBuffer(CommandBuffer, aRhs.Handle, this->Handle, 1, &Region);
-			Result = vkEndCommandBuffer(CommandBuffer);
+			Result = this->Context->api().vkBeginCommandBuffer(CommandBuffer, &BeginInfo);
+			this->Context->api().vkCmdCopyBuffer(CommandBuffer, aRhs.Handle, this->Handle, 1, &Region);
+			Result = this->Context->api().vkEndCommandBuffer(CommandBuffer);
 		}
 		return CommandBuffer;
 	}
@@ -378,10 +485,10 @@ namespace geodesuka::core::gcl {
 
 		//Result = this->Context->create(context::cmdtype::TRANSFER_OTS, 1, &CommandBuffer);
 		CommandBuffer = this->Context->create(device::qfs::TRANSFER);
-		Result = vkBeginCommandBuffer(CommandBuffer, &BeginInfo);
+		Result = this->Context->api().vkBeginCommandBuffer(CommandBuffer, &BeginInfo);
 
 		// Use barrier for transition if layout doesn't match.
-		vkCmdPipelineBarrier(CommandBuffer,
+		this->Context->api().vkCmdPipelineBarrier(CommandBuffer,
 			VkPipelineStageFlagBits::VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
 			VkPipelineStageFlagBits::VK_PIPELINE_STAGE_TRANSFER_BIT,
 			0,
@@ -390,13 +497,13 @@ namespace geodesuka::core::gcl {
 			Barrier.size(), Barrier.data()
 		);
 
-		vkCmdCopyImageToBuffer(CommandBuffer,
+		this->Context->api().vkCmdCopyImageToBuffer(CommandBuffer,
 			aRhs.Handle, VkImageLayout::VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
 			this->Handle,
 			1, &Region
 		);
 
-		Result = vkEndCommandBuffer(CommandBuffer);
+		Result = this->Context->api().vkEndCommandBuffer(CommandBuffer);
 
 		return CommandBuffer;
 	}
@@ -420,12 +527,12 @@ namespace geodesuka::core::gcl {
 
 		VkResult Result = VkResult::VK_SUCCESS;
 		void* nptr = NULL;
-		Result = vkMapMemory(this->Context->handle(), this->MemoryHandle, 0, VK_WHOLE_SIZE, 0, &nptr);
+		Result = this->Context->api().vkMapMemory(this->Context->handle(), this->MemoryHandle, 0, VK_WHOLE_SIZE, 0, &nptr);
 		if ((nptr == NULL) || (Result != VK_SUCCESS)) return;
 		for (uint32_t i = 0; i < aRegionCount; i++) {
 			memcpy((void*)((uintptr_t)nptr + (uintptr_t)aRegion[i].dstOffset), (void*)((uintptr_t)aData + (uintptr_t)aRegion[i].srcOffset), aRegion[i].size);
 		}
-		vkUnmapMemory(this->Context->handle(), this->MemoryHandle);
+		this->Context->api().vkUnmapMemory(this->Context->handle(), this->MemoryHandle);
 
 	}
 
@@ -443,27 +550,195 @@ namespace geodesuka::core::gcl {
 
 		void* nptr = NULL;
 		VkResult Result = VkResult::VK_SUCCESS;
-		Result = vkMapMemory(this->Context->handle(), this->MemoryHandle, 0, VK_WHOLE_SIZE, 0, &nptr);
+		Result = this->Context->api().vkMapMemory(this->Context->handle(), this->MemoryHandle, 0, VK_WHOLE_SIZE, 0, &nptr);
 		if ((nptr == NULL) || (Result != VK_SUCCESS)) return;
 		for (uint32_t i = 0; i < aRegionCount; i++) {
 			memcpy((void*)((uintptr_t)aData + (uintptr_t)aRegion[i].dstOffset), (void*)((uintptr_t)nptr + (uintptr_t)aRegion[i].srcOffset), aRegion[i].size);
 		}
-		vkUnmapMemory(this->Context->handle(), this->MemoryHandle);
+		this->Context->api().vkUnmapMemory(this->Context->handle(), this->MemoryHandle);
 
 	}
 
+	external_memory buffer::export_memory() {
+		external_memory temp;
+		if ((this->Context == nullptr) || (this->MemoryHandle == VK_NULL_HANDLE) || (!this->isExportable)) return temp;
+
+		if (!this->Context->api().isExternalMemoryFdAvailable) return temp;
+
+		VkMemoryGetFdInfoKHR GetInfo{};
+		GetInfo.sType			= VkStructureType::VK_STRUCTURE_TYPE_MEMORY_GET_FD_INFO_KHR;
+		GetInfo.pNext			= NULL;
+		GetInfo.memory			= this->MemoryHandle;
+		GetInfo.handleType		= VkExternalMemoryHandleTypeFlagBits::VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_FD_BIT;
+
+		if (this->Context->api().vkGetMemoryFdKHR(this->Context->handle(), &GetInfo, &temp.FD) != VkResult::VK_SUCCESS) {
+			temp.FD = -1;
+			return temp;
+		}
+
+		VkPhysicalDeviceIDProperties IDProperties = this->Context->parent()->get_id_properties();
+		temp.AllocationSize		= this->AllocateInfo.allocationSize;
+		temp.MemoryTypeIndex	= this->AllocateInfo.memoryTypeIndex;
+		temp.Dedicated			= VK_FALSE;
+		memcpy(temp.DeviceUUID, IDProperties.deviceUUID, VK_UUID_SIZE);
+		return temp;
+	}
+
+	VkResult buffer::duplicate(buffer& aSource) {
+		VkResult Result = VkResult::VK_SUCCESS;
+		// Exclusive source is read on the family owning it, an unowned one on the transfer family.
+		device::qfs CopyQFS = device::qfs::TRANSFER;
+		if ((aSource.Owner != -1) && (aSource.Owner == this->Context->qfi(device::qfs::GRAPHICS_AND_COMPUTE))) {
+			CopyQFS = device::qfs::GRAPHICS_AND_COMPUTE;
+		}
+		else if ((aSource.Owner != -1) && (aSource.Owner == this->Context->qfi(device::qfs::COMPUTE))) {
+			CopyQFS = device::qfs::COMPUTE;
+		}
+
+		VkSubmitInfo Submission[3] = {};
+		VkCommandBuffer CommandBuffer = VK_NULL_HANDLE;
+		VkFenceCreateInfo FenceCreateInfo{};
+		VkFence Fence[2] = { VK_NULL_HANDLE, VK_NULL_HANDLE };
+
+		CommandBuffer = this->copy(CopyQFS, aSource);
+		if (CommandBuffer == VK_NULL_HANDLE) return VkResult::VK_ERROR_INITIALIZATION_FAILED;
+		this->Owner = this->Context->qfi(CopyQFS);
+
+		Submission[0].sType					= VkStructureType::VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		Submission[0].pNext					= NULL;
+		Submission[0].waitSemaphoreCount	= 0;
+		Submission[0].pWaitSemaphores		= NULL;
+		Submission[0].pWaitDstStageMask		= NULL;
+		Submission[0].commandBufferCount	= 1;
+		Submission[0].pCommandBuffers		= &CommandBuffer;
+		Submission[0].signalSemaphoreCount	= 0;
+		Submission[0].pSignalSemaphores		= NULL;
+
+		FenceCreateInfo.sType				= VkStructureType::VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+		FenceCreateInfo.pNext				= NULL;
+		FenceCreateInfo.flags				= 0;
+
+		// Release from the copying family, acquire on graphics, where the buffer is used.
+		ownership_transfer Ownership(
+			this->Context,
+			CopyQFS, VkPipelineStageFlagBits::VK_PIPELINE_STAGE_TRANSFER_BIT,
+			device::qfs::GRAPHICS_AND_COMPUTE, VkPipelineStageFlagBits::VK_PIPELINE_STAGE_ALL_COMMANDS_BIT
+		);
+		Ownership.add(*this,
+			VkAccessFlagBits::VK_ACCESS_TRANSFER_WRITE_BIT,
+			VkAccessFlagBits::VK_ACCESS_MEMORY_READ_BIT | VkAccessFlagBits::VK_ACCESS_MEMORY_WRITE_BIT
+		);
+		Result = Ownership.build();
+		Submission[1] = Ownership.release();
+		Submission[2] = Ownership.acquire();
+
+		if (Result == VkResult::VK_SUCCESS) {
+			Result = this->Context->api().vkCreateFence(this->Context->handle(), &FenceCreateInfo, NULL, &Fence[0]);
+		}
+		if (Result == VkResult::VK_SUCCESS) {
+			Result = this->Context->api().vkCreateFence(this->Context->handle(), &FenceCreateInfo, NULL, &Fence[1]);
+		}
+
+		// Copy and release must be in the same queue submission.
+		VkResult CopyResult = Result == VkResult::VK_SUCCESS ? this->Context->submit(CopyQFS, 2, &Submission[0], Fence[0]) : Result;
+		VkResult AcquireResult = CopyResult == VkResult::VK_SUCCESS ? this->Context->submit(device::qfs::GRAPHICS_AND_COMPUTE, 1, &Submission[2], Fence[1]) : CopyResult;
+		if (CopyResult == VkResult::VK_SUCCESS) {
+			CopyResult = this->Context->api().vkWaitForFences(this->Context->handle(), 1, &Fence[0], VK_TRUE, UINT64_MAX);
+		}
+		if (AcquireResult == VkResult::VK_SUCCESS) {
+			AcquireResult = this->Context->api().vkWaitForFences(this->Context->handle(), 1, &Fence[1], VK_TRUE, UINT64_MAX);
+		}
+
+		if ((CopyResult == VkResult::VK_SUCCESS) && (AcquireResult == VkResult::VK_SUCCESS)) {
+			Ownership.commit();
+			// First use of an unowned source made it owned by the copying family.
+			if (aSource.Owner == -1) {
+				aSource.Owner = this->Context->qfi(CopyQFS);
+			}
+		}
+		else {
+			// Contents and ownership are undefined.
+			this->Owner = -1;
+			Result = CopyResult != VkResult::VK_SUCCESS ? CopyResult : AcquireResult;
+		}
+
+		this->Context->destroy(CopyQFS, CommandBuffer);
+		if (Fence[0] != VK_NULL_HANDLE) {
+			this->Context->api().vkDestroyFence(this->Context->handle(), Fence[0], NULL);
+		}
+		if (Fence[1] != VK_NULL_HANDLE) {
+			this->Context->api().vkDestroyFence(this->Context->handle(), Fence[1], NULL);
+		}
+		return Result;
+	}
+
+	VkCommandBuffer buffer::release_external(device::qfs aQFS) {
+		VkCommandBuffer CommandBuffer = VK_NULL_HANDLE;
+		// Only the owning family can release, an unowned buffer has nothing to hand over.
+		if ((this->Context == nullptr) || (this->Handle == VK_NULL_HANDLE) || (this->Owner == -1) || (this->Owner != this->Context->qfi(aQFS))) return CommandBuffer;
+		return this->external_barrier(aQFS, this->Owner, VK_QUEUE_FAMILY_EXTERNAL);
+	}
+
+	VkCommandBuffer buffer::acquire_external(device::qfs aQFS) {
+		VkCommandBuffer CommandBuffer = VK_NULL_HANDLE;
+		if ((this->Context == nullptr) || (this->Handle == VK_NULL_HANDLE) || (this->Context->qfi(aQFS) == -1)) return CommandBuffer;
+		return this->external_barrier(aQFS, VK_QUEUE_FAMILY_EXTERNAL, this->Context->qfi(aQFS));
+	}
+
 	VkBuffer& buffer::handle() {
 		return this->Handle;
 	}
 
+	VkCommandBuffer buffer::external_barrier(device::qfs aQFS, uint32_t aSrcQFI, uint32_t aDstQFI) {
+		VkResult Result = VkResult::VK_SUCCESS;
+		VkCommandBufferBeginInfo BeginInfo{};
+		VkBufferMemoryBarrier Barrier{};
+		bool isRelease = (aDstQFI == VK_QUEUE_FAMILY_EXTERNAL);
+
+		BeginInfo.sType						= VkStructureType::VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		BeginInfo.pNext						= NULL;
+		BeginInfo.flags						= 0;
+		BeginInfo.pInheritanceInfo			= NULL;
+
+		// Release ignores dstAccessMask, acquire ignores srcAccessMask.
+		Barrier.sType						= VkStructureType::VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+		Barrier.pNext						= NULL;
+		Barrier.srcAccessMask				= isRelease ? VkAccessFlagBits::VK_ACCESS_MEMORY_WRITE_BIT : 0;
+		Barrier.dstAccessMask				= isRelease ? 0 : (VkAccessFlagBits::VK_ACCESS_MEMORY_READ_BIT | VkAccessFlagBits::VK_ACCESS_MEMORY_WRITE_BIT);
+		Barrier.srcQueueFamilyIndex			= aSrcQFI;
+		Barrier.dstQueueFamilyIndex			= aDstQFI;
+		Barrier.buffer						= this->Handle;
+		Barrier.offset						= 0;
+		Barrier.size						= VK_WHOLE_SIZE;
+
+		VkCommandBuffer CommandBuffer = this->Context->create(aQFS);
+		if (CommandBuffer == VK_NULL_HANDLE) return CommandBuffer;
+		Result = this->Context->api().vkBeginCommandBuffer(CommandBuffer, &BeginInfo);
+
+		this->Context->api().vkCmdPipelineBarrier(CommandBuffer,
+			isRelease ? VkPipelineStageFlagBits::VK_PIPELINE_STAGE_ALL_COMMANDS_BIT : VkPipelineStageFlagBits::VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+			isRelease ? VkPipelineStageFlagBits::VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT : VkPipelineStageFlagBits::VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+			0,
+			0, NULL,
+			1, &Barrier,
+			0, NULL
+		);
+
+		Result = this->Context->api().vkEndCommandBuffer(CommandBuffer);
+
+		// Owned by no family of this context until acquired again.
+		this->Owner = isRelease ? -1 : (int)aDstQFI;
+		return CommandBuffer;
+	}
+
 	void buffer::pmclearall() {
 		if (this->Context != nullptr) {
 			if (this->Handle != VK_NULL_HANDLE) {
-				vkDestroyBuffer(this->Context->handle(), this->Handle, NULL);
+				this->Context->api().vkDestroyBuffer(this->Context->handle(), this->Handle, NULL);
 				this->Handle = VK_NULL_HANDLE;
 			}
 			if (this->MemoryHandle != VK_NULL_HANDLE) {
-				vkFreeMemory(this->Context->handle(), this->MemoryHandle, NULL);
+				this->Context->api().vkFreeMemory(this->Context->handle(), this->MemoryHandle, NULL);
 				this->MemoryHandle = VK_NULL_HANDLE;
 			}
 		}
@@ -472,6 +747,8 @@ namespace geodesuka::core::gcl {
 		this->CreateInfo = {};
 		this->AllocateInfo = {};
 		this->MemoryProperty = 0;
+		this->Owner = -1;
+		this->isExportable = false;
 
 		this->Count = 0;
 		this->MemoryLayout = util::variable();
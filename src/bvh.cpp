@@ -0,0 +1,560 @@
+#include <geodesuka/core/logic/bvh.h>
+
+#include <math.h>
+#include <float.h>
+
+#include <algorithm>
+
+namespace geodesuka::core::logic {
+
+	// Bins of the SAH rebuild.
+	static constexpr int BIN_COUNT = 16;
+
+	static float3 centroid(const bvh::aabb& aBox) {
+		return float3((aBox.Min.x + aBox.Max.x) * 0.5f, (aBox.Min.y + aBox.Max.y) * 0.5f, (aBox.Min.z + aBox.Max.z) * 0.5f);
+	}
+
+	static bool is_overlapping(const bvh::aabb& aLhs, const bvh::aabb& aRhs) {
+		return (aLhs.Min.x <= aRhs.Max.x) && (aLhs.Max.x >= aRhs.Min.x)
+			&& (aLhs.Min.y <= aRhs.Max.y) && (aLhs.Max.y >= aRhs.Min.y)
+			&& (aLhs.Min.z <= aRhs.Max.z) && (aLhs.Max.z >= aRhs.Min.z);
+	}
+
+	static bool is_equal(const bvh::aabb& aLhs, const bvh::aabb& aRhs) {
+		return (aLhs.Min.x == aRhs.Min.x) && (aLhs.Min.y == aRhs.Min.y) && (aLhs.Min.z == aRhs.Min.z)
+			&& (aLhs.Max.x == aRhs.Max.x) && (aLhs.Max.y == aRhs.Max.y) && (aLhs.Max.z == aRhs.Max.z);
+	}
+
+	// Entry distance of a ray into a box, FLT_MAX if missed within aMaxDistance.
+	static float intersect(const bvh::aabb& aBox, const float3& aOrigin, const float3& aInverse, float aMaxDistance) {
+		float TX1 = (aBox.Min.x - aOrigin.x) * aInverse.x;
+		float TX2 = (aBox.Max.x - aOrigin.x) * aInverse.x;
+		float TY1 = (aBox.Min.y - aOrigin.y) * aInverse.y;
+		float TY2 = (aBox.Max.y - aOrigin.y) * aInverse.y;
+		float TZ1 = (aBox.Min.z - aOrigin.z) * aInverse.z;
+		float TZ2 = (aBox.Max.z - aOrigin.z) * aInverse.z;
+		float Near = std::max(std::max(std::min(TX1, TX2), std::min(TY1, TY2)), std::min(TZ1, TZ2));
+		float Far = std::min(std::min(std::max(TX1, TX2), std::max(TY1, TY2)), std::max(TZ1, TZ2));
+		Near = std::max(Near, 0.0f);
+		if ((Near > Far) || (Near > aMaxDistance)) return FLT_MAX;
+		return Near;
+	}
+
+	bvh::bvh() {
+		this->Root = INVALID_HANDLE;
+		this->LeafCount = 0;
+		this->BuiltCost = 0.0f;
+	}
+
+	bvh::~bvh() {}
+
+	uint32_t bvh::insert(const aabb& aBounds, void* aUserData) {
+		this->Mutex.lock();
+		uint32_t Handle = INVALID_HANDLE;
+		if (this->FreeHandle.size() > 0) {
+			Handle = this->FreeHandle.back();
+			this->FreeHandle.pop_back();
+		}
+		else {
+			Handle = (uint32_t)this->LeafNode.size();
+			this->LeafNode.push_back(INVALID_HANDLE);
+			this->UserData.push_back(nullptr);
+		}
+
+		uint32_t Leaf = this->allocate_node();
+		this->Node[Leaf].Box		= aBounds;
+		this->Node[Leaf].Handle		= Handle;
+		this->LeafNode[Handle]		= Leaf;
+		this->UserData[Handle]		= aUserData;
+		this->insert_leaf(Leaf);
+		this->LeafCount += 1;
+		this->Mutex.unlock();
+		return Handle;
+	}
+
+	void bvh::move(uint32_t aHandle, const aabb& aBounds) {
+		this->Mutex.lock();
+		if ((aHandle < this->LeafNode.size()) && (this->LeafNode[aHandle] != INVALID_HANDLE)) {
+			node& Leaf = this->Node[this->LeafNode[aHandle]];
+			if (!is_equal(Leaf.Box, aBounds)) {
+				Leaf.Box = aBounds;
+				this->Moved.push_back(aHandle);
+			}
+		}
+		this->Mutex.unlock();
+	}
+
+	void bvh::remove(uint32_t aHandle) {
+		this->Mutex.lock();
+		if ((aHandle < this->LeafNode.size()) && (this->LeafNode[aHandle] != INVALID_HANDLE)) {
+			uint32_t Leaf = this->LeafNode[aHandle];
+			this->remove_leaf(Leaf);
+			this->free_node(Leaf);
+			this->LeafNode[aHandle] = INVALID_HANDLE;
+			this->UserData[aHandle] = nullptr;
+			this->FreeHandle.push_back(aHandle);
+			this->LeafCount -= 1;
+		}
+		this->Mutex.unlock();
+	}
+
+	void bvh::clear() {
+		this->Mutex.lock();
+		this->Node.clear();
+		this->FreeNode.clear();
+		this->Root = INVALID_HANDLE;
+		this->LeafNode.clear();
+		this->UserData.clear();
+		this->FreeHandle.clear();
+		this->Moved.clear();
+		this->LeafCount = 0;
+		this->BuiltCost = 0.0f;
+		this->Mutex.unlock();
+	}
+
+	void bvh::refit() {
+		this->Mutex.lock();
+		this->refit_locked();
+		this->Mutex.unlock();
+	}
+
+	void bvh::rebuild() {
+		this->Mutex.lock();
+		this->rebuild_locked();
+		this->Mutex.unlock();
+	}
+
+	void bvh::maintain(float aRatio) {
+		this->Mutex.lock();
+		this->refit_locked();
+		// Incremental inserts and refits only ever degrade the tree.
+		if (this->cost_locked() > aRatio * this->BuiltCost) {
+			this->rebuild_locked();
+		}
+		this->Mutex.unlock();
+	}
+
+	size_t bvh::size() {
+		this->Mutex.lock_shared();
+		size_t Count = this->LeafCount;
+		this->Mutex.unlock_shared();
+		return Count;
+	}
+
+	float bvh::cost() {
+		this->Mutex.lock_shared();
+		float Cost = this->cost_locked();
+		this->Mutex.unlock_shared();
+		return Cost;
+	}
+
+	void* bvh::user_data(uint32_t aHandle) {
+		void* Data = nullptr;
+		this->Mutex.lock_shared();
+		if (aHandle < this->UserData.size()) {
+			Data = this->UserData[aHandle];
+		}
+		this->Mutex.unlock_shared();
+		return Data;
+	}
+
+	size_t bvh::query(const aabb& aBounds, std::vector<void*>& aResult) {
+		aResult.clear();
+		this->Mutex.lock_shared();
+		if (this->Root != INVALID_HANDLE) {
+			std::vector<uint32_t> Stack;
+			Stack.push_back(this->Root);
+			while (Stack.size() > 0) {
+				const node& Current = this->Node[Stack.back()];
+				Stack.pop_back();
+				if (!is_overlapping(Current.Box, aBounds)) continue;
+				if (Current.Handle != INVALID_HANDLE) {
+					aResult.push_back(this->UserData[Current.Handle]);
+				}
+				else {
+					Stack.push_back(Current.Child[0]);
+					Stack.push_back(Current.Child[1]);
+				}
+			}
+		}
+		this->Mutex.unlock_shared();
+		return aResult.size();
+	}
+
+	size_t bvh::query(const float4 aPlane[6], std::vector<void*>& aResult) {
+		aResult.clear();
+		this->Mutex.lock_shared();
+		if (this->Root != INVALID_HANDLE) {
+			// Node and the planes it may still cross, a clear mask is fully inside.
+			std::vector<std::pair<uint32_t, uint32_t>> Stack;
+			Stack.push_back(std::make_pair(this->Root, 0x3Fu));
+			while (Stack.size() > 0) {
+				uint32_t Index = Stack.back().first;
+				uint32_t Mask = Stack.back().second;
+				Stack.pop_back();
+				const node& Current = this->Node[Index];
+
+				bool isOutside = false;
+				if (Mask != 0) {
+					float3 Center = centroid(Current.Box);
+					float3 Half((Current.Box.Max.x - Current.Box.Min.x) * 0.5f, (Current.Box.Max.y - Current.Box.Min.y) * 0.5f, (Current.Box.Max.z - Current.Box.Min.z) * 0.5f);
+					for (int p = 0; p < 6; p++) {
+						if ((Mask & (1u << p)) == 0) continue;
+						float Distance = aPlane[p].x * Center.x + aPlane[p].y * Center.y + aPlane[p].z * Center.z + aPlane[p].t;
+						float Extent = fabsf(aPlane[p].x) * Half.x + fabsf(aPlane[p].y) * Half.y + fabsf(aPlane[p].z) * Half.z;
+						if (Distance + Extent < 0.0f) {
+							isOutside = true;
+							break;
+						}
+						if (Distance - Extent >= 0.0f) {
+							Mask &= ~(1u << p);
+						}
+					}
+				}
+				if (isOutside) continue;
+
+				if (Current.Handle != INVALID_HANDLE) {
+					aResult.push_back(this->UserData[Current.Handle]);
+				}
+				else {
+					Stack.push_back(std::make_pair(Current.Child[0], Mask));
+					Stack.push_back(std::make_pair(Current.Child[1], Mask));
+				}
+			}
+		}
+		this->Mutex.unlock_shared();
+		return aResult.size();
+	}
+
+	void bvh::raycast(size_t aRayCount, const ray* aRay, hit* aHit) {
+		this->Mutex.lock_shared();
+		// Reused by every ray of the batch.
+		std::vector<std::pair<uint32_t, float>> Stack;
+		for (size_t i = 0; i < aRayCount; i++) {
+			aHit[i].Handle		= INVALID_HANDLE;
+			aHit[i].UserData	= nullptr;
+			aHit[i].Distance	= FLT_MAX;
+			if (this->Root == INVALID_HANDLE) continue;
+
+			const ray& Ray = aRay[i];
+			float3 Inverse(1.0f / Ray.Direction.x, 1.0f / Ray.Direction.y, 1.0f / Ray.Direction.z);
+			float Nearest = Ray.MaxDistance;
+			float RootDistance = intersect(this->Node[this->Root].Box, Ray.Origin, Inverse, Nearest);
+			if (RootDistance == FLT_MAX) continue;
+
+			Stack.clear();
+			Stack.push_back(std::make_pair(this->Root, RootDistance));
+			while (Stack.size() > 0) {
+				uint32_t Index = Stack.back().first;
+				float Distance = Stack.back().second;
+				Stack.pop_back();
+				// A closer leaf was found since this node was pushed.
+				if (Distance > Nearest) continue;
+
+				const node& Current = this->Node[Index];
+				if (Current.Handle != INVALID_HANDLE) {
+					if (Distance < aHit[i].Distance) {
+						aHit[i].Handle		= Current.Handle;
+						aHit[i].UserData	= this->UserData[Current.Handle];
+						aHit[i].Distance	= Distance;
+						Nearest				= Distance;
+					}
+					continue;
+				}
+
+				// Nearer child is pushed last so it is visited first.
+				float Near = intersect(this->Node[Current.Child[0]].Box, Ray.Origin, Inverse, Nearest);
+				float Far = intersect(this->Node[Current.Child[1]].Box, Ray.Origin, Inverse, Nearest);
+				uint32_t NearChild = Current.Child[0];
+				uint32_t FarChild = Current.Child[1];
+				if (Far < Near) {
+					std::swap(Near, Far);
+					std::swap(NearChild, FarChild);
+				}
+				if (Far != FLT_MAX) {
+					Stack.push_back(std::make_pair(FarChild, Far));
+				}
+				if (Near != FLT_MAX) {
+					Stack.push_back(std::make_pair(NearChild, Near));
+				}
+			}
+		}
+		this->Mutex.unlock_shared();
+	}
+
+	uint32_t bvh::allocate_node() {
+		uint32_t Index = INVALID_HANDLE;
+		if (this->FreeNode.size() > 0) {
+			Index = this->FreeNode.back();
+			this->FreeNode.pop_back();
+		}
+		else {
+			Index = (uint32_t)this->Node.size();
+			this->Node.push_back(node{});
+		}
+		node& New = this->Node[Index];
+		New.Parent		= INVALID_HANDLE;
+		New.Child[0]	= INVALID_HANDLE;
+		New.Child[1]	= INVALID_HANDLE;
+		New.Handle		= INVALID_HANDLE;
+		return Index;
+	}
+
+	void bvh::free_node(uint32_t aNode) {
+		this->Node[aNode].Handle = INVALID_HANDLE;
+		this->FreeNode.push_back(aNode);
+	}
+
+	void bvh::insert_leaf(uint32_t aLeaf) {
+		if (this->Root == INVALID_HANDLE) {
+			this->Root = aLeaf;
+			this->Node[aLeaf].Parent = INVALID_HANDLE;
+			return;
+		}
+
+		// Descend to the sibling adding the least area, cost of a new parent
+		// here against the cheapest cost of pushing the leaf into a child.
+		aabb LeafBox = this->Node[aLeaf].Box;
+		uint32_t Index = this->Root;
+		while (this->Node[Index].Handle == INVALID_HANDLE) {
+			const node& Current = this->Node[Index];
+			float Area = area(Current.Box);
+			float Combined = area(merge(Current.Box, LeafBox));
+			float Cost = 2.0f * Combined;
+			float Inheritance = 2.0f * (Combined - Area);
+
+			float ChildCost[2];
+			for (int c = 0; c < 2; c++) {
+				const node& Child = this->Node[Current.Child[c]];
+				float Enlarged = area(merge(Child.Box, LeafBox));
+				ChildCost[c] = (Child.Handle != INVALID_HANDLE ? Enlarged : Enlarged - area(Child.Box)) + Inheritance;
+			}
+			if ((Cost < ChildCost[0]) && (Cost < ChildCost[1])) break;
+			Index = ChildCost[0] < ChildCost[1] ? Current.Child[0] : Current.Child[1];
+		}
+
+		uint32_t Sibling = Index;
+		uint32_t OldParent = this->Node[Sibling].Parent;
+		uint32_t NewParent = this->allocate_node();
+		this->Node[NewParent].Parent	= OldParent;
+		this->Node[NewParent].Box		= merge(LeafBox, this->Node[Sibling].Box);
+		this->Node[NewParent].Child[0]	= Sibling;
+		this->Node[NewParent].Child[1]	= aLeaf;
+		this->Node[Sibling].Parent		= NewParent;
+		this->Node[aLeaf].Parent		= NewParent;
+
+		if (OldParent == INVALID_HANDLE) {
+			this->Root = NewParent;
+		}
+		else {
+			node& Parent = this->Node[OldParent];
+			Parent.Child[Parent.Child[0] == Sibling ? 0 : 1] = NewParent;
+			this->refit_from(OldParent);
+		}
+	}
+
+	void bvh::remove_leaf(uint32_t aLeaf) {
+		if (aLeaf == this->Root) {
+			this->Root = INVALID_HANDLE;
+			return;
+		}
+
+		// Sibling takes the place of the parent.
+		uint32_t Parent = this->Node[aLeaf].Parent;
+		uint32_t GrandParent = this->Node[Parent].Parent;
+		uint32_t Sibling = this->Node[Parent].Child[0] == aLeaf ? this->Node[Parent].Child[1] : this->Node[Parent].Child[0];
+		this->Node[Sibling].Parent = GrandParent;
+		if (GrandParent == INVALID_HANDLE) {
+			this->Root = Sibling;
+		}
+		else {
+			node& Above = this->Node[GrandParent];
+			Above.Child[Above.Child[0] == Parent ? 0 : 1] = Sibling;
+			this->refit_from(GrandParent);
+		}
+		this->free_node(Parent);
+	}
+
+	void bvh::refit_from(uint32_t aNode) {
+		uint32_t Index = aNode;
+		while (Index != INVALID_HANDLE) {
+			node& Current = this->Node[Index];
+			aabb Box = merge(this->Node[Current.Child[0]].Box, this->Node[Current.Child[1]].Box);
+			// Ancestors only depend on this box.
+			if (is_equal(Box, Current.Box)) break;
+			Current.Box = Box;
+			Index = Current.Parent;
+		}
+	}
+
+	void bvh::refit_locked() {
+		for (size_t i = 0; i < this->Moved.size(); i++) {
+			uint32_t Handle = this->Moved[i];
+			// Removed after it moved.
+			if (this->LeafNode[Handle] == INVALID_HANDLE) continue;
+			uint32_t Parent = this->Node[this->LeafNode[Handle]].Parent;
+			if (Parent != INVALID_HANDLE) {
+				this->refit_from(Parent);
+			}
+		}
+		this->Moved.clear();
+	}
+
+	void bvh::rebuild_locked() {
+		this->Moved.clear();
+		if (this->LeafCount == 0) {
+			this->Node.clear();
+			this->FreeNode.clear();
+			this->Root = INVALID_HANDLE;
+			this->BuiltCost = 0.0f;
+			return;
+		}
+
+		std::vector<uint32_t> Handle;
+		std::vector<aabb> Box(this->LeafNode.size());
+		Handle.reserve(this->LeafCount);
+		for (uint32_t i = 0; i < this->LeafNode.size(); i++) {
+			if (this->LeafNode[i] == INVALID_HANDLE) continue;
+			Handle.push_back(i);
+			Box[i] = this->Node[this->LeafNode[i]].Box;
+		}
+
+		// Depth first into a fresh array, free list is gone.
+		std::vector<node> Output;
+		Output.reserve(2 * Handle.size() - 1);
+		this->Root = this->build(Output, Handle, Box, 0, Handle.size(), INVALID_HANDLE);
+		this->Node.swap(Output);
+		this->FreeNode.clear();
+		this->BuiltCost = this->cost_locked();
+	}
+
+	float bvh::cost_locked() {
+		if ((this->Root == INVALID_HANDLE) || (this->Node[this->Root].Handle != INVALID_HANDLE)) return 0.0f;
+		float RootArea = area(this->Node[this->Root].Box);
+		if (RootArea <= 0.0f) return 0.0f;
+
+		float Sum = 0.0f;
+		std::vector<uint32_t> Stack;
+		Stack.push_back(this->Root);
+		while (Stack.size() > 0) {
+			const node& Current = this->Node[Stack.back()];
+			Stack.pop_back();
+			if (Current.Handle != INVALID_HANDLE) continue;
+			Sum += area(Current.Box);
+			Stack.push_back(Current.Child[0]);
+			Stack.push_back(Current.Child[1]);
+		}
+		return Sum / RootArea;
+	}
+
+	uint32_t bvh::build(std::vector<node>& aOutput, std::vector<uint32_t>& aHandle, const std::vector<aabb>& aBox, size_t aBegin, size_t aEnd, uint32_t aParent) {
+		uint32_t Index = (uint32_t)aOutput.size();
+		aOutput.push_back(node{});
+		aOutput[Index].Parent		= aParent;
+		aOutput[Index].Child[0]		= INVALID_HANDLE;
+		aOutput[Index].Child[1]		= INVALID_HANDLE;
+		aOutput[Index].Handle		= INVALID_HANDLE;
+
+		if (aEnd - aBegin == 1) {
+			uint32_t Handle = aHandle[aBegin];
+			aOutput[Index].Box		= aBox[Handle];
+			aOutput[Index].Handle	= Handle;
+			this->LeafNode[Handle]	= Index;
+			return Index;
+		}
+
+		aabb Bounds = aBox[aHandle[aBegin]];
+		float3 Center = centroid(Bounds);
+		aabb CenterBounds = { Center, Center };
+		for (size_t i = aBegin + 1; i < aEnd; i++) {
+			Bounds = merge(Bounds, aBox[aHandle[i]]);
+			Center = centroid(aBox[aHandle[i]]);
+			CenterBounds = merge(CenterBounds, aabb{ Center, Center });
+		}
+		aOutput[Index].Box = Bounds;
+
+		// Split along the widest spread of centroids.
+		float3 Spread(CenterBounds.Max.x - CenterBounds.Min.x, CenterBounds.Max.y - CenterBounds.Min.y, CenterBounds.Max.z - CenterBounds.Min.z);
+		int Axis = (Spread.x >= Spread.y) && (Spread.x >= Spread.z) ? 0 : (Spread.y >= Spread.z ? 1 : 2);
+		float AxisMin = Axis == 0 ? CenterBounds.Min.x : (Axis == 1 ? CenterBounds.Min.y : CenterBounds.Min.z);
+		float AxisSpread = Axis == 0 ? Spread.x : (Axis == 1 ? Spread.y : Spread.z);
+		auto AxisOf = [Axis](const float3& aPoint) -> float {
+			return Axis == 0 ? aPoint.x : (Axis == 1 ? aPoint.y : aPoint.z);
+		};
+
+		size_t Middle = aBegin + (aEnd - aBegin) / 2;
+		if (AxisSpread > 0.0f) {
+			auto BinOf = [&](uint32_t aLeaf) -> int {
+				int Bin = (int)((AxisOf(centroid(aBox[aLeaf])) - AxisMin) / AxisSpread * (float)BIN_COUNT);
+				return Bin < BIN_COUNT ? Bin : BIN_COUNT - 1;
+			};
+
+			size_t BinCount[BIN_COUNT] = { 0 };
+			aabb BinBox[BIN_COUNT];
+			for (size_t i = aBegin; i < aEnd; i++) {
+				int Bin = BinOf(aHandle[i]);
+				BinBox[Bin] = BinCount[Bin] == 0 ? aBox[aHandle[i]] : merge(BinBox[Bin], aBox[aHandle[i]]);
+				BinCount[Bin] += 1;
+			}
+
+			// Right sweep first, then pick the split with the least SAH cost.
+			float RightArea[BIN_COUNT];
+			size_t RightCount[BIN_COUNT];
+			aabb Sweep{};
+			size_t Count = 0;
+			for (int b = BIN_COUNT - 1; b > 0; b--) {
+				if (BinCount[b] > 0) {
+					Sweep = Count == 0 ? BinBox[b] : merge(Sweep, BinBox[b]);
+					Count += BinCount[b];
+				}
+				RightArea[b] = Count > 0 ? area(Sweep) : 0.0f;
+				RightCount[b] = Count;
+			}
+			float BestCost = FLT_MAX;
+			int BestSplit = -1;
+			Count = 0;
+			for (int b = 0; b < BIN_COUNT - 1; b++) {
+				if (BinCount[b] > 0) {
+					Sweep = Count == 0 ? BinBox[b] : merge(Sweep, BinBox[b]);
+					Count += BinCount[b];
+				}
+				if ((Count == 0) || (RightCount[b + 1] == 0)) continue;
+				float Cost = area(Sweep) * (float)Count + RightArea[b + 1] * (float)RightCount[b + 1];
+				if (Cost < BestCost) {
+					BestCost = Cost;
+					BestSplit = b;
+				}
+			}
+
+			if (BestSplit >= 0) {
+				auto Split = std::partition(aHandle.begin() + aBegin, aHandle.begin() + aEnd, [&](uint32_t aLeaf) { return BinOf(aLeaf) <= BestSplit; });
+				Middle = (size_t)(Split - aHandle.begin());
+			}
+		}
+		// Identical centroids or a degenerate split, halve the range.
+		if ((Middle == aBegin) || (Middle == aEnd)) {
+			Middle = aBegin + (aEnd - aBegin) / 2;
+		}
+
+		uint32_t Left = this->build(aOutput, aHandle, aBox, aBegin, Middle, Index);
+		uint32_t Right = this->build(aOutput, aHandle, aBox, Middle, aEnd, Index);
+		aOutput[Index].Child[0] = Left;
+		aOutput[Index].Child[1] = Right;
+		return Index;
+	}
+
+	bvh::aabb bvh::merge(const aabb& aLhs, const aabb& aRhs) {
+		aabb Box;
+		Box.Min = float3(std::min(aLhs.Min.x, aRhs.Min.x), std::min(aLhs.Min.y, aRhs.Min.y), std::min(aLhs.Min.z, aRhs.Min.z));
+		Box.Max = float3(std::max(aLhs.Max.x, aRhs.Max.x), std::max(aLhs.Max.y, aRhs.Max.y), std::max(aLhs.Max.z, aRhs.Max.z));
+		return Box;
+	}
+
+	float bvh::area(const aabb& aBox) {
+		float X = aBox.Max.x - aBox.Min.x;
+		float Y = aBox.Max.y - aBox.Min.y;
+		float Z = aBox.Max.z - aBox.Min.z;
+		return 2.0f * (X * Y + Y * Z + Z * X);
+	}
+
+}
@@ -23,6 +23,10 @@ namespace geodesuka::core::object {
 
 	}
 
+	float4x4 camera::view_projection() {
+		return this->PRT;
+	}
+
 	//void camera::draw(object_t* aObject) {}
 
 	camera::camera(engine* aEngine, gcl::context* aContext, stage_t* aStage) : rendertarget(aEngine, aContext, aStage) {
@@ -1,5 +1,7 @@
 #include <geodesuka/core/object/camera3d.h>
 
+#include <geodesuka/core/logic/radix_sort.h>
+
 namespace geodesuka::core::object {
 
 	//void camera3d::draw(object_t* aObject) {
@@ -38,7 +40,60 @@ namespace geodesuka::core::object {
 		VkSubmitInfo DrawBatch{};
 		DrawBatch.sType = VkStructureType::VK_STRUCTURE_TYPE_SUBMIT_INFO;
 		DrawBatch.pNext = NULL;
+		this->Mutex.lock();
+
+		// Opaque nearest first, then translucent farthest first.
+		this->sort_objects(aObjectCount, aObject);
+		VkCommandBuffer FrameCommand = this->record_frame(this->DrawOrder.size(), this->DrawOrder.data(), this->OpaqueObject.size());
+
+		DrawBatch.commandBufferCount	= FrameCommand != VK_NULL_HANDLE ? 1 : 0;
+		DrawBatch.pCommandBuffers		= FrameCommand != VK_NULL_HANDLE ? &this->FramePack->Command[this->FrameDrawIndex] : NULL;
+		this->Mutex.unlock();
 		return DrawBatch;
 	}
 
-}
\ No newline at end of file
+	void camera3d::sort_objects(size_t aObjectCount, object_t** aObject) {
+		this->PositionX.resize(aObjectCount);
+		this->PositionY.resize(aObjectCount);
+		this->PositionZ.resize(aObjectCount);
+		this->DepthKey.resize(aObjectCount);
+		this->SortKeyScratch.resize(aObjectCount);
+		this->SortObjectScratch.resize(aObjectCount);
+		this->DrawOrder.resize(aObjectCount);
+
+		for (size_t i = 0; i < aObjectCount; i++) {
+			float3 ObjectPosition = aObject[i]->get_position();
+			this->PositionX[i] = ObjectPosition.x;
+			this->PositionY[i] = ObjectPosition.y;
+			this->PositionZ[i] = ObjectPosition.z;
+		}
+		logic::radix_sort::depth_keys(aObjectCount, this->PositionX.data(), this->PositionY.data(), this->PositionZ.data(), this->Position, this->DirectionZ, this->DepthKey.data());
+
+		// Inverted keys sort translucent objects farthest first.
+		this->OpaqueObject.clear();
+		this->OpaqueKey.clear();
+		this->TranslucentObject.clear();
+		this->TranslucentKey.clear();
+		for (size_t i = 0; i < aObjectCount; i++) {
+			if (aObject[i]->is_translucent()) {
+				this->TranslucentObject.push_back(aObject[i]);
+				this->TranslucentKey.push_back(~this->DepthKey[i]);
+			}
+			else {
+				this->OpaqueObject.push_back(aObject[i]);
+				this->OpaqueKey.push_back(this->DepthKey[i]);
+			}
+		}
+
+		logic::radix_sort::sort(this->OpaqueObject.size(), this->OpaqueKey.data(), this->OpaqueObject.data(), this->SortKeyScratch.data(), this->SortObjectScratch.data());
+		logic::radix_sort::sort(this->TranslucentObject.size(), this->TranslucentKey.data(), this->TranslucentObject.data(), this->SortKeyScratch.data(), this->SortObjectScratch.data());
+
+		for (size_t i = 0; i < this->OpaqueObject.size(); i++) {
+			this->DrawOrder[i] = this->OpaqueObject[i];
+		}
+		for (size_t i = 0; i < this->TranslucentObject.size(); i++) {
+			this->DrawOrder[this->OpaqueObject.size() + i] = this->TranslucentObject[i];
+		}
+	}
+
+}
@@ -0,0 +1,343 @@
+#include <geodesuka/core/gcl/command_encoder.h>
+
+#include <string.h>
+
+#include <geodesuka/core/gcl/context.h>
+
+namespace geodesuka::core::gcl {
+
+	command_encoder::command_encoder(context* aContext, VkCommandBuffer aCommandBuffer) {
+		this->Context = aContext;
+		this->Handle = aCommandBuffer;
+		this->IssuedCount = 0;
+		this->FilteredCount = 0;
+		this->invalidate();
+	}
+
+	VkCommandBuffer command_encoder::handle() {
+		return this->Handle;
+	}
+
+	void command_encoder::invalidate() {
+		for (uint32_t i = 0; i < BIND_POINT_COUNT; i++) {
+			this->BindPoint[i].Pipeline = VK_NULL_HANDLE;
+			this->BindPoint[i].Set.clear();
+		}
+		this->VertexBuffer.clear();
+		this->isIndexBufferBound = false;
+		this->IndexBuffer = VK_NULL_HANDLE;
+		this->IndexOffset = 0;
+		this->IndexType = VkIndexType::VK_INDEX_TYPE_UINT16;
+		this->PushLayout = VK_NULL_HANDLE;
+		this->PushStage = 0;
+		memset(this->PushData, 0x00, sizeof(this->PushData));
+		memset(this->PushKnown, 0x00, sizeof(this->PushKnown));
+		this->forget_dynamic_state();
+	}
+
+	void command_encoder::bind_pipeline(VkPipelineBindPoint aBindPoint, VkPipeline aPipeline) {
+		bind_point* Point = this->bind_point_of(aBindPoint);
+		if ((Point != nullptr) && (Point->Pipeline == aPipeline) && (aPipeline != VK_NULL_HANDLE)) {
+			this->FilteredCount += 1;
+			return;
+		}
+		this->Context->api().vkCmdBindPipeline(this->Handle, aBindPoint, aPipeline);
+		this->IssuedCount += 1;
+		if (Point == nullptr) return;
+		Point->Pipeline = aPipeline;
+		// State the new pipeline has static overrides what was set dynamically.
+		if (aBindPoint == VkPipelineBindPoint::VK_PIPELINE_BIND_POINT_GRAPHICS) {
+			this->forget_dynamic_state();
+		}
+	}
+
+	void command_encoder::bind_descriptor_sets(VkPipelineBindPoint aBindPoint, VkPipelineLayout aLayout, uint32_t aFirstSet, uint32_t aSetCount, const VkDescriptorSet* aSet, uint32_t aDynamicOffsetCount, const uint32_t* aDynamicOffset) {
+		if ((aSetCount == 0) || (aSet == NULL)) return;
+		bind_point* Point = this->bind_point_of(aBindPoint);
+		if (Point == nullptr) {
+			this->Context->api().vkCmdBindDescriptorSets(this->Handle, aBindPoint, aLayout, aFirstSet, aSetCount, aSet, aDynamicOffsetCount, aDynamicOffset);
+			this->IssuedCount += 1;
+			return;
+		}
+
+		// Which dynamic offset belongs to which set depends on the layout, so
+		// sets bound with offsets only match a repeat of the same whole call.
+		std::vector<uint32_t> Offset;
+		if ((aDynamicOffsetCount > 0) && (aDynamicOffset != NULL)) {
+			Offset.assign(aDynamicOffset, aDynamicOffset + aDynamicOffsetCount);
+		}
+		bool isRedundant = (Point->Set.size() >= (size_t)(aFirstSet + aSetCount));
+		for (uint32_t i = 0; (i < aSetCount) && (isRedundant); i++) {
+			const descriptor_set& Bound = Point->Set[aFirstSet + i];
+			isRedundant = Bound.isBound && (Bound.Layout == aLayout) && (Bound.Handle == aSet[i]) && (Bound.DynamicOffset == Offset);
+			if ((isRedundant) && (Offset.size() > 0)) {
+				isRedundant = (Bound.CallFirstSet == aFirstSet) && (Bound.CallSetCount == aSetCount);
+			}
+		}
+		if (isRedundant) {
+			this->FilteredCount += 1;
+			return;
+		}
+
+		this->Context->api().vkCmdBindDescriptorSets(this->Handle, aBindPoint, aLayout, aFirstSet, aSetCount, aSet, aDynamicOffsetCount, aDynamicOffset);
+		this->IssuedCount += 1;
+
+		if (Point->Set.size() < (size_t)(aFirstSet + aSetCount)) {
+			descriptor_set Unbound{};
+			Unbound.isBound = false;
+			Point->Set.resize(aFirstSet + aSetCount, Unbound);
+		}
+		bool isDisturbed = false;
+		for (uint32_t i = 0; i < aSetCount; i++) {
+			descriptor_set& Bound = Point->Set[aFirstSet + i];
+			isDisturbed			= isDisturbed || (Bound.isBound && (Bound.Layout != aLayout));
+			Bound.isBound		= true;
+			Bound.Layout		= aLayout;
+			Bound.Handle		= aSet[i];
+			Bound.CallFirstSet	= aFirstSet;
+			Bound.CallSetCount	= aSetCount;
+			Bound.DynamicOffset	= Offset;
+		}
+		// A different layout may disturb every set above the ones bound.
+		if (isDisturbed) {
+			for (size_t j = aFirstSet + aSetCount; j < Point->Set.size(); j++) {
+				Point->Set[j].isBound = false;
+			}
+		}
+	}
+
+	void command_encoder::bind_vertex_buffers(uint32_t aFirstBinding, uint32_t aBindingCount, const VkBuffer* aBuffer, const VkDeviceSize* aOffset) {
+		if ((aBindingCount == 0) || (aBuffer == NULL) || (aOffset == NULL)) return;
+		bool isRedundant = (this->VertexBuffer.size() >= (size_t)(aFirstBinding + aBindingCount));
+		for (uint32_t i = 0; (i < aBindingCount) && (isRedundant); i++) {
+			const vertex_buffer& Bound = this->VertexBuffer[aFirstBinding + i];
+			isRedundant = Bound.isBound && (Bound.Handle == aBuffer[i]) && (Bound.Offset == aOffset[i]);
+		}
+		if (isRedundant) {
+			this->FilteredCount += 1;
+			return;
+		}
+
+		this->Context->api().vkCmdBindVertexBuffers(this->Handle, aFirstBinding, aBindingCount, aBuffer, aOffset);
+		this->IssuedCount += 1;
+
+		if (this->VertexBuffer.size() < (size_t)(aFirstBinding + aBindingCount)) {
+			vertex_buffer Unbound{};
+			Unbound.isBound = false;
+			this->VertexBuffer.resize(aFirstBinding + aBindingCount, Unbound);
+		}
+		for (uint32_t i = 0; i < aBindingCount; i++) {
+			vertex_buffer& Bound = this->VertexBuffer[aFirstBinding + i];
+			Bound.isBound	= true;
+			Bound.Handle	= aBuffer[i];
+			Bound.Offset	= aOffset[i];
+		}
+	}
+
+	void command_encoder::bind_index_buffer(VkBuffer aBuffer, VkDeviceSize aOffset, VkIndexType aIndexType) {
+		if ((this->isIndexBufferBound) && (this->IndexBuffer == aBuffer) && (this->IndexOffset == aOffset) && (this->IndexType == aIndexType)) {
+			this->FilteredCount += 1;
+			return;
+		}
+		this->Context->api().vkCmdBindIndexBuffer(this->Handle, aBuffer, aOffset, aIndexType);
+		this->IssuedCount += 1;
+		this->isIndexBufferBound	= true;
+		this->IndexBuffer			= aBuffer;
+		this->IndexOffset			= aOffset;
+		this->IndexType				= aIndexType;
+	}
+
+	void command_encoder::push_constants(VkPipelineLayout aLayout, VkShaderStageFlags aStage, uint32_t aOffset, uint32_t aSize, const void* aData) {
+		if ((aSize == 0) || (aData == NULL)) return;
+		bool isShadowed = (aOffset + aSize <= PUSH_CONSTANT_SIZE);
+
+		// Values pushed for another layout or other stages do not carry over.
+		if ((this->PushLayout != aLayout) || (this->PushStage != aStage)) {
+			memset(this->PushKnown, 0x00, sizeof(this->PushKnown));
+			this->PushLayout	= aLayout;
+			this->PushStage		= aStage;
+		}
+
+		if (isShadowed) {
+			bool isRedundant = (memcmp(&this->PushData[aOffset], aData, aSize) == 0);
+			for (uint32_t i = aOffset; (i < aOffset + aSize) && (isRedundant); i++) {
+				isRedundant = this->PushKnown[i];
+			}
+			if (isRedundant) {
+				this->FilteredCount += 1;
+				return;
+			}
+		}
+
+		this->Context->api().vkCmdPushConstants(this->Handle, aLayout, aStage, aOffset, aSize, aData);
+		this->IssuedCount += 1;
+
+		if (isShadowed) {
+			memcpy(&this->PushData[aOffset], aData, aSize);
+			memset(&this->PushKnown[aOffset], 0x01, aSize);
+		}
+	}
+
+	void command_encoder::set_viewport(uint32_t aFirstViewport, uint32_t aViewportCount, const VkViewport* aViewport) {
+		if ((aViewportCount == 0) || (aViewport == NULL)) return;
+		bool isRedundant = (this->Viewport.size() >= (size_t)(aFirstViewport + aViewportCount));
+		for (uint32_t i = 0; (i < aViewportCount) && (isRedundant); i++) {
+			isRedundant = this->isViewportSet[aFirstViewport + i] && (memcmp(&this->Viewport[aFirstViewport + i], &aViewport[i], sizeof(VkViewport)) == 0);
+		}
+		if (isRedundant) {
+			this->FilteredCount += 1;
+			return;
+		}
+
+		this->Context->api().vkCmdSetViewport(this->Handle, aFirstViewport, aViewportCount, aViewport);
+		this->IssuedCount += 1;
+
+		if (this->Viewport.size() < (size_t)(aFirstViewport + aViewportCount)) {
+			this->Viewport.resize(aFirstViewport + aViewportCount);
+			this->isViewportSet.resize(aFirstViewport + aViewportCount, false);
+		}
+		for (uint32_t i = 0; i < aViewportCount; i++) {
+			this->Viewport[aFirstViewport + i]		= aViewport[i];
+			this->isViewportSet[aFirstViewport + i]	= true;
+		}
+	}
+
+	void command_encoder::set_scissor(uint32_t aFirstScissor, uint32_t aScissorCount, const VkRect2D* aScissor) {
+		if ((aScissorCount == 0) || (aScissor == NULL)) return;
+		bool isRedundant = (this->Scissor.size() >= (size_t)(aFirstScissor + aScissorCount));
+		for (uint32_t i = 0; (i < aScissorCount) && (isRedundant); i++) {
+			isRedundant = this->isScissorSet[aFirstScissor + i] && (memcmp(&this->Scissor[aFirstScissor + i], &aScissor[i], sizeof(VkRect2D)) == 0);
+		}
+		if (isRedundant) {
+			this->FilteredCount += 1;
+			return;
+		}
+
+		this->Context->api().vkCmdSetScissor(this->Handle, aFirstScissor, aScissorCount, aScissor);
+		this->IssuedCount += 1;
+
+		if (this->Scissor.size() < (size_t)(aFirstScissor + aScissorCount)) {
+			this->Scissor.resize(aFirstScissor + aScissorCount);
+			this->isScissorSet.resize(aFirstScissor + aScissorCount, false);
+		}
+		for (uint32_t i = 0; i < aScissorCount; i++) {
+			this->Scissor[aFirstScissor + i]		= aScissor[i];
+			this->isScissorSet[aFirstScissor + i]	= true;
+		}
+	}
+
+	void command_encoder::set_line_width(float aLineWidth) {
+		if ((this->isLineWidthSet) && (this->LineWidth == aLineWidth)) {
+			this->FilteredCount += 1;
+			return;
+		}
+		this->Context->api().vkCmdSetLineWidth(this->Handle, aLineWidth);
+		this->IssuedCount += 1;
+		this->isLineWidthSet	= true;
+		this->LineWidth			= aLineWidth;
+	}
+
+	void command_encoder::set_depth_bias(float aConstantFactor, float aClamp, float aSlopeFactor) {
+		if ((this->isDepthBiasSet) && (this->DepthBias[0] == aConstantFactor) && (this->DepthBias[1] == aClamp) && (this->DepthBias[2] == aSlopeFactor)) {
+			this->FilteredCount += 1;
+			return;
+		}
+		this->Context->api().vkCmdSetDepthBias(this->Handle, aConstantFactor, aClamp, aSlopeFactor);
+		this->IssuedCount += 1;
+		this->isDepthBiasSet	= true;
+		this->DepthBias[0]		= aConstantFactor;
+		this->DepthBias[1]		= aClamp;
+		this->DepthBias[2]		= aSlopeFactor;
+	}
+
+	void command_encoder::set_blend_constants(const float aBlendConstant[4]) {
+		if ((this->isBlendConstantSet) && (memcmp(this->BlendConstant, aBlendConstant, sizeof(this->BlendConstant)) == 0)) {
+			this->FilteredCount += 1;
+			return;
+		}
+		this->Context->api().vkCmdSetBlendConstants(this->Handle, aBlendConstant);
+		this->IssuedCount += 1;
+		this->isBlendConstantSet = true;
+		memcpy(this->BlendConstant, aBlendConstant, sizeof(this->BlendConstant));
+	}
+
+	void command_encoder::set_stencil_reference(VkStencilFaceFlags aFaceMask, uint32_t aReference) {
+		bool isFront = (aFaceMask & VkStencilFaceFlagBits::VK_STENCIL_FACE_FRONT_BIT) != 0;
+		bool isBack = (aFaceMask & VkStencilFaceFlagBits::VK_STENCIL_FACE_BACK_BIT) != 0;
+		bool isRedundant = (isFront || isBack);
+		if (isFront) isRedundant = isRedundant && this->isStencilReferenceSet[0] && (this->StencilReference[0] == aReference);
+		if (isBack) isRedundant = isRedundant && this->isStencilReferenceSet[1] && (this->StencilReference[1] == aReference);
+		if (isRedundant) {
+			this->FilteredCount += 1;
+			return;
+		}
+		this->Context->api().vkCmdSetStencilReference(this->Handle, aFaceMask, aReference);
+		this->IssuedCount += 1;
+		if (isFront) {
+			this->isStencilReferenceSet[0]	= true;
+			this->StencilReference[0]		= aReference;
+		}
+		if (isBack) {
+			this->isStencilReferenceSet[1]	= true;
+			this->StencilReference[1]		= aReference;
+		}
+	}
+
+	void command_encoder::draw(uint32_t aVertexCount, uint32_t aInstanceCount, uint32_t aFirstVertex, uint32_t aFirstInstance) {
+		this->Context->api().vkCmdDraw(this->Handle, aVertexCount, aInstanceCount, aFirstVertex, aFirstInstance);
+		this->IssuedCount += 1;
+	}
+
+	void command_encoder::draw_indexed(uint32_t aIndexCount, uint32_t aInstanceCount, uint32_t aFirstIndex, int32_t aVertexOffset, uint32_t aFirstInstance) {
+		this->Context->api().vkCmdDrawIndexed(this->Handle, aIndexCount, aInstanceCount, aFirstIndex, aVertexOffset, aFirstInstance);
+		this->IssuedCount += 1;
+	}
+
+	void command_encoder::draw_indirect(VkBuffer aBuffer, VkDeviceSize aOffset, uint32_t aDrawCount, uint32_t aStride) {
+		this->Context->api().vkCmdDrawIndirect(this->Handle, aBuffer, aOffset, aDrawCount, aStride);
+		this->IssuedCount += 1;
+	}
+
+	void command_encoder::draw_indexed_indirect(VkBuffer aBuffer, VkDeviceSize aOffset, uint32_t aDrawCount, uint32_t aStride) {
+		this->Context->api().vkCmdDrawIndexedIndirect(this->Handle, aBuffer, aOffset, aDrawCount, aStride);
+		this->IssuedCount += 1;
+	}
+
+	void command_encoder::dispatch(uint32_t aGroupX, uint32_t aGroupY, uint32_t aGroupZ) {
+		this->Context->api().vkCmdDispatch(this->Handle, aGroupX, aGroupY, aGroupZ);
+		this->IssuedCount += 1;
+	}
+
+	uint64_t command_encoder::issued() {
+		return this->IssuedCount;
+	}
+
+	uint64_t command_encoder::filtered() {
+		return this->FilteredCount;
+	}
+
+	void command_encoder::forget_dynamic_state() {
+		this->Viewport.clear();
+		this->isViewportSet.clear();
+		this->Scissor.clear();
+		this->isScissorSet.clear();
+		this->isLineWidthSet			= false;
+		this->LineWidth					= 0.0f;
+		this->isDepthBiasSet			= false;
+		this->isBlendConstantSet		= false;
+		this->isStencilReferenceSet[0]	= false;
+		this->isStencilReferenceSet[1]	= false;
+	}
+
+	command_encoder::bind_point* command_encoder::bind_point_of(VkPipelineBindPoint aBindPoint) {
+		switch (aBindPoint) {
+		case VkPipelineBindPoint::VK_PIPELINE_BIND_POINT_GRAPHICS:
+			return &this->BindPoint[0];
+		case VkPipelineBindPoint::VK_PIPELINE_BIND_POINT_COMPUTE:
+			return &this->BindPoint[1];
+		default:
+			return nullptr;
+		}
+	}
+
+}
@@ -11,7 +11,7 @@ namespace geodesuka::core::gcl {
 		this->CreateInfo.pNext = NULL;
 		this->CreateInfo.flags = aFlags;
 		this->CreateInfo.queueFamilyIndex = aQueueFamilyIndex;
-		vkCreateCommandPool(aContext->handle(), &this->CreateInfo, NULL, &this->Handle);
+		aContext->api().vkCreateCommandPool(aContext->handle(), &this->CreateInfo, NULL, &this->Handle);
 	}
 
 	command_pool::command_pool(context* aContext, int aFlags, device::qfs aQueueFamilySupport) {
@@ -21,19 +21,19 @@ namespace geodesuka::core::gcl {
 		this->CreateInfo.pNext = NULL;
 		this->CreateInfo.flags = aFlags;
 		this->CreateInfo.queueFamilyIndex = aContext->parent()->qfi(aQueueFamilySupport);
-		vkCreateCommandPool(aContext->handle(), &this->CreateInfo, NULL, &this->Handle);
+		aContext->api().vkCreateCommandPool(aContext->handle(), &this->CreateInfo, NULL, &this->Handle);
 	}
 
 	command_pool::~command_pool() {
 		if (Context != nullptr) {
 			if ((CommandList.n > 0) && (CommandList.ptr != NULL)) {
-				vkFreeCommandBuffers(Context->handle(), Handle, CommandList.n, CommandList.ptr);
+				Context->api().vkFreeCommandBuffers(Context->handle(), Handle, CommandList.n, CommandList.ptr);
 			}
 			free(CommandList.ptr);
 			CommandList.n = 0;
 			CommandList.ptr = NULL;
 			if (Handle != VK_NULL_HANDLE) {
-				vkDestroyCommandPool(Context->handle(), Handle, NULL);
+				Context->api().vkDestroyCommandPool(Context->handle(), Handle, NULL);
 			}
 		}
 		Context = nullptr;
@@ -47,7 +47,7 @@ namespace geodesuka::core::gcl {
 		AllocateInfo.level					= (VkCommandBufferLevel)aLevel;
 		AllocateInfo.commandBufferCount		= 1;
 		VkCommandBuffer CommandBuffer		= VK_NULL_HANDLE;
-		VkResult Result = vkAllocateCommandBuffers(this->Context->handle(), &AllocateInfo, &CommandBuffer);
+		VkResult Result = this->Context->api().vkAllocateCommandBuffers(this->Context->handle(), &AllocateInfo, &CommandBuffer);
 		return CommandBuffer;
 	}
 
@@ -58,7 +58,7 @@ namespace geodesuka::core::gcl {
 		AllocateInfo.commandPool			= this->Handle;
 		AllocateInfo.level					= (VkCommandBufferLevel)aLevel;
 		AllocateInfo.commandBufferCount		= aCommandBufferCount;
-		VkResult Result = vkAllocateCommandBuffers(this->Context->handle(), &AllocateInfo, aCommandBufferList);
+		VkResult Result = this->Context->api().vkAllocateCommandBuffers(this->Context->handle(), &AllocateInfo, aCommandBufferList);
 	}
 
 	command_list command_pool::allocate(int aLevel, uint32_t aCommandBufferCount) {
@@ -72,7 +72,7 @@ namespace geodesuka::core::gcl {
 		ReturnList.n						= aCommandBufferCount;
 		ReturnList.ptr						= (VkCommandBuffer*)malloc(aCommandBufferCount * sizeof(VkCommandBuffer));
 		if (ReturnList.ptr != NULL) {
-			VkResult Result = vkAllocateCommandBuffers(Context->handle(), &AllocateInfo, ReturnList.ptr);
+			VkResult Result = Context->api().vkAllocateCommandBuffers(Context->handle(), &AllocateInfo, ReturnList.ptr);
 		}
 		return ReturnList;
 	}
@@ -122,7 +122,7 @@ namespace geodesuka::core::gcl {
 			}
 		}
 
-		vkFreeCommandBuffers(Context->handle(), Handle, RemoveCount, RemoveList);
+		Context->api().vkFreeCommandBuffers(Context->handle(), Handle, RemoveCount, RemoveList);
 		free(RemoveList);
 		free(CommandList.ptr);
 		CommandList.n = NewCount;
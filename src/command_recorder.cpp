@@ -0,0 +1,136 @@
+#include <geodesuka/core/gcl/command_recorder.h>
+
+namespace geodesuka::core::gcl {
+
+	command_recorder::command_recorder(uint32_t aLaneCount) {
+		this->Shutdown = false;
+		this->Generation = 0;
+		this->Remaining = 0;
+		this->Job = nullptr;
+
+		if (aLaneCount == 0) {
+			aLaneCount = std::thread::hardware_concurrency();
+		}
+		if (aLaneCount == 0) {
+			aLaneCount = 1;
+		}
+
+		this->Lane.resize(aLaneCount);
+
+		// A single lane records on the calling thread.
+		if (aLaneCount > 1) {
+			for (uint32_t i = 0; i < aLaneCount; i++) {
+				this->Worker.push_back(std::thread(&command_recorder::work, this, i));
+			}
+		}
+	}
+
+	command_recorder::~command_recorder() {
+		this->Mutex.lock();
+		this->Shutdown = true;
+		this->Mutex.unlock();
+		this->Condition.notify_all();
+
+		for (size_t i = 0; i < this->Worker.size(); i++) {
+			this->Worker[i].join();
+		}
+		this->Worker.clear();
+
+		this->Lane.clear();
+
+		// Contexts remove their own pools, only left over if one outlived the recorder.
+		for (auto it = this->Pool.begin(); it != this->Pool.end(); it++) {
+			for (size_t i = 0; i < it->second.size(); i++) {
+				delete it->second[i];
+			}
+		}
+		this->Pool.clear();
+	}
+
+	uint32_t command_recorder::lane_count() {
+		return (uint32_t)this->Lane.size();
+	}
+
+	command_pool* command_recorder::pool(context* aContext, uint32_t aLane) {
+		if ((aContext == nullptr) || (aLane >= this->Lane.size())) return nullptr;
+		this->PoolMutex.lock();
+		std::vector<command_pool*>& ContextPool = this->Pool[aContext];
+		if (ContextPool.size() == 0) {
+			for (size_t i = 0; i < this->Lane.size(); i++) {
+				// Buffers are re-recorded when dirty, reset individually.
+				ContextPool.push_back(new command_pool(aContext, command_pool::RESET_COMMAND_BUFFER_BIT, device::qfs::GRAPHICS_AND_COMPUTE));
+			}
+		}
+		command_pool* LanePool = ContextPool[aLane];
+		this->PoolMutex.unlock();
+		return LanePool;
+	}
+
+	void command_recorder::remove(context* aContext) {
+		this->PoolMutex.lock();
+		auto it = this->Pool.find(aContext);
+		if (it != this->Pool.end()) {
+			for (size_t i = 0; i < it->second.size(); i++) {
+				delete it->second[i];
+			}
+			this->Pool.erase(it);
+		}
+		this->PoolMutex.unlock();
+	}
+
+	void command_recorder::run(size_t aJobCount, const std::function<uint32_t(size_t)>& aLane, const std::function<void(size_t)>& aJob) {
+		if (aJobCount == 0) return;
+
+		if (this->Worker.size() == 0) {
+			for (size_t i = 0; i < aJobCount; i++) {
+				aJob(i);
+			}
+			return;
+		}
+
+		// Bucket in job order, each lane then works through its jobs in order.
+		for (size_t i = 0; i < this->Lane.size(); i++) {
+			this->Lane[i].Job.clear();
+		}
+		for (size_t i = 0; i < aJobCount; i++) {
+			this->Lane[aLane(i) % this->Lane.size()].Job.push_back(i);
+		}
+
+		std::unique_lock<std::mutex> Lock(this->Mutex);
+		this->Job = &aJob;
+		this->Remaining = (uint32_t)this->Lane.size();
+		this->Generation += 1;
+		this->Condition.notify_all();
+		this->Done.wait(Lock, [this]() { return this->Remaining == 0; });
+		this->Job = nullptr;
+	}
+
+	void command_recorder::work(uint32_t aLane) {
+		uint64_t Seen = 0;
+		while (true) {
+			const std::function<void(size_t)>* Task = nullptr;
+			{
+				std::unique_lock<std::mutex> Lock(this->Mutex);
+				this->Condition.wait(Lock, [&]() { return this->Shutdown || (this->Generation != Seen); });
+				if (this->Shutdown) return;
+				Seen = this->Generation;
+				Task = this->Job;
+			}
+
+			// Job list was filled before the run was published.
+			const std::vector<size_t>& Job = this->Lane[aLane].Job;
+			for (size_t i = 0; i < Job.size(); i++) {
+				(*Task)(Job[i]);
+			}
+
+			this->Mutex.lock();
+			this->Remaining -= 1;
+			bool isLast = (this->Remaining == 0);
+			this->Mutex.unlock();
+			if (isLast) {
+				this->Done.notify_one();
+			}
+		}
+	}
+
+}
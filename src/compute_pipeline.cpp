@@ -0,0 +1,170 @@
+#include <geodesuka/core/gcl/compute_pipeline.h>
+
+#include <geodesuka/core/gcl/context.h>
+#include <geodesuka/core/gcl/pipeline_state_cache.h>
+
+namespace geodesuka::core::gcl {
+
+	compute_pipeline::compute_pipeline(context* aContext, const char* aSource, const VkSpecializationInfo* aSpecialization) {
+		this->ErrorCode		= VkResult::VK_INCOMPLETE;
+		this->Context		= aContext;
+		this->Shader		= nullptr;
+		this->isShaderOwned	= true;
+		this->Handle		= VK_NULL_HANDLE;
+		if ((aContext == nullptr) || (aSource == NULL)) return;
+
+		this->Shader = new shader(aContext, shader::stage::COMPUTE, aSource);
+		this->create(aSpecialization);
+	}
+
+	compute_pipeline::compute_pipeline(context* aContext, shader* aShader, const VkSpecializationInfo* aSpecialization) {
+		this->ErrorCode		= VkResult::VK_INCOMPLETE;
+		this->Context		= aContext;
+		this->Shader		= aShader;
+		this->isShaderOwned	= false;
+		this->Handle		= VK_NULL_HANDLE;
+		if ((aContext == nullptr) || (aShader == nullptr)) return;
+
+		this->create(aSpecialization);
+	}
+
+	compute_pipeline::~compute_pipeline() {
+		// Shared pipeline, layout is owned by the layout cache.
+		if ((this->Context != nullptr) && (this->Handle != VK_NULL_HANDLE)) {
+			this->Context->pipelines()->release(this->Handle);
+		}
+		if (this->isShaderOwned) {
+			delete this->Shader;
+		}
+		this->Shader = nullptr;
+		this->Handle = VK_NULL_HANDLE;
+		this->Context = nullptr;
+	}
+
+	bool compute_pipeline::is_valid() {
+		return (this->ErrorCode == VkResult::VK_SUCCESS) && (this->Handle != VK_NULL_HANDLE);
+	}
+
+	VkPipeline compute_pipeline::handle() {
+		return this->Handle;
+	}
+
+	VkPipelineLayout compute_pipeline::layout() {
+		return this->Layout.Handle;
+	}
+
+	VkDescriptorSetLayout compute_pipeline::set_layout(uint32_t aSetIndex) {
+		if (aSetIndex >= this->Layout.SetLayout.size()) return VK_NULL_HANDLE;
+		return this->Layout.SetLayout[aSetIndex];
+	}
+
+	const shader_reflection& compute_pipeline::get_reflection() {
+		return this->Shader->get_reflection();
+	}
+
+	void compute_pipeline::get_local_size(uint32_t* aX, uint32_t* aY, uint32_t* aZ) {
+		const shader_reflection& Reflection = this->Shader->get_reflection();
+		if (aX != NULL) *aX = Reflection.LocalSize[0];
+		if (aY != NULL) *aY = Reflection.LocalSize[1];
+		if (aZ != NULL) *aZ = Reflection.LocalSize[2];
+	}
+
+	void compute_pipeline::get_group_count(uint32_t aThreadX, uint32_t aThreadY, uint32_t aThreadZ, uint32_t* aGroupX, uint32_t* aGroupY, uint32_t* aGroupZ) {
+		uint32_t LocalSize[3];
+		this->get_local_size(&LocalSize[0], &LocalSize[1], &LocalSize[2]);
+		uint32_t Thread[3] = { aThreadX, aThreadY, aThreadZ };
+		uint32_t* Group[3] = { aGroupX, aGroupY, aGroupZ };
+		for (int i = 0; i < 3; i++) {
+			// Unreflected size counts as one.
+			uint32_t Size = LocalSize[i] > 0 ? LocalSize[i] : 1;
+			if (Group[i] != NULL) *Group[i] = (Thread[i] + Size - 1) / Size;
+		}
+	}
+
+	void compute_pipeline::bind(VkCommandBuffer aCommandBuffer) {
+		this->Context->api().vkCmdBindPipeline(aCommandBuffer, VkPipelineBindPoint::VK_PIPELINE_BIND_POINT_COMPUTE, this->Handle);
+	}
+
+	void compute_pipeline::push(VkCommandBuffer aCommandBuffer, uint32_t aOffset, uint32_t aSize, const void* aData) {
+		if ((aSize == 0) || (aData == NULL)) return;
+		this->Context->api().vkCmdPushConstants(aCommandBuffer, this->Layout.Handle, VkShaderStageFlagBits::VK_SHADER_STAGE_COMPUTE_BIT, aOffset, aSize, aData);
+	}
+
+	void compute_pipeline::dispatch(VkCommandBuffer aCommandBuffer, uint32_t aGroupX, uint32_t aGroupY, uint32_t aGroupZ) {
+		if ((aGroupX == 0) || (aGroupY == 0) || (aGroupZ == 0)) return;
+		this->Context->api().vkCmdDispatch(aCommandBuffer, aGroupX, aGroupY, aGroupZ);
+	}
+
+	void compute_pipeline::dispatch_threads(VkCommandBuffer aCommandBuffer, uint32_t aThreadX, uint32_t aThreadY, uint32_t aThreadZ) {
+		uint32_t Group[3];
+		this->get_group_count(aThreadX, aThreadY, aThreadZ, &Group[0], &Group[1], &Group[2]);
+		this->dispatch(aCommandBuffer, Group[0], Group[1], Group[2]);
+	}
+
+	void compute_pipeline::dispatch_indirect(VkCommandBuffer aCommandBuffer, VkBuffer aBuffer, VkDeviceSize aOffset) {
+		if (aBuffer == VK_NULL_HANDLE) return;
+		this->Context->api().vkCmdDispatchIndirect(aCommandBuffer, aBuffer, aOffset);
+	}
+
+	void compute_pipeline::barrier(
+		VkCommandBuffer aCommandBuffer, VkBuffer aBuffer, VkDeviceSize aOffset, VkDeviceSize aSize,
+		VkPipelineStageFlags aSrcStage, VkAccessFlags aSrcAccess,
+		VkPipelineStageFlags aDstStage, VkAccessFlags aDstAccess
+	) {
+		VkBufferMemoryBarrier Barrier{};
+		Barrier.sType					= VkStructureType::VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+		Barrier.pNext					= NULL;
+		Barrier.srcAccessMask			= aSrcAccess;
+		Barrier.dstAccessMask			= aDstAccess;
+		Barrier.srcQueueFamilyIndex		= VK_QUEUE_FAMILY_IGNORED;
+		Barrier.dstQueueFamilyIndex		= VK_QUEUE_FAMILY_IGNORED;
+		Barrier.buffer					= aBuffer;
+		Barrier.offset					= aOffset;
+		Barrier.size					= aSize;
+		this->Context->api().vkCmdPipelineBarrier(aCommandBuffer, aSrcStage, aDstStage, 0, 0, NULL, 1, &Barrier, 0, NULL);
+	}
+
+	VkSubmitInfo compute_pipeline::submission(uint32_t aCommandBufferCount, const VkCommandBuffer* aCommandBuffer) {
+		VkSubmitInfo Submission{};
+		Submission.sType					= VkStructureType::VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		Submission.pNext					= NULL;
+		Submission.waitSemaphoreCount		= 0;
+		Submission.pWaitSemaphores			= NULL;
+		Submission.pWaitDstStageMask		= NULL;
+		Submission.commandBufferCount		= aCommandBuffer != NULL ? aCommandBufferCount : 0;
+		Submission.pCommandBuffers			= aCommandBuffer;
+		Submission.signalSemaphoreCount		= 0;
+		Submission.pSignalSemaphores		= NULL;
+		return Submission;
+	}
+
+	void compute_pipeline::create(const VkSpecializationInfo* aSpecialization) {
+		if (!this->Shader->is_valid()) {
+			this->ErrorCode = VkResult::VK_ERROR_INITIALIZATION_FAILED;
+			return;
+		}
+		if (this->Shader->get_stage() != VkShaderStageFlagBits::VK_SHADER_STAGE_COMPUTE_BIT) {
+			this->ErrorCode = VkResult::VK_ERROR_INITIALIZATION_FAILED;
+			return;
+		}
+
+		// Layout from reflection, shared through context cache.
+		shader* ShaderList[1] = { this->Shader };
+		this->ErrorCode = this->Context->layouts()->merge(1, ShaderList, this->Layout);
+		if (this->ErrorCode != VkResult::VK_SUCCESS) return;
+
+		VkComputePipelineCreateInfo CreateInfo{};
+		CreateInfo.sType						= VkStructureType::VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+		CreateInfo.pNext						= NULL;
+		CreateInfo.flags						= 0;
+		CreateInfo.stage						= this->Shader->stageci();
+		CreateInfo.stage.pSpecializationInfo	= aSpecialization;
+		CreateInfo.layout						= this->Layout.Handle;
+		CreateInfo.basePipelineHandle			= VK_NULL_HANDLE;
+		CreateInfo.basePipelineIndex			= -1;
+
+		this->Handle = this->Context->pipelines()->acquire(CreateInfo);
+		this->ErrorCode = this->Handle != VK_NULL_HANDLE ? VkResult::VK_SUCCESS : VkResult::VK_ERROR_INITIALIZATION_FAILED;
+	}
+
+}
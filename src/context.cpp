@@ -1,6 +1,11 @@
 #include <geodesuka/engine.h>
 
 #include <geodesuka/core/gcl/context.h>
+#include <geodesuka/core/gcl/layout_cache.h>
+#include <geodesuka/core/gcl/pipeline_cache.h>
+#include <geodesuka/core/gcl/pipeline_state_cache.h>
+#include <geodesuka/core/gcl/renderpass_cache.h>
+#include <geodesuka/core/gcl/bindless_table.h>
 
 #include <cstdlib>
 #include <cstring>
@@ -18,6 +23,11 @@ namespace geodesuka::core::gcl {
 		// 2: Queue Create Info.
 		// 3: Create Logical Device.
 
+		this->LayoutCache = nullptr;
+		this->PipelineCache = nullptr;
+		this->PipelineStateCache = nullptr;
+		this->RenderPassCache = nullptr;
+		this->BindlessTable = nullptr;
 		if ((aEngine == nullptr) || (aDevice == nullptr)) return;
 
 		this->Engine = aEngine;
@@ -160,9 +170,106 @@ namespace geodesuka::core::gcl {
 		}
 		this->CreateInfo.pEnabledFeatures			= &this->Device->Features;
 
+		// Copies enabled extension names, caller list need not outlive context.
+		for (uint32_t i = 0; i < this->CreateInfo.enabledExtensionCount; i++) {
+			this->Extension.push_back(this->CreateInfo.ppEnabledExtensionNames[i]);
+		}
+
+		// Optional features are chained in front of each other on CreateInfo.pNext.
+		this->isPipelineLibraryEnabled = false;
+		this->isDescriptorIndexingEnabled = false;
+		this->isDrawIndirectCountEnabled = false;
+		this->isDynamicRenderingEnabled = false;
+
+#ifdef VK_EXT_graphics_pipeline_library
+		// Pipeline libraries need the feature enabled, not just the extension.
+		this->GraphicsPipelineLibraryFeatures = {};
+		this->GraphicsPipelineLibraryFeatures.sType = VkStructureType::VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT;
+		if (this->is_enabled(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME) && this->is_enabled(VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME)) {
+			VkPhysicalDeviceFeatures2 Features{};
+			Features.sType		= VkStructureType::VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+			Features.pNext		= &this->GraphicsPipelineLibraryFeatures;
+			vkGetPhysicalDeviceFeatures2(this->Device->handle(), &Features);
+			if (this->GraphicsPipelineLibraryFeatures.graphicsPipelineLibrary == VK_TRUE) {
+				this->GraphicsPipelineLibraryFeatures.pNext = (void*)this->CreateInfo.pNext;
+				this->CreateInfo.pNext = &this->GraphicsPipelineLibraryFeatures;
+				this->isPipelineLibraryEnabled = true;
+			}
+		}
+#endif
+
+		// Descriptor indexing and indirect count are core in 1.2, their features are then
+		// enabled through VkPhysicalDeviceVulkan12Features, which may not be chained with
+		// VkPhysicalDeviceDescriptorIndexingFeatures. Otherwise they need their extensions.
+		this->Vulkan12Features = {};
+		this->Vulkan12Features.sType = VkStructureType::VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+		this->DescriptorIndexingFeatures = {};
+		this->DescriptorIndexingFeatures.sType = VkStructureType::VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES;
+		if (this->api_version() >= VK_API_VERSION_1_2) {
+			VkPhysicalDeviceFeatures2 Features{};
+			Features.sType		= VkStructureType::VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+			Features.pNext		= &this->Vulkan12Features;
+			vkGetPhysicalDeviceFeatures2(this->Device->handle(), &Features);
+			// Everything supported is enabled, the bindless table needs the following.
+			this->isDescriptorIndexingEnabled =
+				(this->Vulkan12Features.descriptorIndexing == VK_TRUE) &&
+				(this->Vulkan12Features.shaderSampledImageArrayNonUniformIndexing == VK_TRUE) &&
+				(this->Vulkan12Features.shaderStorageBufferArrayNonUniformIndexing == VK_TRUE) &&
+				(this->Vulkan12Features.descriptorBindingSampledImageUpdateAfterBind == VK_TRUE) &&
+				(this->Vulkan12Features.descriptorBindingStorageBufferUpdateAfterBind == VK_TRUE) &&
+				(this->Vulkan12Features.descriptorBindingUpdateUnusedWhilePending == VK_TRUE) &&
+				(this->Vulkan12Features.descriptorBindingPartiallyBound == VK_TRUE) &&
+				(this->Vulkan12Features.runtimeDescriptorArray == VK_TRUE);
+			this->isDrawIndirectCountEnabled = (this->Vulkan12Features.drawIndirectCount == VK_TRUE) || this->is_enabled(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+			this->Vulkan12Features.pNext = (void*)this->CreateInfo.pNext;
+			this->CreateInfo.pNext = &this->Vulkan12Features;
+		}
+		else {
+			if (this->is_enabled(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME)) {
+				VkPhysicalDeviceFeatures2 Features{};
+				Features.sType		= VkStructureType::VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+				Features.pNext		= &this->DescriptorIndexingFeatures;
+				vkGetPhysicalDeviceFeatures2(this->Device->handle(), &Features);
+				this->isDescriptorIndexingEnabled =
+					(this->DescriptorIndexingFeatures.shaderSampledImageArrayNonUniformIndexing == VK_TRUE) &&
+					(this->DescriptorIndexingFeatures.shaderStorageBufferArrayNonUniformIndexing == VK_TRUE) &&
+					(this->DescriptorIndexingFeatures.descriptorBindingSampledImageUpdateAfterBind == VK_TRUE) &&
+					(this->DescriptorIndexingFeatures.descriptorBindingStorageBufferUpdateAfterBind == VK_TRUE) &&
+					(this->DescriptorIndexingFeatures.descriptorBindingUpdateUnusedWhilePending == VK_TRUE) &&
+					(this->DescriptorIndexingFeatures.descriptorBindingPartiallyBound == VK_TRUE) &&
+					(this->DescriptorIndexingFeatures.runtimeDescriptorArray == VK_TRUE);
+				this->DescriptorIndexingFeatures.pNext = (void*)this->CreateInfo.pNext;
+				this->CreateInfo.pNext = &this->DescriptorIndexingFeatures;
+			}
+			// No feature bit, enabling the extension is enough.
+			this->isDrawIndirectCountEnabled = this->is_enabled(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+		}
+
+#ifdef VK_KHR_dynamic_rendering
+		// Dynamic rendering is core in 1.3, otherwise needs VK_KHR_dynamic_rendering.
+		// Core only counts if the instance asked for 1.3 as well.
+		this->DynamicRenderingFeatures = {};
+		this->DynamicRenderingFeatures.sType = VkStructureType::VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR;
+		if ((this->api_version() >= VK_API_VERSION_1_3) || this->is_enabled(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME)) {
+			VkPhysicalDeviceFeatures2 Features{};
+			Features.sType		= VkStructureType::VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+			Features.pNext		= &this->DynamicRenderingFeatures;
+			vkGetPhysicalDeviceFeatures2(this->Device->handle(), &Features);
+			if (this->DynamicRenderingFeatures.dynamicRendering == VK_TRUE) {
+				this->DynamicRenderingFeatures.pNext = (void*)this->CreateInfo.pNext;
+				this->CreateInfo.pNext = &this->DynamicRenderingFeatures;
+				this->isDynamicRenderingEnabled = true;
+			}
+		}
+#endif
 
 		Result = vkCreateDevice(this->Device->handle(), &this->CreateInfo, NULL, &this->Handle);
 
+		// All further device calls go through the dispatch table.
+		if (Result == VkResult::VK_SUCCESS) {
+			this->Table.load(this);
+		}
+
 		// Now get queues from device.
 		size_t QueueArrayOffset = 0;
 		for (int i = 0; i < this->UQFICount; i++) {
@@ -170,7 +277,7 @@ namespace geodesuka::core::gcl {
 				size_t Index = j + QueueArrayOffset;
 				this->Queue[Index].i = this->UQFI[i];
 				this->Queue[Index].j = j;
-				vkGetDeviceQueue(this->Handle, this->UQFI[i], j, &this->Queue[Index].Handle);
+				this->Table.vkGetDeviceQueue(this->Handle, this->UQFI[i], j, &this->Queue[Index].Handle);
 			}
 			QueueArrayOffset += QueueFamilyProperty[this->UQFI[i]].queueCount;
 		}
@@ -202,7 +309,7 @@ namespace geodesuka::core::gcl {
 
 		for (int i = 0; i < 3; i++) {
 			if (this->QFI[i] != -1) {
-				Result = vkCreateCommandPool(this->Handle, &this->PoolCreateInfo[i], NULL, &this->Pool[i]);
+				Result = this->Table.vkCreateCommandPool(this->Handle, &this->PoolCreateInfo[i], NULL, &this->Pool[i]);
 			}
 			else {
 				this->Pool[i] = VK_NULL_HANDLE;
@@ -216,9 +323,17 @@ namespace geodesuka::core::gcl {
 		FenceCreateInfo.pNext = NULL;
 		FenceCreateInfo.flags = 0;
 
-		Result = vkCreateFence(Handle, &FenceCreateInfo, NULL, &ExecutionFence[0]);
-		Result = vkCreateFence(Handle, &FenceCreateInfo, NULL, &ExecutionFence[1]);
-		Result = vkCreateFence(Handle, &FenceCreateInfo, NULL, &ExecutionFence[2]);
+		Result = this->Table.vkCreateFence(Handle, &FenceCreateInfo, NULL, &ExecutionFence[0]);
+		Result = this->Table.vkCreateFence(Handle, &FenceCreateInfo, NULL, &ExecutionFence[1]);
+		Result = this->Table.vkCreateFence(Handle, &FenceCreateInfo, NULL, &ExecutionFence[2]);
+
+		this->LayoutCache = new layout_cache(this);
+		this->PipelineCache = new pipeline_cache(this);
+		this->PipelineStateCache = new pipeline_state_cache(this);
+		this->RenderPassCache = new renderpass_cache(this);
+		if (this->isDescriptorIndexingEnabled) {
+			this->BindlessTable = new bindless_table(this);
+		}
 
 		isReadyToBeProcessed.store(true);
 	}
@@ -244,25 +359,36 @@ namespace geodesuka::core::gcl {
 			}
 		}
 
-		vkDestroyFence(Handle, ExecutionFence[0], NULL);
-		vkDestroyFence(Handle, ExecutionFence[1], NULL);
-		vkDestroyFence(Handle, ExecutionFence[2], NULL);
+		// Lane pools of the shared recorder, rendertargets are gone by now.
+		if (Engine->Recorder != nullptr) {
+			Engine->Recorder->remove(this);
+		}
+		delete this->BindlessTable; this->BindlessTable = nullptr;
+		delete this->RenderPassCache; this->RenderPassCache = nullptr;
+		delete this->PipelineStateCache; this->PipelineStateCache = nullptr;
+		delete this->LayoutCache; this->LayoutCache = nullptr;
+		// Saves to disk.
+		delete this->PipelineCache; this->PipelineCache = nullptr;
+
+		this->Table.vkDestroyFence(Handle, ExecutionFence[0], NULL);
+		this->Table.vkDestroyFence(Handle, ExecutionFence[1], NULL);
+		this->Table.vkDestroyFence(Handle, ExecutionFence[2], NULL);
 
 		// Clear all command buffers and pools.
 		for (int i = 0; i < 3; i++) {
 			if (this->CommandBufferCount[i] > 0) {
-				vkFreeCommandBuffers(this->Handle, this->Pool[i], this->CommandBufferCount[i], this->CommandBuffer[i]);
+				this->Table.vkFreeCommandBuffers(this->Handle, this->Pool[i], this->CommandBufferCount[i], this->CommandBuffer[i]);
 			}
 			free(this->CommandBuffer[i]); this->CommandBuffer[i] = NULL;
 			this->CommandBufferCount[i] = 0;
-			vkDestroyCommandPool(this->Handle, this->Pool[i], NULL);
+			this->Table.vkDestroyCommandPool(this->Handle, this->Pool[i], NULL);
 			this->Pool[i] = VK_NULL_HANDLE;
 		}
 
 		delete[] this->Queue; this->Queue = nullptr;
 		this->QueueCount = 0;
 
-		vkDestroyDevice(this->Handle, NULL); this->Handle = VK_NULL_HANDLE;
+		this->Table.vkDestroyDevice(this->Handle, NULL); this->Handle = VK_NULL_HANDLE;
 
 		free(this->QueueCreateInfo); this->QueueCreateInfo = NULL;
 
@@ -303,6 +429,7 @@ namespace geodesuka::core::gcl {
 		case device::qfs::TRANSFER:	 i = 0; break;
 		case device::qfs::COMPUTE:	 i = 1; break;
 		case device::qfs::GRAPHICS:	 i = 2; break;
+		case device::qfs::GRAPHICS_AND_COMPUTE:	 i = 2; break;
 		}
 
 		// Pool is invalid.
@@ -318,7 +445,7 @@ namespace geodesuka::core::gcl {
 
 		this->Mutex.lock();
 		// Check if allocation is succesful.
-		Result = vkAllocateCommandBuffers(this->Handle, &AllocateInfo, aCommandBuffer);
+		Result = this->Table.vkAllocateCommandBuffers(this->Handle, &AllocateInfo, aCommandBuffer);
 		if (Result != VkResult::VK_SUCCESS) {
 			this->Mutex.unlock();
 			return Result;
@@ -336,7 +463,7 @@ namespace geodesuka::core::gcl {
 		// Out of host memory.
 		if (nptr == NULL) {
 			Result = VkResult::VK_ERROR_OUT_OF_HOST_MEMORY;
-			vkFreeCommandBuffers(this->Handle, this->Pool[i], aCommandBufferCount, aCommandBuffer);
+			this->Table.vkFreeCommandBuffers(this->Handle, this->Pool[i], aCommandBufferCount, aCommandBuffer);
 			for (size_t j = 0; j < aCommandBufferCount; j++) {
 				aCommandBuffer[j] = VK_NULL_HANDLE;
 			}
@@ -375,6 +502,7 @@ namespace geodesuka::core::gcl {
 		case device::qfs::TRANSFER:	 Index = 0; break;
 		case device::qfs::COMPUTE:	 Index = 1; break;
 		case device::qfs::GRAPHICS:	 Index = 2; break;
+		case device::qfs::GRAPHICS_AND_COMPUTE:	 Index = 2; break;
 		}
 
 		if (this->Pool[Index] == VK_NULL_HANDLE) return;
@@ -409,7 +537,7 @@ namespace geodesuka::core::gcl {
 					}
 				}
 			}
-			vkFreeCommandBuffers(this->Handle, this->Pool[Index], aCommandBufferCount, aCommandBuffer);
+			this->Table.vkFreeCommandBuffers(this->Handle, this->Pool[Index], aCommandBufferCount, aCommandBuffer);
 			free(this->CommandBuffer[Index]);
 			this->CommandBuffer[Index] = NULL;
 			this->CommandBufferCount[Index] = 0;
@@ -458,7 +586,7 @@ namespace geodesuka::core::gcl {
 
 		}
 
-		vkFreeCommandBuffers(this->Handle, this->Pool[Index], MatchCount, MatchBuffer);
+		this->Table.vkFreeCommandBuffers(this->Handle, this->Pool[Index], MatchCount, MatchBuffer);
 		free(MatchBuffer);
 		MatchBuffer = NULL;
 		free(this->CommandBuffer[Index]);
@@ -473,7 +601,7 @@ namespace geodesuka::core::gcl {
 		default									: return -1;
 		case device::qfs::TRANSFER				: return this->QFI[0];
 		case device::qfs::COMPUTE				: return this->QFI[1];
-		//case device::qfs::GRAPHICS				: return this->QFI[2];
+		case device::qfs::GRAPHICS				: return this->QFI[2];
 		case device::qfs::GRAPHICS_AND_COMPUTE	: return this->QFI[2];
 		case device::qfs::PRESENT				: return this->QFI[3];
 		}
@@ -511,11 +639,11 @@ namespace geodesuka::core::gcl {
 				default:
 					return VkResult::VK_ERROR_FEATURE_NOT_PRESENT;
 				case device::qfs::TRANSFER: case device::qfs::COMPUTE: case device::qfs::GRAPHICS: case device::qfs::GRAPHICS_AND_COMPUTE:
-					Result = vkQueueSubmit(this->Queue[Index].Handle, aCommandBatch.SubmissionCount, aCommandBatch.Submission, aFence);
+					Result = this->Table.vkQueueSubmit(this->Queue[Index].Handle, aCommandBatch.SubmissionCount, aCommandBatch.Submission, aFence);
 					break;
 				case device::qfs::PRESENT:
 					for (int k = 0; k < aCommandBatch.PresentationCount; k++) {
-						Result = vkQueuePresentKHR(this->Queue[Index].Handle, &aCommandBatch.Presentation[k]);
+						Result = this->Table.vkQueuePresentKHR(this->Queue[Index].Handle, &aCommandBatch.Presentation[k]);
 					}
 					break;
 				}
@@ -555,7 +683,7 @@ namespace geodesuka::core::gcl {
 		while (true) {
 			int Index = i + Offset;
 			if (this->Queue[Index].Mutex.try_lock()) {
-				Result = vkQueueSubmit(this->Queue[Index].Handle, aSubmissionCount, aSubmission, aFence);
+				Result = this->Table.vkQueueSubmit(this->Queue[Index].Handle, aSubmissionCount, aSubmission, aFence);
 				this->Queue[Index].Mutex.unlock();
 				break;
 			}
@@ -589,7 +717,7 @@ namespace geodesuka::core::gcl {
 		while (true) {
 			int Index = i + Offset;
 			if (this->Queue[Index].Mutex.try_lock()) {
-				Result = vkQueuePresentKHR(this->Queue[Index].Handle, aPresentation);
+				Result = this->Table.vkQueuePresentKHR(this->Queue[Index].Handle, aPresentation);
 				this->Queue[Index].Mutex.unlock();
 				break;
 			}
@@ -601,6 +729,60 @@ namespace geodesuka::core::gcl {
 		return Result;
 	}
 
+	layout_cache* context::layouts() {
+		return this->LayoutCache;
+	}
+
+	pipeline_cache* context::cache() {
+		return this->PipelineCache;
+	}
+
+	pipeline_state_cache* context::pipelines() {
+		return this->PipelineStateCache;
+	}
+
+	renderpass_cache* context::renderpasses() {
+		return this->RenderPassCache;
+	}
+
+	uint32_t context::api_version() {
+		uint32_t DeviceVersion = this->Device->get_properties().apiVersion;
+		uint32_t InstanceVersion = this->Engine->AppInfo.apiVersion;
+		return DeviceVersion < InstanceVersion ? DeviceVersion : InstanceVersion;
+	}
+
+	bool context::is_enabled(const char* aExtension) {
+		if (aExtension == NULL) return false;
+		for (size_t i = 0; i < this->Extension.size(); i++) {
+			if (this->Extension[i] == aExtension) return true;
+		}
+		return false;
+	}
+
+	bool context::is_pipeline_library_enabled() {
+		return this->isPipelineLibraryEnabled;
+	}
+
+	bool context::is_descriptor_indexing_enabled() {
+		return this->isDescriptorIndexingEnabled;
+	}
+
+	bool context::is_draw_indirect_count_enabled() {
+		return this->isDrawIndirectCountEnabled;
+	}
+
+	bool context::is_dynamic_rendering_enabled() {
+		return this->isDynamicRenderingEnabled;
+	}
+
+	bindless_table* context::bindless() {
+		return this->BindlessTable;
+	}
+
+	const device_table& context::api() {
+		return this->Table;
+	}
+
 	VkInstance context::inst() {
 		return this->Device->inst();
 	}
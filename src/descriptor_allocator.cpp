@@ -0,0 +1,251 @@
+#include <geodesuka/core/gcl/descriptor_allocator.h>
+
+#include <geodesuka/core/gcl/context.h>
+
+namespace geodesuka::core::gcl {
+
+	// Sets in the first pool of a list, each new pool doubles up to the maximum.
+	static const uint32_t InitialSetCount	= 64;
+	static const uint32_t MaximumSetCount	= 4096;
+
+	// Descriptors per set reserved in every pool, by type.
+	static const struct {
+		VkDescriptorType Type;
+		float Ratio;
+	} PoolRatio[] = {
+		{ VkDescriptorType::VK_DESCRIPTOR_TYPE_SAMPLER,					0.5f },
+		{ VkDescriptorType::VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,	4.0f },
+		{ VkDescriptorType::VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,			4.0f },
+		{ VkDescriptorType::VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,			1.0f },
+		{ VkDescriptorType::VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER,	1.0f },
+		{ VkDescriptorType::VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER,	1.0f },
+		{ VkDescriptorType::VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,			2.0f },
+		{ VkDescriptorType::VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,			2.0f },
+		{ VkDescriptorType::VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,	1.0f },
+		{ VkDescriptorType::VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC,	1.0f },
+		{ VkDescriptorType::VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT,		0.5f }
+	};
+
+	template<typename T>
+	static void put(std::string& aKey, const T& aValue) {
+		aKey.append((const char*)&aValue, sizeof(T));
+	}
+
+	descriptor_allocator::pool_list::pool_list() {
+		this->Active = 0;
+		this->SetCount = InitialSetCount;
+	}
+
+	descriptor_allocator::descriptor_allocator(context* aContext, uint32_t aFrameCount) {
+		this->Context = aContext;
+		this->Frame.resize(aFrameCount > 0 ? aFrameCount : 1);
+	}
+
+	descriptor_allocator::~descriptor_allocator() {
+		this->Mutex.lock();
+		for (size_t i = 0; i < this->Frame.size(); i++) {
+			this->destroy(this->Frame[i]);
+		}
+		this->destroy(this->Persistent);
+		this->PersistentSet.clear();
+		for (auto it = this->Template.begin(); it != this->Template.end(); it++) {
+			this->Context->api().vkDestroyDescriptorUpdateTemplate(this->Context->handle(), it->second, NULL);
+		}
+		this->Template.clear();
+		this->Mutex.unlock();
+		this->Context = nullptr;
+	}
+
+	VkDescriptorUpdateTemplate descriptor_allocator::update_template(VkDescriptorSetLayout aLayout, uint32_t aEntryCount, const VkDescriptorUpdateTemplateEntry* aEntry) {
+		VkDescriptorUpdateTemplate Handle = VK_NULL_HANDLE;
+		if ((aLayout == VK_NULL_HANDLE) || (aEntryCount == 0) || (aEntry == NULL)) return Handle;
+
+		std::string Key;
+		put(Key, aLayout);
+		for (uint32_t i = 0; i < aEntryCount; i++) {
+			put(Key, aEntry[i].dstBinding);
+			put(Key, aEntry[i].dstArrayElement);
+			put(Key, aEntry[i].descriptorCount);
+			put(Key, aEntry[i].descriptorType);
+			put(Key, (uint64_t)aEntry[i].offset);
+			put(Key, (uint64_t)aEntry[i].stride);
+		}
+
+		this->Mutex.lock();
+		auto it = this->Template.find(Key);
+		if (it != this->Template.end()) {
+			Handle = it->second;
+		}
+		else {
+			VkDescriptorUpdateTemplateCreateInfo CreateInfo{};
+			CreateInfo.sType						= VkStructureType::VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO;
+			CreateInfo.pNext						= NULL;
+			CreateInfo.flags						= 0;
+			CreateInfo.descriptorUpdateEntryCount	= aEntryCount;
+			CreateInfo.pDescriptorUpdateEntries		= aEntry;
+			CreateInfo.templateType					= VkDescriptorUpdateTemplateType::VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET;
+			CreateInfo.descriptorSetLayout			= aLayout;
+			CreateInfo.pipelineBindPoint			= VkPipelineBindPoint::VK_PIPELINE_BIND_POINT_GRAPHICS;
+			CreateInfo.pipelineLayout				= VK_NULL_HANDLE;
+			CreateInfo.set							= 0;
+			if (this->Context->api().vkCreateDescriptorUpdateTemplate(this->Context->handle(), &CreateInfo, NULL, &Handle) == VkResult::VK_SUCCESS) {
+				this->Template[Key] = Handle;
+			}
+			else {
+				Handle = VK_NULL_HANDLE;
+			}
+		}
+		this->Mutex.unlock();
+
+		return Handle;
+	}
+
+	VkDescriptorSet descriptor_allocator::allocate(uint32_t aFrame, VkDescriptorSetLayout aLayout) {
+		if (aFrame >= this->Frame.size()) return VK_NULL_HANDLE;
+		this->Mutex.lock();
+		VkDescriptorSet Set = this->allocate(this->Frame[aFrame], aLayout);
+		this->Mutex.unlock();
+		return Set;
+	}
+
+	VkDescriptorSet descriptor_allocator::allocate(uint32_t aFrame, VkDescriptorSetLayout aLayout, VkDescriptorUpdateTemplate aTemplate, const void* aData) {
+		VkDescriptorSet Set = this->allocate(aFrame, aLayout);
+		if (Set != VK_NULL_HANDLE) {
+			this->write(Set, aTemplate, aData);
+		}
+		return Set;
+	}
+
+	VkDescriptorSet descriptor_allocator::acquire(VkDescriptorSetLayout aLayout, VkDescriptorUpdateTemplate aTemplate, const void* aData, size_t aSize) {
+		if ((aTemplate == VK_NULL_HANDLE) || (aData == NULL)) return VK_NULL_HANDLE;
+
+		std::string Key;
+		put(Key, aLayout);
+		put(Key, aTemplate);
+		Key.append((const char*)aData, aSize);
+
+		VkDescriptorSet Set = VK_NULL_HANDLE;
+		this->Mutex.lock();
+		auto it = this->PersistentSet.find(Key);
+		if (it != this->PersistentSet.end()) {
+			Set = it->second;
+		}
+		else {
+			Set = this->allocate(this->Persistent, aLayout);
+			if (Set != VK_NULL_HANDLE) {
+				this->Context->api().vkUpdateDescriptorSetWithTemplate(this->Context->handle(), Set, aTemplate, aData);
+				this->PersistentSet[Key] = Set;
+			}
+		}
+		this->Mutex.unlock();
+
+		return Set;
+	}
+
+	void descriptor_allocator::write(VkDescriptorSet aSet, VkDescriptorUpdateTemplate aTemplate, const void* aData) {
+		if ((aSet == VK_NULL_HANDLE) || (aTemplate == VK_NULL_HANDLE) || (aData == NULL)) return;
+		this->Context->api().vkUpdateDescriptorSetWithTemplate(this->Context->handle(), aSet, aTemplate, aData);
+	}
+
+	void descriptor_allocator::reset(uint32_t aFrame) {
+		if (aFrame >= this->Frame.size()) return;
+		this->Mutex.lock();
+		this->reset(this->Frame[aFrame]);
+		this->Mutex.unlock();
+	}
+
+	void descriptor_allocator::reset_persistent() {
+		this->Mutex.lock();
+		this->reset(this->Persistent);
+		this->PersistentSet.clear();
+		this->Mutex.unlock();
+	}
+
+	uint32_t descriptor_allocator::frame_count() {
+		return (uint32_t)this->Frame.size();
+	}
+
+	size_t descriptor_allocator::pool_count(uint32_t aFrame) {
+		if (aFrame >= this->Frame.size()) return 0;
+		this->Mutex.lock();
+		size_t Count = this->Frame[aFrame].Pool.size();
+		this->Mutex.unlock();
+		return Count;
+	}
+
+	VkDescriptorSet descriptor_allocator::allocate(pool_list& aList, VkDescriptorSetLayout aLayout) {
+		VkDescriptorSet Set = VK_NULL_HANDLE;
+		if (aLayout == VK_NULL_HANDLE) return Set;
+
+		VkDescriptorSetAllocateInfo AllocateInfo{};
+		AllocateInfo.sType					= VkStructureType::VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		AllocateInfo.pNext					= NULL;
+		AllocateInfo.descriptorSetCount		= 1;
+		AllocateInfo.pSetLayouts			= &aLayout;
+
+		// Try active pool, move on to next pool when full, create one when none left.
+		while (true) {
+			bool isFresh = false;
+			if (aList.Active == aList.Pool.size()) {
+				VkDescriptorPool Pool = this->create_pool(aList.SetCount);
+				if (Pool == VK_NULL_HANDLE) return VK_NULL_HANDLE;
+				aList.Pool.push_back(Pool);
+				if (aList.SetCount < MaximumSetCount) {
+					aList.SetCount *= 2;
+				}
+				isFresh = true;
+			}
+
+			AllocateInfo.descriptorPool = aList.Pool[aList.Active];
+			VkResult Result = this->Context->api().vkAllocateDescriptorSets(this->Context->handle(), &AllocateInfo, &Set);
+			if (Result == VkResult::VK_SUCCESS) return Set;
+
+			// Other errors are not solved by another pool, and a set too large
+			// for an empty pool will not fit in the next one either.
+			if ((Result != VkResult::VK_ERROR_OUT_OF_POOL_MEMORY) && (Result != VkResult::VK_ERROR_FRAGMENTED_POOL)) return VK_NULL_HANDLE;
+			if (isFresh) return VK_NULL_HANDLE;
+			aList.Active += 1;
+		}
+	}
+
+	VkDescriptorPool descriptor_allocator::create_pool(uint32_t aSetCount) {
+		VkDescriptorPoolSize PoolSize[sizeof(PoolRatio) / sizeof(PoolRatio[0])];
+		uint32_t PoolSizeCount = sizeof(PoolRatio) / sizeof(PoolRatio[0]);
+		for (uint32_t i = 0; i < PoolSizeCount; i++) {
+			PoolSize[i].type				= PoolRatio[i].Type;
+			PoolSize[i].descriptorCount		= (uint32_t)(PoolRatio[i].Ratio * aSetCount);
+		}
+
+		VkDescriptorPoolCreateInfo CreateInfo{};
+		CreateInfo.sType			= VkStructureType::VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+		CreateInfo.pNext			= NULL;
+		CreateInfo.flags			= 0;
+		CreateInfo.maxSets			= aSetCount;
+		CreateInfo.poolSizeCount	= PoolSizeCount;
+		CreateInfo.pPoolSizes		= PoolSize;
+
+		VkDescriptorPool Pool = VK_NULL_HANDLE;
+		if (this->Context->api().vkCreateDescriptorPool(this->Context->handle(), &CreateInfo, NULL, &Pool) != VkResult::VK_SUCCESS) {
+			return VK_NULL_HANDLE;
+		}
+		return Pool;
+	}
+
+	void descriptor_allocator::reset(pool_list& aList) {
+		// Pools are kept, so a steady frame allocates no pools at all.
+		for (size_t i = 0; i < aList.Pool.size(); i++) {
+			this->Context->api().vkResetDescriptorPool(this->Context->handle(), aList.Pool[i], 0);
+		}
+		aList.Active = 0;
+	}
+
+	void descriptor_allocator::destroy(pool_list& aList) {
+		for (size_t i = 0; i < aList.Pool.size(); i++) {
+			this->Context->api().vkDestroyDescriptorPool(this->Context->handle(), aList.Pool[i], NULL);
+		}
+		aList.Pool.clear();
+		aList.Active = 0;
+		aList.SetCount = InitialSetCount;
+	}
+
+}
@@ -141,6 +141,15 @@ namespace geodesuka::core::gcl {
 		vkGetPhysicalDeviceFeatures(this->Handle, &this->Features);
 		vkGetPhysicalDeviceMemoryProperties(this->Handle, &this->MemoryProperties);
 
+		// Device UUID, Vulkan 1.1 core.
+		VkPhysicalDeviceProperties2 Properties2{};
+		this->IDProperties.sType		= VkStructureType::VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ID_PROPERTIES;
+		this->IDProperties.pNext		= NULL;
+		Properties2.sType				= VkStructureType::VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+		Properties2.pNext				= &this->IDProperties;
+		vkGetPhysicalDeviceProperties2(this->Handle, &Properties2);
+		this->IDProperties.pNext		= NULL;
+
 		// Clear up Dummy stuff.
 		vkDestroySurfaceKHR(aInstance, lDummySurface, NULL);
 		lDummySurface = VK_NULL_HANDLE;
@@ -204,6 +213,10 @@ namespace geodesuka::core::gcl {
 		return temp;
 	}
 
+	VkPhysicalDeviceIDProperties device::get_id_properties() const {
+		return this->IDProperties;
+	}
+
 	const VkExtensionProperties* device::get_extensions(uint32_t* aExtensionCount) const {
 		*aExtensionCount = this->ExtensionCount;
 		return this->Extension;
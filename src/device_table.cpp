@@ -0,0 +1,179 @@
+#include <geodesuka/core/gcl/device_table.h>
+
+#include <cstring>
+
+#include <geodesuka/core/gcl/context.h>
+
+// Loads one entry point into the member of the same name.
+#define GCL_LOAD(Name) this->Name = (PFN_##Name)vkGetDeviceProcAddr(Device, #Name)
+
+namespace geodesuka::core::gcl {
+
+	device_table::device_table() {
+		memset(this, 0, sizeof(device_table));
+	}
+
+	void device_table::load(context* aContext) {
+		*this = device_table();
+		if ((aContext == nullptr) || (aContext->handle() == VK_NULL_HANDLE)) return;
+		VkDevice Device = aContext->handle();
+
+		// ----- Core ----- //
+
+		GCL_LOAD(vkDestroyDevice);
+		GCL_LOAD(vkGetDeviceQueue);
+		GCL_LOAD(vkDeviceWaitIdle);
+		GCL_LOAD(vkQueueSubmit);
+		GCL_LOAD(vkQueueWaitIdle);
+		GCL_LOAD(vkCreateFence);
+		GCL_LOAD(vkDestroyFence);
+		GCL_LOAD(vkResetFences);
+		GCL_LOAD(vkGetFenceStatus);
+		GCL_LOAD(vkWaitForFences);
+		GCL_LOAD(vkCreateSemaphore);
+		GCL_LOAD(vkDestroySemaphore);
+		GCL_LOAD(vkAllocateMemory);
+		GCL_LOAD(vkFreeMemory);
+		GCL_LOAD(vkMapMemory);
+		GCL_LOAD(vkUnmapMemory);
+		GCL_LOAD(vkFlushMappedMemoryRanges);
+		GCL_LOAD(vkInvalidateMappedMemoryRanges);
+		GCL_LOAD(vkCreateBuffer);
+		GCL_LOAD(vkDestroyBuffer);
+		GCL_LOAD(vkGetBufferMemoryRequirements);
+		GCL_LOAD(vkBindBufferMemory);
+		GCL_LOAD(vkCreateImage);
+		GCL_LOAD(vkDestroyImage);
+		GCL_LOAD(vkGetImageMemoryRequirements);
+		GCL_LOAD(vkBindImageMemory);
+		GCL_LOAD(vkCreateImageView);
+		GCL_LOAD(vkDestroyImageView);
+		GCL_LOAD(vkCreateSampler);
+		GCL_LOAD(vkDestroySampler);
+		GCL_LOAD(vkCreateDescriptorSetLayout);
+		GCL_LOAD(vkDestroyDescriptorSetLayout);
+		GCL_LOAD(vkCreateDescriptorPool);
+		GCL_LOAD(vkDestroyDescriptorPool);
+		GCL_LOAD(vkResetDescriptorPool);
+		GCL_LOAD(vkAllocateDescriptorSets);
+		GCL_LOAD(vkFreeDescriptorSets);
+		GCL_LOAD(vkUpdateDescriptorSets);
+		GCL_LOAD(vkCreateDescriptorUpdateTemplate);
+		GCL_LOAD(vkDestroyDescriptorUpdateTemplate);
+		GCL_LOAD(vkUpdateDescriptorSetWithTemplate);
+		GCL_LOAD(vkCreateShaderModule);
+		GCL_LOAD(vkDestroyShaderModule);
+		GCL_LOAD(vkCreatePipelineLayout);
+		GCL_LOAD(vkDestroyPipelineLayout);
+		GCL_LOAD(vkCreatePipelineCache);
+		GCL_LOAD(vkDestroyPipelineCache);
+		GCL_LOAD(vkGetPipelineCacheData);
+		GCL_LOAD(vkMergePipelineCaches);
+		GCL_LOAD(vkCreateGraphicsPipelines);
+		GCL_LOAD(vkCreateComputePipelines);
+		GCL_LOAD(vkDestroyPipeline);
+		GCL_LOAD(vkCreateRenderPass);
+		GCL_LOAD(vkDestroyRenderPass);
+		GCL_LOAD(vkCreateFramebuffer);
+		GCL_LOAD(vkDestroyFramebuffer);
+		GCL_LOAD(vkCreateCommandPool);
+		GCL_LOAD(vkDestroyCommandPool);
+		GCL_LOAD(vkResetCommandPool);
+		GCL_LOAD(vkAllocateCommandBuffers);
+		GCL_LOAD(vkFreeCommandBuffers);
+		GCL_LOAD(vkBeginCommandBuffer);
+		GCL_LOAD(vkEndCommandBuffer);
+		GCL_LOAD(vkResetCommandBuffer);
+		GCL_LOAD(vkCmdBindPipeline);
+		GCL_LOAD(vkCmdBindDescriptorSets);
+		GCL_LOAD(vkCmdBindVertexBuffers);
+		GCL_LOAD(vkCmdBindIndexBuffer);
+		GCL_LOAD(vkCmdPushConstants);
+		GCL_LOAD(vkCmdSetViewport);
+		GCL_LOAD(vkCmdSetScissor);
+		GCL_LOAD(vkCmdSetLineWidth);
+		GCL_LOAD(vkCmdSetDepthBias);
+		GCL_LOAD(vkCmdSetBlendConstants);
+		GCL_LOAD(vkCmdSetStencilReference);
+		GCL_LOAD(vkCmdDraw);
+		GCL_LOAD(vkCmdDrawIndexed);
+		GCL_LOAD(vkCmdDrawIndirect);
+		GCL_LOAD(vkCmdDrawIndexedIndirect);
+		GCL_LOAD(vkCmdDispatch);
+		GCL_LOAD(vkCmdDispatchIndirect);
+		GCL_LOAD(vkCmdCopyBuffer);
+		GCL_LOAD(vkCmdCopyImage);
+		GCL_LOAD(vkCmdBlitImage);
+		GCL_LOAD(vkCmdCopyBufferToImage);
+		GCL_LOAD(vkCmdCopyImageToBuffer);
+		GCL_LOAD(vkCmdUpdateBuffer);
+		GCL_LOAD(vkCmdFillBuffer);
+		GCL_LOAD(vkCmdPipelineBarrier);
+		GCL_LOAD(vkCmdBeginRenderPass);
+		GCL_LOAD(vkCmdNextSubpass);
+		GCL_LOAD(vkCmdEndRenderPass);
+		GCL_LOAD(vkCmdExecuteCommands);
+
+		// ----- Extensions ----- //
+		// Only queried when enabled, drivers may return stubs for disabled extensions.
+
+		if (aContext->is_enabled(VK_KHR_SWAPCHAIN_EXTENSION_NAME)) {
+			GCL_LOAD(vkCreateSwapchainKHR);
+			GCL_LOAD(vkDestroySwapchainKHR);
+			GCL_LOAD(vkGetSwapchainImagesKHR);
+			GCL_LOAD(vkAcquireNextImageKHR);
+			GCL_LOAD(vkQueuePresentKHR);
+		}
+		this->isSwapchainAvailable = (this->vkCreateSwapchainKHR != NULL) && (this->vkAcquireNextImageKHR != NULL) && (this->vkQueuePresentKHR != NULL);
+
+		// Opaque file descriptors only, Win32 handle types are not supported.
+#if !(defined(_WIN32) || defined(_WIN64))
+		if (aContext->is_enabled(VK_KHR_EXTERNAL_MEMORY_FD_EXTENSION_NAME)) {
+			GCL_LOAD(vkGetMemoryFdKHR);
+		}
+		if (aContext->is_enabled(VK_KHR_EXTERNAL_SEMAPHORE_FD_EXTENSION_NAME)) {
+			GCL_LOAD(vkGetSemaphoreFdKHR);
+			GCL_LOAD(vkImportSemaphoreFdKHR);
+		}
+#endif
+		this->isExternalMemoryFdAvailable = (this->vkGetMemoryFdKHR != NULL);
+		this->isExternalSemaphoreFdAvailable = (this->vkGetSemaphoreFdKHR != NULL) && (this->vkImportSemaphoreFdKHR != NULL);
+
+		// Only with the feature or extension enabled, core 1.2 entry points are aliases.
+		if (aContext->is_draw_indirect_count_enabled()) {
+			if (aContext->api_version() >= VK_API_VERSION_1_2) {
+				GCL_LOAD(vkCmdDrawIndirectCount);
+				GCL_LOAD(vkCmdDrawIndexedIndirectCount);
+			}
+			if ((this->vkCmdDrawIndirectCount == NULL) || (this->vkCmdDrawIndexedIndirectCount == NULL)) {
+				this->vkCmdDrawIndirectCount			= (PFN_vkCmdDrawIndirectCount)vkGetDeviceProcAddr(Device, "vkCmdDrawIndirectCountKHR");
+				this->vkCmdDrawIndexedIndirectCount		= (PFN_vkCmdDrawIndexedIndirectCount)vkGetDeviceProcAddr(Device, "vkCmdDrawIndexedIndirectCountKHR");
+			}
+		}
+		this->isDrawIndirectCountAvailable = (this->vkCmdDrawIndirectCount != NULL) && (this->vkCmdDrawIndexedIndirectCount != NULL);
+
+		if (aContext->is_enabled(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME)) {
+			GCL_LOAD(vkCmdPushDescriptorSetKHR);
+			GCL_LOAD(vkCmdPushDescriptorSetWithTemplateKHR);
+		}
+		this->isPushDescriptorAvailable = (this->vkCmdPushDescriptorSetKHR != NULL);
+
+#ifdef VK_KHR_dynamic_rendering
+		// Only with the feature enabled, core 1.3 entry points are aliases.
+		if (aContext->is_dynamic_rendering_enabled()) {
+			if (aContext->api_version() >= VK_API_VERSION_1_3) {
+				this->vkCmdBeginRenderingKHR	= (PFN_vkCmdBeginRenderingKHR)vkGetDeviceProcAddr(Device, "vkCmdBeginRendering");
+				this->vkCmdEndRenderingKHR		= (PFN_vkCmdEndRenderingKHR)vkGetDeviceProcAddr(Device, "vkCmdEndRendering");
+			}
+			if (this->vkCmdBeginRenderingKHR == NULL) {
+				GCL_LOAD(vkCmdBeginRenderingKHR);
+				GCL_LOAD(vkCmdEndRenderingKHR);
+			}
+		}
+		this->isDynamicRenderingAvailable = (this->vkCmdBeginRenderingKHR != NULL) && (this->vkCmdEndRenderingKHR != NULL);
+#endif
+	}
+
+}
+
+#undef GCL_LOAD
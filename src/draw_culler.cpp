@@ -0,0 +1,306 @@
+#include <geodesuka/core/gcl/draw_culler.h>
+
+#include <geodesuka/core/gcl/device.h>
+#include <geodesuka/core/logic/frustum_culler.h>
+#include <geodesuka/builtin/embedded_shader.h>
+
+namespace geodesuka::core::gcl {
+
+	// Largest vkCmdUpdateBuffer, in bytes.
+	static constexpr VkDeviceSize UPDATE_LIMIT = 65536;
+
+	// Descriptor data of the culling pass, laid out as the update template.
+	struct cull_descriptor {
+		VkDescriptorBufferInfo Bounds;
+		VkDescriptorBufferInfo Command;
+		VkDescriptorBufferInfo Visible;
+		VkDescriptorBufferInfo VisibleCount;
+	};
+
+	draw_culler::draw_culler(context* aContext, uint32_t aCapacity) {
+		this->ErrorCode		= VkResult::VK_INCOMPLETE;
+		this->Context		= aContext;
+		this->Capacity		= aCapacity;
+		this->Shader		= nullptr;
+		this->Pipeline		= nullptr;
+		this->Descriptor	= nullptr;
+		this->Template		= VK_NULL_HANDLE;
+		this->Bounds		= nullptr;
+		this->Command		= nullptr;
+		this->DrawCount		= 0;
+		this->DirtyBegin	= 0;
+		this->DirtyEnd		= 0;
+		if ((aContext == nullptr) || (aCapacity == 0)) return;
+
+		// Multi draws in draw() are limited by the device, one call per draw otherwise.
+		uint32_t MaxDrawCount = this->Context->parent()->get_properties().limits.maxDrawIndirectCount;
+		bool isMultiDraw = this->Context->api().isDrawIndirectCountAvailable || (this->Context->parent()->get_features().multiDrawIndirect == VK_TRUE);
+		if ((isMultiDraw) && (this->Capacity > MaxDrawCount)) {
+			this->Capacity = MaxDrawCount;
+		}
+
+		this->Shader = builtin::embedded_shader::create(aContext, "draw_cull.comp");
+		if (this->Shader == nullptr) {
+			this->ErrorCode = VkResult::VK_ERROR_INITIALIZATION_FAILED;
+			return;
+		}
+		this->Pipeline = new compute_pipeline(aContext, this->Shader);
+		this->ErrorCode = this->Pipeline->ErrorCode;
+		if (!this->Pipeline->is_valid()) return;
+
+		// Only persistent sets, one per view and frame.
+		this->Descriptor = new descriptor_allocator(aContext, 1);
+		VkDescriptorUpdateTemplateEntry Entry[4];
+		for (uint32_t i = 0; i < 4; i++) {
+			Entry[i].dstBinding			= i;
+			Entry[i].dstArrayElement	= 0;
+			Entry[i].descriptorCount	= 1;
+			Entry[i].descriptorType		= VkDescriptorType::VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+			Entry[i].offset				= i * sizeof(VkDescriptorBufferInfo);
+			Entry[i].stride				= sizeof(VkDescriptorBufferInfo);
+		}
+		this->Template = this->Descriptor->update_template(this->Pipeline->set_layout(0), 4, Entry);
+
+		this->Sphere.resize(this->Capacity, float4(0.0f, 0.0f, 0.0f, 0.0f));
+		this->Draw.resize(this->Capacity, VkDrawIndexedIndirectCommand{});
+		// Device local, only ever written by commands recorded in cull().
+		int SceneUsage = buffer::usage::STORAGE | buffer::usage::TRANSFER_DST;
+		this->Bounds = new buffer(aContext, device::memory::DEVICE_LOCAL, SceneUsage, this->Capacity * sizeof(float4), NULL);
+		this->Command = new buffer(aContext, device::memory::DEVICE_LOCAL, SceneUsage, this->Capacity * sizeof(VkDrawIndexedIndirectCommand), NULL);
+		this->ErrorCode = ((this->Template != VK_NULL_HANDLE) && (this->Bounds->handle() != VK_NULL_HANDLE) && (this->Command->handle() != VK_NULL_HANDLE)) ? VkResult::VK_SUCCESS : VkResult::VK_ERROR_INITIALIZATION_FAILED;
+	}
+
+	draw_culler::~draw_culler() {
+		for (auto it = this->View.begin(); it != this->View.end(); it++) {
+			for (size_t i = 0; i < it->second.size(); i++) {
+				delete it->second[i].Indirect;
+				delete it->second[i].Count;
+			}
+		}
+		this->View.clear();
+		delete this->Command;
+		this->Command = nullptr;
+		delete this->Bounds;
+		this->Bounds = nullptr;
+		// Sets and template go with the allocator.
+		delete this->Descriptor;
+		this->Descriptor = nullptr;
+		delete this->Pipeline;
+		this->Pipeline = nullptr;
+		delete this->Shader;
+		this->Shader = nullptr;
+		this->Context = nullptr;
+	}
+
+	bool draw_culler::is_valid() {
+		return this->ErrorCode == VkResult::VK_SUCCESS;
+	}
+
+	uint32_t draw_culler::add(float3 aCenter, float aRadius, const VkDrawIndexedIndirectCommand& aCommand) {
+		uint32_t Index = INVALID_DRAW;
+		this->Mutex.lock();
+		if (this->FreeDraw.size() > 0) {
+			Index = this->FreeDraw.back();
+			this->FreeDraw.pop_back();
+		}
+		else if (this->DrawCount < this->Capacity) {
+			Index = this->DrawCount;
+			this->DrawCount += 1;
+		}
+		if (Index != INVALID_DRAW) {
+			this->Sphere[Index] = float4(aCenter.x, aCenter.y, aCenter.z, aRadius);
+			this->Draw[Index] = aCommand;
+			this->mark(Index);
+		}
+		this->Mutex.unlock();
+		return Index;
+	}
+
+	void draw_culler::update(uint32_t aDraw, float3 aCenter, float aRadius) {
+		this->Mutex.lock();
+		if (aDraw < this->DrawCount) {
+			this->Sphere[aDraw] = float4(aCenter.x, aCenter.y, aCenter.z, aRadius);
+			this->mark(aDraw);
+		}
+		this->Mutex.unlock();
+	}
+
+	void draw_culler::remove(uint32_t aDraw) {
+		this->Mutex.lock();
+		if ((aDraw < this->DrawCount) && (this->Draw[aDraw].indexCount > 0)) {
+			// Skipped by the pass, slot is reused by the next add().
+			this->Draw[aDraw] = VkDrawIndexedIndirectCommand{};
+			this->FreeDraw.push_back(aDraw);
+			this->mark(aDraw);
+		}
+		this->Mutex.unlock();
+	}
+
+	uint32_t draw_culler::capacity() {
+		return this->Capacity;
+	}
+
+	void draw_culler::cull(VkCommandBuffer aCommandBuffer, object::rendertarget* aRenderTarget, uint32_t aFrameIndex, const float4x4& aViewProjection) {
+		if (!this->is_valid()) return;
+		this->Mutex.lock();
+		view_frame* Frame = this->view_of(aRenderTarget, aFrameIndex);
+		if (Frame == nullptr) {
+			this->Mutex.unlock();
+			return;
+		}
+		this->upload(aCommandBuffer);
+
+		frustum Frustum{};
+		logic::frustum_culler::extract_planes(aViewProjection, Frustum.Plane);
+		Frustum.DrawCount = this->DrawCount;
+
+		const device_table& API = this->Context->api();
+		VkPipelineStageFlags DrawIndirect = VkPipelineStageFlagBits::VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
+
+		// Previous draws of this frame slot read the buffers being reset.
+		API.vkCmdFillBuffer(aCommandBuffer, Frame->Count->handle(), 0, sizeof(uint32_t), 0);
+		if (!API.isDrawIndirectCountAvailable) {
+			API.vkCmdFillBuffer(aCommandBuffer, Frame->Indirect->handle(), 0, VK_WHOLE_SIZE, 0);
+		}
+		this->Pipeline->barrier(aCommandBuffer, Frame->Count->handle(), 0, VK_WHOLE_SIZE,
+			VkPipelineStageFlagBits::VK_PIPELINE_STAGE_TRANSFER_BIT, VkAccessFlagBits::VK_ACCESS_TRANSFER_WRITE_BIT,
+			VkPipelineStageFlagBits::VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VkAccessFlagBits::VK_ACCESS_SHADER_READ_BIT | VkAccessFlagBits::VK_ACCESS_SHADER_WRITE_BIT
+		);
+		this->Pipeline->barrier(aCommandBuffer, Frame->Indirect->handle(), 0, VK_WHOLE_SIZE,
+			VkPipelineStageFlagBits::VK_PIPELINE_STAGE_TRANSFER_BIT, VkAccessFlagBits::VK_ACCESS_TRANSFER_WRITE_BIT,
+			VkPipelineStageFlagBits::VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VkAccessFlagBits::VK_ACCESS_SHADER_WRITE_BIT
+		);
+
+		this->Pipeline->bind(aCommandBuffer);
+		API.vkCmdBindDescriptorSets(aCommandBuffer, VkPipelineBindPoint::VK_PIPELINE_BIND_POINT_COMPUTE, this->Pipeline->layout(), 0, 1, &Frame->Set, 0, NULL);
+		this->Pipeline->push(aCommandBuffer, 0, sizeof(frustum), &Frustum);
+		this->Pipeline->dispatch_threads(aCommandBuffer, this->DrawCount, 1, 1);
+
+		// Compacted draws and their count are read as indirect arguments.
+		this->Pipeline->barrier(aCommandBuffer, Frame->Indirect->handle(), 0, VK_WHOLE_SIZE,
+			VkPipelineStageFlagBits::VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VkAccessFlagBits::VK_ACCESS_SHADER_WRITE_BIT,
+			DrawIndirect, VkAccessFlagBits::VK_ACCESS_INDIRECT_COMMAND_READ_BIT
+		);
+		this->Pipeline->barrier(aCommandBuffer, Frame->Count->handle(), 0, VK_WHOLE_SIZE,
+			VkPipelineStageFlagBits::VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VkAccessFlagBits::VK_ACCESS_SHADER_WRITE_BIT,
+			DrawIndirect, VkAccessFlagBits::VK_ACCESS_INDIRECT_COMMAND_READ_BIT
+		);
+		this->Mutex.unlock();
+	}
+
+	void draw_culler::draw(VkCommandBuffer aCommandBuffer, object::rendertarget* aRenderTarget, uint32_t aFrameIndex) {
+		if (!this->is_valid()) return;
+		this->Mutex.lock();
+		view_frame* Frame = this->view_of(aRenderTarget, aFrameIndex);
+		if (Frame == nullptr) {
+			this->Mutex.unlock();
+			return;
+		}
+
+		// Recorded against capacity, so the secondary survives scene changes.
+		const device_table& API = this->Context->api();
+		uint32_t Stride = sizeof(VkDrawIndexedIndirectCommand);
+		if (API.isDrawIndirectCountAvailable) {
+			API.vkCmdDrawIndexedIndirectCount(aCommandBuffer, Frame->Indirect->handle(), 0, Frame->Count->handle(), 0, this->Capacity, Stride);
+		}
+		else if (this->Context->parent()->get_features().multiDrawIndirect == VK_TRUE) {
+			API.vkCmdDrawIndexedIndirect(aCommandBuffer, Frame->Indirect->handle(), 0, this->Capacity, Stride);
+		}
+		else {
+			for (uint32_t i = 0; i < this->Capacity; i++) {
+				API.vkCmdDrawIndexedIndirect(aCommandBuffer, Frame->Indirect->handle(), (VkDeviceSize)i * Stride, 1, Stride);
+			}
+		}
+		this->Mutex.unlock();
+	}
+
+	void draw_culler::forget(object::rendertarget* aRenderTarget) {
+		this->Mutex.lock();
+		auto it = this->View.find(aRenderTarget);
+		if (it != this->View.end()) {
+			for (size_t i = 0; i < it->second.size(); i++) {
+				delete it->second[i].Indirect;
+				delete it->second[i].Count;
+			}
+			this->View.erase(it);
+		}
+		this->Mutex.unlock();
+	}
+
+	void draw_culler::mark(uint32_t aDraw) {
+		if (this->DirtyBegin == this->DirtyEnd) {
+			this->DirtyBegin = aDraw;
+			this->DirtyEnd = aDraw + 1;
+			return;
+		}
+		this->DirtyBegin = aDraw < this->DirtyBegin ? aDraw : this->DirtyBegin;
+		this->DirtyEnd = aDraw + 1 > this->DirtyEnd ? aDraw + 1 : this->DirtyEnd;
+	}
+
+	void draw_culler::upload(VkCommandBuffer aCommandBuffer) {
+		if (this->DirtyBegin == this->DirtyEnd) return;
+		const device_table& API = this->Context->api();
+		VkDeviceSize BoundsOffset = (VkDeviceSize)this->DirtyBegin * sizeof(float4);
+		VkDeviceSize BoundsSize = (VkDeviceSize)(this->DirtyEnd - this->DirtyBegin) * sizeof(float4);
+		VkDeviceSize CommandOffset = (VkDeviceSize)this->DirtyBegin * sizeof(VkDrawIndexedIndirectCommand);
+		VkDeviceSize CommandSize = (VkDeviceSize)(this->DirtyEnd - this->DirtyBegin) * sizeof(VkDrawIndexedIndirectCommand);
+
+		// Passes of earlier frames, of any view, may still read the scene.
+		this->Pipeline->barrier(aCommandBuffer, this->Bounds->handle(), BoundsOffset, BoundsSize,
+			VkPipelineStageFlagBits::VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VkAccessFlagBits::VK_ACCESS_SHADER_READ_BIT,
+			VkPipelineStageFlagBits::VK_PIPELINE_STAGE_TRANSFER_BIT, VkAccessFlagBits::VK_ACCESS_TRANSFER_WRITE_BIT
+		);
+		this->Pipeline->barrier(aCommandBuffer, this->Command->handle(), CommandOffset, CommandSize,
+			VkPipelineStageFlagBits::VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VkAccessFlagBits::VK_ACCESS_SHADER_READ_BIT,
+			VkPipelineStageFlagBits::VK_PIPELINE_STAGE_TRANSFER_BIT, VkAccessFlagBits::VK_ACCESS_TRANSFER_WRITE_BIT
+		);
+
+		// Data is copied into the command buffer at record time, so the host never
+		// touches memory the device may be reading. Updates are capped at 64KiB.
+		const uint8_t* BoundsData = (const uint8_t*)&this->Sphere[this->DirtyBegin];
+		for (VkDeviceSize Done = 0; Done < BoundsSize; Done += UPDATE_LIMIT) {
+			VkDeviceSize Size = BoundsSize - Done < UPDATE_LIMIT ? BoundsSize - Done : UPDATE_LIMIT;
+			API.vkCmdUpdateBuffer(aCommandBuffer, this->Bounds->handle(), BoundsOffset + Done, Size, BoundsData + Done);
+		}
+		const uint8_t* CommandData = (const uint8_t*)&this->Draw[this->DirtyBegin];
+		for (VkDeviceSize Done = 0; Done < CommandSize; Done += UPDATE_LIMIT) {
+			VkDeviceSize Size = CommandSize - Done < UPDATE_LIMIT ? CommandSize - Done : UPDATE_LIMIT;
+			API.vkCmdUpdateBuffer(aCommandBuffer, this->Command->handle(), CommandOffset + Done, Size, CommandData + Done);
+		}
+
+		// Visible to this pass, and to passes of other views recorded after it.
+		this->Pipeline->barrier(aCommandBuffer, this->Bounds->handle(), BoundsOffset, BoundsSize,
+			VkPipelineStageFlagBits::VK_PIPELINE_STAGE_TRANSFER_BIT, VkAccessFlagBits::VK_ACCESS_TRANSFER_WRITE_BIT,
+			VkPipelineStageFlagBits::VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VkAccessFlagBits::VK_ACCESS_SHADER_READ_BIT
+		);
+		this->Pipeline->barrier(aCommandBuffer, this->Command->handle(), CommandOffset, CommandSize,
+			VkPipelineStageFlagBits::VK_PIPELINE_STAGE_TRANSFER_BIT, VkAccessFlagBits::VK_ACCESS_TRANSFER_WRITE_BIT,
+			VkPipelineStageFlagBits::VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VkAccessFlagBits::VK_ACCESS_SHADER_READ_BIT
+		);
+		this->DirtyBegin = 0;
+		this->DirtyEnd = 0;
+	}
+
+	draw_culler::view_frame* draw_culler::view_of(object::rendertarget* aRenderTarget, uint32_t aFrameIndex) {
+		std::vector<view_frame>& Frame = this->View[aRenderTarget];
+		if (aFrameIndex >= Frame.size()) {
+			Frame.resize(aFrameIndex + 1, view_frame{ nullptr, nullptr, VK_NULL_HANDLE });
+		}
+
+		view_frame& Target = Frame[aFrameIndex];
+		if (Target.Indirect == nullptr) {
+			int Usage = buffer::usage::STORAGE | buffer::usage::INDIRECT | buffer::usage::TRANSFER_DST;
+			Target.Indirect = new buffer(this->Context, device::memory::DEVICE_LOCAL, Usage, this->Capacity * sizeof(VkDrawIndexedIndirectCommand), NULL);
+			Target.Count = new buffer(this->Context, device::memory::DEVICE_LOCAL, Usage, sizeof(uint32_t), NULL);
+
+			cull_descriptor Data{};
+			Data.Bounds				= { this->Bounds->handle(), 0, VK_WHOLE_SIZE };
+			Data.Command			= { this->Command->handle(), 0, VK_WHOLE_SIZE };
+			Data.Visible			= { Target.Indirect->handle(), 0, VK_WHOLE_SIZE };
+			Data.VisibleCount		= { Target.Count->handle(), 0, VK_WHOLE_SIZE };
+			Target.Set = this->Descriptor->acquire(this->Pipeline->set_layout(0), this->Template, &Data, sizeof(cull_descriptor));
+		}
+		return Target.Set != VK_NULL_HANDLE ? &Target : nullptr;
+	}
+
+}
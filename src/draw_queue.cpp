@@ -0,0 +1,206 @@
+#include <geodesuka/core/gcl/draw_queue.h>
+
+#include <string.h>
+
+#include <geodesuka/core/logic/radix_sort.h>
+
+namespace geodesuka::core::gcl {
+
+	// Id of a handle, new handles get the next id. Ids wrap at aLimit, which
+	// only affects how runs are ordered, runs are merged by comparing packets.
+	template<typename K>
+	static uint32_t id_of(std::map<K, uint32_t>& aTable, const K& aKey, uint32_t aLimit) {
+		auto it = aTable.find(aKey);
+		if (it != aTable.end()) return it->second;
+		if (aTable.size() >= aLimit) {
+			aTable.clear();
+		}
+		uint32_t ID = (uint32_t)aTable.size();
+		aTable[aKey] = ID;
+		return ID;
+	}
+
+	draw_queue::draw_queue(context* aContext, uint32_t aFrameCount, uint32_t aInstanceSize, uint32_t aInstanceBinding) {
+		this->Context = aContext;
+		this->InstanceSize = aInstanceSize;
+		this->InstanceBinding = aInstanceBinding;
+		this->DrawCount = 0;
+		this->InstanceBuffer.assign(aFrameCount, nullptr);
+		this->InstanceCapacity.assign(aFrameCount, 0);
+	}
+
+	draw_queue::~draw_queue() {
+		for (size_t i = 0; i < this->InstanceBuffer.size(); i++) {
+			delete this->InstanceBuffer[i];
+		}
+		this->InstanceBuffer.clear();
+		this->InstanceCapacity.clear();
+		this->Context = nullptr;
+	}
+
+	void draw_queue::clear() {
+		// Keeps capacity, nothing is allocated in steady state.
+		this->Packet.clear();
+		this->InstanceData.clear();
+	}
+
+	void draw_queue::submit(const packet& aPacket) {
+		this->Packet.push_back(aPacket);
+		size_t Offset = this->InstanceData.size();
+		this->InstanceData.resize(Offset + this->InstanceSize);
+		if (aPacket.Instance != NULL) {
+			memcpy(&this->InstanceData[Offset], aPacket.Instance, this->InstanceSize);
+		}
+		else {
+			memset(&this->InstanceData[Offset], 0x00, this->InstanceSize);
+		}
+		this->Packet.back().Instance = NULL;
+	}
+
+	size_t draw_queue::packet_count() {
+		return this->Packet.size();
+	}
+
+	size_t draw_queue::packet_count(uint32_t aFirstPass, uint32_t aLastPass) {
+		size_t Count = 0;
+		for (size_t i = 0; i < this->Packet.size(); i++) {
+			uint32_t Pass = this->Packet[i].Pass & 0xF;
+			Count += ((Pass >= aFirstPass) && (Pass <= aLastPass)) ? 1 : 0;
+		}
+		return Count;
+	}
+
+	void draw_queue::record(command_encoder& aEncoder, uint32_t aFrameIndex) {
+		this->prepare(aFrameIndex);
+		this->record(aEncoder, aFrameIndex, 0, 0xF);
+	}
+
+	void draw_queue::prepare(uint32_t aFrameIndex) {
+		this->DrawCount = 0;
+		if ((this->Packet.size() == 0) || (aFrameIndex >= this->InstanceBuffer.size())) return;
+
+		this->sort();
+
+		// Instance data follows sorted order, a run is then a contiguous range.
+		size_t Count = this->Packet.size();
+		size_t Size = Count * this->InstanceSize;
+		if (Size > 0) {
+			this->SortedInstanceData.resize(Size);
+			for (size_t i = 0; i < Count; i++) {
+				memcpy(&this->SortedInstanceData[i * this->InstanceSize], &this->InstanceData[(size_t)this->Order[i] * this->InstanceSize], this->InstanceSize);
+			}
+
+			// Grown by doubling, never shrunk.
+			if ((this->InstanceBuffer[aFrameIndex] == nullptr) || (this->InstanceCapacity[aFrameIndex] < Size)) {
+				size_t Capacity = this->InstanceCapacity[aFrameIndex] > 0 ? this->InstanceCapacity[aFrameIndex] : 64 * (size_t)this->InstanceSize;
+				while (Capacity < Size) {
+					Capacity *= 2;
+				}
+				delete this->InstanceBuffer[aFrameIndex];
+				this->InstanceBuffer[aFrameIndex] = new buffer(this->Context, device::memory::HOST_VISIBLE | device::memory::HOST_COHERENT, buffer::usage::VERTEX, Capacity, NULL);
+				this->InstanceCapacity[aFrameIndex] = Capacity;
+			}
+			this->InstanceBuffer[aFrameIndex]->write(0, Size, this->SortedInstanceData.data());
+		}
+	}
+
+	void draw_queue::record(command_encoder& aEncoder, uint32_t aFrameIndex, uint32_t aFirstPass, uint32_t aLastPass) {
+		if ((this->Packet.size() == 0) || (aFrameIndex >= this->InstanceBuffer.size())) return;
+
+		// Pass is the top of the key, a range of passes is a contiguous range.
+		size_t Count = this->Packet.size();
+		size_t Size = Count * this->InstanceSize;
+		VkDeviceSize Zero = 0;
+		size_t i = 0;
+		while (i < Count) {
+			const packet& First = this->Packet[this->Order[i]];
+			uint32_t Pass = First.Pass & 0xF;
+			if ((Pass < aFirstPass) || (Pass > aLastPass)) {
+				i += 1;
+				continue;
+			}
+			size_t j = i + 1;
+			while ((j < Count) && (is_same_run(First, this->Packet[this->Order[j]]))) {
+				j += 1;
+			}
+
+			// Encoder drops binds repeated between neighbouring runs.
+			aEncoder.bind_pipeline(VkPipelineBindPoint::VK_PIPELINE_BIND_POINT_GRAPHICS, First.Pipeline);
+			if (First.Material != VK_NULL_HANDLE) {
+				aEncoder.bind_descriptor_sets(VkPipelineBindPoint::VK_PIPELINE_BIND_POINT_GRAPHICS, First.Layout, 0, 1, &First.Material, 0, NULL);
+			}
+			if (First.VertexBuffer != VK_NULL_HANDLE) {
+				aEncoder.bind_vertex_buffers(0, 1, &First.VertexBuffer, &Zero);
+			}
+			if (Size > 0) {
+				aEncoder.bind_vertex_buffers(this->InstanceBinding, 1, &this->InstanceBuffer[aFrameIndex]->handle(), &Zero);
+			}
+			if (First.IndexBuffer != VK_NULL_HANDLE) {
+				aEncoder.bind_index_buffer(First.IndexBuffer, 0, First.IndexType);
+				aEncoder.draw_indexed(First.Count, (uint32_t)(j - i), 0, 0, (uint32_t)i);
+			}
+			else {
+				aEncoder.draw(First.Count, (uint32_t)(j - i), 0, (uint32_t)i);
+			}
+			this->DrawCount += 1;
+			i = j;
+		}
+	}
+
+	size_t draw_queue::draw_count() {
+		return this->DrawCount;
+	}
+
+	uint64_t draw_queue::sort_key(uint32_t aPass, uint32_t aPipeline, uint32_t aMaterial, uint32_t aMesh, float aDepth) {
+		uint64_t Pass		= (uint64_t)(aPass & 0xF);
+		uint64_t Pipeline	= (uint64_t)(aPipeline & 0xFFF);
+		uint64_t Material	= (uint64_t)(aMaterial & 0xFFFF);
+		uint64_t Mesh		= (uint64_t)(aMesh & 0xFFFF);
+
+		// Bits of a non negative float order like the float, top 16 are enough.
+		float Depth = aDepth > 0.0f ? aDepth : 0.0f;
+		uint32_t Bits = 0;
+		memcpy(&Bits, &Depth, sizeof(float));
+		uint64_t DepthKey = (uint64_t)(Bits >> 16);
+
+		if (aPass == pass::TRANSLUCENT) {
+			// Back to front, blending order wins over state changes.
+			return (Pass << 60) | ((0xFFFF - DepthKey) << 44) | (Pipeline << 32) | (Material << 16) | Mesh;
+		}
+		return (Pass << 60) | (Pipeline << 48) | (Material << 32) | (Mesh << 16) | DepthKey;
+	}
+
+	uint64_t draw_queue::key_of(const packet& aPacket) {
+		uint32_t Pipeline	= id_of(this->PipelineID, aPacket.Pipeline, 0x1000);
+		uint32_t Material	= id_of(this->MaterialID, aPacket.Material, 0x10000);
+		uint32_t Mesh		= id_of(this->MeshID, mesh_key(aPacket.VertexBuffer, aPacket.IndexBuffer, aPacket.IndexType, aPacket.Count), 0x10000);
+		return sort_key(aPacket.Pass, Pipeline, Material, Mesh, aPacket.Depth);
+	}
+
+	void draw_queue::sort() {
+		size_t Count = this->Packet.size();
+		this->Key.resize(Count);
+		this->KeyScratch.resize(Count);
+		this->Order.resize(Count);
+		this->OrderScratch.resize(Count);
+		for (size_t i = 0; i < Count; i++) {
+			this->Key[i] = this->key_of(this->Packet[i]);
+			this->Order[i] = (uint32_t)i;
+		}
+
+		// Stable, equal keys keep submission order.
+		logic::radix_sort::sort(Count, this->Key.data(), this->Order.data(), this->KeyScratch.data(), this->OrderScratch.data());
+	}
+
+	bool draw_queue::is_same_run(const packet& aLhs, const packet& aRhs) {
+		return (aLhs.Pass == aRhs.Pass)
+			&& (aLhs.Pipeline == aRhs.Pipeline)
+			&& (aLhs.Layout == aRhs.Layout)
+			&& (aLhs.Material == aRhs.Material)
+			&& (aLhs.VertexBuffer == aRhs.VertexBuffer)
+			&& (aLhs.IndexBuffer == aRhs.IndexBuffer)
+			&& (aLhs.IndexType == aRhs.IndexType)
+			&& (aLhs.Count == aRhs.Count);
+	}
+
+}
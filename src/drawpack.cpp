@@ -6,11 +6,375 @@
 
 namespace geodesuka::core::gcl {
 
+	static bool has_depth(VkFormat aFormat) {
+		switch (aFormat) {
+		case VkFormat::VK_FORMAT_D16_UNORM:
+		case VkFormat::VK_FORMAT_X8_D24_UNORM_PACK32:
+		case VkFormat::VK_FORMAT_D32_SFLOAT:
+		case VkFormat::VK_FORMAT_D16_UNORM_S8_UINT:
+		case VkFormat::VK_FORMAT_D24_UNORM_S8_UINT:
+		case VkFormat::VK_FORMAT_D32_SFLOAT_S8_UINT:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	static bool has_stencil(VkFormat aFormat) {
+		switch (aFormat) {
+		case VkFormat::VK_FORMAT_S8_UINT:
+		case VkFormat::VK_FORMAT_D16_UNORM_S8_UINT:
+		case VkFormat::VK_FORMAT_D24_UNORM_S8_UINT:
+		case VkFormat::VK_FORMAT_D32_SFLOAT_S8_UINT:
+			return true;
+		default:
+			return false;
+		}
+	}
+
 	drawpack::drawpack(context* aContext, object::rendertarget* aRenderTarget, uint32_t aSubpassDescriptionCount, VkSubpassDescription* aSubpassDescriptionList, uint32_t aSubpassDependencyCount, VkSubpassDependency* aSubpassDependencyList) {
 
 		Context = aContext;
 		RenderTarget = aRenderTarget;
 
+		Result = VkResult::VK_SUCCESS;
+		Parent = nullptr;
+		RenderPass = VK_NULL_HANDLE;
+		Frame = NULL;
+		DepthAttachment = VK_ATTACHMENT_UNUSED;
+		DepthLayout = VkImageLayout::VK_IMAGE_LAYOUT_UNDEFINED;
+
+		// Dynamic rendering when possible, render pass objects otherwise.
+		isDynamic = this->make_dynamic(aSubpassDescriptionCount, aSubpassDescriptionList);
+		if (!isDynamic) {
+			this->make_render_pass(aSubpassDescriptionCount, aSubpassDescriptionList, aSubpassDependencyCount, aSubpassDependencyList);
+		}
+
+		// Nothing is recorded yet, every frame starts dirty.
+		Generation = 1;
+		RecordedGeneration.assign(RenderTarget->FrameCount, 0);
+
+		Command = (VkCommandBuffer*)malloc(RenderTarget->FrameCount * sizeof(VkCommandBuffer));
+
+		assert(Command != NULL);
+
+		Pool = &RenderTarget->DrawCommandPool;
+		Lane = 0;
+		Pool->allocate(command_pool::level::PRIMARY, RenderTarget->FrameCount, Command);
+	}
+
+	drawpack::drawpack(context* aContext, object::rendertarget* aRenderTarget) {
+
+		Context = aContext;
+		RenderTarget = aRenderTarget;
+
+		Result = VkResult::VK_SUCCESS;
+		Parent = RenderTarget->frame_pack();
+		isDynamic = false;
+		RenderPass = VK_NULL_HANDLE;
+		Frame = NULL;
+		DepthAttachment = VK_ATTACHMENT_UNUSED;
+		DepthLayout = VkImageLayout::VK_IMAGE_LAYOUT_UNDEFINED;
+
+		if (Parent != nullptr) {
+			// Same attachments as the scope, render pass stays owned by it.
+			isDynamic			= Parent->isDynamic;
+			CreateInfo			= Parent->CreateInfo;
+			RenderPass			= Parent->RenderPass;
+			ColorAttachment		= Parent->ColorAttachment;
+			ColorLayout			= Parent->ColorLayout;
+			ColorFormat			= Parent->ColorFormat;
+			DepthAttachment		= Parent->DepthAttachment;
+			DepthLayout			= Parent->DepthLayout;
+			Result				= Parent->Result;
+#ifdef VK_KHR_dynamic_rendering
+			RenderingCreateInfo							= Parent->RenderingCreateInfo;
+			RenderingCreateInfo.pColorAttachmentFormats	= ColorFormat.data();
+#endif
+		}
+		else {
+			Result = VkResult::VK_ERROR_INITIALIZATION_FAILED;
+		}
+
+		// Nothing is recorded yet, every frame starts dirty.
+		Generation = 1;
+		RecordedGeneration.assign(RenderTarget->FrameCount, 0);
+
+		Command = (VkCommandBuffer*)malloc(RenderTarget->FrameCount * sizeof(VkCommandBuffer));
+
+		assert(Command != NULL);
+
+		// Recorded on a worker lane of the rendertarget, from that lane's pool.
+		Pool = RenderTarget->draw_pool(Lane);
+		Pool->Mutex.lock();
+		Pool->allocate(command_pool::level::SECONDARY, RenderTarget->FrameCount, Command);
+		Pool->Mutex.unlock();
+	}
+
+	drawpack::~drawpack() {
+		// Lane may be recording other buffers of the pool.
+		Pool->Mutex.lock();
+		Pool->release(RenderTarget->FrameCount, Command);
+		Pool->Mutex.unlock();
+		free(Command);
+		// Shared through the context, only references are dropped.
+		if (Frame != NULL) {
+			for (uint32_t i = 0; i < RenderTarget->FrameCount; i++) {
+				Context->renderpasses()->release(Frame[i]);
+			}
+		}
+		free(Frame);
+		if (Parent == nullptr) {
+			Context->renderpasses()->release(RenderPass);
+		}
+		Command = NULL;
+		Pool = nullptr;
+		Parent = nullptr;
+		Frame = NULL;
+		RenderPass = VK_NULL_HANDLE;
+		RenderTarget = nullptr;
+		Context = nullptr;
+	}
+
+	void drawpack::pipeline(VkGraphicsPipelineCreateInfo& aCreateInfo) {
+#ifdef VK_KHR_dynamic_rendering
+		if (isDynamic) {
+			aCreateInfo.pNext			= &RenderingCreateInfo;
+			aCreateInfo.renderPass		= VK_NULL_HANDLE;
+			aCreateInfo.subpass			= 0;
+			return;
+		}
+#endif
+		aCreateInfo.renderPass		= RenderPass;
+	}
+
+	void drawpack::refresh() {
+		// Render area changed, on either path.
+		Generation += 1;
+		if (Frame == NULL) return;
+		for (uint32_t i = 0; i < RenderTarget->FrameCount; i++) {
+			Context->renderpasses()->release(Frame[i]);
+			Frame[i] = VK_NULL_HANDLE;
+		}
+		this->make_framebuffers();
+	}
+
+	void drawpack::invalidate() {
+		Generation += 1;
+	}
+
+	bool drawpack::is_dirty(uint32_t aFrameIndex) {
+		if (aFrameIndex >= RecordedGeneration.size()) return false;
+		return RecordedGeneration[aFrameIndex] != this->stamp();
+	}
+
+	void drawpack::recorded(uint32_t aFrameIndex) {
+		if (aFrameIndex >= RecordedGeneration.size()) return;
+		RecordedGeneration[aFrameIndex] = this->stamp();
+	}
+
+	void drawpack::inherit(VkCommandBufferBeginInfo& aBeginInfo) {
+		if (Parent == nullptr) return;
+
+		// Sample count the scope renders with, all attachments of a subpass match.
+		VkSampleCountFlagBits Samples = VkSampleCountFlagBits::VK_SAMPLE_COUNT_1_BIT;
+		for (size_t i = 0; i <= ColorAttachment.size(); i++) {
+			uint32_t Index = i < ColorAttachment.size() ? ColorAttachment[i] : DepthAttachment;
+			if (Index == VK_ATTACHMENT_UNUSED) continue;
+			Samples = RenderTarget->FrameAttachmentDescription[Index].samples;
+			break;
+		}
+
+		Inheritance = {};
+		Inheritance.sType					= VkStructureType::VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+		Inheritance.pNext					= NULL;
+		Inheritance.renderPass				= RenderPass;
+		Inheritance.subpass					= 0;
+		// Left open, the scope swaps framebuffers on resize.
+		Inheritance.framebuffer				= VK_NULL_HANDLE;
+		Inheritance.occlusionQueryEnable	= VK_FALSE;
+		Inheritance.queryFlags				= 0;
+		Inheritance.pipelineStatistics		= 0;
+
+#ifdef VK_KHR_dynamic_rendering
+		if (isDynamic) {
+			InheritanceRendering = {};
+			InheritanceRendering.sType						= VkStructureType::VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO_KHR;
+			InheritanceRendering.pNext						= NULL;
+			InheritanceRendering.flags						= 0;
+			InheritanceRendering.viewMask					= 0;
+			InheritanceRendering.colorAttachmentCount		= (uint32_t)ColorFormat.size();
+			InheritanceRendering.pColorAttachmentFormats	= ColorFormat.data();
+			InheritanceRendering.depthAttachmentFormat		= RenderingCreateInfo.depthAttachmentFormat;
+			InheritanceRendering.stencilAttachmentFormat	= RenderingCreateInfo.stencilAttachmentFormat;
+			InheritanceRendering.rasterizationSamples		= Samples;
+			Inheritance.pNext								= &InheritanceRendering;
+			Inheritance.renderPass							= VK_NULL_HANDLE;
+		}
+#endif
+
+		aBeginInfo.flags				|= VkCommandBufferUsageFlagBits::VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+		aBeginInfo.pInheritanceInfo		= &Inheritance;
+	}
+
+	void drawpack::begin(VkCommandBuffer aCommandBuffer, uint32_t aFrameIndex, uint32_t aClearValueCount, const VkClearValue* aClearValue, bool aSecondaryContents) {
+		// Scope is opened by the rendertarget.
+		if (Parent != nullptr) return;
+
+		VkRect2D RenderArea{};
+		RenderArea.offset = { 0, 0 };
+		RenderArea.extent = { RenderTarget->Resolution.x, RenderTarget->Resolution.y };
+
+#ifdef VK_KHR_dynamic_rendering
+		if (isDynamic) {
+			this->transition(aCommandBuffer, aFrameIndex, true);
+
+			std::vector<VkRenderingAttachmentInfoKHR> Color(ColorAttachment.size());
+			for (size_t i = 0; i < ColorAttachment.size(); i++) {
+				uint32_t Index = ColorAttachment[i];
+				Color[i].sType					= VkStructureType::VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR;
+				Color[i].pNext					= NULL;
+				Color[i].imageView				= VK_NULL_HANDLE;
+				Color[i].imageLayout			= ColorLayout[i];
+				Color[i].resolveMode			= VkResolveModeFlagBits::VK_RESOLVE_MODE_NONE;
+				Color[i].resolveImageView		= VK_NULL_HANDLE;
+				Color[i].resolveImageLayout		= VkImageLayout::VK_IMAGE_LAYOUT_UNDEFINED;
+				Color[i].loadOp					= VkAttachmentLoadOp::VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+				Color[i].storeOp				= VkAttachmentStoreOp::VK_ATTACHMENT_STORE_OP_DONT_CARE;
+				Color[i].clearValue				= {};
+				// Unused slots keep their shader output location.
+				if (Index == VK_ATTACHMENT_UNUSED) continue;
+				Color[i].imageView				= RenderTarget->FrameAttachment[aFrameIndex][Index];
+				Color[i].loadOp					= RenderTarget->FrameAttachmentDescription[Index].loadOp;
+				Color[i].storeOp				= RenderTarget->FrameAttachmentDescription[Index].storeOp;
+				if ((aClearValue != NULL) && (Index < aClearValueCount)) {
+					Color[i].clearValue			= aClearValue[Index];
+				}
+			}
+
+			VkRenderingAttachmentInfoKHR Depth{};
+			VkRenderingAttachmentInfoKHR Stencil{};
+			if (DepthAttachment != VK_ATTACHMENT_UNUSED) {
+				const VkAttachmentDescription& Description = RenderTarget->FrameAttachmentDescription[DepthAttachment];
+				Depth.sType					= VkStructureType::VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR;
+				Depth.pNext					= NULL;
+				Depth.imageView				= RenderTarget->FrameAttachment[aFrameIndex][DepthAttachment];
+				Depth.imageLayout			= DepthLayout;
+				Depth.resolveMode			= VkResolveModeFlagBits::VK_RESOLVE_MODE_NONE;
+				Depth.resolveImageView		= VK_NULL_HANDLE;
+				Depth.resolveImageLayout	= VkImageLayout::VK_IMAGE_LAYOUT_UNDEFINED;
+				Depth.loadOp				= Description.loadOp;
+				Depth.storeOp				= Description.storeOp;
+				Depth.clearValue			= {};
+				if ((aClearValue != NULL) && (DepthAttachment < aClearValueCount)) {
+					Depth.clearValue		= aClearValue[DepthAttachment];
+				}
+				// Same view, stencil aspect uses the stencil ops.
+				Stencil						= Depth;
+				Stencil.loadOp				= Description.stencilLoadOp;
+				Stencil.storeOp				= Description.stencilStoreOp;
+			}
+
+			VkRenderingInfoKHR RenderingInfo{};
+			RenderingInfo.sType						= VkStructureType::VK_STRUCTURE_TYPE_RENDERING_INFO_KHR;
+			RenderingInfo.pNext						= NULL;
+			RenderingInfo.flags						= aSecondaryContents ? VkRenderingFlagBits::VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT_KHR : 0;
+			RenderingInfo.renderArea				= RenderArea;
+			RenderingInfo.layerCount				= RenderTarget->Resolution.z > 0 ? RenderTarget->Resolution.z : 1;
+			RenderingInfo.viewMask					= 0;
+			RenderingInfo.colorAttachmentCount		= (uint32_t)Color.size();
+			RenderingInfo.pColorAttachments			= Color.data();
+			RenderingInfo.pDepthAttachment			= RenderingCreateInfo.depthAttachmentFormat != VkFormat::VK_FORMAT_UNDEFINED ? &Depth : NULL;
+			RenderingInfo.pStencilAttachment		= RenderingCreateInfo.stencilAttachmentFormat != VkFormat::VK_FORMAT_UNDEFINED ? &Stencil : NULL;
+
+			Context->api().vkCmdBeginRenderingKHR(aCommandBuffer, &RenderingInfo);
+			return;
+		}
+#endif
+
+		VkRenderPassBeginInfo RenderPassBeginInfo{};
+		RenderPassBeginInfo.sType				= VkStructureType::VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+		RenderPassBeginInfo.pNext				= NULL;
+		RenderPassBeginInfo.renderPass			= RenderPass;
+		RenderPassBeginInfo.framebuffer			= Frame[aFrameIndex];
+		RenderPassBeginInfo.renderArea			= RenderArea;
+		RenderPassBeginInfo.clearValueCount		= aClearValue != NULL ? aClearValueCount : 0;
+		RenderPassBeginInfo.pClearValues		= aClearValue;
+		Context->api().vkCmdBeginRenderPass(aCommandBuffer, &RenderPassBeginInfo, aSecondaryContents ? VkSubpassContents::VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS : VkSubpassContents::VK_SUBPASS_CONTENTS_INLINE);
+	}
+
+	void drawpack::end(VkCommandBuffer aCommandBuffer, uint32_t aFrameIndex) {
+		if (Parent != nullptr) return;
+#ifdef VK_KHR_dynamic_rendering
+		if (isDynamic) {
+			Context->api().vkCmdEndRenderingKHR(aCommandBuffer);
+			this->transition(aCommandBuffer, aFrameIndex, false);
+			return;
+		}
+#endif
+		Context->api().vkCmdEndRenderPass(aCommandBuffer);
+	}
+
+	bool drawpack::make_dynamic(uint32_t aSubpassDescriptionCount, const VkSubpassDescription* aSubpassDescriptionList) {
+#ifdef VK_KHR_dynamic_rendering
+		if ((!Context->api().isDynamicRenderingAvailable) || (RenderTarget->FrameImage == NULL)) return false;
+		if ((aSubpassDescriptionCount != 1) || (aSubpassDescriptionList == NULL)) return false;
+		const VkSubpassDescription& Subpass = aSubpassDescriptionList[0];
+		if ((Subpass.inputAttachmentCount > 0) || (Subpass.pResolveAttachments != NULL)) return false;
+
+		// Every referenced attachment needs its image for layout transitions.
+		auto isExposed = [&](uint32_t aIndex) -> bool {
+			if (aIndex >= (uint32_t)RenderTarget->FrameAttachmentCount) return false;
+			for (uint32_t i = 0; i < RenderTarget->FrameCount; i++) {
+				if ((RenderTarget->FrameImage[i] == NULL) || (RenderTarget->FrameImage[i][aIndex] == VK_NULL_HANDLE)) return false;
+			}
+			return true;
+		};
+
+		std::vector<uint32_t> Attachment;
+		std::vector<VkImageLayout> Layout;
+		std::vector<VkFormat> Format;
+		for (uint32_t i = 0; i < Subpass.colorAttachmentCount; i++) {
+			uint32_t Index = Subpass.pColorAttachments[i].attachment;
+			if (Index == VK_ATTACHMENT_UNUSED) {
+				Attachment.push_back(VK_ATTACHMENT_UNUSED);
+				Layout.push_back(VkImageLayout::VK_IMAGE_LAYOUT_UNDEFINED);
+				Format.push_back(VkFormat::VK_FORMAT_UNDEFINED);
+				continue;
+			}
+			if (!isExposed(Index)) return false;
+			Attachment.push_back(Index);
+			Layout.push_back(Subpass.pColorAttachments[i].layout);
+			Format.push_back(RenderTarget->FrameAttachmentDescription[Index].format);
+		}
+
+		VkFormat DepthFormat = VkFormat::VK_FORMAT_UNDEFINED;
+		if ((Subpass.pDepthStencilAttachment != NULL) && (Subpass.pDepthStencilAttachment->attachment != VK_ATTACHMENT_UNUSED)) {
+			if (!isExposed(Subpass.pDepthStencilAttachment->attachment)) return false;
+			DepthAttachment		= Subpass.pDepthStencilAttachment->attachment;
+			DepthLayout			= Subpass.pDepthStencilAttachment->layout;
+			DepthFormat			= RenderTarget->FrameAttachmentDescription[DepthAttachment].format;
+		}
+
+		ColorAttachment		= Attachment;
+		ColorLayout			= Layout;
+		ColorFormat			= Format;
+
+		RenderingCreateInfo = {};
+		RenderingCreateInfo.sType						= VkStructureType::VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR;
+		RenderingCreateInfo.pNext						= NULL;
+		RenderingCreateInfo.viewMask					= 0;
+		RenderingCreateInfo.colorAttachmentCount		= (uint32_t)ColorFormat.size();
+		RenderingCreateInfo.pColorAttachmentFormats		= ColorFormat.data();
+		RenderingCreateInfo.depthAttachmentFormat		= has_depth(DepthFormat) ? DepthFormat : VkFormat::VK_FORMAT_UNDEFINED;
+		RenderingCreateInfo.stencilAttachmentFormat		= has_stencil(DepthFormat) ? DepthFormat : VkFormat::VK_FORMAT_UNDEFINED;
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	void drawpack::make_render_pass(uint32_t aSubpassDescriptionCount, VkSubpassDescription* aSubpassDescriptionList, uint32_t aSubpassDependencyCount, VkSubpassDependency* aSubpassDependencyList) {
 		CreateInfo.sType				= VkStructureType::VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
 		CreateInfo.pNext				= NULL;
 		CreateInfo.flags				= 0;
@@ -21,13 +385,18 @@ namespace geodesuka::core::gcl {
 		CreateInfo.dependencyCount		= aSubpassDependencyCount;
 		CreateInfo.pDependencies		= aSubpassDependencyList;
 
-		Result = vkCreateRenderPass(Context->handle(), &CreateInfo, NULL, &RenderPass);
+		// Identical descriptions from other objects resolve to the same render pass.
+		RenderPass = Context->renderpasses()->acquire(CreateInfo);
+		Result = RenderPass != VK_NULL_HANDLE ? VkResult::VK_SUCCESS : VkResult::VK_ERROR_INITIALIZATION_FAILED;
 
 		Frame = (VkFramebuffer*)malloc(RenderTarget->FrameCount * sizeof(VkFramebuffer));
-		Command = (VkCommandBuffer*)malloc(RenderTarget->FrameCount * sizeof(VkCommandBuffer));
 
-		assert(!((Frame == NULL) || (Command == NULL)));
+		assert(Frame != NULL);
+
+		this->make_framebuffers();
+	}
 
+	void drawpack::make_framebuffers() {
 		for (uint32_t i = 0; i < RenderTarget->FrameCount; i++) {
 			VkFramebufferCreateInfo FramebufferCreateInfo{};
 			FramebufferCreateInfo.sType					= VkStructureType::VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
@@ -39,25 +408,67 @@ namespace geodesuka::core::gcl {
 			FramebufferCreateInfo.width					= RenderTarget->Resolution.x;
 			FramebufferCreateInfo.height				= RenderTarget->Resolution.y;
 			FramebufferCreateInfo.layers				= RenderTarget->Resolution.z;
-			Result = vkCreateFramebuffer(Context->handle(), &FramebufferCreateInfo, NULL, &Frame[i]);
+			Frame[i] = Context->renderpasses()->acquire(FramebufferCreateInfo);
+			if (Frame[i] == VK_NULL_HANDLE) {
+				Result = VkResult::VK_ERROR_INITIALIZATION_FAILED;
+			}
 		}
-
-		RenderTarget->DrawCommandPool.allocate(command_pool::level::PRIMARY, RenderTarget->FrameCount, Command);
 	}
 
-	drawpack::~drawpack() {
-		RenderTarget->DrawCommandPool.release(RenderTarget->FrameCount, Command);
-		free(Command);
-		for (uint32_t i = 0; i < RenderTarget->FrameCount; i++) {
-			vkDestroyFramebuffer(Context->handle(), Frame[i], NULL);
+	void drawpack::transition(VkCommandBuffer aCommandBuffer, uint32_t aFrameIndex, bool aBegin) {
+		std::vector<VkImageMemoryBarrier> Barrier;
+		VkPipelineStageFlags AttachmentStage = 0;
+		for (size_t i = 0; i <= ColorAttachment.size(); i++) {
+			// Last iteration is the depth stencil attachment.
+			bool isColor = (i < ColorAttachment.size());
+			uint32_t Index = isColor ? ColorAttachment[i] : DepthAttachment;
+			if (Index == VK_ATTACHMENT_UNUSED) continue;
+
+			const VkAttachmentDescription& Description = RenderTarget->FrameAttachmentDescription[Index];
+			VkImageLayout Layout = isColor ? ColorLayout[i] : DepthLayout;
+			VkImageLayout OldLayout = aBegin ? Description.initialLayout : Layout;
+			VkImageLayout NewLayout = aBegin ? Layout : Description.finalLayout;
+			if (OldLayout == NewLayout) continue;
+
+			VkAccessFlags Access = 0;
+			VkImageMemoryBarrier Transition{};
+			Transition.sType								= VkStructureType::VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+			Transition.pNext								= NULL;
+			Transition.oldLayout							= OldLayout;
+			Transition.newLayout							= NewLayout;
+			Transition.srcQueueFamilyIndex					= VK_QUEUE_FAMILY_IGNORED;
+			Transition.dstQueueFamilyIndex					= VK_QUEUE_FAMILY_IGNORED;
+			Transition.image								= RenderTarget->FrameImage[aFrameIndex][Index];
+			Transition.subresourceRange.baseMipLevel		= 0;
+			Transition.subresourceRange.levelCount			= 1;
+			Transition.subresourceRange.baseArrayLayer		= 0;
+			Transition.subresourceRange.layerCount			= VK_REMAINING_ARRAY_LAYERS;
+			if (isColor) {
+				Transition.subresourceRange.aspectMask		= VkImageAspectFlagBits::VK_IMAGE_ASPECT_COLOR_BIT;
+				Access										= VkAccessFlagBits::VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VkAccessFlagBits::VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+				AttachmentStage								|= VkPipelineStageFlagBits::VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+			}
+			else {
+				Transition.subresourceRange.aspectMask		= 0;
+				if (has_depth(Description.format)) Transition.subresourceRange.aspectMask |= VkImageAspectFlagBits::VK_IMAGE_ASPECT_DEPTH_BIT;
+				if (has_stencil(Description.format)) Transition.subresourceRange.aspectMask |= VkImageAspectFlagBits::VK_IMAGE_ASPECT_STENCIL_BIT;
+				Access										= VkAccessFlagBits::VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VkAccessFlagBits::VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+				AttachmentStage								|= VkPipelineStageFlagBits::VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VkPipelineStageFlagBits::VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+			}
+			// Same implicit external dependencies a render pass has.
+			Transition.srcAccessMask						= aBegin ? 0 : Access;
+			Transition.dstAccessMask						= aBegin ? Access : 0;
+			Barrier.push_back(Transition);
 		}
-		free(Frame);
-		vkDestroyRenderPass(Context->handle(), RenderPass, NULL);
-		Command = NULL;
-		Frame = NULL;
-		RenderPass = VK_NULL_HANDLE;
-		RenderTarget = nullptr;
-		Context = nullptr;
+		if (Barrier.size() == 0) return;
+
+		VkPipelineStageFlags SrcStage = AttachmentStage;
+		VkPipelineStageFlags DstStage = aBegin ? AttachmentStage : VkPipelineStageFlagBits::VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+		Context->api().vkCmdPipelineBarrier(aCommandBuffer, SrcStage, DstStage, 0, 0, NULL, 0, NULL, (uint32_t)Barrier.size(), Barrier.data());
+	}
+
+	uint64_t drawpack::stamp() {
+		return Generation.load() + (Parent != nullptr ? Parent->Generation.load() : 0);
 	}
 
 }
@@ -0,0 +1,59 @@
+#include <geodesuka/builtin/embedded_shader.h>
+
+#include <cstring>
+
+namespace geodesuka::builtin {
+
+	using namespace core;
+
+	// Regenerate with tool/embed_shader.py.
+	#include "embedded_shader.inl"
+
+	// Only present when the build step had a SPIR-V compiler.
+	#if __has_include("embedded_shader_spirv.inl")
+	#include "embedded_shader_spirv.inl"
+	#define GEODESUKA_EMBEDDED_SPIRV
+	#endif
+
+	gcl::shader* embedded_shader::create(gcl::context* aContext, const char* aName) {
+		const source* Source = find_source(aName);
+		if (Source == nullptr) return nullptr;
+
+		const binary* Binary = find_binary(aName);
+		if (Binary != nullptr) {
+			gcl::shader* Shader = new gcl::shader(aContext, Source->Stage, Binary->WordCount, Binary->Word);
+			if (Shader->is_valid()) return Shader;
+			// Stale or rejected binary, fall back to source.
+			delete Shader;
+		}
+
+		return new gcl::shader(aContext, Source->Stage, Source->Source);
+	}
+
+	bool embedded_shader::is_precompiled() {
+	#ifdef GEODESUKA_EMBEDDED_SPIRV
+		return true;
+	#else
+		return false;
+	#endif
+	}
+
+	const embedded_shader::source* embedded_shader::find_source(const char* aName) {
+		if (aName == NULL) return nullptr;
+		for (size_t i = 0; EmbeddedSource[i].Name != NULL; i++) {
+			if (strcmp(EmbeddedSource[i].Name, aName) == 0) return &EmbeddedSource[i];
+		}
+		return nullptr;
+	}
+
+	const embedded_shader::binary* embedded_shader::find_binary(const char* aName) {
+	#ifdef GEODESUKA_EMBEDDED_SPIRV
+		if (aName == NULL) return nullptr;
+		for (size_t i = 0; EmbeddedBinary[i].Name != NULL; i++) {
+			if (strcmp(EmbeddedBinary[i].Name, aName) == 0) return &EmbeddedBinary[i];
+		}
+	#endif
+		return nullptr;
+	}
+
+}
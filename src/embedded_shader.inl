@@ -0,0 +1,94 @@
+// Generated by tool/embed_shader.py from res/shader/builtin, do not edit.
+
+static const char* draw_cull_comp_source =
+	"#version 450\n"
+	"\n"
+	"// Frustum culls bounding spheres, draws that survive are compacted into\n"
+	"// VisibleDraw and counted in VisibleCount.\n"
+	"\n"
+	"layout (local_size_x = 64) in;\n"
+	"\n"
+	"struct draw_indexed_indirect {\n"
+	"	uint IndexCount;\n"
+	"	uint InstanceCount;\n"
+	"	uint FirstIndex;\n"
+	"	int VertexOffset;\n"
+	"	uint FirstInstance;\n"
+	"};\n"
+	"\n"
+	"layout (std430, set = 0, binding = 0) readonly buffer bounds {\n"
+	"	vec4 Sphere[];\n"
+	"};\n"
+	"\n"
+	"layout (std430, set = 0, binding = 1) readonly buffer command {\n"
+	"	draw_indexed_indirect Draw[];\n"
+	"};\n"
+	"\n"
+	"layout (std430, set = 0, binding = 2) writeonly buffer visible {\n"
+	"	draw_indexed_indirect VisibleDraw[];\n"
+	"};\n"
+	"\n"
+	"layout (std430, set = 0, binding = 3) buffer visible_count {\n"
+	"	uint VisibleCount;\n"
+	"};\n"
+	"\n"
+	"layout (push_constant) uniform frustum {\n"
+	"	vec4 Plane[6];\n"
+	"	uint DrawCount;\n"
+	"};\n"
+	"\n"
+	"void main() {\n"
+	"	uint Index = gl_GlobalInvocationID.x;\n"
+	"	if (Index >= DrawCount) return;\n"
+	"\n"
+	"	// Removed draws have no indices.\n"
+	"	if (Draw[Index].IndexCount == 0) return;\n"
+	"\n"
+	"	vec4 Bound = Sphere[Index];\n"
+	"	for (int i = 0; i < 6; i++) {\n"
+	"		if (dot(Plane[i].xyz, Bound.xyz) + Plane[i].w < -Bound.w) return;\n"
+	"	}\n"
+	"\n"
+	"	uint Slot = atomicAdd(VisibleCount, 1);\n"
+	"	VisibleDraw[Slot] = Draw[Index];\n"
+	"}\n";
+
+static const char* triangle_frag_source =
+	"#version 450\n"
+	"\n"
+	"layout (location = 0) in vec3 InterpColor;\n"
+	"\n"
+	"layout (location = 0) out vec4 PixelColor;\n"
+	"\n"
+	"void main() {\n"
+	"	PixelColor = vec4(InterpColor, 1.0);\n"
+	"}\n";
+
+static const char* triangle_vert_source =
+	"#version 450\n"
+	"\n"
+	"vec2 VertexPosition[3] = vec2[](\n"
+	"	vec2(0.0, -0.5),\n"
+	"	vec2(0.5, 0.5),\n"
+	"	vec2(-0.5, 0.5)\n"
+	");\n"
+	"\n"
+	"vec3 VertexColor[3] = vec3[](\n"
+	"	vec3(1.0, 0.0, 0.0),\n"
+	"	vec3(0.0, 1.0, 0.0),\n"
+	"	vec3(0.0, 0.0, 1.0)\n"
+	");\n"
+	"\n"
+	"layout (location = 0) out vec3 InterpColor;\n"
+	"\n"
+	"void main() {\n"
+	"	gl_Position = vec4(VertexPosition[gl_VertexIndex], 0.0, 1.0);\n"
+	"	InterpColor = VertexColor[gl_VertexIndex];\n"
+	"}\n";
+
+static const embedded_shader::source EmbeddedSource[] = {
+	{ "draw_cull.comp", core::gcl::shader::stage::COMPUTE, draw_cull_comp_source },
+	{ "triangle.frag", core::gcl::shader::stage::FRAGMENT, triangle_frag_source },
+	{ "triangle.vert", core::gcl::shader::stage::VERTEX, triangle_vert_source },
+	{ NULL, core::gcl::shader::stage::UNKNOWN, NULL }
+};
@@ -33,6 +33,8 @@ namespace geodesuka {
 		StateID = state::CREATION;
 		Shutdown.store(false);
 		Handle = VK_NULL_HANDLE;
+		ShaderCompiler = nullptr;
+		Recorder = nullptr;
 
 		bool isGLSLANGReady = false;
 		bool isGLFWReady = false;
@@ -51,7 +53,15 @@ namespace geodesuka {
 		//
 
 		// (GLSLang)
+		// Leaves a core for the main and render threads.
+		uint32_t CoreCount = std::thread::hardware_concurrency();
 		isGLSLANGReady = shader::initialize();
+		if (isGLSLANGReady) {
+			ShaderCompiler = new shader_compiler(CoreCount > 2 ? CoreCount - 2 : 1);
+		}
+
+		// One set of recording workers shared by all rendertargets.
+		Recorder = new command_recorder(CoreCount > 2 ? CoreCount - 2 : 1);
 
 		// (GLFW) Must be initialized first for OS extensions.
 		isGLFWReady = system_window::initialize();
@@ -178,6 +188,10 @@ namespace geodesuka {
 		Display.clear();
 		SystemWindow.clear();
 
+		// Pending compile jobs reference contexts.
+		delete ShaderCompiler;
+		ShaderCompiler = nullptr;
+
 		for (size_t i = 0; i < Stage.size(); i++) {
 			delete Stage[i];
 		}
@@ -190,6 +204,10 @@ namespace geodesuka {
 			delete Context[i];
 		}
 
+		// Contexts have removed their pools.
+		delete Recorder;
+		Recorder = nullptr;
+
 		for (size_t i = 0; i < File.size(); i++) {
 			delete File[i];
 		}
@@ -245,6 +263,14 @@ namespace geodesuka {
 		return PrimaryDisplay;
 	}
 
+	shader_compiler* engine::get_shader_compiler() {
+		return ShaderCompiler;
+	}
+
+	command_recorder* engine::get_command_recorder() {
+		return Recorder;
+	}
+
 	VkInstance engine::handle() {
 		return Handle;
 	}
@@ -310,8 +336,8 @@ namespace geodesuka {
 				if (!Context[i]->isReadyToBeProcessed.load()) continue;
 				for (size_t j = 0; j < Object.size(); j++) {
 					if ((Object[j]->isReadyToBeProcessed.load()) && (Object[j]->Context == Context[i])) {
-						Context[i]->BackBatch[0] += Object[i]->update(DeltaTime);
-						Context[i]->BackBatch[1] += Object[i]->compute();
+						Context[i]->BackBatch[0] += Object[j]->update(DeltaTime);
+						Context[i]->BackBatch[1] += Object[j]->compute();
 					}
 				}
 			}
@@ -324,8 +350,8 @@ namespace geodesuka {
 						Stage[j]->RenderTarget[k]->FrameRateTimer.update(DeltaTime);
 					}
 					if ((Stage[j]->isReadyToBeProcessed.load()) && (Stage[j]->Context == Context[i])) {
-						Context[i]->BackBatch[0] += Stage[i]->update(DeltaTime);
-						Context[i]->BackBatch[1] += Stage[i]->compute();
+						Context[i]->BackBatch[0] += Stage[j]->update(DeltaTime);
+						Context[i]->BackBatch[1] += Stage[j]->compute();
 					}
 				}
 			}
@@ -342,12 +368,17 @@ namespace geodesuka {
 				// Iterate through all workbatches and search for inflight operations.
 				for (int j = 0; j < 3; j++) {
 					if (Context[i]->WorkBatch[j].SubmissionCount > 0) {
-						vkWaitForFences(Context[i]->Handle, 1, &Context[i]->ExecutionFence[j], VK_TRUE, UINT64_MAX);
-						vkResetFences(Context[i]->Handle, 1, &Context[i]->ExecutionFence[j]);
+						Context[i]->api().vkWaitForFences(Context[i]->Handle, 1, &Context[i]->ExecutionFence[j], VK_TRUE, UINT64_MAX);
+						Context[i]->api().vkResetFences(Context[i]->Handle, 1, &Context[i]->ExecutionFence[j]);
 						Context[i]->WorkBatch[j].clear();
 					}
 				}
 
+				// Nothing submitted before this point is in flight anymore.
+				if (Context[i]->BindlessTable != nullptr) {
+					Context[i]->BindlessTable->collect();
+				}
+
 				// Check if either transfer back batch, or compute back batch have accumulated submission.
 				if ((Context[i]->BackBatch[0].SubmissionCount > 0) || (Context[i]->BackBatch[1].SubmissionCount > 0)) {
 					// Loads back batch, ready for execution.
@@ -416,12 +447,17 @@ namespace geodesuka {
 				// Iterate through all workbatches and search for inflight operations.
 				for (int j = 0; j < 3; j++) {
 					if (Context[i]->WorkBatch[j].SubmissionCount > 0) {
-						vkWaitForFences(Context[i]->Handle, 1, &Context[i]->ExecutionFence[j], VK_TRUE, UINT64_MAX);
-						vkResetFences(Context[i]->Handle, 1, &Context[i]->ExecutionFence[j]);
+						Context[i]->api().vkWaitForFences(Context[i]->Handle, 1, &Context[i]->ExecutionFence[j], VK_TRUE, UINT64_MAX);
+						Context[i]->api().vkResetFences(Context[i]->Handle, 1, &Context[i]->ExecutionFence[j]);
 						Context[i]->WorkBatch[j].clear();
 					}
 				}
 
+				// Nothing submitted before this point is in flight anymore.
+				if (Context[i]->BindlessTable != nullptr) {
+					Context[i]->BindlessTable->collect();
+				}
+
 				// Check for Graphics & Compute operations accumulated.
 				if (Context[i]->BackBatch[2].SubmissionCount > 0) {
 					// Loads back batch, ready for execution.
@@ -0,0 +1,173 @@
+#include <geodesuka/core/gcl/external.h>
+
+#include <cstring>
+
+#if !(defined(_WIN32) || defined(_WIN64))
+#include <unistd.h>
+#endif
+
+#include <geodesuka/core/gcl/context.h>
+
+namespace geodesuka::core::gcl {
+
+	external_memory::external_memory() {
+		this->FD				= -1;
+		this->AllocationSize	= 0;
+		this->MemoryTypeIndex	= 0;
+		this->Dedicated			= VK_FALSE;
+		this->Layout			= VkImageLayout::VK_IMAGE_LAYOUT_UNDEFINED;
+		memset(this->DeviceUUID, 0x00, VK_UUID_SIZE * sizeof(uint8_t));
+	}
+
+	external_memory::~external_memory() {
+#if !(defined(_WIN32) || defined(_WIN64))
+		if (this->FD >= 0) {
+			close(this->FD);
+		}
+#endif
+		this->FD = -1;
+	}
+
+	external_memory::external_memory(external_memory&& aInput) noexcept {
+		this->FD				= aInput.FD;
+		this->AllocationSize	= aInput.AllocationSize;
+		this->MemoryTypeIndex	= aInput.MemoryTypeIndex;
+		this->Dedicated			= aInput.Dedicated;
+		this->Layout			= aInput.Layout;
+		memcpy(this->DeviceUUID, aInput.DeviceUUID, VK_UUID_SIZE * sizeof(uint8_t));
+		aInput.FD				= -1;
+	}
+
+	external_memory& external_memory::operator=(external_memory&& aRhs) noexcept {
+		if (this == &aRhs) return *this;
+#if !(defined(_WIN32) || defined(_WIN64))
+		if (this->FD >= 0) {
+			close(this->FD);
+		}
+#endif
+		this->FD				= aRhs.FD;
+		this->AllocationSize	= aRhs.AllocationSize;
+		this->MemoryTypeIndex	= aRhs.MemoryTypeIndex;
+		this->Dedicated			= aRhs.Dedicated;
+		this->Layout			= aRhs.Layout;
+		memcpy(this->DeviceUUID, aRhs.DeviceUUID, VK_UUID_SIZE * sizeof(uint8_t));
+		aRhs.FD					= -1;
+		return *this;
+	}
+
+	external_semaphore::external_semaphore() {
+		this->Context = nullptr;
+		this->Handle = VK_NULL_HANDLE;
+	}
+
+	external_semaphore::external_semaphore(context* aContext) {
+		this->Context = nullptr;
+		this->Handle = VK_NULL_HANDLE;
+		if (aContext == nullptr) return;
+
+		// Exporting needs VK_KHR_external_semaphore_fd.
+		if (!aContext->api().isExternalSemaphoreFdAvailable) return;
+
+		VkResult Result = VkResult::VK_SUCCESS;
+		VkExportSemaphoreCreateInfo ExportInfo{};
+		VkSemaphoreCreateInfo CreateInfo{};
+
+		ExportInfo.sType		= VkStructureType::VK_STRUCTURE_TYPE_EXPORT_SEMAPHORE_CREATE_INFO;
+		ExportInfo.pNext		= NULL;
+		ExportInfo.handleTypes	= VkExternalSemaphoreHandleTypeFlagBits::VK_EXTERNAL_SEMAPHORE_HANDLE_TYPE_OPAQUE_FD_BIT;
+
+		CreateInfo.sType		= VkStructureType::VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+		CreateInfo.pNext		= &ExportInfo;
+		CreateInfo.flags		= 0;
+
+		Result = aContext->api().vkCreateSemaphore(aContext->handle(), &CreateInfo, NULL, &this->Handle);
+		if (Result == VkResult::VK_SUCCESS) {
+			this->Context = aContext;
+		}
+	}
+
+	external_semaphore::external_semaphore(context* aContext, int aFD) {
+		this->Context = nullptr;
+		this->Handle = VK_NULL_HANDLE;
+		if ((aContext == nullptr) || (aFD < 0)) return;
+
+		if (!aContext->api().isExternalSemaphoreFdAvailable) return;
+
+		VkResult Result = VkResult::VK_SUCCESS;
+		VkSemaphoreCreateInfo CreateInfo{};
+		VkImportSemaphoreFdInfoKHR ImportInfo{};
+
+		CreateInfo.sType		= VkStructureType::VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+		CreateInfo.pNext		= NULL;
+		CreateInfo.flags		= 0;
+
+		Result = aContext->api().vkCreateSemaphore(aContext->handle(), &CreateInfo, NULL, &this->Handle);
+		if (Result != VkResult::VK_SUCCESS) return;
+
+		ImportInfo.sType		= VkStructureType::VK_STRUCTURE_TYPE_IMPORT_SEMAPHORE_FD_INFO_KHR;
+		ImportInfo.pNext		= NULL;
+		ImportInfo.semaphore	= this->Handle;
+		ImportInfo.flags		= 0;
+		ImportInfo.handleType	= VkExternalSemaphoreHandleTypeFlagBits::VK_EXTERNAL_SEMAPHORE_HANDLE_TYPE_OPAQUE_FD_BIT;
+		ImportInfo.fd			= aFD;
+
+		Result = aContext->api().vkImportSemaphoreFdKHR(aContext->handle(), &ImportInfo);
+		if (Result != VkResult::VK_SUCCESS) {
+			aContext->api().vkDestroySemaphore(aContext->handle(), this->Handle, NULL);
+			this->Handle = VK_NULL_HANDLE;
+			return;
+		}
+
+		this->Context = aContext;
+	}
+
+	external_semaphore::~external_semaphore() {
+		if ((this->Context != nullptr) && (this->Handle != VK_NULL_HANDLE)) {
+			this->Context->api().vkDestroySemaphore(this->Context->handle(), this->Handle, NULL);
+		}
+		this->Context = nullptr;
+		this->Handle = VK_NULL_HANDLE;
+	}
+
+	external_semaphore::external_semaphore(external_semaphore&& aInput) noexcept {
+		this->Context		= aInput.Context;
+		this->Handle		= aInput.Handle;
+		aInput.Context		= nullptr;
+		aInput.Handle		= VK_NULL_HANDLE;
+	}
+
+	external_semaphore& external_semaphore::operator=(external_semaphore&& aRhs) noexcept {
+		if (this == &aRhs) return *this;
+		if ((this->Context != nullptr) && (this->Handle != VK_NULL_HANDLE)) {
+			this->Context->api().vkDestroySemaphore(this->Context->handle(), this->Handle, NULL);
+		}
+		this->Context		= aRhs.Context;
+		this->Handle		= aRhs.Handle;
+		aRhs.Context		= nullptr;
+		aRhs.Handle			= VK_NULL_HANDLE;
+		return *this;
+	}
+
+	int external_semaphore::export_fd() {
+		int FD = -1;
+		if ((this->Context == nullptr) || (this->Handle == VK_NULL_HANDLE)) return FD;
+
+		if (!this->Context->api().isExternalSemaphoreFdAvailable) return FD;
+
+		VkSemaphoreGetFdInfoKHR GetInfo{};
+		GetInfo.sType			= VkStructureType::VK_STRUCTURE_TYPE_SEMAPHORE_GET_FD_INFO_KHR;
+		GetInfo.pNext			= NULL;
+		GetInfo.semaphore		= this->Handle;
+		GetInfo.handleType		= VkExternalSemaphoreHandleTypeFlagBits::VK_EXTERNAL_SEMAPHORE_HANDLE_TYPE_OPAQUE_FD_BIT;
+
+		if (this->Context->api().vkGetSemaphoreFdKHR(this->Context->handle(), &GetInfo, &FD) != VkResult::VK_SUCCESS) {
+			FD = -1;
+		}
+		return FD;
+	}
+
+	VkSemaphore& external_semaphore::handle() {
+		return this->Handle;
+	}
+
+}
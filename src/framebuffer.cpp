@@ -29,20 +29,20 @@ namespace geodesuka::core::gcl {
 		this->CreateInfo.height				= aHeight;
 		this->CreateInfo.layers				= aLayers;
 
-		Result = vkCreateFramebuffer(this->Context->handle(), &this->CreateInfo, NULL, &this->Handle);
+		Result = this->Context->api().vkCreateFramebuffer(this->Context->handle(), &this->CreateInfo, NULL, &this->Handle);
 
 	}
 
 	framebuffer::~framebuffer() {
 		if (this->Context != nullptr) {
 			if (this->Handle != VK_NULL_HANDLE) {
-				vkDestroyFramebuffer(this->Context->handle(), this->Handle, NULL);
+				this->Context->api().vkDestroyFramebuffer(this->Context->handle(), this->Handle, NULL);
 				this->Handle = VK_NULL_HANDLE;
 			}
 			if (this->View != NULL) {
 				for (uint32_t i = 0; i < this->AttachmentCount; i++) {
 					if (this->Handle != VK_NULL_HANDLE) {
-						vkDestroyImageView(this->Context->handle(), this->View[i], NULL);
+						this->Context->api().vkDestroyImageView(this->Context->handle(), this->View[i], NULL);
 						this->View[i] = VK_NULL_HANDLE;
 					}
 				}
@@ -0,0 +1,451 @@
+#include <geodesuka/core/logic/frustum_culler.h>
+
+#include <math.h>
+
+#include <chrono>
+
+#if defined(_M_X64) || defined(__x86_64__) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)) || defined(__SSE2__)
+#define GEODESUKA_CULL_SSE
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define GEODESUKA_TARGET_AVX2
+#else
+#define GEODESUKA_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+#if defined(__ARM_NEON) || defined(_M_ARM64)
+#define GEODESUKA_CULL_NEON
+#include <arm_neon.h>
+#endif
+
+namespace geodesuka::core::logic {
+
+	static bool has_avx2() {
+	#if defined(GEODESUKA_CULL_SSE) && defined(_MSC_VER)
+		int Info[4];
+		__cpuid(Info, 0);
+		if (Info[0] < 7) return false;
+		__cpuid(Info, 1);
+		// AVX and OS saved YMM state.
+		if (((Info[2] & (1 << 27)) == 0) || ((Info[2] & (1 << 28)) == 0)) return false;
+		if ((_xgetbv(0) & 0x6) != 0x6) return false;
+		__cpuidex(Info, 7, 0);
+		return (Info[1] & (1 << 5)) != 0;
+	#elif defined(GEODESUKA_CULL_SSE)
+		return __builtin_cpu_supports("avx2");
+	#else
+		return false;
+	#endif
+	}
+
+	frustum_culler::frustum_culler() {}
+
+	frustum_culler::~frustum_culler() {}
+
+	uint32_t frustum_culler::add(float3 aCenter, float aRadius) {
+		return this->insert(aCenter, aRadius, float3(aRadius, aRadius, aRadius));
+	}
+
+	uint32_t frustum_culler::add(float3 aCenter, float3 aHalfExtent) {
+		float Radius = sqrtf(aHalfExtent.x * aHalfExtent.x + aHalfExtent.y * aHalfExtent.y + aHalfExtent.z * aHalfExtent.z);
+		return this->insert(aCenter, Radius, aHalfExtent);
+	}
+
+	void frustum_culler::update(uint32_t aHandle, float3 aCenter, float aRadius) {
+		if ((aHandle >= this->Slot.size()) || (this->Slot[aHandle] == INVALID_HANDLE)) return;
+		this->set(this->Slot[aHandle], aCenter, aRadius, float3(aRadius, aRadius, aRadius));
+	}
+
+	void frustum_culler::update(uint32_t aHandle, float3 aCenter, float3 aHalfExtent) {
+		if ((aHandle >= this->Slot.size()) || (this->Slot[aHandle] == INVALID_HANDLE)) return;
+		float Radius = sqrtf(aHalfExtent.x * aHalfExtent.x + aHalfExtent.y * aHalfExtent.y + aHalfExtent.z * aHalfExtent.z);
+		this->set(this->Slot[aHandle], aCenter, Radius, aHalfExtent);
+	}
+
+	void frustum_culler::remove(uint32_t aHandle) {
+		if ((aHandle >= this->Slot.size()) || (this->Slot[aHandle] == INVALID_HANDLE)) return;
+
+		// Last slot fills the hole, arrays stay dense.
+		uint32_t Hole = this->Slot[aHandle];
+		uint32_t Last = (uint32_t)(this->Handle.size() - 1);
+		if (Hole != Last) {
+			this->X[Hole]			= this->X[Last];
+			this->Y[Hole]			= this->Y[Last];
+			this->Z[Hole]			= this->Z[Last];
+			this->Radius[Hole]		= this->Radius[Last];
+			this->ExtentX[Hole]		= this->ExtentX[Last];
+			this->ExtentY[Hole]		= this->ExtentY[Last];
+			this->ExtentZ[Hole]		= this->ExtentZ[Last];
+			this->Handle[Hole]		= this->Handle[Last];
+			this->Slot[this->Handle[Hole]] = Hole;
+		}
+		this->X.pop_back();
+		this->Y.pop_back();
+		this->Z.pop_back();
+		this->Radius.pop_back();
+		this->ExtentX.pop_back();
+		this->ExtentY.pop_back();
+		this->ExtentZ.pop_back();
+		this->Handle.pop_back();
+
+		this->Slot[aHandle] = INVALID_HANDLE;
+		this->FreeHandle.push_back(aHandle);
+	}
+
+	void frustum_culler::clear() {
+		this->X.clear();
+		this->Y.clear();
+		this->Z.clear();
+		this->Radius.clear();
+		this->ExtentX.clear();
+		this->ExtentY.clear();
+		this->ExtentZ.clear();
+		this->Handle.clear();
+		this->Slot.clear();
+		this->FreeHandle.clear();
+	}
+
+	size_t frustum_culler::size() const {
+		return this->Handle.size();
+	}
+
+	size_t frustum_culler::cull(const float4 aPlane[6], std::vector<uint32_t>& aVisible, kernel aKernel) const {
+		// Kernels write every lane and advance past visible ones.
+		aVisible.resize(this->Handle.size());
+		if (this->Handle.size() == 0) return 0;
+
+		kernel Kernel = aKernel == AUTOMATIC ? native_kernel() : aKernel;
+		if (!is_supported(Kernel)) {
+			Kernel = SCALAR;
+		}
+
+		size_t End = 0;
+		size_t Count = 0;
+		switch (Kernel) {
+		case AVX2:
+			Count = this->cull_avx2(aPlane, aVisible.data(), &End);
+			break;
+		case SSE:
+			Count = this->cull_sse(aPlane, aVisible.data(), &End);
+			break;
+		case NEON:
+			Count = this->cull_neon(aPlane, aVisible.data(), &End);
+			break;
+		default:
+			break;
+		}
+		// Remainder of the last block.
+		Count += this->cull_scalar(aPlane, End, aVisible.data() + Count);
+		aVisible.resize(Count);
+		return Count;
+	}
+
+	frustum_culler::kernel frustum_culler::native_kernel() {
+		static const kernel Native = is_supported(AVX2) ? AVX2 : (is_supported(SSE) ? SSE : (is_supported(NEON) ? NEON : SCALAR));
+		return Native;
+	}
+
+	bool frustum_culler::is_supported(kernel aKernel) {
+		switch (aKernel) {
+		case AUTOMATIC:
+		case SCALAR:
+			return true;
+	#ifdef GEODESUKA_CULL_SSE
+		case SSE:
+			return true;
+		case AVX2:
+		{
+			static const bool isAVX2 = has_avx2();
+			return isAVX2;
+		}
+	#endif
+	#ifdef GEODESUKA_CULL_NEON
+		case NEON:
+			return true;
+	#endif
+		default:
+			return false;
+		}
+	}
+
+	void frustum_culler::extract_planes(const float4x4& aViewProjection, float4 aPlane[6]) {
+		float Row[4][4];
+		for (int i = 0; i < 4; i++) {
+			for (int j = 0; j < 4; j++) {
+				Row[i][j] = aViewProjection(i + 1, j + 1);
+			}
+		}
+		float Plane[6][4];
+		for (int j = 0; j < 4; j++) {
+			Plane[0][j] = Row[3][j] + Row[0][j];		// Left
+			Plane[1][j] = Row[3][j] - Row[0][j];		// Right
+			Plane[2][j] = Row[3][j] + Row[1][j];		// Bottom
+			Plane[3][j] = Row[3][j] - Row[1][j];		// Top
+			Plane[4][j] = Row[2][j];					// Near, z in [0, w]
+			Plane[5][j] = Row[3][j] - Row[2][j];		// Far
+		}
+		for (int i = 0; i < 6; i++) {
+			// Normalized so radii compare with plane distance, degenerate planes keep everything.
+			float Length = sqrtf(Plane[i][0] * Plane[i][0] + Plane[i][1] * Plane[i][1] + Plane[i][2] * Plane[i][2]);
+			float Scale = Length > 0.0f ? 1.0f / Length : 0.0f;
+			aPlane[i] = float4(Plane[i][0] * Scale, Plane[i][1] * Scale, Plane[i][2] * Scale, Plane[i][3] * Scale);
+		}
+	}
+
+	double frustum_culler::benchmark(kernel aKernel, size_t aCount, int aRepeat) {
+		if (!is_supported(aKernel) || (aRepeat <= 0)) return -1.0;
+
+		// Same scene for every kernel, a fixed seed LCG.
+		frustum_culler Culler;
+		uint32_t Seed = 0x2545F491;
+		auto Random = [&Seed](float aMin, float aMax) -> float {
+			Seed = Seed * 1664525u + 1013904223u;
+			return aMin + (aMax - aMin) * (float)(Seed >> 8) / (float)(1u << 24);
+		};
+		for (size_t i = 0; i < aCount; i++) {
+			float3 Center(Random(-1000.0f, 1000.0f), Random(-1000.0f, 1000.0f), Random(-1000.0f, 1000.0f));
+			if ((i & 1) == 0) {
+				Culler.add(Center, Random(0.5f, 5.0f));
+			}
+			else {
+				Culler.add(Center, float3(Random(0.5f, 5.0f), Random(0.5f, 5.0f), Random(0.5f, 5.0f)));
+			}
+		}
+
+		// Ninety degree view down +z, from 1 to 1000.
+		float Half = 1.0f / sqrtf(2.0f);
+		float4 Plane[6] = {
+			float4(Half, 0.0f, Half, 0.0f),
+			float4(-Half, 0.0f, Half, 0.0f),
+			float4(0.0f, Half, Half, 0.0f),
+			float4(0.0f, -Half, Half, 0.0f),
+			float4(0.0f, 0.0f, 1.0f, -1.0f),
+			float4(0.0f, 0.0f, -1.0f, 1000.0f)
+		};
+
+		std::vector<uint32_t> Visible;
+		Culler.cull(Plane, Visible, aKernel);
+		auto Start = std::chrono::steady_clock::now();
+		for (int i = 0; i < aRepeat; i++) {
+			Culler.cull(Plane, Visible, aKernel);
+		}
+		auto Stop = std::chrono::steady_clock::now();
+		return std::chrono::duration<double, std::milli>(Stop - Start).count() / (double)aRepeat;
+	}
+
+	uint32_t frustum_culler::insert(float3 aCenter, float aRadius, float3 aHalfExtent) {
+		uint32_t NewHandle = INVALID_HANDLE;
+		if (this->FreeHandle.size() > 0) {
+			NewHandle = this->FreeHandle.back();
+			this->FreeHandle.pop_back();
+		}
+		else {
+			NewHandle = (uint32_t)this->Slot.size();
+			this->Slot.push_back(INVALID_HANDLE);
+		}
+
+		uint32_t NewSlot = (uint32_t)this->Handle.size();
+		this->X.push_back(0.0f);
+		this->Y.push_back(0.0f);
+		this->Z.push_back(0.0f);
+		this->Radius.push_back(0.0f);
+		this->ExtentX.push_back(0.0f);
+		this->ExtentY.push_back(0.0f);
+		this->ExtentZ.push_back(0.0f);
+		this->Handle.push_back(NewHandle);
+		this->Slot[NewHandle] = NewSlot;
+		this->set(NewSlot, aCenter, aRadius, aHalfExtent);
+		return NewHandle;
+	}
+
+	void frustum_culler::set(uint32_t aSlot, float3 aCenter, float aRadius, float3 aHalfExtent) {
+		this->X[aSlot]			= aCenter.x;
+		this->Y[aSlot]			= aCenter.y;
+		this->Z[aSlot]			= aCenter.z;
+		this->Radius[aSlot]		= aRadius;
+		this->ExtentX[aSlot]	= fabsf(aHalfExtent.x);
+		this->ExtentY[aSlot]	= fabsf(aHalfExtent.y);
+		this->ExtentZ[aSlot]	= fabsf(aHalfExtent.z);
+	}
+
+	// Reference kernel, every other kernel must produce the same list.
+	size_t frustum_culler::cull_scalar(const float4 aPlane[6], size_t aBegin, uint32_t* aVisible) const {
+		size_t Count = 0;
+		for (size_t i = aBegin; i < this->Handle.size(); i++) {
+			bool isInside = true;
+			for (int p = 0; p < 6; p++) {
+				// Same operation order as the vector kernels.
+				float Distance = (aPlane[p].x * this->X[i] + aPlane[p].y * this->Y[i]) + (aPlane[p].z * this->Z[i] + aPlane[p].t);
+				float Extent = (fabsf(aPlane[p].x) * this->ExtentX[i] + fabsf(aPlane[p].y) * this->ExtentY[i]) + fabsf(aPlane[p].z) * this->ExtentZ[i];
+				Extent = this->Radius[i] < Extent ? this->Radius[i] : Extent;
+				// Negated so NaN bounds are culled, as in the vector compares.
+				if (!(Distance + Extent >= 0.0f)) {
+					isInside = false;
+					break;
+				}
+			}
+			if (isInside) {
+				aVisible[Count] = this->Handle[i];
+				Count += 1;
+			}
+		}
+		return Count;
+	}
+
+#ifdef GEODESUKA_CULL_SSE
+
+	size_t frustum_culler::cull_sse(const float4 aPlane[6], uint32_t* aVisible, size_t* aEnd) const {
+		size_t End = this->Handle.size() & ~(size_t)3;
+		__m128 SignMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+		__m128 Zero = _mm_setzero_ps();
+		__m128 PX[6], PY[6], PZ[6], PW[6], AX[6], AY[6], AZ[6];
+		for (int p = 0; p < 6; p++) {
+			PX[p] = _mm_set1_ps(aPlane[p].x);
+			PY[p] = _mm_set1_ps(aPlane[p].y);
+			PZ[p] = _mm_set1_ps(aPlane[p].z);
+			PW[p] = _mm_set1_ps(aPlane[p].t);
+			AX[p] = _mm_and_ps(PX[p], SignMask);
+			AY[p] = _mm_and_ps(PY[p], SignMask);
+			AZ[p] = _mm_and_ps(PZ[p], SignMask);
+		}
+
+		size_t Count = 0;
+		for (size_t i = 0; i < End; i += 4) {
+			__m128 CX = _mm_loadu_ps(&this->X[i]);
+			__m128 CY = _mm_loadu_ps(&this->Y[i]);
+			__m128 CZ = _mm_loadu_ps(&this->Z[i]);
+			__m128 R = _mm_loadu_ps(&this->Radius[i]);
+			__m128 EX = _mm_loadu_ps(&this->ExtentX[i]);
+			__m128 EY = _mm_loadu_ps(&this->ExtentY[i]);
+			__m128 EZ = _mm_loadu_ps(&this->ExtentZ[i]);
+			int Mask = 0xF;
+			for (int p = 0; (p < 6) && (Mask != 0); p++) {
+				__m128 Distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(PX[p], CX), _mm_mul_ps(PY[p], CY)), _mm_add_ps(_mm_mul_ps(PZ[p], CZ), PW[p]));
+				__m128 Extent = _mm_add_ps(_mm_add_ps(_mm_mul_ps(AX[p], EX), _mm_mul_ps(AY[p], EY)), _mm_mul_ps(AZ[p], EZ));
+				Extent = _mm_min_ps(R, Extent);
+				Mask &= _mm_movemask_ps(_mm_cmpge_ps(_mm_add_ps(Distance, Extent), Zero));
+			}
+			// Most blocks are culled whole in large scenes.
+			if (Mask == 0) continue;
+			for (int k = 0; k < 4; k++) {
+				aVisible[Count] = this->Handle[i + k];
+				Count += (Mask >> k) & 1;
+			}
+		}
+		*aEnd = End;
+		return Count;
+	}
+
+	GEODESUKA_TARGET_AVX2
+	size_t frustum_culler::cull_avx2(const float4 aPlane[6], uint32_t* aVisible, size_t* aEnd) const {
+		size_t End = this->Handle.size() & ~(size_t)7;
+		__m256 SignMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+		__m256 Zero = _mm256_setzero_ps();
+		__m256 PX[6], PY[6], PZ[6], PW[6], AX[6], AY[6], AZ[6];
+		for (int p = 0; p < 6; p++) {
+			PX[p] = _mm256_set1_ps(aPlane[p].x);
+			PY[p] = _mm256_set1_ps(aPlane[p].y);
+			PZ[p] = _mm256_set1_ps(aPlane[p].z);
+			PW[p] = _mm256_set1_ps(aPlane[p].t);
+			AX[p] = _mm256_and_ps(PX[p], SignMask);
+			AY[p] = _mm256_and_ps(PY[p], SignMask);
+			AZ[p] = _mm256_and_ps(PZ[p], SignMask);
+		}
+
+		size_t Count = 0;
+		for (size_t i = 0; i < End; i += 8) {
+			__m256 CX = _mm256_loadu_ps(&this->X[i]);
+			__m256 CY = _mm256_loadu_ps(&this->Y[i]);
+			__m256 CZ = _mm256_loadu_ps(&this->Z[i]);
+			__m256 R = _mm256_loadu_ps(&this->Radius[i]);
+			__m256 EX = _mm256_loadu_ps(&this->ExtentX[i]);
+			__m256 EY = _mm256_loadu_ps(&this->ExtentY[i]);
+			__m256 EZ = _mm256_loadu_ps(&this->ExtentZ[i]);
+			int Mask = 0xFF;
+			for (int p = 0; (p < 6) && (Mask != 0); p++) {
+				__m256 Distance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(PX[p], CX), _mm256_mul_ps(PY[p], CY)), _mm256_add_ps(_mm256_mul_ps(PZ[p], CZ), PW[p]));
+				__m256 Extent = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(AX[p], EX), _mm256_mul_ps(AY[p], EY)), _mm256_mul_ps(AZ[p], EZ));
+				Extent = _mm256_min_ps(R, Extent);
+				Mask &= _mm256_movemask_ps(_mm256_cmp_ps(_mm256_add_ps(Distance, Extent), Zero, _CMP_GE_OQ));
+			}
+			// Most blocks are culled whole in large scenes.
+			if (Mask == 0) continue;
+			for (int k = 0; k < 8; k++) {
+				aVisible[Count] = this->Handle[i + k];
+				Count += (Mask >> k) & 1;
+			}
+		}
+		*aEnd = End;
+		return Count;
+	}
+
+#else
+
+	size_t frustum_culler::cull_sse(const float4*, uint32_t*, size_t* aEnd) const {
+		*aEnd = 0;
+		return 0;
+	}
+
+	size_t frustum_culler::cull_avx2(const float4*, uint32_t*, size_t* aEnd) const {
+		*aEnd = 0;
+		return 0;
+	}
+
+#endif // GEODESUKA_CULL_SSE
+
+#ifdef GEODESUKA_CULL_NEON
+
+	size_t frustum_culler::cull_neon(const float4 aPlane[6], uint32_t* aVisible, size_t* aEnd) const {
+		size_t End = this->Handle.size() & ~(size_t)3;
+		float32x4_t Zero = vdupq_n_f32(0.0f);
+		float32x4_t PX[6], PY[6], PZ[6], PW[6], AX[6], AY[6], AZ[6];
+		for (int p = 0; p < 6; p++) {
+			PX[p] = vdupq_n_f32(aPlane[p].x);
+			PY[p] = vdupq_n_f32(aPlane[p].y);
+			PZ[p] = vdupq_n_f32(aPlane[p].z);
+			PW[p] = vdupq_n_f32(aPlane[p].t);
+			AX[p] = vabsq_f32(PX[p]);
+			AY[p] = vabsq_f32(PY[p]);
+			AZ[p] = vabsq_f32(PZ[p]);
+		}
+
+		size_t Count = 0;
+		for (size_t i = 0; i < End; i += 4) {
+			float32x4_t CX = vld1q_f32(&this->X[i]);
+			float32x4_t CY = vld1q_f32(&this->Y[i]);
+			float32x4_t CZ = vld1q_f32(&this->Z[i]);
+			float32x4_t R = vld1q_f32(&this->Radius[i]);
+			float32x4_t EX = vld1q_f32(&this->ExtentX[i]);
+			float32x4_t EY = vld1q_f32(&this->ExtentY[i]);
+			float32x4_t EZ = vld1q_f32(&this->ExtentZ[i]);
+			uint32x4_t Inside = vdupq_n_u32(0xFFFFFFFF);
+			for (int p = 0; p < 6; p++) {
+				float32x4_t Distance = vaddq_f32(vaddq_f32(vmulq_f32(PX[p], CX), vmulq_f32(PY[p], CY)), vaddq_f32(vmulq_f32(PZ[p], CZ), PW[p]));
+				float32x4_t Extent = vaddq_f32(vaddq_f32(vmulq_f32(AX[p], EX), vmulq_f32(AY[p], EY)), vmulq_f32(AZ[p], EZ));
+				// Select rather than vminq_f32, which propagates NaN unlike the SSE min.
+				Extent = vbslq_f32(vcltq_f32(R, Extent), R, Extent);
+				Inside = vandq_u32(Inside, vcgeq_f32(vaddq_f32(Distance, Extent), Zero));
+			}
+			uint32_t Lane[4];
+			vst1q_u32(Lane, Inside);
+			for (int k = 0; k < 4; k++) {
+				aVisible[Count] = this->Handle[i + k];
+				Count += Lane[k] & 1;
+			}
+		}
+		*aEnd = End;
+		return Count;
+	}
+
+#else
+
+	size_t frustum_culler::cull_neon(const float4*, uint32_t*, size_t* aEnd) const {
+		*aEnd = 0;
+		return 0;
+	}
+
+#endif // GEODESUKA_CULL_NEON
+
+}
@@ -15,6 +15,8 @@
 
 #include <geodesuka/core/util/variable.h>
 
+#include <geodesuka/core/gcl/ownership_transfer.h>
+
 //#include <geodesuka/core/object.h>
 //#include <geodesuka/core/object/system_window.h>
 
@@ -34,19 +36,44 @@ namespace geodesuka::core::gcl {
 		this->AllocateInfo	= {};
 		this->MemoryHandle	= VK_NULL_HANDLE;
 		this->MemoryType	= 0;
+		this->Owner			= -1;
+		this->isExportable	= false;
 		this->BytesPerPixel = 0;
 		this->MemorySize	= 0;
 		this->Layout		= NULL;
 		this->MipExtent		= NULL;
 	}
 
-	image::image(context* aContext, int aMemoryType, prop aProperty, int aFormat, int aWidth, int aHeight, int aDepth, void* aTextureData) {
+	image::image(context* aContext, int aMemoryType, prop aProperty, int aFormat, int aWidth, int aHeight, int aDepth, void* aTextureData) : image(aContext, aMemoryType, aProperty, aFormat, aWidth, aHeight, aDepth, aTextureData, false) {}
+
+	image::image(context* aContext, int aMemoryType, prop aProperty, int aFormat, int aWidth, int aHeight, int aDepth, void* aTextureData, bool aExportable) : image() {
 		if (aContext == nullptr) return;
+		// Exporting needs VK_KHR_external_memory_fd.
+		if (aExportable && (!aContext->api().isExternalMemoryFdAvailable)) return;
 		this->Context = aContext;
+		this->Owner = -1;
+
+		VkExternalMemoryImageCreateInfo ExternalCreateInfo{};
+		VkExportMemoryAllocateInfo ExportAllocateInfo{};
+		VkMemoryDedicatedAllocateInfo DedicatedAllocateInfo{};
+
+		ExternalCreateInfo.sType				= VkStructureType::VK_STRUCTURE_TYPE_EXTERNAL_MEMORY_IMAGE_CREATE_INFO;
+		ExternalCreateInfo.pNext				= NULL;
+		ExternalCreateInfo.handleTypes			= VkExternalMemoryHandleTypeFlagBits::VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_FD_BIT;
+
+		// Exported images always use a dedicated allocation, some drivers require it.
+		DedicatedAllocateInfo.sType				= VkStructureType::VK_STRUCTURE_TYPE_MEMORY_DEDICATED_ALLOCATE_INFO;
+		DedicatedAllocateInfo.pNext				= NULL;
+		DedicatedAllocateInfo.image				= VK_NULL_HANDLE;
+		DedicatedAllocateInfo.buffer			= VK_NULL_HANDLE;
+
+		ExportAllocateInfo.sType				= VkStructureType::VK_STRUCTURE_TYPE_EXPORT_MEMORY_ALLOCATE_INFO;
+		ExportAllocateInfo.pNext				= &DedicatedAllocateInfo;
+		ExportAllocateInfo.handleTypes			= VkExternalMemoryHandleTypeFlagBits::VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_FD_BIT;
 
 		VkResult Result							= VkResult::VK_SUCCESS;
 		this->CreateInfo.sType					= VkStructureType::VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
-		this->CreateInfo.pNext					= NULL;
+		this->CreateInfo.pNext					= aExportable ? &ExternalCreateInfo : NULL;
 		this->CreateInfo.flags					= 0;
 		if ((aWidth > 1) && (aHeight > 1) && (aDepth > 1)) {
 			this->CreateInfo.imageType = VkImageType::VK_IMAGE_TYPE_3D;
@@ -89,17 +116,19 @@ namespace geodesuka::core::gcl {
 		// and possibly elements of a texture array.
 		this->MemorySize = this->CreateInfo.arrayLayers * this->CreateInfo.extent.width * this->CreateInfo.extent.height * this->CreateInfo.extent.depth * this->BytesPerPixel;
 
-		Result = vkCreateImage(this->Context->handle(), &this->CreateInfo, NULL, &this->Handle);
+		Result = this->Context->api().vkCreateImage(this->Context->handle(), &this->CreateInfo, NULL, &this->Handle);
 
 		// Allocate device memory for image handle
 		if (Result == VkResult::VK_SUCCESS) {
 			VkMemoryRequirements MemoryRequirements;
-			vkGetImageMemoryRequirements(this->Context->handle(), this->Handle, &MemoryRequirements);
+			this->Context->api().vkGetImageMemoryRequirements(this->Context->handle(), this->Handle, &MemoryRequirements);
 
 			VkPhysicalDeviceMemoryProperties MemoryProperties = this->Context->parent()->get_memory_properties();
 
+			DedicatedAllocateInfo.image			= this->Handle;
+
 			this->AllocateInfo.sType			= VkStructureType::VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-			this->AllocateInfo.pNext			= NULL;
+			this->AllocateInfo.pNext			= aExportable ? &ExportAllocateInfo : NULL;
 			this->AllocateInfo.allocationSize	= MemoryRequirements.size;
 
 			// First search for exact memory type.
@@ -124,19 +153,24 @@ namespace geodesuka::core::gcl {
 			}
 
 			if (this->MemoryType == -1) {
-				vkDestroyImage(this->Context->handle(), this->Handle, NULL);
+				this->Context->api().vkDestroyImage(this->Context->handle(), this->Handle, NULL);
 				this->Handle = VK_NULL_HANDLE;
 				return;
 			}
 
-			Result = vkAllocateMemory(this->Context->handle(), &this->AllocateInfo, NULL, &this->MemoryHandle);
+			Result = this->Context->api().vkAllocateMemory(this->Context->handle(), &this->AllocateInfo, NULL, &this->MemoryHandle);
 		}
 
 		// Bind image handle to memory.
 		if (Result == VkResult::VK_SUCCESS) {
-			Result = vkBindImageMemory(this->Context->handle(), this->Handle, this->MemoryHandle, 0);
+			Result = this->Context->api().vkBindImageMemory(this->Context->handle(), this->Handle, this->MemoryHandle, 0);
 		}
 
+		// Do not keep pointers to stack.
+		this->CreateInfo.pNext		= NULL;
+		this->AllocateInfo.pNext	= NULL;
+		this->isExportable			= aExportable && (Result == VkResult::VK_SUCCESS);
+
 		// TODO: Fix later for failed allocations.
 		// All initialized layouts is above.
 		// i = mip level, and j = array level;
@@ -176,13 +210,13 @@ namespace geodesuka::core::gcl {
 			aTextureData
 		);
 
-		VkSubmitInfo Submission[2] = { {}, {} };
+		// Upload is done on the transfer family, mip maps are generated on the
+		// graphics family. The image is exclusive, so ownership of the base level
+		// is released by the transfer family and acquired by the graphics family.
+		VkSubmitInfo Submission[4] = { {}, {}, {}, {} };
 		VkCommandBuffer CommandBuffer[2] = { VK_NULL_HANDLE, VK_NULL_HANDLE };
-		VkSemaphoreCreateInfo SemaphoreCreateInfo{};
-		VkSemaphore Semaphore;
 		VkFenceCreateInfo FenceCreateInfo{};
 		VkFence Fence[2];
-		VkPipelineStageFlags PipelineStage = VkPipelineStageFlagBits::VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
 
 		// Transfer.
 		Submission[0].sType						= VkStructureType::VK_STRUCTURE_TYPE_SUBMIT_INFO;
@@ -192,43 +226,206 @@ namespace geodesuka::core::gcl {
 		Submission[0].pWaitDstStageMask			= NULL;
 		Submission[0].commandBufferCount		= 1;
 		Submission[0].pCommandBuffers			= &CommandBuffer[0];
-		Submission[0].signalSemaphoreCount		= 1;
-		Submission[0].pSignalSemaphores			= &Semaphore;
+		Submission[0].signalSemaphoreCount		= 0;
+		Submission[0].pSignalSemaphores			= NULL;
 
 		// Graphics Submission
-		Submission[1].sType						= VkStructureType::VK_STRUCTURE_TYPE_SUBMIT_INFO;
-		Submission[1].pNext						= NULL;
-		Submission[1].waitSemaphoreCount		= 1;
-		Submission[1].pWaitSemaphores			= &Semaphore;
-		Submission[1].pWaitDstStageMask			= &PipelineStage;
-		Submission[1].commandBufferCount		= 1;
-		Submission[1].pCommandBuffers			= &CommandBuffer[1];
-		Submission[1].signalSemaphoreCount		= 0;
-		Submission[1].pSignalSemaphores			= NULL;
-
-		SemaphoreCreateInfo.sType				= VkStructureType::VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
-		SemaphoreCreateInfo.pNext				= NULL;
-		SemaphoreCreateInfo.flags				= 0;
+		Submission[3].sType						= VkStructureType::VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		Submission[3].pNext						= NULL;
+		Submission[3].waitSemaphoreCount		= 0;
+		Submission[3].pWaitSemaphores			= NULL;
+		Submission[3].pWaitDstStageMask			= NULL;
+		Submission[3].commandBufferCount		= 1;
+		Submission[3].pCommandBuffers			= &CommandBuffer[1];
+		Submission[3].signalSemaphoreCount		= 0;
+		Submission[3].pSignalSemaphores			= NULL;
 
 		FenceCreateInfo.sType					= VkStructureType::VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
 		FenceCreateInfo.pNext					= NULL;
 		FenceCreateInfo.flags					= 0;
 
-		Result = vkCreateSemaphore(this->Context->handle(), &SemaphoreCreateInfo, NULL, &Semaphore);
-		Result = vkCreateFence(this->Context->handle(), &FenceCreateInfo, NULL, &Fence[0]);
-		Result = vkCreateFence(this->Context->handle(), &FenceCreateInfo, NULL, &Fence[1]);
+		Result = this->Context->api().vkCreateFence(this->Context->handle(), &FenceCreateInfo, NULL, &Fence[0]);
+		Result = this->Context->api().vkCreateFence(this->Context->handle(), &FenceCreateInfo, NULL, &Fence[1]);
 		CommandBuffer[0] = (*this << StagingBuffer);
-		CommandBuffer[1] = this->generate_mipmaps(VkFilter::VK_FILTER_NEAREST);
+		this->Owner = this->Context->qfi(device::qfs::TRANSFER);
 
-		Result = this->Context->submit(device::TRANSFER, 1, &Submission[0], Fence[0]);
-		Result = this->Context->submit(device::GRAPHICS, 1, &Submission[1], Fence[1]);
-		Result = vkWaitForFences(this->Context->handle(), 2, Fence, VK_TRUE, UINT64_MAX);
-		
-		vkDestroyFence(this->Context->handle(), Fence[0], NULL);
-		vkDestroyFence(this->Context->handle(), Fence[1], NULL);
-		vkDestroySemaphore(this->Context->handle(), Semaphore, NULL);
+		// Release from transfer, acquire on graphics, base level stays in TRANSFER_DST_OPTIMAL.
+		ownership_transfer Ownership(
+			this->Context,
+			device::qfs::TRANSFER, VkPipelineStageFlagBits::VK_PIPELINE_STAGE_TRANSFER_BIT,
+			device::qfs::GRAPHICS_AND_COMPUTE, VkPipelineStageFlagBits::VK_PIPELINE_STAGE_TRANSFER_BIT
+		);
+		Ownership.add(*this,
+			VkImageLayout::VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+			VkAccessFlagBits::VK_ACCESS_TRANSFER_WRITE_BIT,
+			VkAccessFlagBits::VK_ACCESS_TRANSFER_READ_BIT | VkAccessFlagBits::VK_ACCESS_TRANSFER_WRITE_BIT
+		);
+		Result = Ownership.build();
+		Submission[1] = Ownership.release();
+		Submission[2] = Ownership.acquire();
+
+		// Copy and release must be in the same queue submission.
+		VkResult TransferResult = this->Context->submit(device::qfs::TRANSFER, 2, &Submission[0], Fence[0]);
+		VkResult GraphicsResult = TransferResult == VkResult::VK_SUCCESS ? this->Context->submit(device::qfs::GRAPHICS_AND_COMPUTE, 1, &Submission[2], Fence[1]) : TransferResult;
+		if (TransferResult == VkResult::VK_SUCCESS) {
+			TransferResult = this->Context->api().vkWaitForFences(this->Context->handle(), 1, &Fence[0], VK_TRUE, UINT64_MAX);
+		}
+		if (GraphicsResult == VkResult::VK_SUCCESS) {
+			GraphicsResult = this->Context->api().vkWaitForFences(this->Context->handle(), 1, &Fence[1], VK_TRUE, UINT64_MAX);
+		}
+
+		// Mip maps are recorded against the layouts the acquire left behind.
+		if ((TransferResult == VkResult::VK_SUCCESS) && (GraphicsResult == VkResult::VK_SUCCESS)) {
+			Ownership.commit();
+			CommandBuffer[1] = this->generate_mipmaps(VkFilter::VK_FILTER_NEAREST);
+			Result = this->Context->api().vkResetFences(this->Context->handle(), 1, &Fence[1]);
+			if (Result == VkResult::VK_SUCCESS) {
+				Result = this->Context->submit(device::qfs::GRAPHICS_AND_COMPUTE, 1, &Submission[3], Fence[1]);
+			}
+			if (Result == VkResult::VK_SUCCESS) {
+				Result = this->Context->api().vkWaitForFences(this->Context->handle(), 1, &Fence[1], VK_TRUE, UINT64_MAX);
+			}
+		}
+
+		this->Context->api().vkDestroyFence(this->Context->handle(), Fence[0], NULL);
+		this->Context->api().vkDestroyFence(this->Context->handle(), Fence[1], NULL);
 		this->Context->destroy(device::qfs::TRANSFER, CommandBuffer[0]);
-		this->Context->destroy(device::qfs::GRAPHICS, CommandBuffer[1]);
+		if (CommandBuffer[1] != VK_NULL_HANDLE) {
+			this->Context->destroy(device::qfs::GRAPHICS_AND_COMPUTE, CommandBuffer[1]);
+		}
+
+	}
+
+	image::image(context* aContext, prop aProperty, int aFormat, int aWidth, int aHeight, int aDepth, external_memory& aMemory) : image() {
+		if ((aContext == nullptr) || (aMemory.FD < 0)) return;
+		if (!aContext->api().isExternalMemoryFdAvailable) return;
+		// Memory can only be shared on the same physical device.
+		VkPhysicalDeviceIDProperties IDProperties = aContext->parent()->get_id_properties();
+		if (memcmp(IDProperties.deviceUUID, aMemory.DeviceUUID, VK_UUID_SIZE) != 0) return;
+		this->Context = aContext;
+
+		VkExternalMemoryImageCreateInfo ExternalCreateInfo{};
+		VkImportMemoryFdInfoKHR ImportInfo{};
+		VkMemoryDedicatedAllocateInfo DedicatedAllocateInfo{};
+
+		ExternalCreateInfo.sType				= VkStructureType::VK_STRUCTURE_TYPE_EXTERNAL_MEMORY_IMAGE_CREATE_INFO;
+		ExternalCreateInfo.pNext				= NULL;
+		ExternalCreateInfo.handleTypes			= VkExternalMemoryHandleTypeFlagBits::VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_FD_BIT;
+
+		DedicatedAllocateInfo.sType				= VkStructureType::VK_STRUCTURE_TYPE_MEMORY_DEDICATED_ALLOCATE_INFO;
+		DedicatedAllocateInfo.pNext				= NULL;
+		DedicatedAllocateInfo.image				= VK_NULL_HANDLE;
+		DedicatedAllocateInfo.buffer			= VK_NULL_HANDLE;
+
+		ImportInfo.sType						= VkStructureType::VK_STRUCTURE_TYPE_IMPORT_MEMORY_FD_INFO_KHR;
+		ImportInfo.pNext						= aMemory.Dedicated ? &DedicatedAllocateInfo : NULL;
+		ImportInfo.handleType					= VkExternalMemoryHandleTypeFlagBits::VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_FD_BIT;
+		ImportInfo.fd							= aMemory.FD;
+
+		// Create info must be identical to the exporting image.
+		VkResult Result							= VkResult::VK_SUCCESS;
+		this->CreateInfo.sType					= VkStructureType::VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+		this->CreateInfo.pNext					= &ExternalCreateInfo;
+		this->CreateInfo.flags					= 0;
+		if ((aWidth > 1) && (aHeight > 1) && (aDepth > 1)) {
+			this->CreateInfo.imageType = VkImageType::VK_IMAGE_TYPE_3D;
+		}
+		else if ((aWidth > 1) && (aHeight > 1)) {
+			this->CreateInfo.imageType = VkImageType::VK_IMAGE_TYPE_2D;
+		}
+		else if (aWidth > 1) {
+			this->CreateInfo.imageType = VkImageType::VK_IMAGE_TYPE_1D;
+		}
+		else {
+			this->Context = nullptr;
+			return;
+		}
+		this->CreateInfo.format					= (VkFormat)aFormat;
+		switch (this->CreateInfo.imageType) {
+		default:
+			break;
+		case VK_IMAGE_TYPE_1D:
+			this->CreateInfo.extent = { (uint32_t)aWidth, 1u, 1u };
+			break;
+		case VK_IMAGE_TYPE_2D:
+			this->CreateInfo.extent = { (uint32_t)aWidth, (uint32_t)aHeight, 1u };
+			break;
+		case VK_IMAGE_TYPE_3D:
+			this->CreateInfo.extent = { (uint32_t)aWidth, (uint32_t)aHeight, (uint32_t)aDepth };
+			break;
+		}
+		this->CreateInfo.mipLevels				= this->miplevelcalc(this->CreateInfo.imageType, this->CreateInfo.extent);
+		this->CreateInfo.arrayLayers			= aProperty.ArrayLayerCount;
+		this->CreateInfo.samples				= (VkSampleCountFlagBits)aProperty.SampleCounts;
+		this->CreateInfo.tiling					= (VkImageTiling)aProperty.Tiling;
+		this->CreateInfo.usage					= aProperty.Usage | image::usage::TRANSFER_SRC | image::usage::TRANSFER_DST; // Enable Transfer
+		this->CreateInfo.sharingMode			= VkSharingMode::VK_SHARING_MODE_EXCLUSIVE;
+		this->CreateInfo.queueFamilyIndexCount	= 0;
+		this->CreateInfo.pQueueFamilyIndices	= NULL;
+		this->CreateInfo.initialLayout			= VkImageLayout::VK_IMAGE_LAYOUT_UNDEFINED;
+
+		this->BytesPerPixel = this->bytesperpixel(this->CreateInfo.format);
+		this->MemorySize = this->CreateInfo.arrayLayers * this->CreateInfo.extent.width * this->CreateInfo.extent.height * this->CreateInfo.extent.depth * this->BytesPerPixel;
+
+		Result = this->Context->api().vkCreateImage(this->Context->handle(), &this->CreateInfo, NULL, &this->Handle);
+
+		if (Result == VkResult::VK_SUCCESS) {
+			DedicatedAllocateInfo.image			= this->Handle;
+
+			this->AllocateInfo.sType			= VkStructureType::VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+			this->AllocateInfo.pNext			= &ImportInfo;
+			this->AllocateInfo.allocationSize	= aMemory.AllocationSize;
+			this->AllocateInfo.memoryTypeIndex	= aMemory.MemoryTypeIndex;
+			this->MemoryType					= this->Context->parent()->get_memory_type(aMemory.MemoryTypeIndex);
+
+			// On success, the implementation owns the file descriptor.
+			Result = this->Context->api().vkAllocateMemory(this->Context->handle(), &this->AllocateInfo, NULL, &this->MemoryHandle);
+			if (Result == VkResult::VK_SUCCESS) {
+				aMemory.FD = -1;
+			}
+		}
+
+		if (Result == VkResult::VK_SUCCESS) {
+			Result = this->Context->api().vkBindImageMemory(this->Context->handle(), this->Handle, this->MemoryHandle, 0);
+		}
+
+		this->CreateInfo.pNext		= NULL;
+		this->AllocateInfo.pNext	= NULL;
+
+		// Contents are preserved, so layouts are taken from exporter.
+		this->Layout = (VkImageLayout**)malloc(this->CreateInfo.mipLevels * sizeof(VkImageLayout*));
+		this->MipExtent = (VkExtent3D*)malloc(this->CreateInfo.mipLevels * sizeof(VkExtent3D));
+		bool AllocationFailure = (this->Layout == NULL) || (this->MipExtent == NULL);
+		if (this->Layout != NULL) {
+			for (uint32_t i = 0; i < this->CreateInfo.mipLevels; i++) {
+				this->Layout[i] = (VkImageLayout*)malloc(this->CreateInfo.arrayLayers * sizeof(VkImageLayout));
+				AllocationFailure |= (this->Layout[i] == NULL);
+			}
+		}
+
+		if ((Result != VkResult::VK_SUCCESS) || (AllocationFailure)) {
+			this->pmclearall();
+			return;
+		}
+
+		for (uint32_t i = 0; i < this->CreateInfo.mipLevels; i++) {
+			for (uint32_t j = 0; j < this->CreateInfo.arrayLayers; j++) {
+				this->Layout[i][j] = aMemory.Layout;
+			}
+			switch (this->CreateInfo.imageType) {
+			default:
+				break;
+			case VK_IMAGE_TYPE_1D:
+				this->MipExtent[i] = { (this->CreateInfo.extent.width >> i), 1u, 1u };
+				break;
+			case VK_IMAGE_TYPE_2D:
+				this->MipExtent[i] = { (this->CreateInfo.extent.width >> i), (this->CreateInfo.extent.height >> i), 1u };
+				break;
+			case VK_IMAGE_TYPE_3D:
+				this->MipExtent[i] = { (this->CreateInfo.extent.width >> i), (this->CreateInfo.extent.height >> i), (this->CreateInfo.extent.depth >> i) };
+				break;
+			}
+		}
 
 	}
 
@@ -241,9 +438,9 @@ namespace geodesuka::core::gcl {
 		free(this->Layout); this->Layout = NULL;
 		free(this->MipExtent); this->MipExtent = NULL;
 		if (this->Context != nullptr) {
-			vkDestroyImage(this->Context->handle(), this->Handle, NULL);
+			this->Context->api().vkDestroyImage(this->Context->handle(), this->Handle, NULL);
 			this->Handle = VK_NULL_HANDLE;
-			vkFreeMemory(this->Context->handle(), this->MemoryHandle, NULL);
+			this->Context->api().vkFreeMemory(this->Context->handle(), this->MemoryHandle, NULL);
 			this->MemoryHandle = VK_NULL_HANDLE;
 		}
 		this->Context = nullptr;
@@ -254,9 +451,15 @@ namespace geodesuka::core::gcl {
 		this->CreateInfo		= aInput.CreateInfo;
 		this->AllocateInfo		= aInput.AllocateInfo;
 		this->MemoryType		= aInput.MemoryType;
+		this->Owner				= -1;
+		this->isExportable		= false;
 		this->BytesPerPixel		= aInput.BytesPerPixel;
 		this->MemorySize		= aInput.MemorySize;
 
+		// Copies are never shared.
+		this->CreateInfo.pNext		= NULL;
+		this->AllocateInfo.pNext	= NULL;
+
 		this->MipExtent = (VkExtent3D*)malloc(this->CreateInfo.mipLevels * sizeof(VkExtent3D));
 		this->Layout = (VkImageLayout**)malloc(this->CreateInfo.mipLevels * sizeof(VkImageLayout*));
 		if (this->Layout != NULL) {
@@ -311,12 +514,12 @@ namespace geodesuka::core::gcl {
 		}
 
 		VkResult Result = VkResult::VK_SUCCESS;
-		Result = vkCreateImage(this->Context->handle(), &this->CreateInfo, NULL, &this->Handle);
+		Result = this->Context->api().vkCreateImage(this->Context->handle(), &this->CreateInfo, NULL, &this->Handle);
 		if (Result == VkResult::VK_SUCCESS) {
-			Result = vkAllocateMemory(this->Context->handle(), &this->AllocateInfo, NULL, &this->MemoryHandle);
+			Result = this->Context->api().vkAllocateMemory(this->Context->handle(), &this->AllocateInfo, NULL, &this->MemoryHandle);
 		}
 		if (Result == VkResult::VK_SUCCESS) {
-			Result = vkBindImageMemory(this->Context->handle(), this->Handle, this->MemoryHandle, 0);
+			Result = this->Context->api().vkBindImageMemory(this->Context->handle(), this->Handle, this->MemoryHandle, 0);
 		}
 
 		// If successful.
@@ -329,9 +532,9 @@ namespace geodesuka::core::gcl {
 			free(this->Layout); this->Layout = NULL;
 			free(this->MipExtent); this->MipExtent = NULL;
 			if (this->Context != nullptr) {
-				vkDestroyImage(this->Context->handle(), this->Handle, NULL);
+				this->Context->api().vkDestroyImage(this->Context->handle(), this->Handle, NULL);
 				this->Handle = VK_NULL_HANDLE;
-				vkFreeMemory(this->Context->handle(), this->MemoryHandle, NULL);
+				this->Context->api().vkFreeMemory(this->Context->handle(), this->MemoryHandle, NULL);
 				this->MemoryHandle = VK_NULL_HANDLE;
 			}
 			this->Context = nullptr;
@@ -359,11 +562,12 @@ namespace geodesuka::core::gcl {
 		FenceCreateInfo.flags				= 0;
 
 		CommandBuffer = (*this << aInput);
-		Result = vkCreateFence(this->Context->handle(), &FenceCreateInfo, NULL, &Fence);
+		Result = this->Context->api().vkCreateFence(this->Context->handle(), &FenceCreateInfo, NULL, &Fence);
 		Result = this->Context->submit(device::qfs::TRANSFER, 1, &Submission, Fence);
-		Result = vkWaitForFences(this->Context->handle(), 1, &Fence, VK_TRUE, UINT64_MAX);
+		Result = this->Context->api().vkWaitForFences(this->Context->handle(), 1, &Fence, VK_TRUE, UINT64_MAX);
 		this->Context->destroy(device::qfs::TRANSFER, CommandBuffer);
-		vkDestroyFence(this->Context->handle(), Fence, NULL);
+		this->Context->api().vkDestroyFence(this->Context->handle(), Fence, NULL);
+		this->Owner = this->Context->qfi(device::qfs::TRANSFER);
 
 	}
 
@@ -374,6 +578,8 @@ namespace geodesuka::core::gcl {
 		this->AllocateInfo		= aInput.AllocateInfo;
 		this->MemoryHandle		= aInput.MemoryHandle;
 		this->MemoryType		= aInput.MemoryType;
+		this->Owner				= aInput.Owner;
+		this->isExportable		= aInput.isExportable;
 		this->BytesPerPixel		= aInput.BytesPerPixel;
 		this->MemorySize		= aInput.MemorySize;
 		this->Layout			= aInput.Layout;
@@ -385,6 +591,8 @@ namespace geodesuka::core::gcl {
 		aInput.AllocateInfo		= {};
 		aInput.MemoryHandle		= VK_NULL_HANDLE;
 		aInput.MemoryType		= 0;
+		aInput.Owner			= -1;
+		aInput.isExportable		= false;
 		aInput.BytesPerPixel	= 0;
 		aInput.MemorySize		= 0;
 		aInput.Layout			= NULL;
@@ -399,9 +607,15 @@ namespace geodesuka::core::gcl {
 		this->CreateInfo		= aRhs.CreateInfo;
 		this->AllocateInfo		= aRhs.AllocateInfo;
 		this->MemoryType		= aRhs.MemoryType;
+		this->Owner				= -1;
+		this->isExportable		= false;
 		this->BytesPerPixel		= aRhs.BytesPerPixel;
 		this->MemorySize		= aRhs.MemorySize;
 
+		// Copies are never shared.
+		this->CreateInfo.pNext		= NULL;
+		this->AllocateInfo.pNext	= NULL;
+
 		// Allocate Host memory.
 		this->Layout = (VkImageLayout**)malloc(this->CreateInfo.mipLevels * sizeof(VkImageLayout*));
 		for (uint32_t i = 0; i < this->CreateInfo.mipLevels; i++) {
@@ -411,12 +625,12 @@ namespace geodesuka::core::gcl {
 
 		// Allocate Device memory.
 		VkResult Result = VkResult::VK_SUCCESS;
-		Result = vkCreateImage(this->Context->handle(), &this->CreateInfo, NULL, &this->Handle);
+		Result = this->Context->api().vkCreateImage(this->Context->handle(), &this->CreateInfo, NULL, &this->Handle);
 		if (Result == VkResult::VK_SUCCESS) {
-			Result = vkAllocateMemory(this->Context->handle(), &this->AllocateInfo, NULL, &this->MemoryHandle);
+			Result = this->Context->api().vkAllocateMemory(this->Context->handle(), &this->AllocateInfo, NULL, &this->MemoryHandle);
 		}
 		if (Result == VkResult::VK_SUCCESS) {
-			Result = vkBindImageMemory(this->Context->handle(), this->Handle, this->MemoryHandle, 0);
+			Result = this->Context->api().vkBindImageMemory(this->Context->handle(), this->Handle, this->MemoryHandle, 0);
 		}
 
 		// Check for memory allocation failure.
@@ -479,13 +693,14 @@ namespace geodesuka::core::gcl {
 		FenceCreateInfo.pNext				= NULL;
 		FenceCreateInfo.flags				= 0;
 
-		Result = vkCreateFence(this->Context->handle(), &FenceCreateInfo, NULL, &Fence);
+		Result = this->Context->api().vkCreateFence(this->Context->handle(), &FenceCreateInfo, NULL, &Fence);
 		CommandBuffer = (*this << aRhs);
 		Result = this->Context->submit(device::qfs::TRANSFER, 1, &Submission, Fence);
-		Result = vkWaitForFences(this->Context->handle(), 1, &Fence, VK_TRUE, UINT64_MAX);
+		Result = this->Context->api().vkWaitForFences(this->Context->handle(), 1, &Fence, VK_TRUE, UINT64_MAX);
 
-		vkDestroyFence(this->Context->handle(), Fence, NULL);
+		this->Context->api().vkDestroyFence(this->Context->handle(), Fence, NULL);
 		this->Context->destroy(device::qfs::TRANSFER, CommandBuffer);
+		this->Owner = this->Context->qfi(device::qfs::TRANSFER);
 
 		return *this;
 	}
@@ -499,6 +714,8 @@ namespace geodesuka::core::gcl {
 		this->AllocateInfo		= aRhs.AllocateInfo;
 		this->MemoryHandle		= aRhs.MemoryHandle;
 		this->MemoryType		= aRhs.MemoryType;
+		this->Owner				= aRhs.Owner;
+		this->isExportable		= aRhs.isExportable;
 		this->BytesPerPixel		= aRhs.BytesPerPixel;
 		this->MemorySize		= aRhs.MemorySize;
 		this->Layout			= aRhs.Layout;
@@ -510,6 +727,8 @@ namespace geodesuka::core::gcl {
 		aRhs.AllocateInfo	= {};
 		aRhs.MemoryHandle	= VK_NULL_HANDLE;
 		aRhs.MemoryType		= 0;
+		aRhs.Owner			= -1;
+		aRhs.isExportable	= false;
 		aRhs.BytesPerPixel	= 0;
 		aRhs.MemorySize		= 0;
 		aRhs.Layout			= NULL;
@@ -618,10 +837,10 @@ namespace geodesuka::core::gcl {
 		}
 
 		CommandBuffer = this->Context->create(device::qfs::TRANSFER);
-		Result = vkBeginCommandBuffer(CommandBuffer, &BeginInfo);
+		Result = this->Context->api().vkBeginCommandBuffer(CommandBuffer, &BeginInfo);
 
 		// Transition all images.
-		vkCmdPipelineBarrier(CommandBuffer,
+		this->Context->api().vkCmdPipelineBarrier(CommandBuffer,
 			VkPipelineStageFlagBits::VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
 			VkPipelineStageFlagBits::VK_PIPELINE_STAGE_TRANSFER_BIT,
 			0,
@@ -630,13 +849,13 @@ namespace geodesuka::core::gcl {
 			Barrier.size(), Barrier.data()
 		);
 
-		vkCmdCopyImage(CommandBuffer,
+		this->Context->api().vkCmdCopyImage(CommandBuffer,
 			aRhs.Handle, VkImageLayout::VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
 			this->Handle, VkImageLayout::VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
 			Region.size(), Region.data()
 		);
 
-		Result = vkEndCommandBuffer(CommandBuffer);
+		Result = this->Context->api().vkEndCommandBuffer(CommandBuffer);
 
 		return CommandBuffer;
 	}
@@ -696,10 +915,10 @@ namespace geodesuka::core::gcl {
 
 		//Result = this->Context->create(context::cmdtype::TRANSFER_OTS, 1, &CommandBuffer);
 		CommandBuffer = this->Context->create(device::qfs::TRANSFER);
-		Result = vkBeginCommandBuffer(CommandBuffer, &BeginInfo);
+		Result = this->Context->api().vkBeginCommandBuffer(CommandBuffer, &BeginInfo);
 
 		// Setup pipeline barriers.
-		vkCmdPipelineBarrier(CommandBuffer,
+		this->Context->api().vkCmdPipelineBarrier(CommandBuffer,
 			VkPipelineStageFlagBits::VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
 			VkPipelineStageFlagBits::VK_PIPELINE_STAGE_TRANSFER_BIT,
 			0,
@@ -709,13 +928,13 @@ namespace geodesuka::core::gcl {
 		);
 
 		// Actual transfer.
-		vkCmdCopyBufferToImage(CommandBuffer, 
+		this->Context->api().vkCmdCopyBufferToImage(CommandBuffer, 
 			aRhs.Handle, 
 			this->Handle, VkImageLayout::VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
 			1, &CopyRegion
 		);
 
-		Result = vkEndCommandBuffer(CommandBuffer);
+		Result = this->Context->api().vkEndCommandBuffer(CommandBuffer);
 
 		return CommandBuffer;
 	}
@@ -738,8 +957,8 @@ namespace geodesuka::core::gcl {
 		BeginInfo.pInheritanceInfo						= NULL;
 
 		//Result = this->Context->create(context::cmdtype::GRAPHICS, 1, &CommandBuffer);
-		CommandBuffer = this->Context->create(device::qfs::GRAPHICS);
-		Result = vkBeginCommandBuffer(CommandBuffer, &BeginInfo);
+		CommandBuffer = this->Context->create(device::qfs::GRAPHICS_AND_COMPUTE);
+		Result = this->Context->api().vkBeginCommandBuffer(CommandBuffer, &BeginInfo);
 
 		for (uint32_t i = 0; i < this->CreateInfo.mipLevels - 1; i++) {
 			std::vector<VkImageMemoryBarrier> Barrier;
@@ -801,7 +1020,7 @@ namespace geodesuka::core::gcl {
 			Region.dstOffsets[0]					= { 0, 0, 0 };
 			Region.dstOffsets[1]					= { (int32_t)this->MipExtent[i + 1].width, (int32_t)this->MipExtent[i + 1].height, (int32_t)this->MipExtent[i + 1].depth };
 
-			vkCmdPipelineBarrier(CommandBuffer,
+			this->Context->api().vkCmdPipelineBarrier(CommandBuffer,
 				VkPipelineStageFlagBits::VK_PIPELINE_STAGE_TRANSFER_BIT,
 				VkPipelineStageFlagBits::VK_PIPELINE_STAGE_TRANSFER_BIT,
 				0,
@@ -810,7 +1029,7 @@ namespace geodesuka::core::gcl {
 				Barrier.size(), Barrier.data()
 			);
 
-			vkCmdBlitImage(CommandBuffer,
+			this->Context->api().vkCmdBlitImage(CommandBuffer,
 				this->Handle, VkImageLayout::VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
 				this->Handle, VkImageLayout::VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
 				1, &Region, 
@@ -819,11 +1038,162 @@ namespace geodesuka::core::gcl {
 
 		}
 
-		Result = vkEndCommandBuffer(CommandBuffer);
+		Result = this->Context->api().vkEndCommandBuffer(CommandBuffer);
 
 		return CommandBuffer;
 	}
 
+	VkCommandBuffer image::transition(VkImageLayout aNewLayout) {
+		VkCommandBuffer CommandBuffer = VK_NULL_HANDLE;
+		if ((this->Context == nullptr) || (this->Layout == NULL)) return CommandBuffer;
+
+		VkResult Result = VkResult::VK_SUCCESS;
+		VkCommandBufferBeginInfo BeginInfo{};
+		std::vector<VkImageMemoryBarrier> Barrier;
+
+		BeginInfo.sType									= VkStructureType::VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		BeginInfo.pNext									= NULL;
+		BeginInfo.flags									= 0;
+		BeginInfo.pInheritanceInfo						= NULL;
+
+		for (uint32_t i = 0; i < this->CreateInfo.mipLevels; i++) {
+			for (uint32_t j = 0; j < this->CreateInfo.arrayLayers; j++) {
+				if (this->Layout[i][j] == aNewLayout) continue;
+				VkImageMemoryBarrier temp{};
+				temp.sType								= VkStructureType::VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+				temp.pNext								= NULL;
+				temp.srcAccessMask						= VkAccessFlagBits::VK_ACCESS_MEMORY_WRITE_BIT;
+				temp.dstAccessMask						= VkAccessFlagBits::VK_ACCESS_MEMORY_READ_BIT | VkAccessFlagBits::VK_ACCESS_MEMORY_WRITE_BIT;
+				temp.oldLayout							= this->Layout[i][j];
+				temp.newLayout							= aNewLayout;
+				temp.srcQueueFamilyIndex				= VK_QUEUE_FAMILY_IGNORED;
+				temp.dstQueueFamilyIndex				= VK_QUEUE_FAMILY_IGNORED;
+				temp.image								= this->Handle;
+				temp.subresourceRange.aspectMask		= VkImageAspectFlagBits::VK_IMAGE_ASPECT_COLOR_BIT;
+				temp.subresourceRange.baseMipLevel		= i;
+				temp.subresourceRange.levelCount		= 1;
+				temp.subresourceRange.baseArrayLayer	= j;
+				temp.subresourceRange.layerCount		= 1;
+				this->Layout[i][j]						= aNewLayout;
+				Barrier.push_back(temp);
+			}
+		}
+
+		if (Barrier.size() == 0) return CommandBuffer;
+
+		CommandBuffer = this->Context->create(device::qfs::GRAPHICS_AND_COMPUTE);
+		if (CommandBuffer == VK_NULL_HANDLE) return CommandBuffer;
+		Result = this->Context->api().vkBeginCommandBuffer(CommandBuffer, &BeginInfo);
+
+		this->Context->api().vkCmdPipelineBarrier(CommandBuffer,
+			VkPipelineStageFlagBits::VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+			VkPipelineStageFlagBits::VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+			0,
+			0, NULL,
+			0, NULL,
+			Barrier.size(), Barrier.data()
+		);
+
+		Result = this->Context->api().vkEndCommandBuffer(CommandBuffer);
+
+		return CommandBuffer;
+	}
+
+	VkCommandBuffer image::transition(uint32_t MipIndex, uint32_t ArrayIndex, VkImageLayout aNewLayout) {
+		VkCommandBuffer CommandBuffer = VK_NULL_HANDLE;
+		if ((this->Context == nullptr) || (this->Layout == NULL)) return CommandBuffer;
+		if ((MipIndex >= this->CreateInfo.mipLevels) || (ArrayIndex >= this->CreateInfo.arrayLayers)) return CommandBuffer;
+		if (this->Layout[MipIndex][ArrayIndex] == aNewLayout) return CommandBuffer;
+
+		VkResult Result = VkResult::VK_SUCCESS;
+		VkCommandBufferBeginInfo BeginInfo{};
+		VkImageMemoryBarrier Barrier{};
+
+		BeginInfo.sType									= VkStructureType::VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		BeginInfo.pNext									= NULL;
+		BeginInfo.flags									= 0;
+		BeginInfo.pInheritanceInfo						= NULL;
+
+		Barrier.sType									= VkStructureType::VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+		Barrier.pNext									= NULL;
+		Barrier.srcAccessMask							= VkAccessFlagBits::VK_ACCESS_MEMORY_WRITE_BIT;
+		Barrier.dstAccessMask							= VkAccessFlagBits::VK_ACCESS_MEMORY_READ_BIT | VkAccessFlagBits::VK_ACCESS_MEMORY_WRITE_BIT;
+		Barrier.oldLayout								= this->Layout[MipIndex][ArrayIndex];
+		Barrier.newLayout								= aNewLayout;
+		Barrier.srcQueueFamilyIndex						= VK_QUEUE_FAMILY_IGNORED;
+		Barrier.dstQueueFamilyIndex						= VK_QUEUE_FAMILY_IGNORED;
+		Barrier.image									= this->Handle;
+		Barrier.subresourceRange.aspectMask				= VkImageAspectFlagBits::VK_IMAGE_ASPECT_COLOR_BIT;
+		Barrier.subresourceRange.baseMipLevel			= MipIndex;
+		Barrier.subresourceRange.levelCount				= 1;
+		Barrier.subresourceRange.baseArrayLayer			= ArrayIndex;
+		Barrier.subresourceRange.layerCount				= 1;
+		this->Layout[MipIndex][ArrayIndex]				= aNewLayout;
+
+		CommandBuffer = this->Context->create(device::qfs::GRAPHICS_AND_COMPUTE);
+		if (CommandBuffer == VK_NULL_HANDLE) return CommandBuffer;
+		Result = this->Context->api().vkBeginCommandBuffer(CommandBuffer, &BeginInfo);
+
+		this->Context->api().vkCmdPipelineBarrier(CommandBuffer,
+			VkPipelineStageFlagBits::VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+			VkPipelineStageFlagBits::VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+			0,
+			0, NULL,
+			0, NULL,
+			1, &Barrier
+		);
+
+		Result = this->Context->api().vkEndCommandBuffer(CommandBuffer);
+
+		return CommandBuffer;
+	}
+
+	external_memory image::export_memory() {
+		external_memory temp;
+		if ((this->Context == nullptr) || (this->MemoryHandle == VK_NULL_HANDLE) || (!this->isExportable) || (this->Layout == NULL)) return temp;
+
+		// All subresources must share the same layout, use transition() first.
+		for (uint32_t i = 0; i < this->CreateInfo.mipLevels; i++) {
+			for (uint32_t j = 0; j < this->CreateInfo.arrayLayers; j++) {
+				if (this->Layout[i][j] != this->Layout[0][0]) return temp;
+			}
+		}
+
+		if (!this->Context->api().isExternalMemoryFdAvailable) return temp;
+
+		VkMemoryGetFdInfoKHR GetInfo{};
+		GetInfo.sType			= VkStructureType::VK_STRUCTURE_TYPE_MEMORY_GET_FD_INFO_KHR;
+		GetInfo.pNext			= NULL;
+		GetInfo.memory			= this->MemoryHandle;
+		GetInfo.handleType		= VkExternalMemoryHandleTypeFlagBits::VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_FD_BIT;
+
+		if (this->Context->api().vkGetMemoryFdKHR(this->Context->handle(), &GetInfo, &temp.FD) != VkResult::VK_SUCCESS) {
+			temp.FD = -1;
+			return temp;
+		}
+
+		VkPhysicalDeviceIDProperties IDProperties = this->Context->parent()->get_id_properties();
+		temp.AllocationSize		= this->AllocateInfo.allocationSize;
+		temp.MemoryTypeIndex	= this->AllocateInfo.memoryTypeIndex;
+		temp.Dedicated			= VK_TRUE;
+		temp.Layout				= this->Layout[0][0];
+		memcpy(temp.DeviceUUID, IDProperties.deviceUUID, VK_UUID_SIZE);
+		return temp;
+	}
+
+	VkCommandBuffer image::release_external(device::qfs aQFS) {
+		VkCommandBuffer CommandBuffer = VK_NULL_HANDLE;
+		// Only the owning family can release, an unowned image has nothing to hand over.
+		if ((this->Context == nullptr) || (this->Handle == VK_NULL_HANDLE) || (this->Layout == NULL) || (this->Owner == -1) || (this->Owner != this->Context->qfi(aQFS))) return CommandBuffer;
+		return this->external_barrier(aQFS, this->Owner, VK_QUEUE_FAMILY_EXTERNAL);
+	}
+
+	VkCommandBuffer image::acquire_external(device::qfs aQFS) {
+		VkCommandBuffer CommandBuffer = VK_NULL_HANDLE;
+		if ((this->Context == nullptr) || (this->Handle == VK_NULL_HANDLE) || (this->Layout == NULL) || (this->Context->qfi(aQFS) == -1)) return CommandBuffer;
+		return this->external_barrier(aQFS, VK_QUEUE_FAMILY_EXTERNAL, this->Context->qfi(aQFS));
+	}
+
 	VkImageView image::view() {
 		// Change later after screwing with.
 		VkImageView temp = VK_NULL_HANDLE;
@@ -855,7 +1225,7 @@ namespace geodesuka::core::gcl {
 		ImageViewCreateInfo.subresourceRange.levelCount			= this->CreateInfo.mipLevels;
 		ImageViewCreateInfo.subresourceRange.baseArrayLayer		= 0;
 		ImageViewCreateInfo.subresourceRange.layerCount			= this->CreateInfo.arrayLayers;
-		VkResult Result = vkCreateImageView(this->Context->handle(), &ImageViewCreateInfo, NULL, &temp);
+		VkResult Result = this->Context->api().vkCreateImageView(this->Context->handle(), &ImageViewCreateInfo, NULL, &temp);
 		return temp;
 	}
 
@@ -928,14 +1298,72 @@ namespace geodesuka::core::gcl {
 		return MipLevelCount;
 	}
 
+	VkCommandBuffer image::external_barrier(device::qfs aQFS, uint32_t aSrcQFI, uint32_t aDstQFI) {
+		VkCommandBuffer CommandBuffer = VK_NULL_HANDLE;
+		VkResult Result = VkResult::VK_SUCCESS;
+		VkCommandBufferBeginInfo BeginInfo{};
+		std::vector<VkImageMemoryBarrier> Barrier;
+		bool isRelease = (aDstQFI == VK_QUEUE_FAMILY_EXTERNAL);
+
+		BeginInfo.sType									= VkStructureType::VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		BeginInfo.pNext									= NULL;
+		BeginInfo.flags									= 0;
+		BeginInfo.pInheritanceInfo						= NULL;
+
+		for (uint32_t i = 0; i < this->CreateInfo.mipLevels; i++) {
+			for (uint32_t j = 0; j < this->CreateInfo.arrayLayers; j++) {
+				// Contents of undefined subresources need not be preserved.
+				if (this->Layout[i][j] == VkImageLayout::VK_IMAGE_LAYOUT_UNDEFINED) continue;
+				// Release ignores dstAccessMask, acquire ignores srcAccessMask.
+				VkImageMemoryBarrier temp{};
+				temp.sType								= VkStructureType::VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+				temp.pNext								= NULL;
+				temp.srcAccessMask						= isRelease ? VkAccessFlagBits::VK_ACCESS_MEMORY_WRITE_BIT : 0;
+				temp.dstAccessMask						= isRelease ? 0 : (VkAccessFlagBits::VK_ACCESS_MEMORY_READ_BIT | VkAccessFlagBits::VK_ACCESS_MEMORY_WRITE_BIT);
+				temp.oldLayout							= this->Layout[i][j];
+				temp.newLayout							= this->Layout[i][j];
+				temp.srcQueueFamilyIndex				= aSrcQFI;
+				temp.dstQueueFamilyIndex				= aDstQFI;
+				temp.image								= this->Handle;
+				temp.subresourceRange.aspectMask		= image::aspect(this->CreateInfo.format);
+				temp.subresourceRange.baseMipLevel		= i;
+				temp.subresourceRange.levelCount		= 1;
+				temp.subresourceRange.baseArrayLayer	= j;
+				temp.subresourceRange.layerCount		= 1;
+				Barrier.push_back(temp);
+			}
+		}
+
+		// Owned by no family of this context until acquired again.
+		this->Owner = isRelease ? -1 : (int)aDstQFI;
+		if (Barrier.size() == 0) return CommandBuffer;
+
+		CommandBuffer = this->Context->create(aQFS);
+		if (CommandBuffer == VK_NULL_HANDLE) return CommandBuffer;
+		Result = this->Context->api().vkBeginCommandBuffer(CommandBuffer, &BeginInfo);
+
+		this->Context->api().vkCmdPipelineBarrier(CommandBuffer,
+			isRelease ? VkPipelineStageFlagBits::VK_PIPELINE_STAGE_ALL_COMMANDS_BIT : VkPipelineStageFlagBits::VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+			isRelease ? VkPipelineStageFlagBits::VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT : VkPipelineStageFlagBits::VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+			0,
+			0, NULL,
+			0, NULL,
+			Barrier.size(), Barrier.data()
+		);
+
+		Result = this->Context->api().vkEndCommandBuffer(CommandBuffer);
+
+		return CommandBuffer;
+	}
+
 	void image::pmclearall() {
 		if (this->Context != nullptr) {
 			if (this->Handle != VK_NULL_HANDLE) {
-				vkDestroyImage(this->Context->handle(), this->Handle, NULL);
+				this->Context->api().vkDestroyImage(this->Context->handle(), this->Handle, NULL);
 				this->Handle = VK_NULL_HANDLE;
 			}
 			if (this->MemoryHandle != VK_NULL_HANDLE) {
-				vkFreeMemory(this->Context->handle(), this->MemoryHandle, NULL);
+				this->Context->api().vkFreeMemory(this->Context->handle(), this->MemoryHandle, NULL);
 				this->MemoryHandle = VK_NULL_HANDLE;
 			}
 		}
@@ -952,6 +1380,8 @@ namespace geodesuka::core::gcl {
 		this->CreateInfo		= {};
 		this->AllocateInfo		= {};
 		this->MemoryType		= 0;
+		this->Owner				= -1;
+		this->isExportable		= false;
 		this->BytesPerPixel		= 0;
 		this->MemorySize		= 0;
 	}
@@ -960,6 +1390,23 @@ namespace geodesuka::core::gcl {
 		return (image::bitsperpixel(aFormat) / 8);
 	}
 
+	VkImageAspectFlags image::aspect(VkFormat aFormat) {
+		switch (aFormat) {
+		case VkFormat::VK_FORMAT_D16_UNORM:
+		case VkFormat::VK_FORMAT_X8_D24_UNORM_PACK32:
+		case VkFormat::VK_FORMAT_D32_SFLOAT:
+			return VkImageAspectFlagBits::VK_IMAGE_ASPECT_DEPTH_BIT;
+		case VkFormat::VK_FORMAT_S8_UINT:
+			return VkImageAspectFlagBits::VK_IMAGE_ASPECT_STENCIL_BIT;
+		case VkFormat::VK_FORMAT_D16_UNORM_S8_UINT:
+		case VkFormat::VK_FORMAT_D24_UNORM_S8_UINT:
+		case VkFormat::VK_FORMAT_D32_SFLOAT_S8_UINT:
+			return VkImageAspectFlagBits::VK_IMAGE_ASPECT_DEPTH_BIT | VkImageAspectFlagBits::VK_IMAGE_ASPECT_STENCIL_BIT;
+		default:
+			return VkImageAspectFlagBits::VK_IMAGE_ASPECT_COLOR_BIT;
+		}
+	}
+
 	// So gross.
 	// Group these later based on spec.
 	// https://www.khronos.org/registry/vulkan/specs/1.2-extensions/html/vkspec.html#texel-block-size
@@ -0,0 +1,174 @@
+#include <geodesuka/core/gcl/layout_cache.h>
+
+#include <algorithm>
+
+#include <geodesuka/core/gcl/context.h>
+#include <geodesuka/core/gcl/shader.h>
+
+namespace geodesuka::core::gcl {
+
+	layout_cache::layout::layout() {
+		this->Handle = VK_NULL_HANDLE;
+	}
+
+	layout_cache::layout_cache(context* aContext) {
+		this->Context = aContext;
+	}
+
+	layout_cache::~layout_cache() {
+		this->Mutex.lock();
+		for (auto it = this->PipelineLayout.begin(); it != this->PipelineLayout.end(); it++) {
+			this->Context->api().vkDestroyPipelineLayout(this->Context->handle(), it->second, NULL);
+		}
+		for (auto it = this->SetLayout.begin(); it != this->SetLayout.end(); it++) {
+			this->Context->api().vkDestroyDescriptorSetLayout(this->Context->handle(), it->second, NULL);
+		}
+		this->PipelineLayout.clear();
+		this->SetLayout.clear();
+		this->Mutex.unlock();
+		this->Context = nullptr;
+	}
+
+	VkDescriptorSetLayout layout_cache::set_layout(uint32_t aBindingCount, const VkDescriptorSetLayoutBinding* aBinding) {
+		VkDescriptorSetLayout Handle = VK_NULL_HANDLE;
+		if ((aBindingCount > 0) && (aBinding == NULL)) return Handle;
+
+		// Key is independent of binding order.
+		std::vector<VkDescriptorSetLayoutBinding> Binding(aBinding, aBinding + aBindingCount);
+		std::sort(Binding.begin(), Binding.end(), [](const VkDescriptorSetLayoutBinding& A, const VkDescriptorSetLayoutBinding& B) { return A.binding < B.binding; });
+
+		std::string Key;
+		for (size_t i = 0; i < Binding.size(); i++) {
+			uint32_t Field[4] = { Binding[i].binding, (uint32_t)Binding[i].descriptorType, Binding[i].descriptorCount, Binding[i].stageFlags };
+			Key.append((const char*)Field, sizeof(Field));
+			Binding[i].pImmutableSamplers = NULL;
+		}
+
+		this->Mutex.lock();
+		auto it = this->SetLayout.find(Key);
+		if (it != this->SetLayout.end()) {
+			Handle = it->second;
+		}
+		else {
+			VkDescriptorSetLayoutCreateInfo CreateInfo{};
+			CreateInfo.sType			= VkStructureType::VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+			CreateInfo.pNext			= NULL;
+			CreateInfo.flags			= 0;
+			CreateInfo.bindingCount		= (uint32_t)Binding.size();
+			CreateInfo.pBindings		= Binding.data();
+			if (this->Context->api().vkCreateDescriptorSetLayout(this->Context->handle(), &CreateInfo, NULL, &Handle) == VkResult::VK_SUCCESS) {
+				this->SetLayout[Key] = Handle;
+			}
+			else {
+				Handle = VK_NULL_HANDLE;
+			}
+		}
+		this->Mutex.unlock();
+
+		return Handle;
+	}
+
+	VkPipelineLayout layout_cache::pipeline_layout(uint32_t aSetLayoutCount, const VkDescriptorSetLayout* aSetLayout, uint32_t aRangeCount, const VkPushConstantRange* aRange) {
+		VkPipelineLayout Handle = VK_NULL_HANDLE;
+		if (((aSetLayoutCount > 0) && (aSetLayout == NULL)) || ((aRangeCount > 0) && (aRange == NULL))) return Handle;
+
+		std::string Key;
+		Key.append((const char*)&aSetLayoutCount, sizeof(uint32_t));
+		Key.append((const char*)aSetLayout, aSetLayoutCount * sizeof(VkDescriptorSetLayout));
+		Key.append((const char*)aRange, aRangeCount * sizeof(VkPushConstantRange));
+
+		this->Mutex.lock();
+		auto it = this->PipelineLayout.find(Key);
+		if (it != this->PipelineLayout.end()) {
+			Handle = it->second;
+		}
+		else {
+			VkPipelineLayoutCreateInfo CreateInfo{};
+			CreateInfo.sType					= VkStructureType::VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+			CreateInfo.pNext					= NULL;
+			CreateInfo.flags					= 0;
+			CreateInfo.setLayoutCount			= aSetLayoutCount;
+			CreateInfo.pSetLayouts				= aSetLayout;
+			CreateInfo.pushConstantRangeCount	= aRangeCount;
+			CreateInfo.pPushConstantRanges		= aRange;
+			if (this->Context->api().vkCreatePipelineLayout(this->Context->handle(), &CreateInfo, NULL, &Handle) == VkResult::VK_SUCCESS) {
+				this->PipelineLayout[Key] = Handle;
+			}
+			else {
+				Handle = VK_NULL_HANDLE;
+			}
+		}
+		this->Mutex.unlock();
+
+		return Handle;
+	}
+
+	VkResult layout_cache::merge(uint32_t aShaderCount, shader** aShader, layout& aLayout) {
+		aLayout = layout();
+		if ((aShaderCount > 0) && (aShader == NULL)) return VkResult::VK_ERROR_INITIALIZATION_FAILED;
+
+		// Set -> Binding -> Merged binding.
+		std::map<uint32_t, std::map<uint32_t, VkDescriptorSetLayoutBinding>> Set;
+		VkPushConstantRange Range{};
+		uint32_t RangeEnd = 0;
+		Range.offset = UINT32_MAX;
+
+		for (uint32_t i = 0; i < aShaderCount; i++) {
+			if (aShader[i] == nullptr) continue;
+			const shader_reflection& Reflection = aShader[i]->get_reflection();
+
+			for (size_t j = 0; j < Reflection.Binding.size(); j++) {
+				const shader_reflection::binding& Src = Reflection.Binding[j];
+				std::map<uint32_t, VkDescriptorSetLayoutBinding>& Dst = Set[Src.Set];
+				auto it = Dst.find(Src.Binding);
+				if (it == Dst.end()) {
+					VkDescriptorSetLayoutBinding Binding{};
+					Binding.binding				= Src.Binding;
+					Binding.descriptorType		= Src.Type;
+					Binding.descriptorCount		= Src.Count;
+					Binding.stageFlags			= Src.Stage;
+					Binding.pImmutableSamplers	= NULL;
+					Dst[Src.Binding] = Binding;
+				}
+				else {
+					// Same slot must describe the same resource in every stage.
+					if ((it->second.descriptorType != Src.Type) || (it->second.descriptorCount != Src.Count)) return VkResult::VK_ERROR_INITIALIZATION_FAILED;
+					it->second.stageFlags |= Src.Stage;
+				}
+			}
+
+			for (size_t j = 0; j < Reflection.PushConstant.size(); j++) {
+				const shader_reflection::push_constant& Src = Reflection.PushConstant[j];
+				Range.stageFlags |= Src.Stage;
+				if (Src.Offset < Range.offset) Range.offset = Src.Offset;
+				if (Src.Offset + Src.Size > RangeEnd) RangeEnd = Src.Offset + Src.Size;
+			}
+		}
+
+		// Dense set list, gaps get empty layouts.
+		uint32_t SetCount = Set.size() > 0 ? Set.rbegin()->first + 1 : 0;
+		aLayout.SetLayout.resize(SetCount);
+		for (uint32_t i = 0; i < SetCount; i++) {
+			std::vector<VkDescriptorSetLayoutBinding> Binding;
+			auto it = Set.find(i);
+			if (it != Set.end()) {
+				for (auto jt = it->second.begin(); jt != it->second.end(); jt++) {
+					Binding.push_back(jt->second);
+				}
+			}
+			aLayout.SetLayout[i] = this->set_layout((uint32_t)Binding.size(), Binding.data());
+			if (aLayout.SetLayout[i] == VK_NULL_HANDLE) return VkResult::VK_ERROR_INITIALIZATION_FAILED;
+		}
+
+		if (Range.stageFlags != 0) {
+			Range.size = RangeEnd - Range.offset;
+			aLayout.PushConstantRange.push_back(Range);
+		}
+
+		aLayout.Handle = this->pipeline_layout((uint32_t)aLayout.SetLayout.size(), aLayout.SetLayout.data(), (uint32_t)aLayout.PushConstantRange.size(), aLayout.PushConstantRange.data());
+		if (aLayout.Handle == VK_NULL_HANDLE) return VkResult::VK_ERROR_INITIALIZATION_FAILED;
+
+		return VkResult::VK_SUCCESS;
+	}
+
+}
@@ -64,11 +64,40 @@ namespace geodesuka::core {
 		return this->Position;
 	}
 
+	bool object_t::get_bounds(float3& aMin, float3& aMax) {
+		return false;
+	}
+
+	bool object_t::is_translucent() {
+		return false;
+	}
+
 	VkCommandBuffer object_t::draw(object::rendertarget* aRenderTarget) {
 		VkCommandBuffer DrawCommand = VK_NULL_HANDLE;
 		this->Mutex.lock();
-		if (DrawPack.count(aRenderTarget) > 0) {
-			DrawCommand = DrawPack[aRenderTarget]->Command[aRenderTarget->FrameDrawIndex];
+		auto it = DrawPack.find(aRenderTarget);
+		if (it != DrawPack.end()) {
+			gcl::drawpack* Pack = it->second;
+			uint32_t FrameIndex = aRenderTarget->FrameDrawIndex;
+			DrawCommand = Pack->Command[FrameIndex];
+			// Static commands are recorded once and resubmitted until dirty.
+			if (Pack->is_dirty(FrameIndex)) {
+				VkCommandBufferBeginInfo BeginInfo{};
+				BeginInfo.sType					= VkStructureType::VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+				BeginInfo.pNext					= NULL;
+				BeginInfo.flags					= 0;
+				BeginInfo.pInheritanceInfo		= NULL;
+				Pack->inherit(BeginInfo);
+
+				Pack->Pool->Mutex.lock();
+				if (Context->api().vkBeginCommandBuffer(DrawCommand, &BeginInfo) == VkResult::VK_SUCCESS) {
+					this->record(aRenderTarget, FrameIndex, DrawCommand);
+					if (Context->api().vkEndCommandBuffer(DrawCommand) == VkResult::VK_SUCCESS) {
+						Pack->recorded(FrameIndex);
+					}
+				}
+				Pack->Pool->Mutex.unlock();
+			}
 		}
 		this->Mutex.unlock();
 		return DrawCommand;
@@ -125,4 +154,23 @@ namespace geodesuka::core {
 		return ComputeBatch;
 	}
 
+	void object_t::record(object::rendertarget* aRenderTarget, uint32_t aFrameIndex, VkCommandBuffer aCommandBuffer) {
+
+	}
+
+	void object_t::invalidate_draw() {
+		// Drawpacks are only added on construction, no lock needed.
+		for (auto it = DrawPack.begin(); it != DrawPack.end(); it++) {
+			it->second->invalidate();
+		}
+	}
+
+	void object_t::enqueue(object::rendertarget* aRenderTarget, gcl::draw_queue* aQueue) {
+
+	}
+
+	void object_t::prepare(object::rendertarget* aRenderTarget, uint32_t aFrameIndex, VkCommandBuffer aCommandBuffer) {
+
+	}
+
 }
\ No newline at end of file
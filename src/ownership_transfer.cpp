@@ -0,0 +1,301 @@
+#include <geodesuka/core/gcl/ownership_transfer.h>
+
+#include <geodesuka/core/gcl/buffer.h>
+#include <geodesuka/core/gcl/image.h>
+
+namespace geodesuka::core::gcl {
+
+	ownership_transfer::ownership_transfer() {
+		this->Context			= nullptr;
+		this->SrcQFS			= device::qfs::TRANSFER;
+		this->DstQFS			= device::qfs::TRANSFER;
+		this->SrcQFI			= -1;
+		this->DstQFI			= -1;
+		this->SrcStage			= 0;
+		this->DstStage			= 0;
+		this->CommandBuffer[0]	= VK_NULL_HANDLE;
+		this->CommandBuffer[1]	= VK_NULL_HANDLE;
+		this->Semaphore			= VK_NULL_HANDLE;
+	}
+
+	ownership_transfer::ownership_transfer(context* aContext, device::qfs aSrcQFS, VkPipelineStageFlags aSrcStage, device::qfs aDstQFS, VkPipelineStageFlags aDstStage) {
+		this->Context			= aContext;
+		this->SrcQFS			= aSrcQFS;
+		this->DstQFS			= aDstQFS;
+		this->SrcQFI			= (aContext != nullptr) ? aContext->qfi(aSrcQFS) : -1;
+		this->DstQFI			= (aContext != nullptr) ? aContext->qfi(aDstQFS) : -1;
+		this->SrcStage			= aSrcStage;
+		this->DstStage			= aDstStage;
+		this->CommandBuffer[0]	= VK_NULL_HANDLE;
+		this->CommandBuffer[1]	= VK_NULL_HANDLE;
+		this->Semaphore			= VK_NULL_HANDLE;
+	}
+
+	ownership_transfer::~ownership_transfer() {
+		if (this->Context != nullptr) {
+			// Caller is responsible for insuring both submissions have completed.
+			if (this->CommandBuffer[0] != VK_NULL_HANDLE) {
+				this->Context->destroy(this->SrcQFS, this->CommandBuffer[0]);
+			}
+			if (this->CommandBuffer[1] != VK_NULL_HANDLE) {
+				this->Context->destroy(this->DstQFS, this->CommandBuffer[1]);
+			}
+			if (this->Semaphore != VK_NULL_HANDLE) {
+				this->Context->api().vkDestroySemaphore(this->Context->handle(), this->Semaphore, NULL);
+				this->Semaphore = VK_NULL_HANDLE;
+			}
+		}
+		this->Context = nullptr;
+	}
+
+	bool ownership_transfer::is_required() {
+		return ((this->SrcQFI != -1) && (this->DstQFI != -1) && (this->SrcQFI != this->DstQFI));
+	}
+
+	void ownership_transfer::add(buffer& aBuffer, VkAccessFlags aSrcAccess, VkAccessFlags aDstAccess) {
+		if ((this->Context == nullptr) || (aBuffer.Context != this->Context) || (aBuffer.Handle == VK_NULL_HANDLE)) return;
+		// Already owned by destination family, nothing to do.
+		if ((aBuffer.Owner == this->DstQFI) && (this->DstQFI != -1)) return;
+		// Never owned by any family, the first queue to use it acquires it implicitly.
+		if (aBuffer.Owner == -1) {
+			this->Buffer.push_back(&aBuffer);
+			return;
+		}
+
+		VkBufferMemoryBarrier temp{};
+		temp.sType						= VkStructureType::VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+		temp.pNext						= NULL;
+		temp.srcAccessMask				= aSrcAccess;
+		temp.dstAccessMask				= aDstAccess;
+		if (this->is_required()) {
+			temp.srcQueueFamilyIndex	= this->SrcQFI;
+			temp.dstQueueFamilyIndex	= this->DstQFI;
+		}
+		else {
+			temp.srcQueueFamilyIndex	= VK_QUEUE_FAMILY_IGNORED;
+			temp.dstQueueFamilyIndex	= VK_QUEUE_FAMILY_IGNORED;
+		}
+		temp.buffer						= aBuffer.Handle;
+		temp.offset						= 0;
+		temp.size						= VK_WHOLE_SIZE;
+		this->Buffer.push_back(&aBuffer);
+		this->BufferBarrier.push_back(temp);
+	}
+
+	void ownership_transfer::add(image& aImage, VkImageLayout aNewLayout, VkAccessFlags aSrcAccess, VkAccessFlags aDstAccess) {
+		if ((this->Context == nullptr) || (aImage.Context != this->Context) || (aImage.Handle == VK_NULL_HANDLE) || (aImage.Layout == NULL)) return;
+		if ((aImage.Owner == this->DstQFI) && (this->DstQFI != -1)) return;
+		// Never owned by any family, layouts are still transitioned on the acquire side.
+		bool isTransfer = this->is_required() && (aImage.Owner != -1);
+
+		for (uint32_t i = 0; i < aImage.CreateInfo.mipLevels; i++) {
+			for (uint32_t j = 0; j < aImage.CreateInfo.arrayLayers; j++) {
+				// Contents of undefined subresources need not be preserved,
+				// so they do not require an ownership transfer.
+				if (aImage.Layout[i][j] == VkImageLayout::VK_IMAGE_LAYOUT_UNDEFINED) continue;
+
+				VkImageMemoryBarrier temp{};
+				temp.sType								= VkStructureType::VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+				temp.pNext								= NULL;
+				temp.srcAccessMask						= aSrcAccess;
+				temp.dstAccessMask						= aDstAccess;
+				temp.oldLayout							= aImage.Layout[i][j];
+				temp.newLayout							= aNewLayout;
+				if (isTransfer) {
+					temp.srcQueueFamilyIndex			= this->SrcQFI;
+					temp.dstQueueFamilyIndex			= this->DstQFI;
+				}
+				else {
+					temp.srcQueueFamilyIndex			= VK_QUEUE_FAMILY_IGNORED;
+					temp.dstQueueFamilyIndex			= VK_QUEUE_FAMILY_IGNORED;
+				}
+				temp.image								= aImage.Handle;
+				temp.subresourceRange.aspectMask		= image::aspect(aImage.CreateInfo.format);
+				temp.subresourceRange.baseMipLevel		= i;
+				temp.subresourceRange.levelCount		= 1;
+				temp.subresourceRange.baseArrayLayer	= j;
+				temp.subresourceRange.layerCount		= 1;
+				this->ImageBarrier.push_back(temp);
+				this->ImageTarget.push_back(&aImage);
+			}
+		}
+		this->Image.push_back(&aImage);
+	}
+
+	void ownership_transfer::commit() {
+		// Tracked state follows what has executed, not what was queued.
+		for (size_t i = 0; i < this->Buffer.size(); i++) {
+			this->Buffer[i]->Owner = this->DstQFI;
+		}
+		for (size_t i = 0; i < this->ImageBarrier.size(); i++) {
+			const VkImageSubresourceRange& Range = this->ImageBarrier[i].subresourceRange;
+			this->ImageTarget[i]->Layout[Range.baseMipLevel][Range.baseArrayLayer] = this->ImageBarrier[i].newLayout;
+		}
+		for (size_t i = 0; i < this->Image.size(); i++) {
+			this->Image[i]->Owner = this->DstQFI;
+		}
+		this->Buffer.clear();
+		this->Image.clear();
+		this->ImageTarget.clear();
+	}
+
+	void ownership_transfer::release(VkCommandBuffer aCommandBuffer) {
+		// Nothing to release if the same family is used.
+		if ((aCommandBuffer == VK_NULL_HANDLE) || (!this->is_required())) return;
+		if ((this->BufferBarrier.size() == 0) && (this->ImageBarrier.size() == 0)) return;
+
+		// dstAccessMask is ignored for release operations. Barriers without a
+		// family transfer are only recorded on the acquire side.
+		std::vector<VkBufferMemoryBarrier> lBufferBarrier;
+		std::vector<VkImageMemoryBarrier> lImageBarrier;
+		for (size_t i = 0; i < this->BufferBarrier.size(); i++) {
+			if (this->BufferBarrier[i].srcQueueFamilyIndex == VK_QUEUE_FAMILY_IGNORED) continue;
+			lBufferBarrier.push_back(this->BufferBarrier[i]);
+			lBufferBarrier.back().dstAccessMask = 0;
+		}
+		for (size_t i = 0; i < this->ImageBarrier.size(); i++) {
+			if (this->ImageBarrier[i].srcQueueFamilyIndex == VK_QUEUE_FAMILY_IGNORED) continue;
+			lImageBarrier.push_back(this->ImageBarrier[i]);
+			lImageBarrier.back().dstAccessMask = 0;
+		}
+		if ((lBufferBarrier.size() == 0) && (lImageBarrier.size() == 0)) return;
+
+		this->Context->api().vkCmdPipelineBarrier(aCommandBuffer,
+			this->SrcStage,
+			VkPipelineStageFlagBits::VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+			0,
+			0, NULL,
+			lBufferBarrier.size(), lBufferBarrier.data(),
+			lImageBarrier.size(), lImageBarrier.data()
+		);
+	}
+
+	void ownership_transfer::acquire(VkCommandBuffer aCommandBuffer) {
+		if (aCommandBuffer == VK_NULL_HANDLE) return;
+		if ((this->BufferBarrier.size() == 0) && (this->ImageBarrier.size() == 0)) return;
+
+		if (this->is_required()) {
+			// srcAccessMask is ignored for acquire operations, and resources never
+			// owned by a family have no prior writes to make available.
+			std::vector<VkBufferMemoryBarrier> lBufferBarrier = this->BufferBarrier;
+			std::vector<VkImageMemoryBarrier> lImageBarrier = this->ImageBarrier;
+			for (size_t i = 0; i < lBufferBarrier.size(); i++) {
+				lBufferBarrier[i].srcAccessMask = 0;
+			}
+			for (size_t i = 0; i < lImageBarrier.size(); i++) {
+				lImageBarrier[i].srcAccessMask = 0;
+			}
+
+			this->Context->api().vkCmdPipelineBarrier(aCommandBuffer,
+				VkPipelineStageFlagBits::VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+				this->DstStage,
+				0,
+				0, NULL,
+				lBufferBarrier.size(), lBufferBarrier.data(),
+				lImageBarrier.size(), lImageBarrier.data()
+			);
+		}
+		else {
+			// Same family, plain memory dependency and layout transition.
+			this->Context->api().vkCmdPipelineBarrier(aCommandBuffer,
+				this->SrcStage,
+				this->DstStage,
+				0,
+				0, NULL,
+				this->BufferBarrier.size(), this->BufferBarrier.data(),
+				this->ImageBarrier.size(), this->ImageBarrier.data()
+			);
+		}
+	}
+
+	VkResult ownership_transfer::build() {
+		VkResult Result = VkResult::VK_INCOMPLETE;
+		if ((this->Context == nullptr) || (this->SrcQFI == -1) || (this->DstQFI == -1)) return Result;
+		// Already built.
+		if (this->Semaphore != VK_NULL_HANDLE) return VkResult::VK_SUCCESS;
+
+		VkSemaphoreCreateInfo SemaphoreCreateInfo{};
+		VkCommandBufferBeginInfo BeginInfo{};
+
+		SemaphoreCreateInfo.sType		= VkStructureType::VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+		SemaphoreCreateInfo.pNext		= NULL;
+		SemaphoreCreateInfo.flags		= 0;
+
+		BeginInfo.sType					= VkStructureType::VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		BeginInfo.pNext					= NULL;
+		BeginInfo.flags					= VkCommandBufferUsageFlagBits::VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+		BeginInfo.pInheritanceInfo		= NULL;
+
+		Result = this->Context->api().vkCreateSemaphore(this->Context->handle(), &SemaphoreCreateInfo, NULL, &this->Semaphore);
+		if (Result != VkResult::VK_SUCCESS) return Result;
+
+		this->CommandBuffer[0] = this->Context->create(this->SrcQFS);
+		this->CommandBuffer[1] = this->Context->create(this->DstQFS);
+		if ((this->CommandBuffer[0] == VK_NULL_HANDLE) || (this->CommandBuffer[1] == VK_NULL_HANDLE)) {
+			Result = VkResult::VK_ERROR_OUT_OF_DEVICE_MEMORY;
+		}
+
+		if (Result == VkResult::VK_SUCCESS) {
+			Result = this->Context->api().vkBeginCommandBuffer(this->CommandBuffer[0], &BeginInfo);
+		}
+		if (Result == VkResult::VK_SUCCESS) {
+			this->release(this->CommandBuffer[0]);
+			Result = this->Context->api().vkEndCommandBuffer(this->CommandBuffer[0]);
+		}
+		if (Result == VkResult::VK_SUCCESS) {
+			Result = this->Context->api().vkBeginCommandBuffer(this->CommandBuffer[1], &BeginInfo);
+		}
+		if (Result == VkResult::VK_SUCCESS) {
+			this->acquire(this->CommandBuffer[1]);
+			Result = this->Context->api().vkEndCommandBuffer(this->CommandBuffer[1]);
+		}
+
+		// Failed builds yield empty submissions, and can be retried.
+		if (Result != VkResult::VK_SUCCESS) {
+			if (this->CommandBuffer[0] != VK_NULL_HANDLE) {
+				this->Context->destroy(this->SrcQFS, this->CommandBuffer[0]);
+				this->CommandBuffer[0] = VK_NULL_HANDLE;
+			}
+			if (this->CommandBuffer[1] != VK_NULL_HANDLE) {
+				this->Context->destroy(this->DstQFS, this->CommandBuffer[1]);
+				this->CommandBuffer[1] = VK_NULL_HANDLE;
+			}
+			this->Context->api().vkDestroySemaphore(this->Context->handle(), this->Semaphore, NULL);
+			this->Semaphore = VK_NULL_HANDLE;
+		}
+
+		return Result;
+	}
+
+	VkSubmitInfo ownership_transfer::release() {
+		VkSubmitInfo temp{};
+		temp.sType						= VkStructureType::VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		temp.pNext						= NULL;
+		// Will be ignored by command_batch if not built.
+		if (this->Semaphore == VK_NULL_HANDLE) return temp;
+		temp.waitSemaphoreCount			= 0;
+		temp.pWaitSemaphores			= NULL;
+		temp.pWaitDstStageMask			= NULL;
+		temp.commandBufferCount			= 1;
+		temp.pCommandBuffers			= &this->CommandBuffer[0];
+		temp.signalSemaphoreCount		= 1;
+		temp.pSignalSemaphores			= &this->Semaphore;
+		return temp;
+	}
+
+	VkSubmitInfo ownership_transfer::acquire() {
+		VkSubmitInfo temp{};
+		temp.sType						= VkStructureType::VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		temp.pNext						= NULL;
+		if (this->Semaphore == VK_NULL_HANDLE) return temp;
+		temp.waitSemaphoreCount			= 1;
+		temp.pWaitSemaphores			= &this->Semaphore;
+		temp.pWaitDstStageMask			= &this->DstStage;
+		temp.commandBufferCount			= 1;
+		temp.pCommandBuffers			= &this->CommandBuffer[1];
+		temp.signalSemaphoreCount		= 0;
+		temp.pSignalSemaphores			= NULL;
+		return temp;
+	}
+
+}
@@ -1,5 +1,9 @@
 #include <geodesuka/core/gcl/pipeline.h>
 
+#include <stdlib.h>
+
+#include <geodesuka/core/gcl/pipeline_state_cache.h>
+
 namespace geodesuka::core::gcl {
 
 
@@ -17,36 +21,63 @@ namespace geodesuka::core::gcl {
 
 		VkResult Result = VkResult::VK_SUCCESS;
 
+		this->Context		= aContext;
+		this->ShaderCount	= aShaderCount;
+		this->Shader		= aShader;
+		this->ShaderStage	= NULL;
+		this->Handle		= VK_NULL_HANDLE;
+		if ((aContext == nullptr) || (aShaderCount == 0) || (aShader == nullptr)) return;
+
 		// Load shaders.
 		this->ShaderStage = (VkPipelineShaderStageCreateInfo*)malloc(this->ShaderCount * sizeof(VkPipelineShaderStageCreateInfo));
 		for (uint32_t i = 0; i < this->ShaderCount; i++) {
 			this->ShaderStage[i] = this->Shader[i].stageci();
 		}
 
-		VkDescriptorPoolCreateInfo DescriptorPoolCreateInfo{};
-		DescriptorPoolCreateInfo.sType				= VkStructureType::VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-		DescriptorPoolCreateInfo.pNext				= NULL;
-		DescriptorPoolCreateInfo.flags				= 0;
-		DescriptorPoolCreateInfo.maxSets			;
-		DescriptorPoolCreateInfo.poolSizeCount		;
-		DescriptorPoolCreateInfo.pPoolSizes			;
+		// Pipeline Layout, shared through context cache.
+		if (aDSLCount > 0) {
+			this->Layout.SetLayout = std::vector<VkDescriptorSetLayout>(aDSL, aDSL + aDSLCount);
+			this->Layout.Handle = this->Context->layouts()->pipeline_layout(aDSLCount, aDSL, 0, NULL);
+		}
+		else {
+			std::vector<shader*> ShaderList(this->ShaderCount);
+			for (uint32_t i = 0; i < this->ShaderCount; i++) {
+				ShaderList[i] = &this->Shader[i];
+			}
+			Result = this->Context->layouts()->merge(this->ShaderCount, ShaderList.data(), this->Layout);
+		}
+		if ((Result != VkResult::VK_SUCCESS) || (this->Layout.Handle == VK_NULL_HANDLE)) return;
 
-		// Create Pipeline Layout.
-		this->LayoutCreateInfo.sType					= VkStructureType::VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-		this->LayoutCreateInfo.pNext					= NULL;
-		this->LayoutCreateInfo.flags					= 0;
-		this->LayoutCreateInfo.setLayoutCount			= aDSLCount;
-		this->LayoutCreateInfo.pSetLayouts				= aDSL;
-		this->LayoutCreateInfo.pushConstantRangeCount	= 0;
-		this->LayoutCreateInfo.pPushConstantRanges		= NULL;
-		Result = vkCreatePipelineLayout(this->Context->handle(), &this->LayoutCreateInfo, NULL, &this->Layout);
+		this->GraphicsCreateInfo.stageCount		= this->ShaderCount;
+		this->GraphicsCreateInfo.pStages		= this->ShaderStage;
+		this->GraphicsCreateInfo.layout			= this->Layout.Handle;
+		this->GraphicsCreateInfo.renderPass		= aRenderPass.handle();
+		this->GraphicsCreateInfo.subpass		= aSubpassIndex;
 
+		this->Handle = this->Context->pipelines()->acquire(this->GraphicsCreateInfo);
+	}
 
+	pipeline::~pipeline() {
+		// Shared pipeline, layout is owned by the layout cache.
+		if ((this->Context != nullptr) && (this->Handle != VK_NULL_HANDLE)) {
+			this->Context->pipelines()->release(this->Handle);
+		}
+		free(this->ShaderStage);
+		this->ShaderStage = NULL;
+		this->Handle = VK_NULL_HANDLE;
+		this->Context = nullptr;
+	}
 
+	bool pipeline::is_valid() {
+		return this->Handle != VK_NULL_HANDLE;
 	}
 
-	pipeline::~pipeline() {
+	VkPipeline pipeline::handle() {
+		return this->Handle;
+	}
 
+	VkPipelineLayout pipeline::layout() {
+		return this->Layout.Handle;
 	}
 
 	void pipeline::gdefault() {
@@ -68,7 +99,7 @@ namespace geodesuka::core::gcl {
 		this->GraphicsCreateInfo.renderPass				= VK_NULL_HANDLE;
 		this->GraphicsCreateInfo.subpass				= 0;
 		this->GraphicsCreateInfo.basePipelineHandle		= VK_NULL_HANDLE;
-		this->GraphicsCreateInfo.basePipelineIndex		= 0;
+		this->GraphicsCreateInfo.basePipelineIndex		= -1;
 
 		this->VertexInput.sType = VkStructureType::VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
 		this->VertexInput.pNext = NULL;
@@ -77,6 +108,8 @@ namespace geodesuka::core::gcl {
 		this->InputAssembly.sType = VkStructureType::VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
 		this->InputAssembly.pNext = NULL;
 		this->InputAssembly.flags = 0;
+		this->InputAssembly.topology = VkPrimitiveTopology::VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+		this->InputAssembly.primitiveRestartEnable = VK_FALSE;
 
 		this->Tesselation.sType = VkStructureType::VK_STRUCTURE_TYPE_PIPELINE_TESSELLATION_STATE_CREATE_INFO;
 		this->Tesselation.pNext = NULL;
@@ -85,14 +118,24 @@ namespace geodesuka::core::gcl {
 		this->Viewport.sType = VkStructureType::VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
 		this->Viewport.pNext = NULL;
 		this->Viewport.flags = 0;
+		this->Viewport.viewportCount = 1;
+		this->Viewport.pViewports = NULL;
+		this->Viewport.scissorCount = 1;
+		this->Viewport.pScissors = NULL;
 
 		this->Rasterizer.sType = VkStructureType::VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
 		this->Rasterizer.pNext = NULL;
 		this->Rasterizer.flags = 0;
+		this->Rasterizer.polygonMode = VkPolygonMode::VK_POLYGON_MODE_FILL;
+		this->Rasterizer.cullMode = VkCullModeFlagBits::VK_CULL_MODE_NONE;
+		this->Rasterizer.frontFace = VkFrontFace::VK_FRONT_FACE_COUNTER_CLOCKWISE;
+		this->Rasterizer.lineWidth = 1.0f;
 
 		this->Multisample.sType = VkStructureType::VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
 		this->Multisample.pNext = NULL;
 		this->Multisample.flags = 0;
+		this->Multisample.rasterizationSamples = VkSampleCountFlagBits::VK_SAMPLE_COUNT_1_BIT;
+		this->Multisample.minSampleShading = 1.0f;
 
 		this->DepthStencil.sType = VkStructureType::VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
 		this->DepthStencil.pNext = NULL;
@@ -101,10 +144,19 @@ namespace geodesuka::core::gcl {
 		this->ColorBlend.sType = VkStructureType::VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
 		this->ColorBlend.pNext = NULL;
 		this->ColorBlend.flags = 0;
+		this->ColorBlend.attachmentCount = 1;
+		this->ColorBlend.pAttachments = &this->ColorBlendAttachment;
+
+		this->ColorBlendAttachment.blendEnable = VK_FALSE;
+		this->ColorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
 
 		this->DynamicState.sType = VkStructureType::VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
 		this->DynamicState.pNext = NULL;
 		this->DynamicState.flags = 0;
+		this->DynamicStateList[0] = VkDynamicState::VK_DYNAMIC_STATE_VIEWPORT;
+		this->DynamicStateList[1] = VkDynamicState::VK_DYNAMIC_STATE_SCISSOR;
+		this->DynamicState.dynamicStateCount = 2;
+		this->DynamicState.pDynamicStates = this->DynamicStateList;
 	}
 
 }
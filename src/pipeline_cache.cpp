@@ -0,0 +1,262 @@
+#include <geodesuka/core/gcl/pipeline_cache.h>
+
+#include <cstdio>
+#include <cstring>
+
+#include <filesystem>
+#include <chrono>
+
+#include <geodesuka/core/gcl/device.h>
+#include <geodesuka/core/gcl/context.h>
+
+namespace geodesuka::core::gcl {
+
+	// 'G' 'P' 'C' 'H'
+	static const uint32_t CacheMagic		= 0x48435047;
+	static const uint32_t CacheVersion		= 1;
+
+	std::mutex pipeline_cache::DirectoryMutex;
+	std::string pipeline_cache::Directory;
+	uint32_t pipeline_cache::TemporaryCount = 0;
+
+	static uint64_t fnv1a(const void* aData, size_t aSize) {
+		const unsigned char* Byte = (const unsigned char*)aData;
+		uint64_t Hash = 0xcbf29ce484222325ull;
+		for (size_t i = 0; i < aSize; i++) {
+			Hash ^= (uint64_t)Byte[i];
+			Hash *= 0x100000001b3ull;
+		}
+		return Hash;
+	}
+
+	pipeline_cache::pipeline_cache(context* aContext) {
+		this->Context = aContext;
+		this->Handle = VK_NULL_HANDLE;
+		if (aContext == nullptr) return;
+
+		VkPhysicalDeviceProperties Properties = this->Context->parent()->get_properties();
+		DirectoryMutex.lock();
+		if (Directory.size() > 0) {
+			char FileName[64];
+			snprintf(FileName, sizeof(FileName), "/%08x_%08x.bin", Properties.vendorID, Properties.deviceID);
+			this->Path = Directory + FileName;
+		}
+		DirectoryMutex.unlock();
+
+		std::vector<uint8_t> Data = load(this->Path, Properties);
+
+		VkPipelineCacheCreateInfo CreateInfo{};
+		CreateInfo.sType				= VkStructureType::VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+		CreateInfo.pNext				= NULL;
+		CreateInfo.flags				= 0;
+		CreateInfo.initialDataSize		= Data.size();
+		CreateInfo.pInitialData			= Data.size() > 0 ? Data.data() : NULL;
+
+		VkResult Result = this->Context->api().vkCreatePipelineCache(this->Context->handle(), &CreateInfo, NULL, &this->Handle);
+		if ((Result != VkResult::VK_SUCCESS) && (Data.size() > 0)) {
+			// Driver rejected data, start empty.
+			CreateInfo.initialDataSize	= 0;
+			CreateInfo.pInitialData		= NULL;
+			Result = this->Context->api().vkCreatePipelineCache(this->Context->handle(), &CreateInfo, NULL, &this->Handle);
+		}
+		if (Result != VkResult::VK_SUCCESS) {
+			this->Handle = VK_NULL_HANDLE;
+		}
+	}
+
+	pipeline_cache::~pipeline_cache() {
+		if ((this->Context != nullptr) && (this->Handle != VK_NULL_HANDLE)) {
+			this->save();
+			this->Context->api().vkDestroyPipelineCache(this->Context->handle(), this->Handle, NULL);
+		}
+		this->Context = nullptr;
+		this->Handle = VK_NULL_HANDLE;
+	}
+
+	VkPipelineCache pipeline_cache::handle() {
+		return this->Handle;
+	}
+
+	VkPipelineCache pipeline_cache::create_worker() {
+		VkPipelineCache Worker = VK_NULL_HANDLE;
+		if ((this->Context == nullptr) || (this->Handle == VK_NULL_HANDLE)) return Worker;
+
+		VkPipelineCacheCreateInfo CreateInfo{};
+		CreateInfo.sType				= VkStructureType::VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+		CreateInfo.pNext				= NULL;
+		CreateInfo.flags				= 0;
+		CreateInfo.initialDataSize		= 0;
+		CreateInfo.pInitialData			= NULL;
+
+		if (this->Context->api().vkCreatePipelineCache(this->Context->handle(), &CreateInfo, NULL, &Worker) != VkResult::VK_SUCCESS) {
+			Worker = VK_NULL_HANDLE;
+		}
+		return Worker;
+	}
+
+	VkResult pipeline_cache::merge(uint32_t aWorkerCount, VkPipelineCache* aWorker) {
+		VkResult Result = VkResult::VK_SUCCESS;
+		if ((this->Context == nullptr) || (this->Handle == VK_NULL_HANDLE) || (aWorkerCount == 0) || (aWorker == NULL)) return VkResult::VK_INCOMPLETE;
+
+		std::vector<VkPipelineCache> Source;
+		for (uint32_t i = 0; i < aWorkerCount; i++) {
+			if (aWorker[i] != VK_NULL_HANDLE) {
+				Source.push_back(aWorker[i]);
+			}
+		}
+
+		if (Source.size() > 0) {
+			Result = this->Context->api().vkMergePipelineCaches(this->Context->handle(), this->Handle, (uint32_t)Source.size(), Source.data());
+		}
+
+		for (uint32_t i = 0; i < aWorkerCount; i++) {
+			if (aWorker[i] != VK_NULL_HANDLE) {
+				this->Context->api().vkDestroyPipelineCache(this->Context->handle(), aWorker[i], NULL);
+				aWorker[i] = VK_NULL_HANDLE;
+			}
+		}
+
+		return Result;
+	}
+
+	VkResult pipeline_cache::save() {
+		VkResult Result = VkResult::VK_SUCCESS;
+		if ((this->Context == nullptr) || (this->Handle == VK_NULL_HANDLE) || (this->Path.size() == 0)) return VkResult::VK_INCOMPLETE;
+
+		// Merge with what is on disk now, another context or process may have saved since load.
+		std::vector<uint8_t> Disk = load(this->Path, this->Context->parent()->get_properties());
+
+		VkPipelineCacheCreateInfo CreateInfo{};
+		CreateInfo.sType				= VkStructureType::VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+		CreateInfo.pNext				= NULL;
+		CreateInfo.flags				= 0;
+		CreateInfo.initialDataSize		= Disk.size();
+		CreateInfo.pInitialData			= Disk.size() > 0 ? Disk.data() : NULL;
+
+		VkPipelineCache Merged = VK_NULL_HANDLE;
+		Result = this->Context->api().vkCreatePipelineCache(this->Context->handle(), &CreateInfo, NULL, &Merged);
+		if ((Result != VkResult::VK_SUCCESS) && (Disk.size() > 0)) {
+			CreateInfo.initialDataSize	= 0;
+			CreateInfo.pInitialData		= NULL;
+			Result = this->Context->api().vkCreatePipelineCache(this->Context->handle(), &CreateInfo, NULL, &Merged);
+		}
+		if (Result != VkResult::VK_SUCCESS) return Result;
+
+		// Source cache is not externally synchronized, Handle stays usable by other threads.
+		Result = this->Context->api().vkMergePipelineCaches(this->Context->handle(), Merged, 1, &this->Handle);
+
+		size_t DataSize = 0;
+		std::vector<uint8_t> Data;
+		if (Result == VkResult::VK_SUCCESS) {
+			Result = this->Context->api().vkGetPipelineCacheData(this->Context->handle(), Merged, &DataSize, NULL);
+		}
+		if ((Result == VkResult::VK_SUCCESS) && (DataSize > 0)) {
+			Data.resize(DataSize);
+			Result = this->Context->api().vkGetPipelineCacheData(this->Context->handle(), Merged, &DataSize, Data.data());
+			Data.resize(DataSize);
+		}
+		this->Context->api().vkDestroyPipelineCache(this->Context->handle(), Merged, NULL);
+		if ((Result != VkResult::VK_SUCCESS) || (Data.size() == 0)) return Result;
+
+		if (!write(this->Path, Data)) return VkResult::VK_ERROR_INITIALIZATION_FAILED;
+
+		return VkResult::VK_SUCCESS;
+	}
+
+	void pipeline_cache::set_directory(const char* aDirectory) {
+		DirectoryMutex.lock();
+		if (aDirectory != NULL) {
+			Directory = aDirectory;
+		}
+		else {
+			Directory.clear();
+		}
+		DirectoryMutex.unlock();
+	}
+
+	std::vector<uint8_t> pipeline_cache::load(const std::string& aPath, const VkPhysicalDeviceProperties& aProperties) {
+		std::vector<uint8_t> Data;
+		if (aPath.size() == 0) return Data;
+
+		std::error_code ErrorCode;
+		uintmax_t FileSize = std::filesystem::file_size(aPath, ErrorCode);
+		if (ErrorCode) return Data;
+		FILE* File = fopen(aPath.c_str(), "rb");
+		if (File == NULL) return Data;
+
+		header Header{};
+		bool isValid = (FileSize >= sizeof(header)) && (fread(&Header, sizeof(header), 1, File) == 1);
+		isValid = isValid && (Header.Magic == CacheMagic) && (Header.Version == CacheVersion) && (Header.DataSize > 0);
+		// Data size is checked against the file size before anything is allocated from it.
+		isValid = isValid && (FileSize - sizeof(header) == Header.DataSize);
+		if (isValid) {
+			Data.resize(Header.DataSize);
+			isValid = (fread(Data.data(), sizeof(uint8_t), Data.size(), File) == Data.size());
+		}
+		isValid = isValid && (fgetc(File) == EOF);
+		fclose(File);
+
+		isValid = isValid && (fnv1a(Data.data(), Data.size()) == Header.Checksum) && is_compatible(Data, aProperties);
+
+		if (!isValid) {
+			Data.clear();
+			std::remove(aPath.c_str());
+		}
+		return Data;
+	}
+
+	bool pipeline_cache::write(const std::string& aPath, const std::vector<uint8_t>& aData) {
+		if ((aPath.size() == 0) || (aData.size() == 0)) return false;
+
+		std::error_code ErrorCode;
+		std::filesystem::create_directories(std::filesystem::path(aPath).parent_path(), ErrorCode);
+
+		header Header{};
+		Header.Magic		= CacheMagic;
+		Header.Version		= CacheVersion;
+		Header.DataSize		= aData.size();
+		Header.Checksum		= fnv1a(aData.data(), aData.size());
+
+		// Written to temporary file first so a crash never leaves a partial cache.
+		// Unique per process and per call, contexts on the same device share a path.
+		char Suffix[96];
+		DirectoryMutex.lock();
+		snprintf(Suffix, sizeof(Suffix), ".%llx.%u.tmp", (unsigned long long)std::chrono::high_resolution_clock::now().time_since_epoch().count(), TemporaryCount++);
+		DirectoryMutex.unlock();
+		std::string TemporaryPath = aPath + Suffix;
+		FILE* File = fopen(TemporaryPath.c_str(), "wb");
+		if (File == NULL) return false;
+		bool isWritten = (fwrite(&Header, sizeof(header), 1, File) == 1);
+		isWritten = isWritten && (fwrite(aData.data(), sizeof(uint8_t), aData.size(), File) == aData.size());
+		isWritten = (fclose(File) == 0) && isWritten;
+
+		if (isWritten) {
+			std::filesystem::rename(TemporaryPath, aPath, ErrorCode);
+		}
+		if ((!isWritten) || (ErrorCode)) {
+			std::remove(TemporaryPath.c_str());
+			return false;
+		}
+		return true;
+	}
+
+	bool pipeline_cache::is_compatible(const std::vector<uint8_t>& aData, const VkPhysicalDeviceProperties& aProperties) {
+		// VkPipelineCacheHeaderVersionOne
+		const size_t HeaderSize = 16 + VK_UUID_SIZE;
+		if (aData.size() < HeaderSize) return false;
+
+		uint32_t Length, Version, VendorID, DeviceID;
+		memcpy(&Length,		&aData[0],	sizeof(uint32_t));
+		memcpy(&Version,	&aData[4],	sizeof(uint32_t));
+		memcpy(&VendorID,	&aData[8],	sizeof(uint32_t));
+		memcpy(&DeviceID,	&aData[12],	sizeof(uint32_t));
+
+		return
+			(Length >= HeaderSize) &&
+			(Version == VkPipelineCacheHeaderVersion::VK_PIPELINE_CACHE_HEADER_VERSION_ONE) &&
+			(VendorID == aProperties.vendorID) &&
+			(DeviceID == aProperties.deviceID) &&
+			(memcmp(&aData[16], aProperties.pipelineCacheUUID, VK_UUID_SIZE) == 0);
+	}
+
+}
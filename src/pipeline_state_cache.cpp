@@ -0,0 +1,573 @@
+#include <geodesuka/core/gcl/pipeline_state_cache.h>
+
+#include <cstring>
+
+#include <geodesuka/core/gcl/context.h>
+#include <geodesuka/core/gcl/pipeline_cache.h>
+
+namespace geodesuka::core::gcl {
+
+	// Appends raw bytes of a value to a key, only used for types without padding.
+	template<typename T>
+	static void put(std::string& aKey, const T& aValue) {
+		aKey.append((const char*)&aValue, sizeof(T));
+	}
+
+	static void put(std::string& aKey, const void* aData, size_t aSize) {
+		put(aKey, (uint64_t)aSize);
+		if ((aData != NULL) && (aSize > 0)) {
+			aKey.append((const char*)aData, aSize);
+		}
+	}
+
+	// Dynamic rendering pipelines carry their attachment formats as the only pNext struct.
+	static const void* rendering_of(const VkGraphicsPipelineCreateInfo& aCreateInfo) {
+#ifdef VK_KHR_dynamic_rendering
+		const VkPipelineRenderingCreateInfoKHR* Rendering = (const VkPipelineRenderingCreateInfoKHR*)aCreateInfo.pNext;
+		if ((Rendering != NULL) && (Rendering->sType == VkStructureType::VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR) && (Rendering->pNext == NULL)) {
+			return Rendering;
+		}
+#endif
+		return NULL;
+	}
+
+	static void put_rendering(std::string& aKey, const VkGraphicsPipelineCreateInfo& aCreateInfo) {
+#ifdef VK_KHR_dynamic_rendering
+		const VkPipelineRenderingCreateInfoKHR* Rendering = (const VkPipelineRenderingCreateInfoKHR*)rendering_of(aCreateInfo);
+		if (Rendering != NULL) {
+			put(aKey, Rendering->viewMask);
+			put(aKey, Rendering->pColorAttachmentFormats, Rendering->colorAttachmentCount * sizeof(VkFormat));
+			put(aKey, Rendering->depthAttachmentFormat);
+			put(aKey, Rendering->stencilAttachmentFormat);
+			return;
+		}
+#endif
+		put(aKey, (uint32_t)UINT32_MAX);
+	}
+
+	pipeline_state_cache::pipeline_state_cache(context* aContext) {
+		this->Context = aContext;
+		this->UncachedCount = 0;
+		this->isLibraryEnabled = (aContext != nullptr) && aContext->is_pipeline_library_enabled();
+	}
+
+	pipeline_state_cache::~pipeline_state_cache() {
+		this->Mutex.lock();
+		for (auto it = this->Entry.begin(); it != this->Entry.end(); it++) {
+			if (it->second.Handle != VK_NULL_HANDLE) {
+				this->Context->api().vkDestroyPipeline(this->Context->handle(), it->second.Handle, NULL);
+			}
+		}
+		for (auto it = this->Library.begin(); it != this->Library.end(); it++) {
+			this->Context->api().vkDestroyPipeline(this->Context->handle(), it->second, NULL);
+		}
+		this->Entry.clear();
+		this->Key.clear();
+		this->Library.clear();
+		this->Mutex.unlock();
+		this->Context = nullptr;
+	}
+
+	VkPipeline pipeline_state_cache::acquire(const VkGraphicsPipelineCreateInfo& aCreateInfo) {
+		std::string Key;
+		bool isLinkable = key_of(aCreateInfo, Key);
+		if (!isLinkable) {
+			// Not keyable, unique key so it is still tracked by release().
+			Key = "uncached";
+			this->Mutex.lock();
+			put(Key, this->UncachedCount++);
+			this->Mutex.unlock();
+		}
+		// Discarded rasterization has no fragment parts to link.
+		isLinkable = isLinkable && (aCreateInfo.pRasterizationState != NULL) && (aCreateInfo.pRasterizationState->rasterizerDiscardEnable == VK_FALSE);
+		return this->acquire(Key, &aCreateInfo, NULL, isLinkable);
+	}
+
+	VkPipeline pipeline_state_cache::acquire(const VkComputePipelineCreateInfo& aCreateInfo) {
+		std::string Key;
+		if (!key_of(aCreateInfo, Key)) {
+			Key = "uncached";
+			this->Mutex.lock();
+			put(Key, this->UncachedCount++);
+			this->Mutex.unlock();
+		}
+		return this->acquire(Key, NULL, &aCreateInfo, false);
+	}
+
+	void pipeline_state_cache::release(VkPipeline aPipeline) {
+		if (aPipeline == VK_NULL_HANDLE) return;
+		this->Mutex.lock();
+		auto it = this->Key.find(aPipeline);
+		if (it != this->Key.end()) {
+			entry& Entry = this->Entry[it->second];
+			if (Entry.ReferenceCount > 0) {
+				Entry.ReferenceCount -= 1;
+			}
+		}
+		this->Mutex.unlock();
+	}
+
+	void pipeline_state_cache::trim() {
+		this->Mutex.lock();
+		for (auto it = this->Entry.begin(); it != this->Entry.end();) {
+			if ((it->second.isReady) && (it->second.ReferenceCount == 0)) {
+				if (it->second.Handle != VK_NULL_HANDLE) {
+					this->Key.erase(it->second.Handle);
+					this->Context->api().vkDestroyPipeline(this->Context->handle(), it->second.Handle, NULL);
+				}
+				it = this->Entry.erase(it);
+			}
+			else {
+				it++;
+			}
+		}
+		this->Mutex.unlock();
+	}
+
+	size_t pipeline_state_cache::size() {
+		this->Mutex.lock();
+		size_t Size = this->Entry.size();
+		this->Mutex.unlock();
+		return Size;
+	}
+
+	size_t pipeline_state_cache::library_count() {
+		this->Mutex.lock();
+		size_t Count = this->Library.size();
+		this->Mutex.unlock();
+		return Count;
+	}
+
+	void pipeline_state_cache::identify(VkShaderModule aModule, size_t aWordCount, const uint32_t* aWord) {
+		if ((aModule == VK_NULL_HANDLE) || (aWord == NULL)) return;
+		// Code id is a hash of the code, recreating a shader finds its old pipelines without keeping the code.
+		uint64_t Id = 0xcbf29ce484222325ull;
+		const unsigned char* Byte = (const unsigned char*)aWord;
+		for (size_t i = 0; i < aWordCount * sizeof(uint32_t); i++) {
+			Id ^= (uint64_t)Byte[i];
+			Id *= 0x100000001b3ull;
+		}
+		Id ^= (uint64_t)aWordCount;
+		this->ModuleMutex.lock();
+		this->Module[aModule] = Id;
+		this->ModuleMutex.unlock();
+	}
+
+	void pipeline_state_cache::forget(VkShaderModule aModule) {
+		this->ModuleMutex.lock();
+		this->Module.erase(aModule);
+		this->ModuleMutex.unlock();
+	}
+
+	VkPipeline pipeline_state_cache::acquire(const std::string& aKey, const VkGraphicsPipelineCreateInfo* aGraphics, const VkComputePipelineCreateInfo* aCompute, bool aLinkable) {
+		std::unique_lock<std::mutex> Lock(this->Mutex);
+
+		auto it = this->Entry.find(aKey);
+		if (it != this->Entry.end()) {
+			// Another thread is creating it.
+			this->Condition.wait(Lock, [&]() { return this->Entry[aKey].isReady; });
+			entry& Entry = this->Entry[aKey];
+			if (Entry.Handle != VK_NULL_HANDLE) {
+				Entry.ReferenceCount += 1;
+			}
+			return Entry.Handle;
+		}
+
+		// Reserve slot, create without holding the lock.
+		entry Pending;
+		Pending.Handle			= VK_NULL_HANDLE;
+		Pending.ReferenceCount	= 0;
+		Pending.isReady			= false;
+		this->Entry[aKey] = Pending;
+		Lock.unlock();
+
+		VkPipeline Handle = VK_NULL_HANDLE;
+		VkPipelineCache Cache = this->Context->cache() != nullptr ? this->Context->cache()->handle() : VK_NULL_HANDLE;
+		VkResult Result = VkResult::VK_SUCCESS;
+		if (aGraphics != NULL) {
+			if ((this->isLibraryEnabled) && (aLinkable)) {
+				Handle = this->link(*aGraphics, Cache);
+			}
+			// Monolithic fallback.
+			if (Handle == VK_NULL_HANDLE) {
+				Result = this->Context->api().vkCreateGraphicsPipelines(this->Context->handle(), Cache, 1, aGraphics, NULL, &Handle);
+			}
+		}
+		else {
+			Result = this->Context->api().vkCreateComputePipelines(this->Context->handle(), Cache, 1, aCompute, NULL, &Handle);
+		}
+		if (Result != VkResult::VK_SUCCESS) {
+			Handle = VK_NULL_HANDLE;
+		}
+
+		// Failed entries stay with a null handle until trim(), waiters see the failure.
+		Lock.lock();
+		entry& Entry = this->Entry[aKey];
+		Entry.Handle			= Handle;
+		Entry.ReferenceCount	= Handle != VK_NULL_HANDLE ? 1 : 0;
+		Entry.isReady			= true;
+		if (Handle != VK_NULL_HANDLE) {
+			this->Key[Handle] = aKey;
+		}
+		this->Condition.notify_all();
+		return Handle;
+	}
+
+	VkPipeline pipeline_state_cache::link(const VkGraphicsPipelineCreateInfo& aCreateInfo, VkPipelineCache aCache) {
+		VkPipeline Handle = VK_NULL_HANDLE;
+#ifdef VK_EXT_graphics_pipeline_library
+		VkPipeline Part[part::COUNT];
+		for (int i = 0; i < part::COUNT; i++) {
+			Part[i] = this->library(aCreateInfo, (part)i, aCache);
+			if (Part[i] == VK_NULL_HANDLE) return VK_NULL_HANDLE;
+		}
+
+		// Fast link, no link time optimization unless requested in flags.
+		VkPipelineLibraryCreateInfoKHR LibraryInfo{};
+		LibraryInfo.sType				= VkStructureType::VK_STRUCTURE_TYPE_PIPELINE_LIBRARY_CREATE_INFO_KHR;
+		LibraryInfo.pNext				= NULL;
+		LibraryInfo.libraryCount		= part::COUNT;
+		LibraryInfo.pLibraries			= Part;
+
+		VkGraphicsPipelineCreateInfo CreateInfo{};
+		CreateInfo.sType				= VkStructureType::VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+		CreateInfo.pNext				= &LibraryInfo;
+		CreateInfo.flags				= aCreateInfo.flags;
+		CreateInfo.layout				= aCreateInfo.layout;
+		CreateInfo.basePipelineHandle	= VK_NULL_HANDLE;
+		CreateInfo.basePipelineIndex	= -1;
+		if (this->Context->api().vkCreateGraphicsPipelines(this->Context->handle(), aCache, 1, &CreateInfo, NULL, &Handle) != VkResult::VK_SUCCESS) {
+			Handle = VK_NULL_HANDLE;
+		}
+#endif
+		return Handle;
+	}
+
+	VkPipeline pipeline_state_cache::library(const VkGraphicsPipelineCreateInfo& aCreateInfo, part aPart, VkPipelineCache aCache) {
+		VkPipeline Handle = VK_NULL_HANDLE;
+#ifdef VK_EXT_graphics_pipeline_library
+		std::string Key;
+		put(Key, aCreateInfo.flags);
+		if (!key_of(aCreateInfo, aPart, Key)) return VK_NULL_HANDLE;
+
+		this->Mutex.lock();
+		auto it = this->Library.find(Key);
+		if (it != this->Library.end()) {
+			Handle = it->second;
+		}
+		this->Mutex.unlock();
+		if (Handle != VK_NULL_HANDLE) return Handle;
+
+		const VkGraphicsPipelineLibraryFlagsEXT PartFlag[part::COUNT] = {
+			VkGraphicsPipelineLibraryFlagBitsEXT::VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT,
+			VkGraphicsPipelineLibraryFlagBitsEXT::VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT,
+			VkGraphicsPipelineLibraryFlagBitsEXT::VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT,
+			VkGraphicsPipelineLibraryFlagBitsEXT::VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT
+		};
+
+		VkGraphicsPipelineLibraryCreateInfoEXT LibraryInfo{};
+		LibraryInfo.sType				= VkStructureType::VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_LIBRARY_CREATE_INFO_EXT;
+		LibraryInfo.pNext				= aPart != part::VERTEX_INPUT ? (void*)rendering_of(aCreateInfo) : NULL;
+		LibraryInfo.flags				= PartFlag[aPart];
+
+		// Each part only receives the state it owns.
+		std::vector<VkPipelineShaderStageCreateInfo> Stage;
+		VkGraphicsPipelineCreateInfo CreateInfo{};
+		CreateInfo.sType				= VkStructureType::VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+		CreateInfo.pNext				= &LibraryInfo;
+		CreateInfo.flags				= aCreateInfo.flags | VkPipelineCreateFlagBits::VK_PIPELINE_CREATE_LIBRARY_BIT_KHR | VkPipelineCreateFlagBits::VK_PIPELINE_CREATE_RETAIN_LINK_TIME_OPTIMIZATION_INFO_BIT_EXT;
+		CreateInfo.pDynamicState		= aCreateInfo.pDynamicState;
+		CreateInfo.basePipelineHandle	= VK_NULL_HANDLE;
+		CreateInfo.basePipelineIndex	= -1;
+		switch (aPart) {
+		case part::VERTEX_INPUT:
+			CreateInfo.pVertexInputState		= aCreateInfo.pVertexInputState;
+			CreateInfo.pInputAssemblyState		= aCreateInfo.pInputAssemblyState;
+			break;
+		case part::PRE_RASTERIZATION:
+		case part::FRAGMENT_SHADER:
+			for (uint32_t i = 0; i < aCreateInfo.stageCount; i++) {
+				bool isFragment = (aCreateInfo.pStages[i].stage == VkShaderStageFlagBits::VK_SHADER_STAGE_FRAGMENT_BIT);
+				if (isFragment == (aPart == part::FRAGMENT_SHADER)) {
+					Stage.push_back(aCreateInfo.pStages[i]);
+				}
+			}
+			CreateInfo.stageCount				= (uint32_t)Stage.size();
+			CreateInfo.pStages					= Stage.data();
+			CreateInfo.layout					= aCreateInfo.layout;
+			CreateInfo.renderPass				= aCreateInfo.renderPass;
+			CreateInfo.subpass					= aCreateInfo.subpass;
+			if (aPart == part::PRE_RASTERIZATION) {
+				CreateInfo.pTessellationState	= aCreateInfo.pTessellationState;
+				CreateInfo.pViewportState		= aCreateInfo.pViewportState;
+				CreateInfo.pRasterizationState	= aCreateInfo.pRasterizationState;
+			}
+			else {
+				CreateInfo.pMultisampleState	= aCreateInfo.pMultisampleState;
+				CreateInfo.pDepthStencilState	= aCreateInfo.pDepthStencilState;
+			}
+			break;
+		case part::FRAGMENT_OUTPUT:
+			CreateInfo.pMultisampleState		= aCreateInfo.pMultisampleState;
+			CreateInfo.pColorBlendState			= aCreateInfo.pColorBlendState;
+			CreateInfo.renderPass				= aCreateInfo.renderPass;
+			CreateInfo.subpass					= aCreateInfo.subpass;
+			break;
+		default:
+			return VK_NULL_HANDLE;
+		}
+
+		if (this->Context->api().vkCreateGraphicsPipelines(this->Context->handle(), aCache, 1, &CreateInfo, NULL, &Handle) != VkResult::VK_SUCCESS) {
+			return VK_NULL_HANDLE;
+		}
+
+		// Another thread may have built the same part meanwhile, keep the first.
+		this->Mutex.lock();
+		auto jt = this->Library.find(Key);
+		if (jt != this->Library.end()) {
+			this->Context->api().vkDestroyPipeline(this->Context->handle(), Handle, NULL);
+			Handle = jt->second;
+		}
+		else {
+			this->Library[Key] = Handle;
+		}
+		this->Mutex.unlock();
+#endif
+		return Handle;
+	}
+
+	bool pipeline_state_cache::key_of(const VkGraphicsPipelineCreateInfo& aCreateInfo, std::string& aKey) {
+		if ((aCreateInfo.pNext != NULL) && (rendering_of(aCreateInfo) == NULL)) return false;
+
+		aKey.clear();
+		put(aKey, (uint32_t)VK_PIPELINE_BIND_POINT_GRAPHICS);
+		put(aKey, aCreateInfo.flags);
+		for (int i = 0; i < part::COUNT; i++) {
+			if (!key_of(aCreateInfo, (part)i, aKey)) return false;
+		}
+
+		return true;
+	}
+
+	bool pipeline_state_cache::key_of(const VkGraphicsPipelineCreateInfo& aCreateInfo, part aPart, std::string& aKey) {
+		put(aKey, (uint32_t)aPart);
+
+		// Every part sees the dynamic state list, it decides which fixed state is relevant.
+		bool isViewportDynamic = false;
+		bool isScissorDynamic = false;
+		if (aCreateInfo.pDynamicState != NULL) {
+			const VkPipelineDynamicStateCreateInfo& S = *aCreateInfo.pDynamicState;
+			if (S.pNext != NULL) return false;
+			put(aKey, S.dynamicStateCount);
+			for (uint32_t i = 0; i < S.dynamicStateCount; i++) {
+				put(aKey, S.pDynamicStates[i]);
+				isViewportDynamic |= (S.pDynamicStates[i] == VkDynamicState::VK_DYNAMIC_STATE_VIEWPORT);
+				isScissorDynamic |= (S.pDynamicStates[i] == VkDynamicState::VK_DYNAMIC_STATE_SCISSOR);
+			}
+		}
+		else {
+			put(aKey, (uint32_t)UINT32_MAX);
+		}
+
+		// Fragment stage belongs to the fragment shader part, all others to pre-rasterization.
+		if ((aPart == part::PRE_RASTERIZATION) || (aPart == part::FRAGMENT_SHADER)) {
+			for (uint32_t i = 0; i < aCreateInfo.stageCount; i++) {
+				bool isFragment = (aCreateInfo.pStages[i].stage == VkShaderStageFlagBits::VK_SHADER_STAGE_FRAGMENT_BIT);
+				if (isFragment != (aPart == part::FRAGMENT_SHADER)) continue;
+				if (!key_of(aCreateInfo.pStages[i], aKey)) return false;
+			}
+		}
+
+		switch (aPart) {
+		case part::VERTEX_INPUT:
+			if (aCreateInfo.pVertexInputState != NULL) {
+				const VkPipelineVertexInputStateCreateInfo& S = *aCreateInfo.pVertexInputState;
+				if (S.pNext != NULL) return false;
+				put(aKey, S.vertexBindingDescriptionCount);
+				for (uint32_t i = 0; i < S.vertexBindingDescriptionCount; i++) {
+					put(aKey, S.pVertexBindingDescriptions[i].binding);
+					put(aKey, S.pVertexBindingDescriptions[i].stride);
+					put(aKey, S.pVertexBindingDescriptions[i].inputRate);
+				}
+				put(aKey, S.vertexAttributeDescriptionCount);
+				for (uint32_t i = 0; i < S.vertexAttributeDescriptionCount; i++) {
+					put(aKey, S.pVertexAttributeDescriptions[i].location);
+					put(aKey, S.pVertexAttributeDescriptions[i].binding);
+					put(aKey, S.pVertexAttributeDescriptions[i].format);
+					put(aKey, S.pVertexAttributeDescriptions[i].offset);
+				}
+			}
+			else {
+				put(aKey, (uint32_t)UINT32_MAX);
+			}
+
+			if (aCreateInfo.pInputAssemblyState != NULL) {
+				const VkPipelineInputAssemblyStateCreateInfo& S = *aCreateInfo.pInputAssemblyState;
+				if (S.pNext != NULL) return false;
+				put(aKey, S.topology);
+				put(aKey, S.primitiveRestartEnable);
+			}
+			else {
+				put(aKey, (uint32_t)UINT32_MAX);
+			}
+			return true;
+		case part::PRE_RASTERIZATION:
+			if (aCreateInfo.pTessellationState != NULL) {
+				const VkPipelineTessellationStateCreateInfo& S = *aCreateInfo.pTessellationState;
+				if (S.pNext != NULL) return false;
+				put(aKey, S.patchControlPoints);
+			}
+			else {
+				put(aKey, (uint32_t)UINT32_MAX);
+			}
+
+			if (aCreateInfo.pViewportState != NULL) {
+				const VkPipelineViewportStateCreateInfo& S = *aCreateInfo.pViewportState;
+				if (S.pNext != NULL) return false;
+				put(aKey, S.viewportCount);
+				if ((!isViewportDynamic) && (S.pViewports != NULL)) {
+					put(aKey, S.pViewports, S.viewportCount * sizeof(VkViewport));
+				}
+				put(aKey, S.scissorCount);
+				if ((!isScissorDynamic) && (S.pScissors != NULL)) {
+					put(aKey, S.pScissors, S.scissorCount * sizeof(VkRect2D));
+				}
+			}
+			else {
+				put(aKey, (uint32_t)UINT32_MAX);
+			}
+
+			if (aCreateInfo.pRasterizationState != NULL) {
+				const VkPipelineRasterizationStateCreateInfo& S = *aCreateInfo.pRasterizationState;
+				if (S.pNext != NULL) return false;
+				put(aKey, S.depthClampEnable);
+				put(aKey, S.rasterizerDiscardEnable);
+				put(aKey, S.polygonMode);
+				put(aKey, S.cullMode);
+				put(aKey, S.frontFace);
+				put(aKey, S.depthBiasEnable);
+				put(aKey, S.depthBiasConstantFactor);
+				put(aKey, S.depthBiasClamp);
+				put(aKey, S.depthBiasSlopeFactor);
+				put(aKey, S.lineWidth);
+			}
+			else {
+				put(aKey, (uint32_t)UINT32_MAX);
+			}
+
+			put(aKey, aCreateInfo.layout);
+			put(aKey, aCreateInfo.renderPass);
+			put(aKey, aCreateInfo.subpass);
+			put_rendering(aKey, aCreateInfo);
+			return true;
+		case part::FRAGMENT_SHADER:
+		case part::FRAGMENT_OUTPUT:
+			if (aCreateInfo.pMultisampleState != NULL) {
+				const VkPipelineMultisampleStateCreateInfo& S = *aCreateInfo.pMultisampleState;
+				if (S.pNext != NULL) return false;
+				put(aKey, S.rasterizationSamples);
+				put(aKey, S.sampleShadingEnable);
+				put(aKey, S.minSampleShading);
+				if (S.pSampleMask != NULL) {
+					put(aKey, S.pSampleMask, ((S.rasterizationSamples + 31) / 32) * sizeof(VkSampleMask));
+				}
+				else {
+					put(aKey, NULL, 0);
+				}
+				put(aKey, S.alphaToCoverageEnable);
+				put(aKey, S.alphaToOneEnable);
+			}
+			else {
+				put(aKey, (uint32_t)UINT32_MAX);
+			}
+
+			if (aPart == part::FRAGMENT_SHADER) {
+				if (aCreateInfo.pDepthStencilState != NULL) {
+					const VkPipelineDepthStencilStateCreateInfo& S = *aCreateInfo.pDepthStencilState;
+					if (S.pNext != NULL) return false;
+					put(aKey, S.flags);
+					put(aKey, S.depthTestEnable);
+					put(aKey, S.depthWriteEnable);
+					put(aKey, S.depthCompareOp);
+					put(aKey, S.depthBoundsTestEnable);
+					put(aKey, S.stencilTestEnable);
+					put(aKey, S.front);
+					put(aKey, S.back);
+					put(aKey, S.minDepthBounds);
+					put(aKey, S.maxDepthBounds);
+				}
+				else {
+					put(aKey, (uint32_t)UINT32_MAX);
+				}
+				put(aKey, aCreateInfo.layout);
+			}
+			else {
+				if (aCreateInfo.pColorBlendState != NULL) {
+					const VkPipelineColorBlendStateCreateInfo& S = *aCreateInfo.pColorBlendState;
+					if (S.pNext != NULL) return false;
+					put(aKey, S.logicOpEnable);
+					put(aKey, S.logicOp);
+					put(aKey, S.attachmentCount);
+					for (uint32_t i = 0; i < S.attachmentCount; i++) {
+						put(aKey, S.pAttachments[i]);
+					}
+					put(aKey, S.blendConstants);
+				}
+				else {
+					put(aKey, (uint32_t)UINT32_MAX);
+				}
+			}
+
+			put(aKey, aCreateInfo.renderPass);
+			put(aKey, aCreateInfo.subpass);
+			put_rendering(aKey, aCreateInfo);
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	bool pipeline_state_cache::key_of(const VkComputePipelineCreateInfo& aCreateInfo, std::string& aKey) {
+		if (aCreateInfo.pNext != NULL) return false;
+		aKey.clear();
+		put(aKey, (uint32_t)VK_PIPELINE_BIND_POINT_COMPUTE);
+		put(aKey, aCreateInfo.flags);
+		if (!key_of(aCreateInfo.stage, aKey)) return false;
+		put(aKey, aCreateInfo.layout);
+		return true;
+	}
+
+	bool pipeline_state_cache::key_of(const VkPipelineShaderStageCreateInfo& aStage, std::string& aKey) {
+		if (aStage.pNext != NULL) return false;
+		put(aKey, aStage.flags);
+		put(aKey, aStage.stage);
+		// Code id when known, handles are reused after a module is destroyed.
+		this->ModuleMutex.lock();
+		auto it = this->Module.find(aStage.module);
+		if (it != this->Module.end()) {
+			put(aKey, (uint32_t)1);
+			put(aKey, it->second);
+		}
+		else {
+			put(aKey, (uint32_t)0);
+			put(aKey, aStage.module);
+		}
+		this->ModuleMutex.unlock();
+		put(aKey, aStage.pName, aStage.pName != NULL ? strlen(aStage.pName) : 0);
+		if (aStage.pSpecializationInfo != NULL) {
+			const VkSpecializationInfo& S = *aStage.pSpecializationInfo;
+			put(aKey, S.mapEntryCount);
+			for (uint32_t i = 0; i < S.mapEntryCount; i++) {
+				put(aKey, S.pMapEntries[i].constantID);
+				put(aKey, S.pMapEntries[i].offset);
+				put(aKey, (uint64_t)S.pMapEntries[i].size);
+			}
+			put(aKey, S.pData, S.dataSize);
+		}
+		else {
+			put(aKey, (uint32_t)UINT32_MAX);
+		}
+		return true;
+	}
+
+}
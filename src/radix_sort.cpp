@@ -0,0 +1,55 @@
+#include <geodesuka/core/logic/radix_sort.h>
+
+#if defined(_M_X64) || defined(__x86_64__) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)) || defined(__SSE2__)
+#define GEODESUKA_SORT_SSE
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define GEODESUKA_SORT_NEON
+#include <arm_neon.h>
+#endif
+
+namespace geodesuka::core::logic {
+
+	uint32_t radix_sort::depth_key(float aValue) {
+		uint32_t Bits;
+		memcpy(&Bits, &aValue, sizeof(uint32_t));
+		return Bits ^ ((uint32_t)((int32_t)Bits >> 31) | 0x80000000u);
+	}
+
+	void radix_sort::depth_keys(size_t aCount, const float* aX, const float* aY, const float* aZ, float3 aOrigin, float3 aForward, uint32_t* aKey) {
+		float Offset = aForward.x * aOrigin.x + aForward.y * aOrigin.y + aForward.z * aOrigin.z;
+		size_t i = 0;
+#if defined(GEODESUKA_SORT_SSE)
+		__m128 ForwardX = _mm_set1_ps(aForward.x);
+		__m128 ForwardY = _mm_set1_ps(aForward.y);
+		__m128 ForwardZ = _mm_set1_ps(aForward.z);
+		__m128 Origin = _mm_set1_ps(Offset);
+		__m128i Sign = _mm_set1_epi32((int)0x80000000);
+		for (; i + 4 <= aCount; i += 4) {
+			__m128 Depth = _mm_add_ps(_mm_mul_ps(ForwardX, _mm_loadu_ps(aX + i)), _mm_mul_ps(ForwardY, _mm_loadu_ps(aY + i)));
+			Depth = _mm_sub_ps(_mm_add_ps(Depth, _mm_mul_ps(ForwardZ, _mm_loadu_ps(aZ + i))), Origin);
+			__m128i Bits = _mm_castps_si128(Depth);
+			__m128i Mask = _mm_or_si128(_mm_srai_epi32(Bits, 31), Sign);
+			_mm_storeu_si128((__m128i*)(aKey + i), _mm_xor_si128(Bits, Mask));
+		}
+#elif defined(GEODESUKA_SORT_NEON)
+		float32x4_t ForwardX = vdupq_n_f32(aForward.x);
+		float32x4_t ForwardY = vdupq_n_f32(aForward.y);
+		float32x4_t ForwardZ = vdupq_n_f32(aForward.z);
+		float32x4_t Origin = vdupq_n_f32(Offset);
+		uint32x4_t Sign = vdupq_n_u32(0x80000000u);
+		for (; i + 4 <= aCount; i += 4) {
+			float32x4_t Depth = vaddq_f32(vmulq_f32(ForwardX, vld1q_f32(aX + i)), vmulq_f32(ForwardY, vld1q_f32(aY + i)));
+			Depth = vsubq_f32(vaddq_f32(Depth, vmulq_f32(ForwardZ, vld1q_f32(aZ + i))), Origin);
+			uint32x4_t Bits = vreinterpretq_u32_f32(Depth);
+			uint32x4_t Mask = vorrq_u32(vreinterpretq_u32_s32(vshrq_n_s32(vreinterpretq_s32_u32(Bits), 31)), Sign);
+			vst1q_u32(aKey + i, veorq_u32(Bits, Mask));
+		}
+#endif
+		// Remainder, and everything on other targets.
+		for (; i < aCount; i++) {
+			aKey[i] = depth_key((aForward.x * aX[i] + aForward.y * aY[i] + aForward.z * aZ[i]) - Offset);
+		}
+	}
+
+}
@@ -33,7 +33,7 @@ namespace geodesuka::core::gcl {
 
 
 
-			Result = vkCreateRenderPass(this->Context->handle(), &this->CreateInfo, NULL, &this->Handle);
+			Result = this->Context->api().vkCreateRenderPass(this->Context->handle(), &this->CreateInfo, NULL, &this->Handle);
 		}
 		else {
 
@@ -0,0 +1,257 @@
+#include <geodesuka/core/gcl/renderpass_cache.h>
+
+#include <geodesuka/core/gcl/context.h>
+
+namespace geodesuka::core::gcl {
+
+	// Appends raw bytes of a value to a key, only used for types without padding.
+	template<typename T>
+	static void put(std::string& aKey, const T& aValue) {
+		aKey.append((const char*)&aValue, sizeof(T));
+	}
+
+	static void put(std::string& aKey, uint32_t aCount, const VkAttachmentReference* aReference) {
+		put(aKey, aReference != NULL ? aCount : (uint32_t)UINT32_MAX);
+		if (aReference == NULL) return;
+		for (uint32_t i = 0; i < aCount; i++) {
+			put(aKey, aReference[i].attachment);
+			put(aKey, aReference[i].layout);
+		}
+	}
+
+	renderpass_cache::renderpass_cache(context* aContext) {
+		this->Context = aContext;
+		this->UncachedCount = 0;
+	}
+
+	renderpass_cache::~renderpass_cache() {
+		this->Mutex.lock();
+		for (auto it = this->Framebuffer.begin(); it != this->Framebuffer.end(); it++) {
+			this->Context->api().vkDestroyFramebuffer(this->Context->handle(), it->second.Handle, NULL);
+		}
+		for (auto it = this->Retired.begin(); it != this->Retired.end(); it++) {
+			this->Context->api().vkDestroyFramebuffer(this->Context->handle(), it->first, NULL);
+		}
+		for (auto it = this->RenderPass.begin(); it != this->RenderPass.end(); it++) {
+			this->Context->api().vkDestroyRenderPass(this->Context->handle(), it->second.Handle, NULL);
+		}
+		this->Framebuffer.clear();
+		this->FramebufferKey.clear();
+		this->Retired.clear();
+		this->RenderPass.clear();
+		this->RenderPassKey.clear();
+		this->Mutex.unlock();
+		this->Context = nullptr;
+	}
+
+	VkRenderPass renderpass_cache::acquire(const VkRenderPassCreateInfo& aCreateInfo) {
+		VkRenderPass Handle = VK_NULL_HANDLE;
+		std::string Key;
+		bool isShared = key_of(aCreateInfo, Key);
+
+		this->Mutex.lock();
+		if (!isShared) {
+			// Not keyable, unique key so it is still tracked by release().
+			Key = "uncached";
+			put(Key, this->UncachedCount++);
+		}
+
+		auto it = this->RenderPass.find(Key);
+		if (it != this->RenderPass.end()) {
+			it->second.ReferenceCount += 1;
+			Handle = it->second.Handle;
+			this->Mutex.unlock();
+			return Handle;
+		}
+
+		if (this->Context->api().vkCreateRenderPass(this->Context->handle(), &aCreateInfo, NULL, &Handle) != VkResult::VK_SUCCESS) {
+			Handle = VK_NULL_HANDLE;
+		}
+		if (Handle != VK_NULL_HANDLE) {
+			renderpass_entry Entry;
+			Entry.Handle			= Handle;
+			Entry.ReferenceCount	= 1;
+			Entry.isShared			= isShared;
+			this->RenderPass[Key] = Entry;
+			this->RenderPassKey[Handle] = Key;
+		}
+		this->Mutex.unlock();
+		return Handle;
+	}
+
+	VkFramebuffer renderpass_cache::acquire(const VkFramebufferCreateInfo& aCreateInfo) {
+		VkFramebuffer Handle = VK_NULL_HANDLE;
+		std::string Key;
+		bool isShared = key_of(aCreateInfo, Key);
+
+		this->Mutex.lock();
+		if (!isShared) {
+			Key = "uncached";
+			put(Key, this->UncachedCount++);
+		}
+
+		auto it = this->Framebuffer.find(Key);
+		if (it != this->Framebuffer.end()) {
+			it->second.ReferenceCount += 1;
+			Handle = it->second.Handle;
+			this->Mutex.unlock();
+			return Handle;
+		}
+
+		if (this->Context->api().vkCreateFramebuffer(this->Context->handle(), &aCreateInfo, NULL, &Handle) != VkResult::VK_SUCCESS) {
+			Handle = VK_NULL_HANDLE;
+		}
+		if (Handle != VK_NULL_HANDLE) {
+			framebuffer_entry Entry;
+			Entry.Handle			= Handle;
+			Entry.ReferenceCount	= 1;
+			if (aCreateInfo.pAttachments != NULL) {
+				Entry.View.assign(aCreateInfo.pAttachments, aCreateInfo.pAttachments + aCreateInfo.attachmentCount);
+			}
+			this->Framebuffer[Key] = Entry;
+			this->FramebufferKey[Handle] = Key;
+		}
+		this->Mutex.unlock();
+		return Handle;
+	}
+
+	void renderpass_cache::release(VkRenderPass aRenderPass) {
+		if (aRenderPass == VK_NULL_HANDLE) return;
+		this->Mutex.lock();
+		auto it = this->RenderPassKey.find(aRenderPass);
+		if (it != this->RenderPassKey.end()) {
+			renderpass_entry& Entry = this->RenderPass[it->second];
+			if (Entry.ReferenceCount > 0) {
+				Entry.ReferenceCount -= 1;
+			}
+			// Shared render passes stay, pipelines are keyed by their handle.
+			if ((!Entry.isShared) && (Entry.ReferenceCount == 0)) {
+				this->Context->api().vkDestroyRenderPass(this->Context->handle(), Entry.Handle, NULL);
+				this->RenderPass.erase(it->second);
+				this->RenderPassKey.erase(it);
+			}
+		}
+		this->Mutex.unlock();
+	}
+
+	void renderpass_cache::release(VkFramebuffer aFramebuffer) {
+		if (aFramebuffer == VK_NULL_HANDLE) return;
+		this->Mutex.lock();
+		auto it = this->FramebufferKey.find(aFramebuffer);
+		if (it != this->FramebufferKey.end()) {
+			framebuffer_entry& Entry = this->Framebuffer[it->second];
+			if (Entry.ReferenceCount > 0) {
+				Entry.ReferenceCount -= 1;
+			}
+			if (Entry.ReferenceCount == 0) {
+				this->Context->api().vkDestroyFramebuffer(this->Context->handle(), Entry.Handle, NULL);
+				this->Framebuffer.erase(it->second);
+				this->FramebufferKey.erase(it);
+			}
+		}
+		else {
+			auto jt = this->Retired.find(aFramebuffer);
+			if (jt != this->Retired.end()) {
+				if (jt->second > 0) {
+					jt->second -= 1;
+				}
+				if (jt->second == 0) {
+					this->Context->api().vkDestroyFramebuffer(this->Context->handle(), jt->first, NULL);
+					this->Retired.erase(jt);
+				}
+			}
+		}
+		this->Mutex.unlock();
+	}
+
+	void renderpass_cache::invalidate(uint32_t aImageViewCount, const VkImageView* aImageView) {
+		if ((aImageViewCount == 0) || (aImageView == NULL)) return;
+		this->Mutex.lock();
+		auto it = this->Framebuffer.begin();
+		while (it != this->Framebuffer.end()) {
+			bool isAffected = false;
+			for (size_t i = 0; (i < it->second.View.size()) && (!isAffected); i++) {
+				for (uint32_t j = 0; j < aImageViewCount; j++) {
+					if (it->second.View[i] == aImageView[j]) {
+						isAffected = true;
+						break;
+					}
+				}
+			}
+			if (!isAffected) {
+				it++;
+				continue;
+			}
+			// Holders still reference it, destroyed on their last release.
+			this->Retired[it->second.Handle] = it->second.ReferenceCount;
+			this->FramebufferKey.erase(it->second.Handle);
+			it = this->Framebuffer.erase(it);
+		}
+		this->Mutex.unlock();
+	}
+
+	size_t renderpass_cache::renderpass_count() {
+		this->Mutex.lock();
+		size_t Count = this->RenderPass.size();
+		this->Mutex.unlock();
+		return Count;
+	}
+
+	size_t renderpass_cache::framebuffer_count() {
+		this->Mutex.lock();
+		size_t Count = this->Framebuffer.size() + this->Retired.size();
+		this->Mutex.unlock();
+		return Count;
+	}
+
+	bool renderpass_cache::key_of(const VkRenderPassCreateInfo& aCreateInfo, std::string& aKey) {
+		if (aCreateInfo.pNext != NULL) return false;
+
+		aKey.clear();
+		put(aKey, aCreateInfo.flags);
+
+		// Formats, sample counts, load/store ops and layouts.
+		put(aKey, aCreateInfo.attachmentCount);
+		for (uint32_t i = 0; i < aCreateInfo.attachmentCount; i++) {
+			put(aKey, aCreateInfo.pAttachments[i]);
+		}
+
+		put(aKey, aCreateInfo.subpassCount);
+		for (uint32_t i = 0; i < aCreateInfo.subpassCount; i++) {
+			const VkSubpassDescription& S = aCreateInfo.pSubpasses[i];
+			put(aKey, S.flags);
+			put(aKey, S.pipelineBindPoint);
+			put(aKey, S.inputAttachmentCount, S.pInputAttachments);
+			put(aKey, S.colorAttachmentCount, S.pColorAttachments);
+			put(aKey, S.colorAttachmentCount, S.pResolveAttachments);
+			put(aKey, 1, S.pDepthStencilAttachment);
+			put(aKey, S.preserveAttachmentCount);
+			for (uint32_t j = 0; j < S.preserveAttachmentCount; j++) {
+				put(aKey, S.pPreserveAttachments[j]);
+			}
+		}
+
+		put(aKey, aCreateInfo.dependencyCount);
+		for (uint32_t i = 0; i < aCreateInfo.dependencyCount; i++) {
+			put(aKey, aCreateInfo.pDependencies[i]);
+		}
+		return true;
+	}
+
+	bool renderpass_cache::key_of(const VkFramebufferCreateInfo& aCreateInfo, std::string& aKey) {
+		if ((aCreateInfo.pNext != NULL) || (aCreateInfo.pAttachments == NULL)) return false;
+
+		aKey.clear();
+		put(aKey, aCreateInfo.flags);
+		put(aKey, aCreateInfo.renderPass);
+		put(aKey, aCreateInfo.attachmentCount);
+		for (uint32_t i = 0; i < aCreateInfo.attachmentCount; i++) {
+			put(aKey, aCreateInfo.pAttachments[i]);
+		}
+		put(aKey, aCreateInfo.width);
+		put(aKey, aCreateInfo.height);
+		put(aKey, aCreateInfo.layers);
+		return true;
+	}
+
+}
@@ -1,14 +1,36 @@
 #include <geodesuka/core/object/rendertarget.h>
 
+#include <vector>
+
+#include <assert.h>
+#include <string.h>
+
 namespace geodesuka::core::object {
 
-	rendertarget::~rendertarget() {
+	static bool is_depth_stencil(VkFormat aFormat) {
+		switch (aFormat) {
+		case VkFormat::VK_FORMAT_D16_UNORM:
+		case VkFormat::VK_FORMAT_X8_D24_UNORM_PACK32:
+		case VkFormat::VK_FORMAT_D32_SFLOAT:
+		case VkFormat::VK_FORMAT_S8_UINT:
+		case VkFormat::VK_FORMAT_D16_UNORM_S8_UINT:
+		case VkFormat::VK_FORMAT_D24_UNORM_S8_UINT:
+		case VkFormat::VK_FORMAT_D32_SFLOAT_S8_UINT:
+			return true;
+		default:
+			return false;
+		}
+	}
 
+	rendertarget::~rendertarget() {
+		this->clear_frame_pack();
+		// Shared, owned by the engine.
+		this->Recorder = nullptr;
 	}
 
 	rendertarget::rendertarget(engine* aEngine, gcl::context* aContext, stage_t* aStage/*, int aFrameCount, double aFrameRate*/) : 
 		object_t(aEngine, aContext, aStage), 
-		DrawCommandPool(aContext, 0, gcl::device::qfs::GRAPHICS_AND_COMPUTE)
+		DrawCommandPool(aContext, gcl::command_pool::RESET_COMMAND_BUFFER_BIT, gcl::device::qfs::GRAPHICS_AND_COMPUTE)
 	{
 
 		this->FrameCount = 0;
@@ -19,12 +41,41 @@ namespace geodesuka::core::object {
 		this->FrameAttachmentCount = 0;
 		this->FrameAttachmentDescription = NULL;
 		this->FrameAttachment = NULL;
+		this->FrameImage = NULL;
+		this->FrameAttachmentClearValue = NULL;
 
 		//this->FrameReadIndex = 0;
 		this->FrameDrawIndex = 0;
 
 		this->DrawCommandCount = NULL;
 		this->DrawCommandList = NULL;
+		this->FramePack = nullptr;
+		this->Recorder = nullptr;
+		this->NextLane = 0;
+		this->DrawQueue = nullptr;
+		this->QueuePack = nullptr;
+		this->BlendQueuePack = nullptr;
+	}
+
+	gcl::drawpack* rendertarget::frame_pack() {
+		return this->FramePack;
+	}
+
+	gcl::command_pool* rendertarget::draw_pool(uint32_t& aLane) {
+		if (this->Recorder == nullptr) {
+			aLane = 0;
+			return &this->DrawCommandPool;
+		}
+		aLane = this->NextLane.fetch_add(1) % this->Recorder->lane_count();
+		return this->Recorder->pool(this->Context, aLane);
+	}
+
+	gcl::draw_queue* rendertarget::queue() {
+		return this->DrawQueue;
+	}
+
+	float4x4 rendertarget::view_projection() {
+		return float4x4();
 	}
 
 	void rendertarget::next_frame() {
@@ -48,4 +99,191 @@ namespace geodesuka::core::object {
 		return PresentInfo;
 	}
 
+	void rendertarget::make_frame_pack() {
+		if ((this->FramePack != nullptr) || (this->FrameAttachmentCount == 0) || (this->FrameAttachmentDescription == NULL)) return;
+
+		std::vector<VkAttachmentReference> Color;
+		VkAttachmentReference DepthStencil{};
+		DepthStencil.attachment		= VK_ATTACHMENT_UNUSED;
+		DepthStencil.layout			= VkImageLayout::VK_IMAGE_LAYOUT_UNDEFINED;
+		for (int i = 0; i < this->FrameAttachmentCount; i++) {
+			VkAttachmentReference Reference{};
+			Reference.attachment = (uint32_t)i;
+			if (is_depth_stencil(this->FrameAttachmentDescription[i].format)) {
+				// Only the first one can be bound.
+				if (DepthStencil.attachment != VK_ATTACHMENT_UNUSED) continue;
+				Reference.layout = VkImageLayout::VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+				DepthStencil = Reference;
+			}
+			else {
+				Reference.layout = VkImageLayout::VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+				Color.push_back(Reference);
+			}
+		}
+
+		VkSubpassDescription Subpass{};
+		Subpass.flags						= 0;
+		Subpass.pipelineBindPoint			= VkPipelineBindPoint::VK_PIPELINE_BIND_POINT_GRAPHICS;
+		Subpass.inputAttachmentCount		= 0;
+		Subpass.pInputAttachments			= NULL;
+		Subpass.colorAttachmentCount		= (uint32_t)Color.size();
+		Subpass.pColorAttachments			= Color.size() > 0 ? Color.data() : NULL;
+		Subpass.pResolveAttachments			= NULL;
+		Subpass.pDepthStencilAttachment		= DepthStencil.attachment != VK_ATTACHMENT_UNUSED ? &DepthStencil : NULL;
+		Subpass.preserveAttachmentCount		= 0;
+		Subpass.pPreserveAttachments		= NULL;
+
+		VkSubpassDependency Dependency{};
+		Dependency.srcSubpass			= VK_SUBPASS_EXTERNAL;
+		Dependency.dstSubpass			= 0;
+		Dependency.srcStageMask			= VkPipelineStageFlagBits::VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VkPipelineStageFlagBits::VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+		Dependency.dstStageMask			= VkPipelineStageFlagBits::VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VkPipelineStageFlagBits::VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+		Dependency.srcAccessMask		= 0;
+		Dependency.dstAccessMask		= VkAccessFlagBits::VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VkAccessFlagBits::VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+		Dependency.dependencyFlags		= 0;
+
+		this->FramePack = new gcl::drawpack(this->Context, this, 1, &Subpass, 1, &Dependency);
+
+		// Workers are shared by every rendertarget of the engine.
+		if (this->Recorder == nullptr) {
+			this->Recorder = this->Engine->get_command_recorder();
+		}
+
+		// Borrows the frame scope, so made after it.
+		this->QueuePack = new gcl::drawpack(this->Context, this);
+		this->BlendQueuePack = new gcl::drawpack(this->Context, this);
+		this->DrawQueue = new gcl::draw_queue(this->Context, this->FrameCount, sizeof(float4x4), 1);
+	}
+
+	void rendertarget::clear_frame_pack() {
+		delete this->DrawQueue;
+		this->DrawQueue = nullptr;
+		delete this->QueuePack;
+		this->QueuePack = nullptr;
+		delete this->BlendQueuePack;
+		this->BlendQueuePack = nullptr;
+		delete this->FramePack;
+		this->FramePack = nullptr;
+	}
+
+	VkCommandBuffer rendertarget::record_frame(size_t aObjectCount, object_t** aObject) {
+		return this->record_frame(aObjectCount, aObject, aObjectCount);
+	}
+
+	VkCommandBuffer rendertarget::record_frame(size_t aObjectCount, object_t** aObject, size_t aOpaqueCount) {
+		if (this->FramePack == nullptr) return VK_NULL_HANDLE;
+
+		// Gather secondaries, objects without commands for this target are skipped.
+		// Two more for the opaque and blended packet secondaries.
+		void* nptr = realloc(this->DrawCommandList[this->FrameDrawIndex], (aObjectCount + 2) * sizeof(VkCommandBuffer));
+
+		// Check if NULL.
+		assert(nptr != NULL);
+
+		this->DrawCommandList[this->FrameDrawIndex] = (VkCommandBuffer*)nptr;
+		VkCommandBuffer* Secondary = this->DrawCommandList[this->FrameDrawIndex];
+		auto LaneOf = [&](size_t i) -> uint32_t {
+			// Drawpacks are only added on construction, read without lock.
+			auto it = aObject[i]->DrawPack.find(this);
+			return it != aObject[i]->DrawPack.end() ? it->second->Lane : (uint32_t)i;
+		};
+		// Packets are gathered on this thread, submission order stays deterministic.
+		this->DrawQueue->clear();
+		for (size_t i = 0; i < aObjectCount; i++) {
+			if ((object_t*)this == aObject[i]) continue;
+			aObject[i]->enqueue(this, this->DrawQueue);
+		}
+
+		auto Record = [&](size_t i) {
+			Secondary[i] = ((object_t*)this != aObject[i]) ? aObject[i]->draw(this) : VK_NULL_HANDLE;
+		};
+		if (this->Recorder != nullptr) {
+			this->Recorder->run(aObjectCount, LaneOf, Record);
+		}
+		else {
+			for (size_t i = 0; i < aObjectCount; i++) {
+				Record(i);
+			}
+		}
+
+		// Compacted in object order, independent of which lane recorded what.
+		uint32_t SecondaryCount = 0;
+		uint32_t OpaqueSecondaryCount = 0;
+		for (size_t i = 0; i < aObjectCount; i++) {
+			if (Secondary[i] == VK_NULL_HANDLE) continue;
+			Secondary[SecondaryCount] = Secondary[i];
+			SecondaryCount += 1;
+			OpaqueSecondaryCount += i < aOpaqueCount ? 1 : 0;
+		}
+
+		// Sorted packets are recorded every frame, instance data changes with them.
+		// Opaque packets follow opaque objects, blended packets go after everything.
+		this->DrawQueue->prepare(this->FrameDrawIndex);
+		VkCommandBuffer OpaqueQueueCommand = this->record_queue(this->QueuePack, gcl::draw_queue::OPAQUE, gcl::draw_queue::MASKED);
+		VkCommandBuffer BlendQueueCommand = this->record_queue(this->BlendQueuePack, gcl::draw_queue::TRANSLUCENT, gcl::draw_queue::OVERLAY);
+		if (OpaqueQueueCommand != VK_NULL_HANDLE) {
+			memmove(&Secondary[OpaqueSecondaryCount + 1], &Secondary[OpaqueSecondaryCount], (SecondaryCount - OpaqueSecondaryCount) * sizeof(VkCommandBuffer));
+			Secondary[OpaqueSecondaryCount] = OpaqueQueueCommand;
+			SecondaryCount += 1;
+		}
+		if (BlendQueueCommand != VK_NULL_HANDLE) {
+			Secondary[SecondaryCount] = BlendQueueCommand;
+			SecondaryCount += 1;
+		}
+		this->DrawCommandCount[this->FrameDrawIndex] = SecondaryCount;
+
+		// Re-recorded every frame, the pool resets command buffers individually.
+		VkCommandBuffer Primary = this->FramePack->Command[this->FrameDrawIndex];
+		VkCommandBufferBeginInfo BeginInfo{};
+		BeginInfo.sType					= VkStructureType::VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		BeginInfo.pNext					= NULL;
+		BeginInfo.flags					= VkCommandBufferUsageFlagBits::VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+		BeginInfo.pInheritanceInfo		= NULL;
+
+		// Cleared attachments need a value even if none was set.
+		std::vector<VkClearValue> ClearValue(this->FrameAttachmentCount);
+		for (int i = 0; i < this->FrameAttachmentCount; i++) {
+			ClearValue[i] = this->FrameAttachmentClearValue != NULL ? this->FrameAttachmentClearValue[i] : VkClearValue{};
+		}
+
+		this->DrawCommandPool.Mutex.lock();
+		this->Context->api().vkBeginCommandBuffer(Primary, &BeginInfo);
+		for (size_t i = 0; i < aObjectCount; i++) {
+			if ((object_t*)this == aObject[i]) continue;
+			aObject[i]->prepare(this, this->FrameDrawIndex, Primary);
+		}
+		this->FramePack->begin(Primary, this->FrameDrawIndex, (uint32_t)ClearValue.size(), ClearValue.data(), true);
+		if (SecondaryCount > 0) {
+			this->Context->api().vkCmdExecuteCommands(Primary, SecondaryCount, this->DrawCommandList[this->FrameDrawIndex]);
+		}
+		this->FramePack->end(Primary, this->FrameDrawIndex);
+		this->Context->api().vkEndCommandBuffer(Primary);
+		this->DrawCommandPool.Mutex.unlock();
+		return Primary;
+	}
+
+	VkCommandBuffer rendertarget::record_queue(gcl::drawpack* aPack, uint32_t aFirstPass, uint32_t aLastPass) {
+		if (this->DrawQueue->packet_count(aFirstPass, aLastPass) == 0) return VK_NULL_HANDLE;
+
+		VkCommandBuffer QueueCommand = aPack->Command[this->FrameDrawIndex];
+		VkCommandBufferBeginInfo QueueBeginInfo{};
+		QueueBeginInfo.sType				= VkStructureType::VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		QueueBeginInfo.pNext				= NULL;
+		QueueBeginInfo.flags				= VkCommandBufferUsageFlagBits::VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+		QueueBeginInfo.pInheritanceInfo		= NULL;
+		aPack->inherit(QueueBeginInfo);
+
+		VkCommandBuffer Recorded = VK_NULL_HANDLE;
+		aPack->Pool->Mutex.lock();
+		if (this->Context->api().vkBeginCommandBuffer(QueueCommand, &QueueBeginInfo) == VkResult::VK_SUCCESS) {
+			gcl::command_encoder Encoder(this->Context, QueueCommand);
+			this->DrawQueue->record(Encoder, this->FrameDrawIndex, aFirstPass, aLastPass);
+			if (this->Context->api().vkEndCommandBuffer(QueueCommand) == VkResult::VK_SUCCESS) {
+				Recorded = QueueCommand;
+			}
+		}
+		aPack->Pool->Mutex.unlock();
+		return Recorded;
+	}
+
 }
@@ -1,5 +1,12 @@
 #include <geodesuka/core/gcl/shader.h>
 
+#include <cstring>
+
+#include <string>
+
+#include <geodesuka/core/gcl/shader_cache.h>
+#include <geodesuka/core/gcl/pipeline_state_cache.h>
+
 #include <glslang/Public/ShaderLang.h>
 #include <glslang/Include/ResourceLimits.h>
 #include <StandAlone/ResourceLimits.h>
@@ -8,8 +15,21 @@
 
 namespace geodesuka::core::gcl {
 
-	shader::shader(context* aDeviceContext, stage aStage, const char* aSource) {
+	std::mutex shader::ProcessMutex;
+	int shader::ProcessCount = 0;
+
+	// Bump when compile options below change, invalidates cached binaries.
+	static const int CompileOptionVersion = 1;
+
+	static const uint32_t SPIRVMagic = 0x07230203;
+	// Highest SPIR-V version accepted by Vulkan 1.2.
+	static const uint32_t SPIRVMaxVersion = 0x00010500;
+
+	shader::shader(context* aDeviceContext, stage aStage, const char* aSource) : shader(aDeviceContext, aStage, aSource, 0, NULL) {}
+
+	shader::shader(context* aDeviceContext, stage aStage, const char* aSource, uint32_t aDefineCount, const char** aDefineList) {
 		this->ErrorCode = VkResult::VK_SUCCESS;
+		this->Handle = VK_NULL_HANDLE;
 
 		this->FileHandle = nullptr;
 		this->ParentDC = aDeviceContext;
@@ -52,7 +72,35 @@ namespace geodesuka::core::gcl {
 			break;
 		}
 
+		// Cache key covers source, stage, defines and compiler version.
+		uint64_t CacheKey = 0;
+		bool isCached = false;
 		if (this->isValid) {
+			std::string CompilerVersion = glslang::GetGlslVersionString();
+			CompilerVersion += " spv:" + std::to_string(spv::GetSpirvGeneratorVersion());
+			CompilerVersion += " opt:" + std::to_string(CompileOptionVersion);
+			CacheKey = shader_cache::hash(this->Stage, aSource, aDefineCount, aDefineList, CompilerVersion.c_str());
+			isCached = shader_cache::load(CacheKey, this->Binary);
+		}
+
+		if ((this->isValid) && (!isCached)) {
+
+			// Defines are injected as preamble.
+			std::string Preamble;
+			for (uint32_t i = 0; i < aDefineCount; i++) {
+				if (aDefineList[i] == NULL) continue;
+				const char* Equal = strchr(aDefineList[i], '=');
+				Preamble += "#define ";
+				if (Equal != NULL) {
+					Preamble.append(aDefineList[i], Equal - aDefineList[i]);
+					Preamble += " ";
+					Preamble += (Equal + 1);
+				}
+				else {
+					Preamble += aDefineList[i];
+				}
+				Preamble += "\n";
+			}
 
 			glslang::EShSource Source = glslang::EShSource::EShSourceGlsl;
 			glslang::EShClient Client = glslang::EShClient::EShClientVulkan;
@@ -86,17 +134,42 @@ namespace geodesuka::core::gcl {
 			lShader.setEnvClient(Client, ClientVersion);
 			lShader.setEnvTarget(TargetLanguage, TargetLanguageVersion);
 			lShader.setEntryPoint("main");
+			if (Preamble.size() > 0) {
+				lShader.setPreamble(Preamble.c_str());
+			}
 
 			//this->isValid = lShader.preprocess(&glslang::DefaultTBuiltInResource, DefaultVersion, ENoProfile, false, false, Options, NULL);
 			this->isValid = lShader.parse(&glslang::DefaultTBuiltInResource, DefaultVersion, false, Options);
+			if (!this->isValid) {
+				this->Log += lShader.getInfoLog();
+			}
 
 			glslang::TProgram Program;
-			Program.addShader(&lShader);
-			Program.link(Options);
-			//Program.buildReflection(EShReflectionDefault);
+			if (this->isValid) {
+				Program.addShader(&lShader);
+				this->isValid = Program.link(Options);
+				if (!this->isValid) {
+					this->Log += Program.getInfoLog();
+				}
+			}
+
+			if (this->isValid) {
+				glslang::GlslangToSpv(*Program.getIntermediate(lShaderStage), this->Binary, &SPIRVLogger, &SPIRVOption);
+				this->isValid = (this->Binary.size() > 0);
+				if (!this->isValid) {
+					this->Log += SPIRVLogger.getAllMessages();
+				}
+			}
+
+			if (this->isValid) {
+				shader_cache::store(CacheKey, this->Binary);
+			}
 
-			glslang::GlslangToSpv(*Program.getIntermediate(lShaderStage), this->Binary, &SPIRVLogger, &SPIRVOption);
+		}
 
+		// Reflected from binary so cached binaries are covered as well.
+		if (this->isValid) {
+			this->Reflection.reflect(this->VkStage, this->Binary.size(), this->Binary.data());
 		}
 
 		if (this->isValid) {
@@ -106,8 +179,78 @@ namespace geodesuka::core::gcl {
 			this->CreateInfo.codeSize = this->Binary.size() * sizeof(uint32_t);
 			this->CreateInfo.pCode = reinterpret_cast<const uint32_t*>(this->Binary.data());
 
-			this->ErrorCode = vkCreateShaderModule(this->ParentDC->handle(), &this->CreateInfo, NULL, &this->Handle);
+			this->ErrorCode = this->ParentDC->api().vkCreateShaderModule(this->ParentDC->handle(), &this->CreateInfo, NULL, &this->Handle);
 			if (this->ErrorCode != VkResult::VK_SUCCESS) this->isValid = false;
+			// Pipelines are shared by module content, not handle.
+			if ((this->isValid) && (this->ParentDC->pipelines() != nullptr)) {
+				this->ParentDC->pipelines()->identify(this->Handle, this->Binary.size(), (const uint32_t*)this->Binary.data());
+			}
+		}
+	}
+
+	shader::shader(context* aDeviceContext, stage aStage, size_t aWordCount, const uint32_t* aWord) {
+		this->ErrorCode = VkResult::VK_SUCCESS;
+		this->Handle = VK_NULL_HANDLE;
+
+		this->FileHandle = nullptr;
+		this->ParentDC = aDeviceContext;
+
+		this->Stage = aStage;
+		this->isValid = true;
+		switch (this->Stage) {
+		default:
+			this->Stage = UNKNOWN;
+			this->VkStage = (VkShaderStageFlagBits)0;
+			this->isValid = false;
+			break;
+		case VERTEX:
+			this->VkStage = VkShaderStageFlagBits::VK_SHADER_STAGE_VERTEX_BIT;
+			break;
+		case TESSELLATION_CONTROL:
+			this->VkStage = VkShaderStageFlagBits::VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT;
+			break;
+		case TESSELLATION_EVALUATION:
+			this->VkStage = VkShaderStageFlagBits::VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT;
+			break;
+		case GEOMETRY:
+			this->VkStage = VkShaderStageFlagBits::VK_SHADER_STAGE_GEOMETRY_BIT;
+			break;
+		case FRAGMENT:
+			this->VkStage = VkShaderStageFlagBits::VK_SHADER_STAGE_FRAGMENT_BIT;
+			break;
+		case COMPUTE:
+			this->VkStage = VkShaderStageFlagBits::VK_SHADER_STAGE_COMPUTE_BIT;
+			break;
+		}
+
+		if (this->isValid) {
+			this->isValid = validate(this->Stage, aWordCount, aWord, this->Log);
+		}
+
+		if (this->isValid) {
+			this->Binary = std::vector<unsigned int>(aWord, aWord + aWordCount);
+			this->isValid = this->Reflection.reflect(this->VkStage, this->Binary.size(), this->Binary.data());
+			if (!this->isValid) {
+				this->Log += "SPIR-V reflection failed.\n";
+			}
+		}
+
+		if (this->isValid) {
+			this->CreateInfo.sType = VkStructureType::VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+			this->CreateInfo.pNext = NULL;
+			this->CreateInfo.flags = 0;
+			this->CreateInfo.codeSize = this->Binary.size() * sizeof(uint32_t);
+			this->CreateInfo.pCode = reinterpret_cast<const uint32_t*>(this->Binary.data());
+
+			this->ErrorCode = this->ParentDC->api().vkCreateShaderModule(this->ParentDC->handle(), &this->CreateInfo, NULL, &this->Handle);
+			if (this->ErrorCode != VkResult::VK_SUCCESS) this->isValid = false;
+			// Pipelines are shared by module content, not handle.
+			if ((this->isValid) && (this->ParentDC->pipelines() != nullptr)) {
+				this->ParentDC->pipelines()->identify(this->Handle, this->Binary.size(), (const uint32_t*)this->Binary.data());
+			}
+		}
+		else {
+			this->ErrorCode = VkResult::VK_ERROR_INITIALIZATION_FAILED;
 		}
 	}
 
@@ -118,7 +261,12 @@ namespace geodesuka::core::gcl {
 		//this->VkStage		= (VkShaderStageFlagBits)0;
 		//this->isValid		= false;
 		this->Binary.clear();
-		vkDestroyShaderModule(this->ParentDC->handle(), this->Handle, NULL);
+		if ((this->ParentDC != nullptr) && (this->Handle != VK_NULL_HANDLE)) {
+			if (this->ParentDC->pipelines() != nullptr) {
+				this->ParentDC->pipelines()->forget(this->Handle);
+			}
+			this->ParentDC->api().vkDestroyShaderModule(this->ParentDC->handle(), this->Handle, NULL);
+		}
 	}
 
 	VkShaderStageFlagBits shader::get_stage() {
@@ -129,6 +277,18 @@ namespace geodesuka::core::gcl {
 		return this->Handle;
 	}
 
+	bool shader::is_valid() {
+		return this->isValid;
+	}
+
+	const char* shader::get_log() {
+		return this->Log.c_str();
+	}
+
+	const shader_reflection& shader::get_reflection() {
+		return this->Reflection;
+	}
+
 	VkPipelineShaderStageCreateInfo shader::stageci() {
 		VkPipelineShaderStageCreateInfo Temp;
 		Temp.sType					= VkStructureType::VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
@@ -142,11 +302,75 @@ namespace geodesuka::core::gcl {
 	}
 
 	bool shader::initialize() {
-		return glslang::InitializeProcess();
+		bool Result = true;
+		ProcessMutex.lock();
+		if (ProcessCount == 0) {
+			Result = glslang::InitializeProcess();
+		}
+		if (Result) {
+			ProcessCount += 1;
+		}
+		ProcessMutex.unlock();
+		return Result;
+	}
+
+	bool shader::validate(stage aStage, size_t aWordCount, const uint32_t* aWord, std::string& aLog) {
+		// SPIR-V execution model of each stage.
+		static const uint32_t ExecutionModel[] = { UINT32_MAX, 0, 1, 2, 3, 4, 5 };
+		const uint32_t OpEntryPoint = 15;
+
+		if ((aWord == NULL) || (aWordCount < 5)) {
+			aLog += "SPIR-V binary is too short.\n";
+			return false;
+		}
+		if (aWord[0] != SPIRVMagic) {
+			aLog += "SPIR-V magic number mismatch.\n";
+			return false;
+		}
+		if ((aWord[1] > SPIRVMaxVersion) || ((aWord[1] & 0xFF0000FF) != 0)) {
+			aLog += "SPIR-V version not supported.\n";
+			return false;
+		}
+		if ((aWord[3] == 0) || (aWord[4] != 0)) {
+			aLog += "SPIR-V header is malformed.\n";
+			return false;
+		}
+
+		bool hasEntryPoint = false;
+		size_t i = 5;
+		while (i < aWordCount) {
+			uint32_t Op = aWord[i] & 0xFFFF;
+			uint32_t Count = aWord[i] >> 16;
+			if ((Count == 0) || (i + Count > aWordCount)) {
+				aLog += "SPIR-V instruction stream is truncated.\n";
+				return false;
+			}
+			// OpEntryPoint <model> <id> <name>
+			if ((Op == OpEntryPoint) && (Count >= 4) && (aWord[i + 1] == ExecutionModel[aStage])) {
+				const char* Name = (const char*)&aWord[i + 3];
+				size_t MaxLength = (Count - 3) * sizeof(uint32_t);
+				hasEntryPoint |= ((strnlen(Name, MaxLength) < MaxLength) && (strcmp(Name, "main") == 0));
+			}
+			i += Count;
+		}
+
+		if (!hasEntryPoint) {
+			aLog += "SPIR-V has no \"main\" entry point for this stage.\n";
+			return false;
+		}
+
+		return true;
 	}
 
 	void shader::terminate() {
-		glslang::FinalizeProcess();
+		ProcessMutex.lock();
+		if (ProcessCount > 0) {
+			ProcessCount -= 1;
+			if (ProcessCount == 0) {
+				glslang::FinalizeProcess();
+			}
+		}
+		ProcessMutex.unlock();
 	}
 
 }
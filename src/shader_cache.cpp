@@ -0,0 +1,203 @@
+#include <geodesuka/core/gcl/shader_cache.h>
+
+#include <cstdio>
+#include <cstring>
+
+#include <filesystem>
+#include <chrono>
+
+namespace geodesuka::core::gcl {
+
+	// 'G' 'S' 'P' 'V'
+	static const uint32_t CacheMagic		= 0x56505347;
+	static const uint32_t CacheVersion		= 1;
+	static const uint32_t SPIRVMagic		= 0x07230203;
+
+	std::mutex shader_cache::Mutex;
+	shader_cache::entry_list shader_cache::Recent;
+	std::unordered_map<uint64_t, shader_cache::entry_list::iterator> shader_cache::Memory;
+	size_t shader_cache::MemorySize = 0;
+	size_t shader_cache::MemoryBudget = 64 << 20;
+	std::string shader_cache::Directory;
+	uint32_t shader_cache::TemporaryCount = 0;
+
+	uint64_t shader_cache::hash(int aStage, const char* aSource, uint32_t aDefineCount, const char** aDefineList, const char* aCompilerVersion) {
+		// Separator prevents ("ab", "c") and ("a", "bc") from colliding.
+		const char Separator = '\0';
+		uint64_t Hash = 0xcbf29ce484222325ull;
+		Hash = fnv1a(Hash, &aStage, sizeof(int));
+		if (aSource != NULL) {
+			Hash = fnv1a(Hash, aSource, strlen(aSource));
+		}
+		Hash = fnv1a(Hash, &Separator, sizeof(char));
+		for (uint32_t i = 0; i < aDefineCount; i++) {
+			if (aDefineList[i] == NULL) continue;
+			Hash = fnv1a(Hash, aDefineList[i], strlen(aDefineList[i]));
+			Hash = fnv1a(Hash, &Separator, sizeof(char));
+		}
+		if (aCompilerVersion != NULL) {
+			Hash = fnv1a(Hash, aCompilerVersion, strlen(aCompilerVersion));
+		}
+		return Hash;
+	}
+
+	void shader_cache::set_directory(const char* aDirectory) {
+		Mutex.lock();
+		if (aDirectory != NULL) {
+			Directory = aDirectory;
+		}
+		else {
+			Directory.clear();
+		}
+		Mutex.unlock();
+	}
+
+	void shader_cache::set_budget(size_t aBytes) {
+		Mutex.lock();
+		MemoryBudget = aBytes;
+		evict();
+		Mutex.unlock();
+	}
+
+	bool shader_cache::load(uint64_t aHash, std::vector<unsigned int>& aBinary) {
+		std::string FilePath;
+
+		// Memory tier.
+		Mutex.lock();
+		auto it = Memory.find(aHash);
+		if (it != Memory.end()) {
+			Recent.splice(Recent.begin(), Recent, it->second);
+			aBinary = it->second->second;
+			Mutex.unlock();
+			return true;
+		}
+		FilePath = path(aHash);
+		Mutex.unlock();
+
+		// Disk tier.
+		if (FilePath.size() == 0) return false;
+		std::error_code ErrorCode;
+		uintmax_t FileSize = std::filesystem::file_size(FilePath, ErrorCode);
+		if (ErrorCode) return false;
+		FILE* File = fopen(FilePath.c_str(), "rb");
+		if (File == NULL) return false;
+
+		header Header{};
+		bool isValid = (FileSize >= sizeof(header)) && (fread(&Header, sizeof(header), 1, File) == 1);
+		isValid = isValid && (Header.Magic == CacheMagic) && (Header.Version == CacheVersion) && (Header.Hash == aHash) && (Header.WordCount > 0);
+		// Word count is checked against the file size before anything is allocated from it.
+		isValid = isValid && ((FileSize - sizeof(header)) % sizeof(unsigned int) == 0) && ((FileSize - sizeof(header)) / sizeof(unsigned int) == Header.WordCount);
+
+		std::vector<unsigned int> Binary;
+		if (isValid) {
+			Binary.resize(Header.WordCount);
+			isValid = (fread(Binary.data(), sizeof(unsigned int), Binary.size(), File) == Binary.size());
+		}
+		if (isValid) {
+			// Trailing bytes means the file is not what was written.
+			isValid = (fgetc(File) == EOF);
+		}
+		fclose(File);
+
+		isValid = isValid && (Binary[0] == SPIRVMagic) && (fnv1a(0xcbf29ce484222325ull, Binary.data(), Binary.size() * sizeof(unsigned int)) == Header.Checksum);
+
+		// Corrupt entry, remove so it is rewritten on next store.
+		if (!isValid) {
+			std::remove(FilePath.c_str());
+			return false;
+		}
+
+		Mutex.lock();
+		insert(aHash, Binary);
+		Mutex.unlock();
+
+		aBinary = std::move(Binary);
+		return true;
+	}
+
+	void shader_cache::store(uint64_t aHash, const std::vector<unsigned int>& aBinary) {
+		if ((aBinary.size() == 0) || (aBinary[0] != SPIRVMagic)) return;
+		std::string FilePath;
+		std::string TemporaryPath;
+
+		Mutex.lock();
+		insert(aHash, aBinary);
+		FilePath = path(aHash);
+		if (FilePath.size() > 0) {
+			// Unique per process and per call.
+			char Suffix[96];
+			snprintf(Suffix, sizeof(Suffix), ".%llx.%u.tmp", (unsigned long long)std::chrono::high_resolution_clock::now().time_since_epoch().count(), TemporaryCount++);
+			TemporaryPath = FilePath + Suffix;
+		}
+		Mutex.unlock();
+
+		if (FilePath.size() == 0) return;
+
+		std::error_code ErrorCode;
+		std::filesystem::create_directories(std::filesystem::path(FilePath).parent_path(), ErrorCode);
+
+		header Header{};
+		Header.Magic		= CacheMagic;
+		Header.Version		= CacheVersion;
+		Header.Hash			= aHash;
+		Header.WordCount	= aBinary.size();
+		Header.Checksum		= fnv1a(0xcbf29ce484222325ull, aBinary.data(), aBinary.size() * sizeof(unsigned int));
+
+		FILE* File = fopen(TemporaryPath.c_str(), "wb");
+		if (File == NULL) return;
+		bool isWritten = (fwrite(&Header, sizeof(header), 1, File) == 1);
+		isWritten = isWritten && (fwrite(aBinary.data(), sizeof(unsigned int), aBinary.size(), File) == aBinary.size());
+		isWritten = (fclose(File) == 0) && isWritten;
+
+		// If rename fails, another thread or process has already stored the same entry.
+		if ((!isWritten) || (std::rename(TemporaryPath.c_str(), FilePath.c_str()) != 0)) {
+			std::remove(TemporaryPath.c_str());
+		}
+	}
+
+	void shader_cache::clear() {
+		Mutex.lock();
+		Recent.clear();
+		Memory.clear();
+		MemorySize = 0;
+		Mutex.unlock();
+	}
+
+	uint64_t shader_cache::fnv1a(uint64_t aHash, const void* aData, size_t aSize) {
+		const unsigned char* Byte = (const unsigned char*)aData;
+		for (size_t i = 0; i < aSize; i++) {
+			aHash ^= (uint64_t)Byte[i];
+			aHash *= 0x100000001b3ull;
+		}
+		return aHash;
+	}
+
+	std::string shader_cache::path(uint64_t aHash) {
+		if (Directory.size() == 0) return std::string();
+		char FileName[32];
+		snprintf(FileName, sizeof(FileName), "/%016llx.spv", (unsigned long long)aHash);
+		return Directory + FileName;
+	}
+
+	void shader_cache::insert(uint64_t aHash, const std::vector<unsigned int>& aBinary) {
+		auto it = Memory.find(aHash);
+		if (it != Memory.end()) {
+			MemorySize -= it->second->second.size() * sizeof(unsigned int);
+			Recent.erase(it->second);
+			Memory.erase(it);
+		}
+		Recent.emplace_front(aHash, aBinary);
+		Memory[aHash] = Recent.begin();
+		MemorySize += aBinary.size() * sizeof(unsigned int);
+		evict();
+	}
+
+	void shader_cache::evict() {
+		while ((MemorySize > MemoryBudget) && (Recent.size() > 0)) {
+			MemorySize -= Recent.back().second.size() * sizeof(unsigned int);
+			Memory.erase(Recent.back().first);
+			Recent.pop_back();
+		}
+	}
+
+}
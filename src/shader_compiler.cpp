@@ -0,0 +1,99 @@
+#include <geodesuka/core/gcl/shader_compiler.h>
+
+namespace geodesuka::core::gcl {
+
+	shader_compiler::shader_compiler(uint32_t aThreadCount) {
+		this->Shutdown = false;
+		// Balanced by terminate() in destructor, glslang is only initialized once per process.
+		this->isReady = shader::initialize();
+		if (!this->isReady) return;
+
+		if (aThreadCount == 0) {
+			aThreadCount = std::thread::hardware_concurrency();
+		}
+		if (aThreadCount == 0) {
+			aThreadCount = 1;
+		}
+
+		for (uint32_t i = 0; i < aThreadCount; i++) {
+			this->Worker.push_back(std::thread(&shader_compiler::work, this));
+		}
+	}
+
+	shader_compiler::~shader_compiler() {
+		// Workers drain the queue before exiting, so no future is left unsatisfied.
+		this->Mutex.lock();
+		this->Shutdown = true;
+		this->Mutex.unlock();
+		this->Condition.notify_all();
+
+		for (size_t i = 0; i < this->Worker.size(); i++) {
+			this->Worker[i].join();
+		}
+		this->Worker.clear();
+
+		if (this->isReady) {
+			shader::terminate();
+		}
+	}
+
+	std::future<shader*> shader_compiler::compile(context* aContext, shader::stage aStage, const char* aSource, uint32_t aDefineCount, const char** aDefineList) {
+		// Copy inputs, caller's strings may not outlive the job.
+		std::string Source = (aSource != NULL) ? aSource : "";
+		std::vector<std::string> Define;
+		for (uint32_t i = 0; i < aDefineCount; i++) {
+			if (aDefineList[i] == NULL) continue;
+			Define.push_back(aDefineList[i]);
+		}
+
+		std::packaged_task<shader*()> Task([=]() -> shader* {
+			std::vector<const char*> DefineList(Define.size());
+			for (size_t i = 0; i < Define.size(); i++) {
+				DefineList[i] = Define[i].c_str();
+			}
+			return new shader(aContext, aStage, Source.c_str(), (uint32_t)DefineList.size(), DefineList.data());
+		});
+		std::future<shader*> Result = Task.get_future();
+
+		// No workers, compile on calling thread.
+		if (this->Worker.size() == 0) {
+			Task();
+			return Result;
+		}
+
+		this->Mutex.lock();
+		this->Job.push_back(std::move(Task));
+		this->Mutex.unlock();
+		this->Condition.notify_one();
+
+		return Result;
+	}
+
+	std::vector<std::future<shader*>> shader_compiler::compile(context* aContext, size_t aSourceCount, const source* aSourceList) {
+		std::vector<std::future<shader*>> Result;
+		Result.reserve(aSourceCount);
+		for (size_t i = 0; i < aSourceCount; i++) {
+			Result.push_back(this->compile(aContext, aSourceList[i].Stage, aSourceList[i].Source, aSourceList[i].DefineCount, aSourceList[i].DefineList));
+		}
+		return Result;
+	}
+
+	uint32_t shader_compiler::get_thread_count() {
+		return (uint32_t)this->Worker.size();
+	}
+
+	void shader_compiler::work() {
+		while (true) {
+			std::packaged_task<shader*()> Task;
+			{
+				std::unique_lock<std::mutex> Lock(this->Mutex);
+				this->Condition.wait(Lock, [this]() { return this->Shutdown || (this->Job.size() > 0); });
+				if (this->Job.size() == 0) return;
+				Task = std::move(this->Job.front());
+				this->Job.pop_front();
+			}
+			Task();
+		}
+	}
+
+}
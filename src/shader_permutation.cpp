@@ -0,0 +1,230 @@
+#include <geodesuka/core/gcl/shader_permutation.h>
+
+#include <geodesuka/core/gcl/shader_cache.h>
+
+namespace geodesuka::core::gcl {
+
+	VkPipelineShaderStageCreateInfo shader_permutation::variant::stageci() {
+		VkPipelineShaderStageCreateInfo Temp = this->Shader->stageci();
+		if (this->MapEntry.size() > 0) {
+			Temp.pSpecializationInfo = &this->SpecializationInfo;
+		}
+		return Temp;
+	}
+
+	shader_permutation::shader_permutation(context* aContext, shader::stage aStage, const char* aSource) {
+		this->Context = aContext;
+		this->Stage = aStage;
+		if (aSource != NULL) {
+			this->Source = aSource;
+		}
+		this->DefineMask = 0;
+	}
+
+	shader_permutation::~shader_permutation() {
+		this->Mutex.lock();
+		for (auto it = this->Variant.begin(); it != this->Variant.end(); it++) {
+			delete it->second;
+		}
+		for (auto it = this->Module.begin(); it != this->Module.end(); it++) {
+			delete it->second;
+		}
+		this->Variant.clear();
+		this->Module.clear();
+		this->ModuleUseCount.clear();
+		this->Mutex.unlock();
+	}
+
+	int shader_permutation::add_define(const char* aName) {
+		if (aName == NULL) return -1;
+		int Index = -1;
+		this->Mutex.lock();
+		// Existing variants were built without it, features are fixed once any exist.
+		if ((this->Feature.size() < 64) && (this->Variant.size() == 0)) {
+			feature Feature;
+			Feature.Name		= aName;
+			Feature.isConstant	= false;
+			Feature.ConstantID	= 0;
+			Index = (int)this->Feature.size();
+			this->Feature.push_back(Feature);
+			this->DefineMask |= (1ull << Index);
+		}
+		this->Mutex.unlock();
+		return Index;
+	}
+
+	int shader_permutation::add_constant(const char* aName, uint32_t aConstantID) {
+		if (aName == NULL) return -1;
+		int Index = -1;
+		this->Mutex.lock();
+		// Existing variants were built without it, features are fixed once any exist.
+		if ((this->Feature.size() < 64) && (this->Variant.size() == 0)) {
+			feature Feature;
+			Feature.Name		= aName;
+			Feature.isConstant	= true;
+			Feature.ConstantID	= aConstantID;
+			Index = (int)this->Feature.size();
+			this->Feature.push_back(Feature);
+		}
+		this->Mutex.unlock();
+		return Index;
+	}
+
+	shader_permutation::variant* shader_permutation::acquire(uint64_t aFeature) {
+		variant* Variant = nullptr;
+
+		this->Mutex.lock();
+
+		// Undeclared bits are ignored so they cannot create duplicate variants.
+		uint64_t DeclaredMask = this->Feature.size() < 64 ? ((1ull << this->Feature.size()) - 1) : ~0ull;
+		aFeature &= DeclaredMask;
+
+		auto it = this->Variant.find(aFeature);
+		if (it != this->Variant.end()) {
+			Variant = it->second;
+			Variant->UseCount += 1;
+			this->Mutex.unlock();
+			return Variant;
+		}
+
+		// Module is shared by all variants with the same defines.
+		std::vector<const char*> DefineList;
+		uint64_t Key = this->module_key(aFeature, DefineList);
+		shader* Shader = nullptr;
+		auto jt = this->Module.find(Key);
+		if (jt != this->Module.end()) {
+			Shader = jt->second;
+		}
+		else {
+			// Compiled unlocked so unrelated variants compile concurrently. Names are
+			// copied, add_define() and add_constant() may reallocate Feature meanwhile.
+			std::vector<std::string> DefineName(DefineList.begin(), DefineList.end());
+			for (size_t i = 0; i < DefineName.size(); i++) {
+				DefineList[i] = DefineName[i].c_str();
+			}
+			this->Mutex.unlock();
+
+			shader* Compiled = new shader(this->Context, this->Stage, this->Source.c_str(), (uint32_t)DefineList.size(), DefineList.data());
+			if (!Compiled->is_valid()) {
+				delete Compiled;
+				return nullptr;
+			}
+
+			this->Mutex.lock();
+			// Another thread may have compiled the same module, or made the same variant.
+			jt = this->Module.find(Key);
+			if (jt != this->Module.end()) {
+				delete Compiled;
+				Shader = jt->second;
+			}
+			else {
+				Shader = Compiled;
+				this->Module[Key] = Shader;
+				this->ModuleUseCount[Key] = 0;
+			}
+			it = this->Variant.find(aFeature);
+			if (it != this->Variant.end()) {
+				Variant = it->second;
+				Variant->UseCount += 1;
+				this->Mutex.unlock();
+				return Variant;
+			}
+		}
+		this->ModuleUseCount[Key] += 1;
+
+		Variant = new variant();
+		Variant->Feature	= aFeature;
+		Variant->Shader		= Shader;
+		Variant->UseCount	= 1;
+
+		// Every declared constant is specialized, so pipeline state is explicit.
+		for (size_t i = 0; i < this->Feature.size(); i++) {
+			if (!this->Feature[i].isConstant) continue;
+			VkSpecializationMapEntry Entry{};
+			Entry.constantID	= this->Feature[i].ConstantID;
+			Entry.offset		= (uint32_t)(Variant->Data.size() * sizeof(VkBool32));
+			Entry.size			= sizeof(VkBool32);
+			Variant->MapEntry.push_back(Entry);
+			Variant->Data.push_back((aFeature & (1ull << i)) ? VK_TRUE : VK_FALSE);
+		}
+
+		Variant->SpecializationInfo.mapEntryCount	= (uint32_t)Variant->MapEntry.size();
+		Variant->SpecializationInfo.pMapEntries		= Variant->MapEntry.data();
+		Variant->SpecializationInfo.dataSize		= Variant->Data.size() * sizeof(VkBool32);
+		Variant->SpecializationInfo.pData			= Variant->Data.data();
+
+		this->Variant[aFeature] = Variant;
+
+		this->Mutex.unlock();
+		return Variant;
+	}
+
+	void shader_permutation::release(variant* aVariant) {
+		if (aVariant == nullptr) return;
+		this->Mutex.lock();
+		if (aVariant->UseCount > 0) {
+			aVariant->UseCount -= 1;
+		}
+		this->Mutex.unlock();
+	}
+
+	std::vector<shader_permutation::usage> shader_permutation::usage_list() {
+		std::vector<usage> List;
+		this->Mutex.lock();
+		for (auto it = this->Variant.begin(); it != this->Variant.end(); it++) {
+			usage Usage;
+			Usage.Feature	= it->first;
+			Usage.UseCount	= it->second->UseCount;
+			List.push_back(Usage);
+		}
+		this->Mutex.unlock();
+		return List;
+	}
+
+	void shader_permutation::trim() {
+		this->Mutex.lock();
+		for (auto it = this->Variant.begin(); it != this->Variant.end();) {
+			if (it->second->UseCount == 0) {
+				std::vector<const char*> DefineList;
+				uint64_t Key = this->module_key(it->first, DefineList);
+				this->ModuleUseCount[Key] -= 1;
+				delete it->second;
+				it = this->Variant.erase(it);
+			}
+			else {
+				it++;
+			}
+		}
+		for (auto it = this->Module.begin(); it != this->Module.end();) {
+			if (this->ModuleUseCount[it->first] == 0) {
+				delete it->second;
+				this->ModuleUseCount.erase(it->first);
+				it = this->Module.erase(it);
+			}
+			else {
+				it++;
+			}
+		}
+		this->Mutex.unlock();
+	}
+
+	size_t shader_permutation::module_count() {
+		this->Mutex.lock();
+		size_t Count = this->Module.size();
+		this->Mutex.unlock();
+		return Count;
+	}
+
+	uint64_t shader_permutation::module_key(uint64_t aFeature, std::vector<const char*>& aDefineList) {
+		// Feature order is fixed, so the same bits always produce the same list.
+		aDefineList.clear();
+		uint64_t DefineFeature = aFeature & this->DefineMask;
+		for (size_t i = 0; i < this->Feature.size(); i++) {
+			if (DefineFeature & (1ull << i)) {
+				aDefineList.push_back(this->Feature[i].Name.c_str());
+			}
+		}
+		return shader_cache::hash(this->Stage, this->Source.c_str(), (uint32_t)aDefineList.size(), aDefineList.data(), NULL);
+	}
+
+}
@@ -0,0 +1,627 @@
+#include <geodesuka/core/gcl/shader_reflection.h>
+
+#include <cstring>
+
+namespace geodesuka::core::gcl {
+
+	// SPIR-V tokens used by reflection, see SPIR-V specification.
+	enum {
+		OpName							= 5,
+		OpMemberName					= 6,
+		OpExecutionMode					= 16,
+		OpTypeBool						= 20,
+		OpTypeInt						= 21,
+		OpTypeFloat						= 22,
+		OpTypeVector					= 23,
+		OpTypeMatrix					= 24,
+		OpTypeImage						= 25,
+		OpTypeSampler					= 26,
+		OpTypeSampledImage				= 27,
+		OpTypeArray						= 28,
+		OpTypeRuntimeArray				= 29,
+		OpTypeStruct					= 30,
+		OpTypePointer					= 32,
+		OpConstantTrue					= 41,
+		OpConstantFalse					= 42,
+		OpConstant						= 43,
+		OpConstantComposite				= 44,
+		OpSpecConstantTrue				= 48,
+		OpSpecConstantFalse				= 49,
+		OpSpecConstant					= 50,
+		OpSpecConstantComposite			= 51,
+		OpFunction						= 54,
+		OpVariable						= 59,
+		OpDecorate						= 71,
+		OpMemberDecorate				= 72,
+		OpExecutionModeId				= 331,
+		OpTypeAccelerationStructureKHR	= 5341
+	};
+
+	enum {
+		DecorationBlock					= 2,
+		DecorationBufferBlock			= 3,
+		DecorationArrayStride			= 6,
+		DecorationMatrixStride			= 7,
+		DecorationBuiltIn				= 11,
+		DecorationLocation				= 30,
+		DecorationBinding				= 33,
+		DecorationDescriptorSet			= 34,
+		DecorationOffset				= 35
+	};
+
+	enum {
+		StorageClassUniformConstant		= 0,
+		StorageClassInput				= 1,
+		StorageClassUniform				= 2,
+		StorageClassOutput				= 3,
+		StorageClassPushConstant		= 9,
+		StorageClassStorageBuffer		= 12,
+		StorageClassPhysicalStorageBuffer	= 5349
+	};
+
+	enum {
+		DimBuffer						= 5,
+		DimSubpassData					= 6,
+		ExecutionModeLocalSize			= 17,
+		ExecutionModeLocalSizeId		= 38,
+		BuiltInWorkgroupSize			= 25
+	};
+
+	static const uint32_t SPIRVMagic = 0x07230203;
+
+	// Nesting limit for type walks, malformed modules may reference types cyclically.
+	static const uint32_t MaxTypeDepth = 64;
+
+	// Everything known about a single SPIR-V id.
+	struct spv_member {
+		std::string Name;
+		uint32_t Offset;
+		uint32_t MatrixStride;
+		bool isBuiltIn;
+	};
+
+	struct spv_id {
+		uint32_t Op;
+		std::string Name;
+		// Type operands.
+		uint32_t Width;				// Int, Float
+		uint32_t Signed;			// Int
+		uint32_t Element;			// Vector, Matrix, Array, Pointer
+		uint32_t Length;			// Vector, Matrix component count, Array length id.
+		uint32_t Dim;				// Image
+		uint32_t Sampled;			// Image
+		uint32_t StorageClass;		// Pointer, Variable
+		uint32_t Type;				// Variable
+		uint32_t Value;				// Constant, default value of spec constants.
+		std::vector<uint32_t> Member;	// Struct members, composite constituents.
+		std::vector<spv_member> MemberInfo;
+		// Decorations.
+		bool isBlock;
+		bool isBufferBlock;
+		bool isBuiltIn;
+		uint32_t BuiltIn;
+		bool hasLocation;
+		uint32_t Location;
+		uint32_t Set;
+		uint32_t Binding;
+		uint32_t ArrayStride;
+		spv_id() {
+			Op = 0; Width = 0; Signed = 0; Element = 0; Length = 0; Dim = 0; Sampled = 0;
+			StorageClass = 0; Type = 0; Value = 0;
+			isBlock = false; isBufferBlock = false; isBuiltIn = false; BuiltIn = 0; hasLocation = false;
+			Location = 0; Set = 0; Binding = 0; ArrayStride = 0;
+		}
+	};
+
+	static std::string spv_string(const uint32_t* aWord, size_t aWordCount) {
+		size_t MaxLength = aWordCount * sizeof(uint32_t);
+		const char* String = (const char*)aWord;
+		size_t Length = 0;
+		while ((Length < MaxLength) && (String[Length] != '\0')) Length++;
+		return std::string(String, Length);
+	}
+
+	static spv_member& spv_member_of(spv_id& aID, uint32_t aIndex) {
+		if (aID.MemberInfo.size() <= aIndex) {
+			size_t Old = aID.MemberInfo.size();
+			aID.MemberInfo.resize(aIndex + 1);
+			for (size_t i = Old; i < aID.MemberInfo.size(); i++) {
+				aID.MemberInfo[i].Offset = 0;
+				aID.MemberInfo[i].MatrixStride = 0;
+				aID.MemberInfo[i].isBuiltIn = false;
+			}
+		}
+		return aID.MemberInfo[aIndex];
+	}
+
+	// Size in bytes of a type as laid out in memory.
+	static uint32_t spv_size_of(const std::vector<spv_id>& aID, uint32_t aType, uint32_t aMatrixStride, uint32_t aDepth = 0) {
+		if (aDepth > MaxTypeDepth) return 0;
+		const spv_id& T = aID[aType];
+		switch (T.Op) {
+		case OpTypeBool:
+			return 4;
+		case OpTypeInt:
+		case OpTypeFloat:
+			return T.Width / 8;
+		case OpTypeVector:
+			return T.Length * spv_size_of(aID, T.Element, 0, aDepth + 1);
+		case OpTypeMatrix:
+			if (aMatrixStride > 0) return T.Length * aMatrixStride;
+			return T.Length * spv_size_of(aID, T.Element, 0, aDepth + 1);
+		case OpTypeArray:
+			{
+				uint32_t Stride = T.ArrayStride > 0 ? T.ArrayStride : spv_size_of(aID, T.Element, aMatrixStride, aDepth + 1);
+				return aID[T.Length].Value * Stride;
+			}
+		case OpTypeRuntimeArray:
+			return 0;
+		case OpTypeStruct:
+			{
+				uint32_t Size = 0;
+				for (size_t i = 0; i < T.Member.size(); i++) {
+					uint32_t Offset = i < T.MemberInfo.size() ? T.MemberInfo[i].Offset : 0;
+					uint32_t MatrixStride = i < T.MemberInfo.size() ? T.MemberInfo[i].MatrixStride : 0;
+					uint32_t End = Offset + spv_size_of(aID, T.Member[i], MatrixStride, aDepth + 1);
+					if (End > Size) Size = End;
+				}
+				return Size;
+			}
+		case OpTypePointer:
+			// Buffer device addresses, other pointers have no size in memory.
+			return T.StorageClass == StorageClassPhysicalStorageBuffer ? 8 : 0;
+		default:
+			return 0;
+		}
+	}
+
+	// Maps numeric SPIR-V types to util::type ids.
+	static util::type::id spv_type_id_of(const std::vector<spv_id>& aID, uint32_t aType, uint32_t aDepth = 0) {
+		typedef util::type::id tid;
+		if (aDepth > MaxTypeDepth) return tid::UNKNOWN;
+		const spv_id& T = aID[aType];
+		switch (T.Op) {
+		case OpTypeInt:
+			switch (T.Width) {
+			case 8:		return T.Signed ? tid::CHAR : tid::UCHAR;
+			case 16:	return T.Signed ? tid::SHORT : tid::USHORT;
+			case 32:	return T.Signed ? tid::INT : tid::UINT;
+			default:	return tid::UNKNOWN;
+			}
+		case OpTypeFloat:
+			switch (T.Width) {
+			case 32:	return tid::FLOAT;
+			case 64:	return tid::DOUBLE;
+			default:	return tid::UNKNOWN;
+			}
+		case OpTypeVector:
+			{
+				static const tid Vector[7][3] = {
+					{ tid::UCHAR2,	tid::UCHAR3,	tid::UCHAR4		},
+					{ tid::USHORT2,	tid::USHORT3,	tid::USHORT4	},
+					{ tid::UINT2,	tid::UINT3,		tid::UINT4		},
+					{ tid::CHAR2,	tid::CHAR3,		tid::CHAR4		},
+					{ tid::SHORT2,	tid::SHORT3,	tid::SHORT4		},
+					{ tid::INT2,	tid::INT3,		tid::INT4		},
+					{ tid::FLOAT2,	tid::FLOAT3,	tid::FLOAT4		}
+				};
+				if ((T.Length < 2) || (T.Length > 4)) return tid::UNKNOWN;
+				int Row = -1;
+				switch (spv_type_id_of(aID, T.Element, aDepth + 1)) {
+				case tid::UCHAR:	Row = 0; break;
+				case tid::USHORT:	Row = 1; break;
+				case tid::UINT:		Row = 2; break;
+				case tid::CHAR:		Row = 3; break;
+				case tid::SHORT:	Row = 4; break;
+				case tid::INT:		Row = 5; break;
+				case tid::FLOAT:	Row = 6; break;
+				default:			return tid::UNKNOWN;
+				}
+				return Vector[Row][T.Length - 2];
+			}
+		case OpTypeMatrix:
+			{
+				// util naming is float<columns>x<rows>.
+				static const tid Matrix[3][3] = {
+					{ tid::FLOAT2X2,	tid::FLOAT2X3,	tid::FLOAT2X4 },
+					{ tid::FLOAT3X2,	tid::FLOAT3X3,	tid::FLOAT3X4 },
+					{ tid::FLOAT4X2,	tid::FLOAT4X3,	tid::FLOAT4X4 }
+				};
+				const spv_id& Column = aID[T.Element];
+				if ((spv_type_id_of(aID, Column.Element, aDepth + 1) != tid::FLOAT) || (T.Length < 2) || (T.Length > 4) || (Column.Length < 2) || (Column.Length > 4)) return tid::UNKNOWN;
+				return Matrix[T.Length - 2][Column.Length - 2];
+			}
+		case OpTypeStruct:
+			return tid::STRUCT;
+		default:
+			return tid::UNKNOWN;
+		}
+	}
+
+	// Builds a util::variable tree for a type, arrays become subscripts.
+	static util::variable spv_variable_of(const std::vector<spv_id>& aID, uint32_t aType, const char* aName, uint32_t aDepth = 0) {
+		if (aDepth > MaxTypeDepth) return util::variable();
+		std::vector<int> Dimension;
+		uint32_t Type = aType;
+		while ((aID[Type].Op == OpTypeArray) || (aID[Type].Op == OpTypeRuntimeArray)) {
+			if (Dimension.size() > MaxTypeDepth) return util::variable();
+			// Runtime arrays have no static size, left out of the subscript list.
+			if (aID[Type].Op == OpTypeArray) {
+				Dimension.push_back((int)aID[aID[Type].Length].Value);
+			}
+			Type = aID[Type].Element;
+		}
+
+		util::type::id TypeID = spv_type_id_of(aID, Type, aDepth + 1);
+		if (TypeID == util::type::id::UNKNOWN) return util::variable();
+
+		if (TypeID == util::type::id::STRUCT) {
+			const spv_id& Struct = aID[Type];
+			util::type StructType(util::type::id::STRUCT, Struct.Name.c_str());
+			for (size_t i = 0; i < Struct.Member.size(); i++) {
+				if ((i < Struct.MemberInfo.size()) && (Struct.MemberInfo[i].isBuiltIn)) continue;
+				const char* MemberName = i < Struct.MemberInfo.size() ? Struct.MemberInfo[i].Name.c_str() : "";
+				util::variable Member = spv_variable_of(aID, Struct.Member[i], MemberName, aDepth + 1);
+				if (Member.Type.ID == util::type::id::UNKNOWN) continue;
+				StructType.push(Member);
+			}
+			if (Dimension.size() == 0) return util::variable(StructType, aName);
+			if (Dimension.size() == 1) return util::variable(StructType, aName, Dimension[0]);
+			return util::variable(StructType, aName, (int)Dimension.size(), Dimension.data());
+		}
+		else {
+			if (Dimension.size() == 0) return util::variable(TypeID, aName);
+			if (Dimension.size() == 1) return util::variable(TypeID, aName, Dimension[0]);
+			return util::variable(TypeID, aName, (int)Dimension.size(), Dimension.data());
+		}
+	}
+
+	// Vertex attribute format of a scalar or vector type.
+	static VkFormat spv_format_of(const std::vector<spv_id>& aID, uint32_t aType) {
+		const spv_id& T = aID[aType];
+		uint32_t Count = 1;
+		const spv_id* Scalar = &T;
+		if (T.Op == OpTypeVector) {
+			Count = T.Length;
+			Scalar = &aID[T.Element];
+		}
+		if ((Count < 1) || (Count > 4)) return VkFormat::VK_FORMAT_UNDEFINED;
+		if ((Scalar->Op == OpTypeFloat) && (Scalar->Width == 32)) {
+			static const VkFormat Format[4] = { VK_FORMAT_R32_SFLOAT, VK_FORMAT_R32G32_SFLOAT, VK_FORMAT_R32G32B32_SFLOAT, VK_FORMAT_R32G32B32A32_SFLOAT };
+			return Format[Count - 1];
+		}
+		if ((Scalar->Op == OpTypeFloat) && (Scalar->Width == 64)) {
+			static const VkFormat Format[4] = { VK_FORMAT_R64_SFLOAT, VK_FORMAT_R64G64_SFLOAT, VK_FORMAT_R64G64B64_SFLOAT, VK_FORMAT_R64G64B64A64_SFLOAT };
+			return Format[Count - 1];
+		}
+		if ((Scalar->Op == OpTypeInt) && (Scalar->Width == 32) && (Scalar->Signed)) {
+			static const VkFormat Format[4] = { VK_FORMAT_R32_SINT, VK_FORMAT_R32G32_SINT, VK_FORMAT_R32G32B32_SINT, VK_FORMAT_R32G32B32A32_SINT };
+			return Format[Count - 1];
+		}
+		if ((Scalar->Op == OpTypeInt) && (Scalar->Width == 32) && (!Scalar->Signed)) {
+			static const VkFormat Format[4] = { VK_FORMAT_R32_UINT, VK_FORMAT_R32G32_UINT, VK_FORMAT_R32G32B32_UINT, VK_FORMAT_R32G32B32A32_UINT };
+			return Format[Count - 1];
+		}
+		return VkFormat::VK_FORMAT_UNDEFINED;
+	}
+
+	shader_reflection::shader_reflection() {
+		this->Stage = (VkShaderStageFlagBits)0;
+		this->LocalSize[0] = 0;
+		this->LocalSize[1] = 0;
+		this->LocalSize[2] = 0;
+	}
+
+	bool shader_reflection::reflect(VkShaderStageFlagBits aStage, size_t aWordCount, const uint32_t* aWord) {
+		this->clear();
+		this->Stage = aStage;
+		if ((aWord == NULL) || (aWordCount < 5) || (aWord[0] != SPIRVMagic)) return false;
+
+		uint32_t Bound = aWord[3];
+		std::vector<spv_id> ID(Bound);
+		std::vector<uint32_t> Variable;
+		std::vector<uint32_t> LocalSizeID;
+
+		// Global declarations all precede the first function.
+		size_t i = 5;
+		while (i < aWordCount) {
+			uint32_t Op = aWord[i] & 0xFFFF;
+			uint32_t Count = aWord[i] >> 16;
+			const uint32_t* W = &aWord[i];
+			if ((Count == 0) || (i + Count > aWordCount)) return false;
+			if (Op == OpFunction) break;
+
+			// Ids referenced as W[1] or W[2] must be within bound.
+			switch (Op) {
+			case OpName:
+				if ((Count < 2) || (W[1] >= Bound)) return false;
+				ID[W[1]].Name = spv_string(&W[2], Count - 2);
+				break;
+			case OpMemberName:
+				if ((Count < 3) || (W[1] >= Bound)) return false;
+				spv_member_of(ID[W[1]], W[2]).Name = spv_string(&W[3], Count - 3);
+				break;
+			case OpExecutionMode:
+				if ((Count >= 6) && (W[2] == ExecutionModeLocalSize)) {
+					this->LocalSize[0] = W[3];
+					this->LocalSize[1] = W[4];
+					this->LocalSize[2] = W[5];
+				}
+				break;
+			case OpExecutionModeId:
+				// Operands are constant ids, resolved once constants are known.
+				if ((Count >= 6) && (W[2] == ExecutionModeLocalSizeId)) {
+					if ((W[3] >= Bound) || (W[4] >= Bound) || (W[5] >= Bound)) return false;
+					LocalSizeID.assign(&W[3], &W[6]);
+				}
+				break;
+			case OpTypeBool:
+			case OpTypeSampler:
+			case OpTypeAccelerationStructureKHR:
+				if ((Count < 2) || (W[1] >= Bound)) return false;
+				ID[W[1]].Op = Op;
+				break;
+			case OpTypeInt:
+				if ((Count < 4) || (W[1] >= Bound)) return false;
+				ID[W[1]].Op = Op;
+				ID[W[1]].Width = W[2];
+				ID[W[1]].Signed = W[3];
+				break;
+			case OpTypeFloat:
+				if ((Count < 3) || (W[1] >= Bound)) return false;
+				ID[W[1]].Op = Op;
+				ID[W[1]].Width = W[2];
+				break;
+			case OpTypeVector:
+			case OpTypeMatrix:
+			case OpTypeArray:
+				if ((Count < 4) || (W[1] >= Bound) || (W[2] >= Bound) || ((Op == OpTypeArray) && (W[3] >= Bound))) return false;
+				ID[W[1]].Op = Op;
+				ID[W[1]].Element = W[2];
+				ID[W[1]].Length = W[3];
+				break;
+			case OpTypeRuntimeArray:
+			case OpTypeSampledImage:
+				if ((Count < 3) || (W[1] >= Bound) || (W[2] >= Bound)) return false;
+				ID[W[1]].Op = Op;
+				ID[W[1]].Element = W[2];
+				break;
+			case OpTypeImage:
+				if ((Count < 9) || (W[1] >= Bound)) return false;
+				ID[W[1]].Op = Op;
+				ID[W[1]].Dim = W[3];
+				ID[W[1]].Sampled = W[7];
+				break;
+			case OpTypeStruct:
+				if ((Count < 2) || (W[1] >= Bound)) return false;
+				ID[W[1]].Op = Op;
+				for (uint32_t j = 2; j < Count; j++) {
+					if (W[j] >= Bound) return false;
+					ID[W[1]].Member.push_back(W[j]);
+				}
+				if (Count > 2) {
+					spv_member_of(ID[W[1]], Count - 3);
+				}
+				break;
+			case OpTypePointer:
+				if ((Count < 4) || (W[1] >= Bound) || (W[3] >= Bound)) return false;
+				ID[W[1]].Op = Op;
+				ID[W[1]].StorageClass = W[2];
+				ID[W[1]].Element = W[3];
+				break;
+			case OpConstant:
+			case OpSpecConstant:
+				// Spec constants resolve to their default value.
+				if ((Count < 4) || (W[2] >= Bound)) return false;
+				ID[W[2]].Op = Op;
+				ID[W[2]].Value = W[3];
+				break;
+			case OpConstantTrue:
+			case OpConstantFalse:
+			case OpSpecConstantTrue:
+			case OpSpecConstantFalse:
+				if ((Count < 3) || (W[2] >= Bound)) return false;
+				ID[W[2]].Op = Op;
+				ID[W[2]].Value = ((Op == OpConstantTrue) || (Op == OpSpecConstantTrue)) ? 1 : 0;
+				break;
+			case OpConstantComposite:
+			case OpSpecConstantComposite:
+				if ((Count < 3) || (W[2] >= Bound)) return false;
+				ID[W[2]].Op = Op;
+				for (uint32_t j = 3; j < Count; j++) {
+					if (W[j] >= Bound) return false;
+					ID[W[2]].Member.push_back(W[j]);
+				}
+				break;
+			case OpVariable:
+				if ((Count < 4) || (W[1] >= Bound) || (W[2] >= Bound)) return false;
+				ID[W[2]].Op = Op;
+				ID[W[2]].Type = W[1];
+				ID[W[2]].StorageClass = W[3];
+				Variable.push_back(W[2]);
+				break;
+			case OpDecorate:
+				if ((Count < 3) || (W[1] >= Bound)) return false;
+				switch (W[2]) {
+				case DecorationBlock:			ID[W[1]].isBlock = true; break;
+				case DecorationBufferBlock:		ID[W[1]].isBufferBlock = true; break;
+				case DecorationBuiltIn:			ID[W[1]].isBuiltIn = true; if (Count > 3) ID[W[1]].BuiltIn = W[3]; break;
+				case DecorationArrayStride:		if (Count > 3) ID[W[1]].ArrayStride = W[3]; break;
+				case DecorationLocation:		if (Count > 3) { ID[W[1]].Location = W[3]; ID[W[1]].hasLocation = true; } break;
+				case DecorationBinding:			if (Count > 3) ID[W[1]].Binding = W[3]; break;
+				case DecorationDescriptorSet:	if (Count > 3) ID[W[1]].Set = W[3]; break;
+				default: break;
+				}
+				break;
+			case OpMemberDecorate:
+				if ((Count < 4) || (W[1] >= Bound)) return false;
+				switch (W[3]) {
+				case DecorationBuiltIn:			spv_member_of(ID[W[1]], W[2]).isBuiltIn = true; break;
+				case DecorationOffset:			if (Count > 4) spv_member_of(ID[W[1]], W[2]).Offset = W[4]; break;
+				case DecorationMatrixStride:	if (Count > 4) spv_member_of(ID[W[1]], W[2]).MatrixStride = W[4]; break;
+				default: break;
+				}
+				break;
+			default:
+				break;
+			}
+
+			i += Count;
+		}
+
+		if (LocalSizeID.size() == 3) {
+			for (int j = 0; j < 3; j++) {
+				this->LocalSize[j] = ID[LocalSizeID[j]].Value;
+			}
+		}
+
+		// A WorkgroupSize built-in overrides any execution mode, glslang emits it for local_size_*_id.
+		for (size_t j = 0; j < ID.size(); j++) {
+			if ((!ID[j].isBuiltIn) || (ID[j].BuiltIn != BuiltInWorkgroupSize) || (ID[j].Member.size() != 3)) continue;
+			if ((ID[j].Op != OpConstantComposite) && (ID[j].Op != OpSpecConstantComposite)) continue;
+			for (int k = 0; k < 3; k++) {
+				this->LocalSize[k] = ID[ID[j].Member[k]].Value;
+			}
+		}
+
+		for (size_t v = 0; v < Variable.size(); v++) {
+			const spv_id& Var = ID[Variable[v]];
+			const spv_id& Pointer = ID[Var.Type];
+			if (Pointer.Op != OpTypePointer) continue;
+
+			// Peel arrays to find resource type and descriptor count.
+			uint32_t Type = Pointer.Element;
+			uint32_t DescriptorCount = 1;
+			uint32_t Depth = 0;
+			while (((ID[Type].Op == OpTypeArray) || (ID[Type].Op == OpTypeRuntimeArray)) && (Depth++ < MaxTypeDepth)) {
+				if (ID[Type].Op == OpTypeArray) {
+					DescriptorCount *= ID[ID[Type].Length].Value;
+				}
+				else {
+					DescriptorCount = 0;
+				}
+				Type = ID[Type].Element;
+			}
+			const spv_id& Resource = ID[Type];
+
+			switch (Var.StorageClass) {
+			case StorageClassUniformConstant:
+			case StorageClassUniform:
+			case StorageClassStorageBuffer:
+				{
+					binding Binding;
+					Binding.Set			= Var.Set;
+					Binding.Binding		= Var.Binding;
+					Binding.Type		= VkDescriptorType::VK_DESCRIPTOR_TYPE_MAX_ENUM;
+					Binding.Count		= DescriptorCount;
+					Binding.Stage		= aStage;
+					Binding.Size		= 0;
+					Binding.Name		= Var.Name;
+					switch (Resource.Op) {
+					case OpTypeSampler:
+						Binding.Type = VkDescriptorType::VK_DESCRIPTOR_TYPE_SAMPLER;
+						break;
+					case OpTypeSampledImage:
+						Binding.Type = ID[Resource.Element].Dim == DimBuffer ? VkDescriptorType::VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER : VkDescriptorType::VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+						break;
+					case OpTypeImage:
+						if (Resource.Dim == DimSubpassData) {
+							Binding.Type = VkDescriptorType::VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT;
+						}
+						else if (Resource.Dim == DimBuffer) {
+							Binding.Type = Resource.Sampled == 2 ? VkDescriptorType::VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER : VkDescriptorType::VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER;
+						}
+						else {
+							Binding.Type = Resource.Sampled == 2 ? VkDescriptorType::VK_DESCRIPTOR_TYPE_STORAGE_IMAGE : VkDescriptorType::VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+						}
+						break;
+					case OpTypeAccelerationStructureKHR:
+						Binding.Type = VkDescriptorType::VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR;
+						break;
+					case OpTypeStruct:
+						if ((Var.StorageClass == StorageClassStorageBuffer) || (Resource.isBufferBlock)) {
+							Binding.Type = VkDescriptorType::VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+						}
+						else if (Resource.isBlock) {
+							Binding.Type = VkDescriptorType::VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+						}
+						Binding.Size		= spv_size_of(ID, Type, 0);
+						Binding.Variable	= spv_variable_of(ID, Type, Var.Name.c_str());
+						break;
+					default:
+						break;
+					}
+					if (Binding.Type != VkDescriptorType::VK_DESCRIPTOR_TYPE_MAX_ENUM) {
+						this->Binding.push_back(Binding);
+					}
+				}
+				break;
+			case StorageClassPushConstant:
+				if (Resource.Op == OpTypeStruct) {
+					push_constant PushConstant;
+					uint32_t Begin = UINT32_MAX;
+					for (size_t m = 0; m < Resource.MemberInfo.size() && m < Resource.Member.size(); m++) {
+						if (Resource.MemberInfo[m].Offset < Begin) Begin = Resource.MemberInfo[m].Offset;
+					}
+					if (Begin == UINT32_MAX) Begin = 0;
+					PushConstant.Stage		= aStage;
+					PushConstant.Offset		= Begin;
+					PushConstant.Size		= spv_size_of(ID, Type, 0) - Begin;
+					PushConstant.Name		= Var.Name;
+					PushConstant.Variable	= spv_variable_of(ID, Type, Var.Name.c_str());
+					this->PushConstant.push_back(PushConstant);
+				}
+				break;
+			case StorageClassInput:
+			case StorageClassOutput:
+				{
+					// Built-ins are not user interface.
+					if ((Var.isBuiltIn) || (!Var.hasLocation)) break;
+					bool isBuiltInBlock = false;
+					for (size_t m = 0; m < Resource.MemberInfo.size(); m++) {
+						isBuiltInBlock |= Resource.MemberInfo[m].isBuiltIn;
+					}
+					if (isBuiltInBlock) break;
+
+					std::vector<attribute>& List = (Var.StorageClass == StorageClassInput) ? this->Input : this->Output;
+					// Matrices take one location per column, arrays one per element.
+					uint32_t ColumnCount = 1;
+					uint32_t ColumnType = Type;
+					if (Resource.Op == OpTypeMatrix) {
+						ColumnCount = Resource.Length;
+						ColumnType = Resource.Element;
+					}
+					uint32_t ElementCount = DescriptorCount > 0 ? DescriptorCount : 1;
+					for (uint32_t e = 0; e < ElementCount * ColumnCount; e++) {
+						attribute Attribute;
+						Attribute.Location	= Var.Location + e;
+						Attribute.Format	= spv_format_of(ID, ColumnType);
+						Attribute.Size		= spv_size_of(ID, ColumnType, 0);
+						Attribute.Name		= Var.Name;
+						if (e == 0) {
+							Attribute.Variable = spv_variable_of(ID, Pointer.Element, Var.Name.c_str());
+						}
+						List.push_back(Attribute);
+					}
+				}
+				break;
+			default:
+				break;
+			}
+		}
+
+		return true;
+	}
+
+	void shader_reflection::clear() {
+		this->Stage = (VkShaderStageFlagBits)0;
+		this->Binding.clear();
+		this->PushConstant.clear();
+		this->Input.clear();
+		this->Output.clear();
+		this->LocalSize[0] = 0;
+		this->LocalSize[1] = 0;
+		this->LocalSize[2] = 0;
+	}
+
+}
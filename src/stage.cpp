@@ -1,11 +1,14 @@
 #include <geodesuka/engine.h>
 #include <geodesuka/core/stage.h>
 
+#include <geodesuka/core/logic/frustum_culler.h>
+
 namespace geodesuka::core {
 
 	stage_t::stage_t(engine* aEngine, gcl::context* aContext) {
 		Engine				= aEngine;
 		Context				= aContext;
+		SpatialStamp		= 0;
 
 		isReadyToBeProcessed.store(false);
 		if (Engine->StateID != engine::state::id::CREATION) {
@@ -56,6 +59,7 @@ namespace geodesuka::core {
 		for (size_t i = 0; i < this->RenderTarget.size(); i++) {
 			this->RenderTarget[i]->FrameRateTimer.update(aDeltaTime);
 		}
+		this->update_spatial();
 		this->Mutex.unlock();
 		return TransferBatch;
     }
@@ -96,4 +100,73 @@ namespace geodesuka::core {
 		return Batch;
 	}
 
+	size_t stage_t::query(float3 aMin, float3 aMax, std::vector<object_t*>& aObject) {
+		std::vector<void*> Result;
+		this->Spatial.query(logic::bvh::aabb{ aMin, aMax }, Result);
+		aObject.resize(Result.size());
+		for (size_t i = 0; i < Result.size(); i++) {
+			aObject[i] = (object_t*)Result[i];
+		}
+		return aObject.size();
+	}
+
+	size_t stage_t::query(const float4x4& aViewProjection, std::vector<object_t*>& aObject) {
+		float4 Plane[6];
+		std::vector<void*> Result;
+		logic::frustum_culler::extract_planes(aViewProjection, Plane);
+		this->Spatial.query(Plane, Result);
+		aObject.resize(Result.size());
+		for (size_t i = 0; i < Result.size(); i++) {
+			aObject[i] = (object_t*)Result[i];
+		}
+		return aObject.size();
+	}
+
+	void stage_t::pick(size_t aRayCount, const logic::bvh::ray* aRay, object_t** aObject, float* aDistance) {
+		std::vector<logic::bvh::hit> Hit(aRayCount);
+		this->Spatial.raycast(aRayCount, aRay, Hit.data());
+		for (size_t i = 0; i < aRayCount; i++) {
+			aObject[i] = (object_t*)Hit[i].UserData;
+			aDistance[i] = Hit[i].Distance;
+		}
+	}
+
+	void stage_t::update_spatial() {
+		this->SpatialStamp += 1;
+		for (size_t i = 0; i < this->Object.size(); i++) {
+			logic::bvh::aabb Bounds;
+			if (!this->Object[i]->get_bounds(Bounds.Min, Bounds.Max)) continue;
+			auto it = this->SpatialEntry.find(this->Object[i]);
+			if (it == this->SpatialEntry.end()) {
+				spatial_entry Entry;
+				Entry.Handle	= this->Spatial.insert(Bounds, this->Object[i]);
+				Entry.Stamp		= this->SpatialStamp;
+				Entry.Bounds	= Bounds;
+				this->SpatialEntry[this->Object[i]] = Entry;
+				continue;
+			}
+			const logic::bvh::aabb& Old = it->second.Bounds;
+			if ((Old.Min.x != Bounds.Min.x) || (Old.Min.y != Bounds.Min.y) || (Old.Min.z != Bounds.Min.z)
+				|| (Old.Max.x != Bounds.Max.x) || (Old.Max.y != Bounds.Max.y) || (Old.Max.z != Bounds.Max.z)) {
+				this->Spatial.move(it->second.Handle, Bounds);
+				it->second.Bounds = Bounds;
+			}
+			it->second.Stamp = this->SpatialStamp;
+		}
+
+		// Objects removed from the stage, or which lost their bounds.
+		for (auto it = this->SpatialEntry.begin(); it != this->SpatialEntry.end();) {
+			if (it->second.Stamp != this->SpatialStamp) {
+				this->Spatial.remove(it->second.Handle);
+				it = this->SpatialEntry.erase(it);
+			}
+			else {
+				++it;
+			}
+		}
+
+		// Refit what moved, rebuild if the tree degraded.
+		this->Spatial.maintain();
+	}
+
 }
@@ -215,11 +215,11 @@ namespace geodesuka::core::object {
 		CreateInfo.clipped					= (VkBool32)aProperty.Swapchain.Clipped;
 		CreateInfo.oldSwapchain				= VK_NULL_HANDLE;
 
-		Result = vkCreateSwapchainKHR(Context->handle(), &CreateInfo, NULL, &Swapchain);
+		Result = Context->api().vkCreateSwapchainKHR(Context->handle(), &CreateInfo, NULL, &Swapchain);
 
-		Result = vkGetSwapchainImagesKHR(this->Context->handle(), Swapchain, &FrameCount, NULL);
+		Result = this->Context->api().vkGetSwapchainImagesKHR(this->Context->handle(), Swapchain, &FrameCount, NULL);
 		std::vector<VkImage> Image(FrameCount);
-		Result = vkGetSwapchainImagesKHR(this->Context->handle(), Swapchain, &FrameCount, Image.data());
+		Result = this->Context->api().vkGetSwapchainImagesKHR(this->Context->handle(), Swapchain, &FrameCount, Image.data());
 
 		Frame = new image[FrameCount];
 
@@ -261,14 +261,14 @@ namespace geodesuka::core::object {
 			ImageViewCreateInfo.subresourceRange.baseArrayLayer		= 0;
 			ImageViewCreateInfo.subresourceRange.layerCount			= 1;
 
-			Result = vkCreateImageView(Context->handle(), &ImageViewCreateInfo, NULL, &FrameAttachment[i][0]);
+			Result = Context->api().vkCreateImageView(Context->handle(), &ImageViewCreateInfo, NULL, &FrameAttachment[i][0]);
 
 			VkSemaphoreCreateInfo SemaphoreCreateInfo{};
 			SemaphoreCreateInfo.sType = VkStructureType::VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
 			SemaphoreCreateInfo.pNext = NULL;
 			SemaphoreCreateInfo.flags = 0;
-			Result = vkCreateSemaphore(Context->handle(), &SemaphoreCreateInfo, NULL, &NextImageSemaphore[i]);
-			Result = vkCreateSemaphore(Context->handle(), &SemaphoreCreateInfo, NULL, &RenderOperationSemaphore[i]);
+			Result = Context->api().vkCreateSemaphore(Context->handle(), &SemaphoreCreateInfo, NULL, &NextImageSemaphore[i]);
+			Result = Context->api().vkCreateSemaphore(Context->handle(), &SemaphoreCreateInfo, NULL, &RenderOperationSemaphore[i]);
 
 			PresentIndex[i] = i;
 			PresentResult[i] = VkResult::VK_SUCCESS;
@@ -440,11 +440,11 @@ namespace geodesuka::core::object {
 		CreateInfo.clipped					= (VkBool32)aProperty.Swapchain.Clipped;
 		CreateInfo.oldSwapchain				= VK_NULL_HANDLE;
 
-		Result = vkCreateSwapchainKHR(Context->handle(), &CreateInfo, NULL, &Swapchain);
+		Result = Context->api().vkCreateSwapchainKHR(Context->handle(), &CreateInfo, NULL, &Swapchain);
 
-		Result = vkGetSwapchainImagesKHR(Context->handle(), Swapchain, &FrameCount, NULL);
+		Result = Context->api().vkGetSwapchainImagesKHR(Context->handle(), Swapchain, &FrameCount, NULL);
 		std::vector<VkImage> Image(FrameCount);
-		Result = vkGetSwapchainImagesKHR(Context->handle(), Swapchain, &FrameCount, Image.data());
+		Result = Context->api().vkGetSwapchainImagesKHR(Context->handle(), Swapchain, &FrameCount, Image.data());
 
 		Frame = new image[FrameCount];
 
@@ -486,14 +486,14 @@ namespace geodesuka::core::object {
 			ImageViewCreateInfo.subresourceRange.baseArrayLayer		= 0;
 			ImageViewCreateInfo.subresourceRange.layerCount			= 1;
 
-			Result = vkCreateImageView(Context->handle(), &ImageViewCreateInfo, NULL, &FrameAttachment[i][0]);
+			Result = Context->api().vkCreateImageView(Context->handle(), &ImageViewCreateInfo, NULL, &FrameAttachment[i][0]);
 
 			VkSemaphoreCreateInfo SemaphoreCreateInfo{};
 			SemaphoreCreateInfo.sType = VkStructureType::VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
 			SemaphoreCreateInfo.pNext = NULL;
 			SemaphoreCreateInfo.flags = 0;
-			vkCreateSemaphore(Context->handle(), &SemaphoreCreateInfo, NULL, &NextImageSemaphore[i]);
-			vkCreateSemaphore(Context->handle(), &SemaphoreCreateInfo, NULL, &RenderOperationSemaphore[i]);
+			Context->api().vkCreateSemaphore(Context->handle(), &SemaphoreCreateInfo, NULL, &NextImageSemaphore[i]);
+			Context->api().vkCreateSemaphore(Context->handle(), &SemaphoreCreateInfo, NULL, &RenderOperationSemaphore[i]);
 
 			PresentIndex[i] = i;
 			PresentResult[i] = VkResult::VK_SUCCESS;
@@ -647,18 +647,20 @@ namespace geodesuka::core::object {
 			}
 			CreateInfo.clipped					= VK_TRUE;
 
-			vkCreateSwapchainKHR(Context->handle(), &CreateInfo, NULL, &Swapchain);
+			Context->api().vkCreateSwapchainKHR(Context->handle(), &CreateInfo, NULL, &Swapchain);
 		}
 
 		if (Swapchain != VK_NULL_HANDLE) {
-			vkGetSwapchainImagesKHR(Context->handle(), Swapchain, &FrameCount, NULL);
+			Context->api().vkGetSwapchainImagesKHR(Context->handle(), Swapchain, &FrameCount, NULL);
 			std::vector<VkImage> sImage(FrameCount);
-			vkGetSwapchainImagesKHR(Context->handle(), Swapchain, &FrameCount, sImage.data());
+			Context->api().vkGetSwapchainImagesKHR(Context->handle(), Swapchain, &FrameCount, sImage.data());
 
 			FrameRateTimer.set(1.0 / FrameRate);
 
 			FrameAttachmentDescription = (VkAttachmentDescription*)malloc(FrameAttachmentCount * sizeof(VkAttachmentDescription));
+			FrameAttachmentClearValue = (VkClearValue*)malloc(FrameAttachmentCount * sizeof(VkClearValue));
 			FrameAttachment = (VkImageView**)malloc(FrameCount * sizeof(VkImageView*));
+			FrameImage = (VkImage**)malloc(FrameCount * sizeof(VkImage*));
 			DrawCommandCount = (uint32_t*)malloc(FrameCount * sizeof(uint32_t));
 			DrawCommandList = (VkCommandBuffer**)malloc(FrameCount * sizeof(VkCommandBuffer*));
 			NextImageSemaphore = (VkSemaphore*)malloc(FrameCount * sizeof(VkSemaphore));
@@ -668,16 +670,22 @@ namespace geodesuka::core::object {
 			Presentation = (VkPresentInfoKHR*)malloc(FrameCount * sizeof(VkPresentInfoKHR));
 			PipelineStageFlags = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
 
-			if (FrameAttachment != NULL) {
+			if ((FrameAttachment != NULL) && (FrameImage != NULL)) {
 				for (int i = 0; i < FrameCount; i++) {
 					DrawCommandCount[i] = 0;
 					DrawCommandList[i] = NULL;
 					FrameAttachment[i] = (VkImageView*)malloc(FrameAttachmentCount * sizeof(VkImageView));
+					FrameImage[i] = (VkImage*)malloc(FrameAttachmentCount * sizeof(VkImage));
 					if (FrameAttachment[i] != NULL) {
 						for (int j = 0; j < FrameAttachmentCount; j++) {
 							FrameAttachment[i][j] = VK_NULL_HANDLE;
 						}
 					}
+					if (FrameImage[i] != NULL) {
+						for (int j = 0; j < FrameAttachmentCount; j++) {
+							FrameImage[i][j] = VK_NULL_HANDLE;
+						}
+					}
 				}
 			}
 
@@ -690,6 +698,10 @@ namespace geodesuka::core::object {
 			FrameAttachmentDescription[0].initialLayout		= VK_IMAGE_LAYOUT_UNDEFINED;
 			FrameAttachmentDescription[0].finalLayout		= VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
 
+			if (FrameAttachmentClearValue != NULL) {
+				FrameAttachmentClearValue[0].color			= { { 0.0f, 0.0f, 0.0f, 1.0f } };
+			}
+
 			for (int i = 0; i < FrameCount; i++) {
 				VkImageViewCreateInfo ImageViewCreateInfo{};
 				ImageViewCreateInfo.sType									= VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
@@ -706,14 +718,15 @@ namespace geodesuka::core::object {
 				ImageViewCreateInfo.subresourceRange.baseArrayLayer			= 0;
 				ImageViewCreateInfo.subresourceRange.layerCount				= 1;
 
-				vkCreateImageView(Context->handle(), &ImageViewCreateInfo, NULL, &FrameAttachment[i][0]);
+				Context->api().vkCreateImageView(Context->handle(), &ImageViewCreateInfo, NULL, &FrameAttachment[i][0]);
+				FrameImage[i][0] = sImage[i];
 
 				VkSemaphoreCreateInfo SemaphoreCreateInfo{};
 				SemaphoreCreateInfo.sType = VkStructureType::VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
 				SemaphoreCreateInfo.pNext = NULL;
 				SemaphoreCreateInfo.flags = 0;
-				vkCreateSemaphore(Context->handle(), &SemaphoreCreateInfo, NULL, &NextImageSemaphore[i]);
-				vkCreateSemaphore(Context->handle(), &SemaphoreCreateInfo, NULL, &RenderOperationSemaphore[i]);
+				Context->api().vkCreateSemaphore(Context->handle(), &SemaphoreCreateInfo, NULL, &NextImageSemaphore[i]);
+				Context->api().vkCreateSemaphore(Context->handle(), &SemaphoreCreateInfo, NULL, &RenderOperationSemaphore[i]);
 
 				PresentIndex[i]		= i;
 				PresentResult[i]	= VkResult::VK_SUCCESS;
@@ -728,6 +741,9 @@ namespace geodesuka::core::object {
 				Presentation[i].pResults				= &PresentResult[i];
 
 			}
+
+			// One render pass instance per frame for all objects.
+			make_frame_pack();
 		}
 
 		isReadyToBeProcessed.store(true);
@@ -761,7 +777,7 @@ namespace geodesuka::core::object {
 		NextImageSemaphoreIndex = ((NextImageSemaphoreIndex == (FrameCount - 1)) ? 0 : (NextImageSemaphoreIndex + 1));
 		// This function is fucking retarded when it comes to semaphores. Because I cannot know that the next frame index is before setting a signal
 		// semaphore, I have iterate through an unmatched semaphore array to 
-		vkAcquireNextImageKHR(Context->handle(), Swapchain, UINT64_MAX, NextImageSemaphore[NextImageSemaphoreIndex], VK_NULL_HANDLE, &FrameDrawIndex);
+		Context->api().vkAcquireNextImageKHR(Context->handle(), Swapchain, UINT64_MAX, NextImageSemaphore[NextImageSemaphoreIndex], VK_NULL_HANDLE, &FrameDrawIndex);
 		Mutex.unlock();
 	}
 
@@ -771,33 +787,14 @@ namespace geodesuka::core::object {
 		DrawBatch.pNext	= NULL;
 		this->Mutex.lock();
 
-		// If memory container not the same size, change size.
-		if (DrawCommandCount[FrameDrawIndex] != aObjectCount) {
-			void* nptr = NULL;
-			if (DrawCommandList[FrameDrawIndex] == NULL) {
-				nptr = malloc(aObjectCount * sizeof(VkCommandBuffer));
-			}
-			else if (DrawCommandCount[FrameDrawIndex] != aObjectCount) {
-				nptr = realloc(DrawCommandList[FrameDrawIndex], aObjectCount * sizeof(VkCommandBuffer));
-			}
-
-			// Check if NULL.	
-			assert(nptr != NULL);
-
-			if (nptr != this->DrawCommandList[this->FrameDrawIndex]) this->DrawCommandList[this->FrameDrawIndex] = (VkCommandBuffer*)nptr;
-			DrawCommandCount[FrameDrawIndex] = aObjectCount;
-		}		
-
-		// Segfault anyways if mem alloc failure.
-		for (size_t i = 0; i < aObjectCount; i++) {
-			DrawCommandList[FrameDrawIndex][i] = aObject[i]->draw(this);
-		}
+		// Objects record into one frame scope, only its primary is submitted.
+		VkCommandBuffer FrameCommand = this->record_frame(aObjectCount, aObject);
 
 		DrawBatch.waitSemaphoreCount	= 1;
 		DrawBatch.pWaitSemaphores		= &this->NextImageSemaphore[this->NextImageSemaphoreIndex];
 		DrawBatch.pWaitDstStageMask		= &this->PipelineStageFlags;
-		DrawBatch.commandBufferCount	= this->DrawCommandCount[this->FrameDrawIndex];
-		DrawBatch.pCommandBuffers		= this->DrawCommandList[this->FrameDrawIndex];
+		DrawBatch.commandBufferCount	= FrameCommand != VK_NULL_HANDLE ? 1 : 0;
+		DrawBatch.pCommandBuffers		= FrameCommand != VK_NULL_HANDLE ? &this->FramePack->Command[this->FrameDrawIndex] : NULL;
 		DrawBatch.signalSemaphoreCount	= 1;
 		DrawBatch.pSignalSemaphores		= &this->RenderOperationSemaphore[this->FrameDrawIndex];
 		this->Mutex.unlock();
@@ -902,9 +899,15 @@ namespace geodesuka::core::object {
 		FrameAttachmentCount = 0;
 		FrameAttachmentDescription = NULL;
 		FrameAttachment = NULL;
+		FrameImage = NULL;
+		FrameAttachmentClearValue = NULL;
 		FrameDrawIndex = 0;
 		DrawCommandCount = NULL;
 		DrawCommandList = NULL;
+		FramePack = nullptr;
+		DrawQueue = nullptr;
+		QueuePack = nullptr;
+		BlendQueuePack = nullptr;
 
 		Title = "";
 		Size = float2(0.0, 0.0);
@@ -928,12 +931,17 @@ namespace geodesuka::core::object {
 
 	void system_window::clear_all() {
 		if (Context != nullptr) {
+			clear_frame_pack();
+			// Shared framebuffers on these views must not be handed out anymore.
 			for (int i = 0; i < FrameCount; i++) {
-				vkDestroySemaphore(Context->handle(), RenderOperationSemaphore[i], NULL);
-				vkDestroySemaphore(Context->handle(), NextImageSemaphore[i], NULL);
-				vkDestroyImageView(Context->handle(), FrameAttachment[i][0], NULL);
+				Context->renderpasses()->invalidate(FrameAttachmentCount, FrameAttachment[i]);
 			}
-			vkDestroySwapchainKHR(Context->handle(), Swapchain, NULL);
+			for (int i = 0; i < FrameCount; i++) {
+				Context->api().vkDestroySemaphore(Context->handle(), RenderOperationSemaphore[i], NULL);
+				Context->api().vkDestroySemaphore(Context->handle(), NextImageSemaphore[i], NULL);
+				Context->api().vkDestroyImageView(Context->handle(), FrameAttachment[i][0], NULL);
+			}
+			Context->api().vkDestroySwapchainKHR(Context->handle(), Swapchain, NULL);
 			vkDestroySurfaceKHR(Engine->handle(), Surface, NULL);
 			system_window::destroy_window_handle(Handle);
 		}
@@ -956,6 +964,13 @@ namespace geodesuka::core::object {
 				free(FrameAttachment);
 			}
 		}
+		if (FrameImage != NULL) {
+			for (int i = 0; i < FrameCount; i++) {
+				free(FrameImage[i]);
+			}
+		}
+		free(FrameImage);
+		free(FrameAttachmentClearValue);
 		free(FrameAttachmentDescription);
 
 	}
@@ -1,4 +1,5 @@
 #include <geodesuka/builtin/object/triangle.h>
+#include <geodesuka/builtin/embedded_shader.h>
 
 #include <geodesuka/engine.h>
 
@@ -52,96 +53,14 @@ namespace geodesuka::builtin::object {
 		//		PixelColor = vec4(InterpColor, 1.0);\n\
 		//	}";
 
-		const char* VertexShaderSource =
-			"#version 450														\n\
-																				\n\
-			vec2 VertexPosition[3] = vec2[](									\n\
-			    vec2(0.0, -0.5),												\n\
-			    vec2(0.5, 0.5),													\n\
-			    vec2(-0.5, 0.5)													\n\
-			);																	\n\
-																				\n\
-			vec3 VertexColor[3] = vec3[](										\n\
-				vec3(1.0, 0.0, 0.0),											\n\
-				vec3(0.0, 1.0, 0.0),											\n\
-				vec3(0.0, 0.0, 1.0)												\n\
-			);																	\n\
-																				\n\
-			layout (location = 0) out vec3 InterpColor;							\n\
-																				\n\
-			void main() {														\n\
-			    gl_Position = vec4(VertexPosition[gl_VertexIndex], 0.0, 1.0);	\n\
-				InterpColor = VertexColor[gl_VertexIndex];						\n\
-			}";
-
-		const char* PixelShaderSource =
-			"#version 450										\n\
-																\n\
-			layout (location = 0) in vec3 InterpColor;			\n\
-																\n\
-			layout(location = 0) out vec4 PixelColor;			\n\
-																\n\
-			void main() {										\n\
-				PixelColor = vec4(InterpColor, 1.0);			\n\
-			}";
-
-		// Could glslang be a point of error for why a triangle is not rendering?
-		VertexShader = new shader(Context, shader::stage::VERTEX, VertexShaderSource);
-		PixelShader = new shader(Context, shader::stage::FRAGMENT, PixelShaderSource);
-
-		// ----- Render Pass Construction ----- //
-
-		VkAttachmentReference colorAttachmentRef{};
-		colorAttachmentRef.attachment = 0;
-		colorAttachmentRef.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-
-		VkSubpassDescription subpass{};
-		subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
-		subpass.colorAttachmentCount = 1;
-		subpass.pColorAttachments = &colorAttachmentRef;
-
-		VkSubpassDependency dependency{};
-		dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
-		dependency.dstSubpass = 0;
-		dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-		dependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-		dependency.srcAccessMask = 0;
-		dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-
-		VkRenderPassCreateInfo RenderPassCreateInfo{};
-		RenderPassCreateInfo.sType				= VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
-		RenderPassCreateInfo.pNext				= NULL;
-		RenderPassCreateInfo.flags				;
-		RenderPassCreateInfo.attachmentCount	= Stage->RenderTarget[0]->FrameAttachmentCount;
-		RenderPassCreateInfo.pAttachments		= Stage->RenderTarget[0]->FrameAttachmentDescription;
-		RenderPassCreateInfo.subpassCount		= 1;
-		RenderPassCreateInfo.pSubpasses			= &subpass;
-		RenderPassCreateInfo.dependencyCount	= 1;
-		RenderPassCreateInfo.pDependencies		= &dependency;
-
-		if (vkCreateRenderPass(Context->handle(), &RenderPassCreateInfo, nullptr, &RenderPass) != VK_SUCCESS) {
-			throw std::runtime_error("failed to create render pass!");
-		}
-
-		FrameBuffer.resize(Stage->RenderTarget[0]->FrameCount);
-		for (uint32_t i = 0; i < Stage->RenderTarget[0]->FrameCount; i++) {
-			VkFramebufferCreateInfo FrameBufferCreateInfo{};
-			FrameBufferCreateInfo.sType				= VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
-			FrameBufferCreateInfo.pNext				= NULL;
-			FrameBufferCreateInfo.flags				= 0;
-			FrameBufferCreateInfo.renderPass		= RenderPass;
-			FrameBufferCreateInfo.attachmentCount	= Stage->RenderTarget[0]->FrameAttachmentCount;
-			FrameBufferCreateInfo.pAttachments		= Stage->RenderTarget[0]->FrameAttachment[i];
-			FrameBufferCreateInfo.width				= Stage->RenderTarget[0]->Resolution.x;
-			FrameBufferCreateInfo.height			= Stage->RenderTarget[0]->Resolution.y;
-			FrameBufferCreateInfo.layers			= 1;
-
-			vkCreateFramebuffer(Context->handle(), &FrameBufferCreateInfo, NULL, &FrameBuffer[i]);
-		}
+		// Sources in res/shader/builtin, precompiled at build time when possible.
+		VertexShader = embedded_shader::create(Context, "triangle.vert");
+		PixelShader = embedded_shader::create(Context, "triangle.frag");
 
-		// ----- Command Buffer Construction ----- //
-		CommandBuffer.resize(Stage->RenderTarget[0]->FrameCount);
-		Stage->RenderTarget[0]->DrawCommandPool.allocate(VK_COMMAND_BUFFER_LEVEL_PRIMARY, CommandBuffer.size(), CommandBuffer.data());
+		// Records into the frame scope of the rendertarget, which owns the
+		// render pass (or dynamic rendering scope) and clears the frame.
+		DrawPack.try_emplace(Stage->RenderTarget[0], new drawpack(Context, Stage->RenderTarget[0]));
+		drawpack* Pack = DrawPack[Stage->RenderTarget[0]];
 
 		// ----- Graphics Pipeline Constrcution ----- //
 
@@ -218,12 +137,9 @@ namespace geodesuka::builtin::object {
 		colorBlending.blendConstants[2] = 0.0f;
 		colorBlending.blendConstants[3] = 0.0f;
 
-		VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
-		pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-		pipelineLayoutInfo.setLayoutCount = 0;
-		pipelineLayoutInfo.pushConstantRangeCount = 0;
-
-		if (vkCreatePipelineLayout(Context->handle(), &pipelineLayoutInfo, nullptr, &PipelineLayout) != VK_SUCCESS) {
+		// Shared through the context, identical triangles then share one pipeline.
+		PipelineLayout = Context->layouts()->pipeline_layout(0, NULL, 0, NULL);
+		if (PipelineLayout == VK_NULL_HANDLE) {
 			throw std::runtime_error("failed to create pipeline layout!");
 		}
 
@@ -238,51 +154,16 @@ namespace geodesuka::builtin::object {
 		pipelineInfo.pMultisampleState = &multisampling;
 		pipelineInfo.pColorBlendState = &colorBlending;
 		pipelineInfo.layout = PipelineLayout;
-		pipelineInfo.renderPass = RenderPass;
 		pipelineInfo.subpass = 0;
 		pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
+		Pack->pipeline(pipelineInfo);
 
-		if (vkCreateGraphicsPipelines(Context->handle(), VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &Pipeline) != VK_SUCCESS) {
+		Pipeline = Context->pipelines()->acquire(pipelineInfo);
+		if (Pipeline == VK_NULL_HANDLE) {
 			throw std::runtime_error("failed to create graphics pipeline!");
 		}
 
-		// ----- Record Draw Commands ----- //
-
-		for (uint32_t i = 0; i < Stage->RenderTarget[0]->FrameCount; i++) {
-			VkCommandBufferBeginInfo CommandBufferBeginInfo{};
-			VkRenderPassBeginInfo RenderPassBeginInfo{};
-			VkClearValue ClearColor = { {{0.0f, 0.0f, 0.0f, 1.0f}} };
-
-			CommandBufferBeginInfo.sType				= VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-			CommandBufferBeginInfo.pNext				= NULL;
-			CommandBufferBeginInfo.flags				= 0;
-			CommandBufferBeginInfo.pInheritanceInfo		= NULL;
-
-			RenderPassBeginInfo.sType					= VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-			RenderPassBeginInfo.renderPass				= RenderPass;
-			RenderPassBeginInfo.framebuffer				= FrameBuffer[i];
-			RenderPassBeginInfo.renderArea.offset		= { 0, 0 };
-			RenderPassBeginInfo.renderArea.extent		= { Stage->RenderTarget[0]->Resolution.x, Stage->RenderTarget[0]->Resolution.y };
-			RenderPassBeginInfo.clearValueCount			= 1;
-			RenderPassBeginInfo.pClearValues			= &ClearColor;
-
-			if (vkBeginCommandBuffer(CommandBuffer[i], &CommandBufferBeginInfo) != VK_SUCCESS) {
-				throw std::runtime_error("failed to begin recording command buffer!");
-			}
-
-			vkCmdBeginRenderPass(CommandBuffer[i], &RenderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
-
-			vkCmdBindPipeline(CommandBuffer[i], VK_PIPELINE_BIND_POINT_GRAPHICS, Pipeline);
-
-			vkCmdDraw(CommandBuffer[i], 3, 1, 0, 0);
-
-			vkCmdEndRenderPass(CommandBuffer[i]);
-
-			if (vkEndCommandBuffer(CommandBuffer[i]) != VK_SUCCESS) {
-				throw std::runtime_error("failed to record command buffer!");
-			}
-		}
-
+		// Draw commands are recorded in record() on first use.
 
 		//type VertexLayoutType(type::id::STRUCT, "");
 		//VertexLayoutType.push(type::id::FLOAT3, "Position");
@@ -591,14 +472,22 @@ namespace geodesuka::builtin::object {
 
 	triangle::~triangle() {
 		isReadyToBeProcessed.store(false);
+		Context->pipelines()->release(Pipeline);
 		// Delete Drawpack
+		for (auto it = DrawPack.begin(); it != DrawPack.end(); it++) {
+			delete it->second;
+		}
+		DrawPack.clear();
 		delete PixelShader;
 		delete VertexShader;
 		delete VertexBuffer;
 	}
 
-	VkCommandBuffer triangle::draw(core::object::rendertarget* aRenderTarget) {
-		return CommandBuffer[aRenderTarget->FrameDrawIndex];
+	void triangle::record(core::object::rendertarget* aRenderTarget, uint32_t aFrameIndex, VkCommandBuffer aCommandBuffer) {
+		// Nothing changes per frame, recorded once per frame image.
+		command_encoder Encoder(Context, aCommandBuffer);
+		Encoder.bind_pipeline(VK_PIPELINE_BIND_POINT_GRAPHICS, Pipeline);
+		Encoder.draw(3, 1, 0, 0);
 	}
 
 }
@@ -0,0 +1,35 @@
+#pragma once
+#ifndef GEODESUKA_TEST_TEST_H
+#define GEODESUKA_TEST_TEST_H
+
+/*
+* Usage:
+*	Minimal harness for the host side unit tests, one executable per file.
+*		TEST_CHECK(Count == 3);
+*		...
+*		return test_result();
+*
+*	Failed checks are printed with file and line, the exit code is non zero
+*	if any check failed.
+*/
+
+#include <stdio.h>
+
+static int TestCheckCount = 0;
+static int TestFailCount = 0;
+
+#define TEST_CHECK(aCondition) \
+	do { \
+		TestCheckCount += 1; \
+		if (!(aCondition)) { \
+			TestFailCount += 1; \
+			printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #aCondition); \
+		} \
+	} while (0)
+
+static inline int test_result() {
+	printf("%d checks, %d failed\n", TestCheckCount, TestFailCount);
+	return TestFailCount > 0 ? 1 : 0;
+}
+
+#endif // !GEODESUKA_TEST_TEST_H
@@ -0,0 +1,225 @@
+#include <geodesuka/core/logic/bvh.h>
+
+#include <float.h>
+#include <math.h>
+
+#include <vector>
+#include <algorithm>
+
+#include "test.h"
+
+using namespace geodesuka::core;
+using namespace geodesuka::core::logic;
+
+static uint32_t Seed = 0x2545F491;
+
+static float random_float(float aMin, float aMax) {
+	Seed = Seed * 1664525u + 1013904223u;
+	return aMin + (aMax - aMin) * (float)(Seed >> 8) / (float)(1u << 24);
+}
+
+static bvh::aabb random_box() {
+	float3 Center(random_float(-100.0f, 100.0f), random_float(-100.0f, 100.0f), random_float(-100.0f, 100.0f));
+	float3 Half(random_float(0.1f, 5.0f), random_float(0.1f, 5.0f), random_float(0.1f, 5.0f));
+	bvh::aabb Box;
+	Box.Min = float3(Center.x - Half.x, Center.y - Half.y, Center.z - Half.z);
+	Box.Max = float3(Center.x + Half.x, Center.y + Half.y, Center.z + Half.z);
+	return Box;
+}
+
+static bool is_overlapping(const bvh::aabb& aLhs, const bvh::aabb& aRhs) {
+	return (aLhs.Min.x <= aRhs.Max.x) && (aLhs.Max.x >= aRhs.Min.x)
+		&& (aLhs.Min.y <= aRhs.Max.y) && (aLhs.Max.y >= aRhs.Min.y)
+		&& (aLhs.Min.z <= aRhs.Max.z) && (aLhs.Max.z >= aRhs.Min.z);
+}
+
+static bool is_in_frustum(const bvh::aabb& aBox, const float4 aPlane[6]) {
+	float3 Center((aBox.Min.x + aBox.Max.x) * 0.5f, (aBox.Min.y + aBox.Max.y) * 0.5f, (aBox.Min.z + aBox.Max.z) * 0.5f);
+	float3 Half((aBox.Max.x - aBox.Min.x) * 0.5f, (aBox.Max.y - aBox.Min.y) * 0.5f, (aBox.Max.z - aBox.Min.z) * 0.5f);
+	for (int p = 0; p < 6; p++) {
+		float Distance = aPlane[p].x * Center.x + aPlane[p].y * Center.y + aPlane[p].z * Center.z + aPlane[p].t;
+		float Extent = fabsf(aPlane[p].x) * Half.x + fabsf(aPlane[p].y) * Half.y + fabsf(aPlane[p].z) * Half.z;
+		if (Distance + Extent < 0.0f) return false;
+	}
+	return true;
+}
+
+// Same slab test as the tree, FLT_MAX if missed.
+static float intersect(const bvh::aabb& aBox, const bvh::ray& aRay) {
+	float3 Inverse(1.0f / aRay.Direction.x, 1.0f / aRay.Direction.y, 1.0f / aRay.Direction.z);
+	float TX1 = (aBox.Min.x - aRay.Origin.x) * Inverse.x;
+	float TX2 = (aBox.Max.x - aRay.Origin.x) * Inverse.x;
+	float TY1 = (aBox.Min.y - aRay.Origin.y) * Inverse.y;
+	float TY2 = (aBox.Max.y - aRay.Origin.y) * Inverse.y;
+	float TZ1 = (aBox.Min.z - aRay.Origin.z) * Inverse.z;
+	float TZ2 = (aBox.Max.z - aRay.Origin.z) * Inverse.z;
+	float Near = std::max(std::max(std::min(TX1, TX2), std::min(TY1, TY2)), std::min(TZ1, TZ2));
+	float Far = std::min(std::min(std::max(TX1, TX2), std::max(TY1, TY2)), std::max(TZ1, TZ2));
+	Near = std::max(Near, 0.0f);
+	if ((Near > Far) || (Near > aRay.MaxDistance)) return FLT_MAX;
+	return Near;
+}
+
+// Live leaves, user data points at the leaf's own entry.
+struct leaf {
+	uint32_t Handle;
+	bvh::aabb Box;
+	bool isAlive;
+};
+
+static std::vector<void*> sorted(std::vector<void*> aList) {
+	std::sort(aList.begin(), aList.end());
+	return aList;
+}
+
+// Compares box, frustum and ray queries of aTree against brute force over aLeaf.
+static bool matches_brute_force(bvh& aTree, std::vector<leaf>& aLeaf) {
+	size_t AliveCount = 0;
+	for (size_t i = 0; i < aLeaf.size(); i++) {
+		AliveCount += aLeaf[i].isAlive ? 1 : 0;
+	}
+	if (aTree.size() != AliveCount) return false;
+
+	for (int q = 0; q < 20; q++) {
+		bvh::aabb Query = random_box();
+		Query.Min = float3(Query.Min.x - 20.0f, Query.Min.y - 20.0f, Query.Min.z - 20.0f);
+		Query.Max = float3(Query.Max.x + 20.0f, Query.Max.y + 20.0f, Query.Max.z + 20.0f);
+		std::vector<void*> Expected;
+		for (size_t i = 0; i < aLeaf.size(); i++) {
+			if ((aLeaf[i].isAlive) && (is_overlapping(aLeaf[i].Box, Query))) {
+				Expected.push_back(&aLeaf[i]);
+			}
+		}
+		std::vector<void*> Result;
+		aTree.query(Query, Result);
+		if (sorted(Result) != sorted(Expected)) return false;
+	}
+
+	// Ninety degree view down +z from the origin, out to 60.
+	float Half = 1.0f / sqrtf(2.0f);
+	float4 Plane[6] = {
+		float4(Half, 0.0f, Half, 0.0f),
+		float4(-Half, 0.0f, Half, 0.0f),
+		float4(0.0f, Half, Half, 0.0f),
+		float4(0.0f, -Half, Half, 0.0f),
+		float4(0.0f, 0.0f, 1.0f, -1.0f),
+		float4(0.0f, 0.0f, -1.0f, 60.0f)
+	};
+	std::vector<void*> Expected;
+	for (size_t i = 0; i < aLeaf.size(); i++) {
+		if ((aLeaf[i].isAlive) && (is_in_frustum(aLeaf[i].Box, Plane))) {
+			Expected.push_back(&aLeaf[i]);
+		}
+	}
+	std::vector<void*> Result;
+	aTree.query(Plane, Result);
+	if (sorted(Result) != sorted(Expected)) return false;
+
+	std::vector<bvh::ray> Ray(50);
+	for (size_t r = 0; r < Ray.size(); r++) {
+		Ray[r].Origin = float3(random_float(-120.0f, 120.0f), random_float(-120.0f, 120.0f), random_float(-120.0f, 120.0f));
+		Ray[r].Direction = float3(random_float(-1.0f, 1.0f), random_float(-1.0f, 1.0f), random_float(-1.0f, 1.0f));
+		Ray[r].MaxDistance = r % 5 == 0 ? 10.0f : FLT_MAX;
+	}
+	std::vector<bvh::hit> Hit(Ray.size());
+	aTree.raycast(Ray.size(), Ray.data(), Hit.data());
+	for (size_t r = 0; r < Ray.size(); r++) {
+		float Nearest = FLT_MAX;
+		for (size_t i = 0; i < aLeaf.size(); i++) {
+			if (aLeaf[i].isAlive) {
+				Nearest = std::min(Nearest, intersect(aLeaf[i].Box, Ray[r]));
+			}
+		}
+		if (Nearest == FLT_MAX) {
+			if ((Hit[r].Handle != bvh::INVALID_HANDLE) || (Hit[r].UserData != nullptr)) return false;
+			continue;
+		}
+		if ((Hit[r].Handle == bvh::INVALID_HANDLE) || (Hit[r].Distance != Nearest)) return false;
+		// Ties aside, the reported leaf is the one at that distance.
+		const leaf* Leaf = (const leaf*)Hit[r].UserData;
+		if ((Leaf == nullptr) || (!Leaf->isAlive) || (Leaf->Handle != Hit[r].Handle) || (intersect(Leaf->Box, Ray[r]) != Nearest)) return false;
+	}
+	return true;
+}
+
+int main() {
+
+	bvh Tree;
+	std::vector<void*> Result;
+	TEST_CHECK(Tree.size() == 0);
+	TEST_CHECK(Tree.query(random_box(), Result) == 0);
+
+	bvh::ray Ray;
+	Ray.Origin = float3(0.0f, 0.0f, 0.0f);
+	Ray.Direction = float3(0.0f, 0.0f, 1.0f);
+	Ray.MaxDistance = FLT_MAX;
+	bvh::hit Hit;
+	Tree.raycast(1, &Ray, &Hit);
+	TEST_CHECK(Hit.Handle == bvh::INVALID_HANDLE);
+
+	// Reserved up front, user data points into it.
+	std::vector<leaf> Leaf(400);
+	for (size_t i = 0; i < 300; i++) {
+		Leaf[i].Box = random_box();
+		Leaf[i].isAlive = true;
+		Leaf[i].Handle = Tree.insert(Leaf[i].Box, &Leaf[i]);
+	}
+	for (size_t i = 300; i < Leaf.size(); i++) {
+		Leaf[i].isAlive = false;
+		Leaf[i].Handle = bvh::INVALID_HANDLE;
+	}
+	TEST_CHECK(Tree.user_data(Leaf[42].Handle) == &Leaf[42]);
+	TEST_CHECK(matches_brute_force(Tree, Leaf));
+
+	// Moved leaves are found at their new place after refit.
+	for (size_t i = 0; i < 300; i += 3) {
+		Leaf[i].Box = random_box();
+		Tree.move(Leaf[i].Handle, Leaf[i].Box);
+	}
+	Tree.refit();
+	TEST_CHECK(matches_brute_force(Tree, Leaf));
+
+	// Removal, then reuse of freed handles.
+	for (size_t i = 1; i < 300; i += 4) {
+		Tree.remove(Leaf[i].Handle);
+		Leaf[i].isAlive = false;
+	}
+	TEST_CHECK(matches_brute_force(Tree, Leaf));
+	for (size_t i = 300; i < Leaf.size(); i++) {
+		Leaf[i].Box = random_box();
+		Leaf[i].isAlive = true;
+		Leaf[i].Handle = Tree.insert(Leaf[i].Box, &Leaf[i]);
+	}
+	TEST_CHECK(matches_brute_force(Tree, Leaf));
+
+	// A full rebuild answers the same and is no worse than the incremental tree.
+	float IncrementalCost = Tree.cost();
+	Tree.rebuild();
+	TEST_CHECK(Tree.cost() <= IncrementalCost);
+	TEST_CHECK(matches_brute_force(Tree, Leaf));
+
+	// Large moves push the cost up, maintain() refits and rebuilds as needed.
+	for (size_t i = 0; i < Leaf.size(); i++) {
+		if (!Leaf[i].isAlive) continue;
+		Leaf[i].Box = random_box();
+		Tree.move(Leaf[i].Handle, Leaf[i].Box);
+	}
+	Tree.maintain();
+	TEST_CHECK(matches_brute_force(Tree, Leaf));
+
+	// Single leaf tree.
+	Tree.clear();
+	TEST_CHECK(Tree.size() == 0);
+	bvh::aabb Box;
+	Box.Min = float3(-1.0f, -1.0f, 4.0f);
+	Box.Max = float3(1.0f, 1.0f, 6.0f);
+	int Marker = 0;
+	uint32_t Handle = Tree.insert(Box, &Marker);
+	Tree.raycast(1, &Ray, &Hit);
+	TEST_CHECK((Hit.Handle == Handle) && (Hit.UserData == &Marker) && (Hit.Distance == 4.0f));
+	Ray.MaxDistance = 3.0f;
+	Tree.raycast(1, &Ray, &Hit);
+	TEST_CHECK(Hit.Handle == bvh::INVALID_HANDLE);
+
+	return test_result();
+}
@@ -0,0 +1,42 @@
+#include <geodesuka/core/gcl/draw_queue.h>
+
+#include "test.h"
+
+using namespace geodesuka::core;
+using namespace geodesuka::core::gcl;
+
+int main() {
+	typedef draw_queue dq;
+
+	// Pass is the top of the key, whatever else differs.
+	TEST_CHECK(dq::sort_key(dq::OPAQUE, 0xFFF, 0xFFFF, 0xFFFF, 1.0e30f) < dq::sort_key(dq::MASKED, 0, 0, 0, 0.0f));
+	TEST_CHECK(dq::sort_key(dq::MASKED, 0xFFF, 0xFFFF, 0xFFFF, 1.0e30f) < dq::sort_key(dq::TRANSLUCENT, 0, 0, 0, 0.0f));
+	TEST_CHECK(dq::sort_key(dq::TRANSLUCENT, 0xFFF, 0xFFFF, 0xFFFF, 0.0f) < dq::sort_key(dq::OVERLAY, 0, 0, 0, 0.0f));
+
+	// Opaque packets group by pipeline, then material, then mesh, depth last.
+	TEST_CHECK(dq::sort_key(dq::OPAQUE, 1, 0xFFFF, 0xFFFF, 1000.0f) < dq::sort_key(dq::OPAQUE, 2, 0, 0, 0.0f));
+	TEST_CHECK(dq::sort_key(dq::OPAQUE, 1, 1, 0xFFFF, 1000.0f) < dq::sort_key(dq::OPAQUE, 1, 2, 0, 0.0f));
+	TEST_CHECK(dq::sort_key(dq::OPAQUE, 1, 1, 1, 1000.0f) < dq::sort_key(dq::OPAQUE, 1, 1, 2, 0.0f));
+
+	// Within a run, front to back.
+	TEST_CHECK(dq::sort_key(dq::OPAQUE, 1, 1, 1, 1.0f) < dq::sort_key(dq::OPAQUE, 1, 1, 1, 2.0f));
+	TEST_CHECK(dq::sort_key(dq::MASKED, 1, 1, 1, 10.0f) < dq::sort_key(dq::MASKED, 1, 1, 1, 100.0f));
+
+	// Translucent packets go back to front before any state.
+	TEST_CHECK(dq::sort_key(dq::TRANSLUCENT, 0xFFF, 0xFFFF, 0xFFFF, 100.0f) < dq::sort_key(dq::TRANSLUCENT, 0, 0, 0, 10.0f));
+	TEST_CHECK(dq::sort_key(dq::TRANSLUCENT, 1, 1, 1, 5.0f) < dq::sort_key(dq::TRANSLUCENT, 2, 1, 1, 5.0f));
+
+	// Negative depth counts as zero, ids are truncated to their fields.
+	TEST_CHECK(dq::sort_key(dq::OPAQUE, 1, 1, 1, -5.0f) == dq::sort_key(dq::OPAQUE, 1, 1, 1, 0.0f));
+	TEST_CHECK(dq::sort_key(dq::OPAQUE, 0x1001, 0x10001, 0x10001, 0.0f) == dq::sort_key(dq::OPAQUE, 1, 1, 1, 0.0f));
+
+	// Depth is quantized but never out of order.
+	uint64_t Previous = dq::sort_key(dq::OPAQUE, 3, 3, 3, 0.0f);
+	for (float Depth = 0.01f; Depth < 1.0e6f; Depth *= 1.37f) {
+		uint64_t Key = dq::sort_key(dq::OPAQUE, 3, 3, 3, Depth);
+		TEST_CHECK(Key >= Previous);
+		Previous = Key;
+	}
+
+	return test_result();
+}
@@ -0,0 +1,114 @@
+#include <geodesuka/core/logic/frustum_culler.h>
+
+#include <math.h>
+
+#include <vector>
+
+#include "test.h"
+
+using namespace geodesuka::core;
+using namespace geodesuka::core::logic;
+
+static uint32_t Seed = 0x2545F491;
+
+static float random_float(float aMin, float aMax) {
+	Seed = Seed * 1664525u + 1013904223u;
+	return aMin + (aMax - aMin) * (float)(Seed >> 8) / (float)(1u << 24);
+}
+
+// Every supported kernel must produce exactly the scalar list.
+static bool matches_scalar(const frustum_culler& aCuller, const float4 aPlane[6]) {
+	const frustum_culler::kernel Kernel[] = { frustum_culler::SSE, frustum_culler::AVX2, frustum_culler::NEON, frustum_culler::AUTOMATIC };
+	std::vector<uint32_t> Expected;
+	aCuller.cull(aPlane, Expected, frustum_culler::SCALAR);
+	for (size_t k = 0; k < sizeof(Kernel) / sizeof(frustum_culler::kernel); k++) {
+		if (!frustum_culler::is_supported(Kernel[k])) continue;
+		std::vector<uint32_t> Visible;
+		size_t Count = aCuller.cull(aPlane, Visible, Kernel[k]);
+		if ((Count != Expected.size()) || (Visible != Expected)) return false;
+	}
+	return true;
+}
+
+int main() {
+
+	// Ninety degree view down +z, from 1 to 1000.
+	float Half = 1.0f / sqrtf(2.0f);
+	float4 Plane[6] = {
+		float4(Half, 0.0f, Half, 0.0f),
+		float4(-Half, 0.0f, Half, 0.0f),
+		float4(0.0f, Half, Half, 0.0f),
+		float4(0.0f, -Half, Half, 0.0f),
+		float4(0.0f, 0.0f, 1.0f, -1.0f),
+		float4(0.0f, 0.0f, -1.0f, 1000.0f)
+	};
+
+	frustum_culler Culler;
+	std::vector<uint32_t> Visible;
+	TEST_CHECK(Culler.cull(Plane, Visible) == 0);
+
+	// Known cases, scalar reference.
+	uint32_t Inside = Culler.add(float3(0.0f, 0.0f, 10.0f), 1.0f);
+	uint32_t Behind = Culler.add(float3(0.0f, 0.0f, -10.0f), 1.0f);
+	uint32_t Straddle = Culler.add(float3(0.0f, 0.0f, 0.5f), float3(1.0f, 1.0f, 1.0f));
+	uint32_t Beyond = Culler.add(float3(0.0f, 0.0f, 1010.0f), float3(1.0f, 1.0f, 1.0f));
+	TEST_CHECK(Culler.cull(Plane, Visible, frustum_culler::SCALAR) == 2);
+	TEST_CHECK((Visible.size() == 2) && (Visible[0] == Inside) && (Visible[1] == Straddle));
+	(void)Behind;
+	(void)Beyond;
+
+	// Moving a bound into view, removal keeps other handles valid.
+	Culler.update(Beyond, float3(0.0f, 0.0f, 990.0f), float3(1.0f, 1.0f, 1.0f));
+	Culler.remove(Inside);
+	TEST_CHECK(Culler.cull(Plane, Visible, frustum_culler::SCALAR) == 2);
+	TEST_CHECK((Visible.size() == 2) && (Visible[0] != Inside) && (Visible[1] != Inside));
+	Culler.clear();
+	TEST_CHECK(Culler.size() == 0);
+
+	// Random scenes of every size around the block widths, so both vector
+	// blocks and the scalar remainder run.
+	for (size_t Count = 1; Count <= 37; Count++) {
+		Culler.clear();
+		for (size_t i = 0; i < Count; i++) {
+			float3 Center(random_float(-50.0f, 50.0f), random_float(-50.0f, 50.0f), random_float(-10.0f, 60.0f));
+			if ((i & 1) == 0) {
+				Culler.add(Center, random_float(0.5f, 5.0f));
+			}
+			else {
+				Culler.add(Center, float3(random_float(0.5f, 5.0f), random_float(0.5f, 5.0f), random_float(0.5f, 5.0f)));
+			}
+		}
+		TEST_CHECK(matches_scalar(Culler, Plane));
+	}
+
+	// NaN bounds are culled by every kernel, in vector blocks and the remainder.
+	Culler.clear();
+	float NaN = nanf("");
+	for (size_t i = 0; i < 19; i++) {
+		switch (i % 4) {
+		case 0: Culler.add(float3(NaN, 0.0f, 10.0f), 1.0f); break;
+		case 1: Culler.add(float3(0.0f, 0.0f, 10.0f), NaN); break;
+		case 2: Culler.add(float3(0.0f, 0.0f, 10.0f), float3(NaN, 1.0f, 1.0f)); break;
+		default: Culler.add(float3(0.0f, 0.0f, 10.0f), 1.0f); break;
+		}
+	}
+	TEST_CHECK(matches_scalar(Culler, Plane));
+	Culler.cull(Plane, Visible, frustum_culler::SCALAR);
+	TEST_CHECK(Visible.size() == 4);
+
+	// Planes from a matrix keep the point straight ahead and drop the one behind.
+	float4x4 Identity(
+		1.0f, 0.0f, 0.0f, 0.0f,
+		0.0f, 1.0f, 0.0f, 0.0f,
+		0.0f, 0.0f, 1.0f, 0.0f,
+		0.0f, 0.0f, 0.0f, 1.0f
+	);
+	float4 Box[6];
+	frustum_culler::extract_planes(Identity, Box);
+	Culler.clear();
+	uint32_t Center = Culler.add(float3(0.0f, 0.0f, 0.5f), 0.1f);
+	Culler.add(float3(0.0f, 0.0f, -5.0f), 0.1f);
+	TEST_CHECK((Culler.cull(Box, Visible) == 1) && (Visible[0] == Center));
+
+	return test_result();
+}
@@ -0,0 +1,139 @@
+#include <geodesuka/core/gcl/pipeline_cache.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#include <vector>
+#include <string>
+#include <filesystem>
+
+#include "test.h"
+
+using namespace geodesuka::core;
+using namespace geodesuka::core::gcl;
+
+static std::vector<unsigned char> read_file(const std::string& aPath) {
+	std::vector<unsigned char> Byte;
+	FILE* File = fopen(aPath.c_str(), "rb");
+	if (File == NULL) return Byte;
+	int Character;
+	while ((Character = fgetc(File)) != EOF) {
+		Byte.push_back((unsigned char)Character);
+	}
+	fclose(File);
+	return Byte;
+}
+
+static void write_file(const std::string& aPath, const std::vector<unsigned char>& aByte) {
+	FILE* File = fopen(aPath.c_str(), "wb");
+	if (File == NULL) return;
+	fwrite(aByte.data(), 1, aByte.size(), File);
+	fclose(File);
+}
+
+// Driver data as vkGetPipelineCacheData would return it for aProperties.
+static std::vector<uint8_t> driver_data(const VkPhysicalDeviceProperties& aProperties, size_t aBodySize) {
+	std::vector<uint8_t> Data(16 + VK_UUID_SIZE + aBodySize);
+	uint32_t Header[4] = { 16 + VK_UUID_SIZE, VK_PIPELINE_CACHE_HEADER_VERSION_ONE, aProperties.vendorID, aProperties.deviceID };
+	memcpy(&Data[0], Header, sizeof(Header));
+	memcpy(&Data[16], aProperties.pipelineCacheUUID, VK_UUID_SIZE);
+	for (size_t i = 16 + VK_UUID_SIZE; i < Data.size(); i++) {
+		Data[i] = (uint8_t)(i * 31);
+	}
+	return Data;
+}
+
+// Writes aData, lets aCorrupt edit the file, then checks it is rejected and deleted.
+template<typename F>
+static bool rejects(const std::string& aPath, const VkPhysicalDeviceProperties& aProperties, const std::vector<uint8_t>& aData, F aCorrupt) {
+	if (!pipeline_cache::write(aPath, aData)) return false;
+	std::vector<unsigned char> Byte = read_file(aPath);
+	aCorrupt(Byte);
+	write_file(aPath, Byte);
+	return (pipeline_cache::load(aPath, aProperties).size() == 0) && (!std::filesystem::exists(aPath));
+}
+
+int main() {
+
+	std::error_code ErrorCode;
+	std::string Directory = (std::filesystem::temp_directory_path() / "geodesuka_test_pipeline_cache").string();
+	std::filesystem::remove_all(Directory, ErrorCode);
+	std::string Path = Directory + "/cache.bin";
+
+	VkPhysicalDeviceProperties Properties{};
+	Properties.vendorID = 0x10DE;
+	Properties.deviceID = 0x2684;
+	for (uint32_t i = 0; i < VK_UUID_SIZE; i++) {
+		Properties.pipelineCacheUUID[i] = (uint8_t)(i + 1);
+	}
+	std::vector<uint8_t> Data = driver_data(Properties, 100);
+
+	// Nothing there, or persistence off.
+	TEST_CHECK(pipeline_cache::load(Path, Properties).size() == 0);
+	TEST_CHECK(pipeline_cache::load(std::string(), Properties).size() == 0);
+	TEST_CHECK(!pipeline_cache::write(std::string(), Data));
+	TEST_CHECK(!pipeline_cache::write(Path, std::vector<uint8_t>()));
+
+	// Round trip, directory created on demand, no temporary left behind.
+	TEST_CHECK(pipeline_cache::write(Path, Data));
+	TEST_CHECK(pipeline_cache::load(Path, Properties) == Data);
+	size_t FileCount = 0;
+	for (const auto& Entry : std::filesystem::directory_iterator(Directory, ErrorCode)) {
+		(void)Entry;
+		FileCount += 1;
+	}
+	TEST_CHECK(FileCount == 1);
+
+	// Rewriting replaces the old data.
+	std::vector<uint8_t> Larger = driver_data(Properties, 300);
+	TEST_CHECK(pipeline_cache::write(Path, Larger));
+	TEST_CHECK(pipeline_cache::load(Path, Properties) == Larger);
+
+	// Header data size disagreeing with the file size, either way.
+	TEST_CHECK(rejects(Path, Properties, Data, [](std::vector<unsigned char>& aByte) {
+		uint64_t DataSize = 0xFFFFFFFFFFull;
+		memcpy(&aByte[8], &DataSize, sizeof(uint64_t));
+	}));
+	TEST_CHECK(rejects(Path, Properties, Data, [](std::vector<unsigned char>& aByte) {
+		uint64_t DataSize;
+		memcpy(&DataSize, &aByte[8], sizeof(uint64_t));
+		DataSize -= 1;
+		memcpy(&aByte[8], &DataSize, sizeof(uint64_t));
+	}));
+
+	// Truncated, trailing bytes, header only.
+	TEST_CHECK(rejects(Path, Properties, Data, [](std::vector<unsigned char>& aByte) { aByte.resize(aByte.size() - 1); }));
+	TEST_CHECK(rejects(Path, Properties, Data, [](std::vector<unsigned char>& aByte) { aByte.push_back(0); }));
+	TEST_CHECK(rejects(Path, Properties, Data, [](std::vector<unsigned char>& aByte) { aByte.resize(24); }));
+	TEST_CHECK(rejects(Path, Properties, Data, [](std::vector<unsigned char>& aByte) { aByte.resize(10); }));
+
+	// Bad magic, version or checksum.
+	TEST_CHECK(rejects(Path, Properties, Data, [](std::vector<unsigned char>& aByte) { aByte[0] ^= 1; }));
+	TEST_CHECK(rejects(Path, Properties, Data, [](std::vector<unsigned char>& aByte) { aByte[4] ^= 1; }));
+	TEST_CHECK(rejects(Path, Properties, Data, [](std::vector<unsigned char>& aByte) { aByte[aByte.size() - 1] ^= 1; }));
+
+	// Intact, but made by another device or driver.
+	VkPhysicalDeviceProperties Other = Properties;
+	Other.vendorID += 1;
+	TEST_CHECK(rejects(Path, Properties, driver_data(Other, 100), [](std::vector<unsigned char>&) {}));
+	Other = Properties;
+	Other.deviceID += 1;
+	TEST_CHECK(rejects(Path, Properties, driver_data(Other, 100), [](std::vector<unsigned char>&) {}));
+	Other = Properties;
+	Other.pipelineCacheUUID[VK_UUID_SIZE - 1] ^= 0xFF;
+	TEST_CHECK(rejects(Path, Properties, driver_data(Other, 100), [](std::vector<unsigned char>&) {}));
+
+	// Driver header checks on their own.
+	TEST_CHECK(pipeline_cache::is_compatible(Data, Properties));
+	TEST_CHECK(!pipeline_cache::is_compatible(std::vector<uint8_t>(Data.begin(), Data.begin() + 16 + VK_UUID_SIZE - 1), Properties));
+	std::vector<uint8_t> Broken = Data;
+	Broken[0] = 8;
+	TEST_CHECK(!pipeline_cache::is_compatible(Broken, Properties));
+	Broken = Data;
+	Broken[4] = 2;
+	TEST_CHECK(!pipeline_cache::is_compatible(Broken, Properties));
+
+	std::filesystem::remove_all(Directory, ErrorCode);
+
+	return test_result();
+}
@@ -0,0 +1,105 @@
+#include <geodesuka/core/logic/radix_sort.h>
+
+#include <vector>
+#include <algorithm>
+
+#include "test.h"
+
+using namespace geodesuka::core;
+using namespace geodesuka::core::logic;
+
+static uint32_t Seed = 0x2545F491;
+
+static uint32_t random32() {
+	Seed = Seed * 1664525u + 1013904223u;
+	return Seed;
+}
+
+// Sorts aKey with radix_sort and std::stable_sort, values are the original indices.
+template<typename K>
+static bool matches_stable_sort(std::vector<K> aKey) {
+	size_t Count = aKey.size();
+	std::vector<uint32_t> Index(Count);
+	for (size_t i = 0; i < Count; i++) {
+		Index[i] = (uint32_t)i;
+	}
+	std::vector<uint32_t> Expected = Index;
+	std::stable_sort(Expected.begin(), Expected.end(), [&aKey](uint32_t aLhs, uint32_t aRhs) { return aKey[aLhs] < aKey[aRhs]; });
+
+	std::vector<K> Key = aKey;
+	std::vector<K> KeyScratch(Count);
+	std::vector<uint32_t> IndexScratch(Count);
+	radix_sort::sort(Count, Key.data(), Index.data(), KeyScratch.data(), IndexScratch.data());
+
+	for (size_t i = 0; i < Count; i++) {
+		if ((Index[i] != Expected[i]) || (Key[i] != aKey[Expected[i]])) return false;
+	}
+	return true;
+}
+
+int main() {
+
+	// Empty and single element lists are left alone.
+	TEST_CHECK(matches_stable_sort(std::vector<uint32_t>()));
+	TEST_CHECK(matches_stable_sort(std::vector<uint32_t>(1, 7)));
+
+	// Full range keys, every pass runs.
+	std::vector<uint32_t> Key32(1000);
+	for (size_t i = 0; i < Key32.size(); i++) {
+		Key32[i] = random32();
+	}
+	TEST_CHECK(matches_stable_sort(Key32));
+
+	// Few distinct keys, equal keys must keep their order.
+	for (size_t i = 0; i < Key32.size(); i++) {
+		Key32[i] = random32() % 5;
+	}
+	TEST_CHECK(matches_stable_sort(Key32));
+
+	// Only the second byte differs, one pass runs and the result is in scratch.
+	for (size_t i = 0; i < Key32.size(); i++) {
+		Key32[i] = 0xAB0000CDu | ((random32() & 0xFF) << 8);
+	}
+	TEST_CHECK(matches_stable_sort(Key32));
+
+	// All keys equal, every pass is skipped.
+	TEST_CHECK(matches_stable_sort(std::vector<uint32_t>(100, 0x12345678u)));
+
+	std::vector<uint64_t> Key64(1000);
+	for (size_t i = 0; i < Key64.size(); i++) {
+		Key64[i] = ((uint64_t)random32() << 32) | random32();
+	}
+	TEST_CHECK(matches_stable_sort(Key64));
+	for (size_t i = 0; i < Key64.size(); i++) {
+		Key64[i] = (uint64_t)(random32() % 3) << 60;
+	}
+	TEST_CHECK(matches_stable_sort(Key64));
+
+	// Depth keys order like the floats, negative included.
+	const float Depth[] = { -1.0e30f, -1000.0f, -2.5f, -1.0f, -1.0e-30f, 0.0f, 1.0e-30f, 1.0f, 2.5f, 1000.0f, 1.0e30f };
+	const size_t DepthCount = sizeof(Depth) / sizeof(float);
+	for (size_t i = 0; i + 1 < DepthCount; i++) {
+		TEST_CHECK(radix_sort::depth_key(Depth[i]) < radix_sort::depth_key(Depth[i + 1]));
+		// Inverted keys reverse the order.
+		TEST_CHECK(~radix_sort::depth_key(Depth[i]) > ~radix_sort::depth_key(Depth[i + 1]));
+	}
+	TEST_CHECK(radix_sort::depth_key(-0.0f) < radix_sort::depth_key(0.0f));
+
+	// Vector and remainder lanes of depth_keys agree with depth_key.
+	const size_t PointCount = 13;
+	std::vector<float> X(PointCount), Y(PointCount), Z(PointCount);
+	for (size_t i = 0; i < PointCount; i++) {
+		X[i] = (float)(random32() % 200) - 100.0f;
+		Y[i] = (float)(random32() % 200) - 100.0f;
+		Z[i] = (float)(random32() % 200) - 100.0f;
+	}
+	float3 Origin(1.0f, 2.0f, 3.0f);
+	float3 Forward(0.0f, 0.0f, 1.0f);
+	std::vector<uint32_t> Key(PointCount);
+	radix_sort::depth_keys(PointCount, X.data(), Y.data(), Z.data(), Origin, Forward, Key.data());
+	for (size_t i = 0; i < PointCount; i++) {
+		TEST_CHECK(Key[i] == radix_sort::depth_key(Z[i] - 3.0f));
+	}
+
+	return test_result();
+}
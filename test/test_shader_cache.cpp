@@ -0,0 +1,208 @@
+#include <geodesuka/core/gcl/shader_cache.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#include <vector>
+#include <string>
+#include <filesystem>
+
+#include "test.h"
+
+using namespace geodesuka::core;
+using namespace geodesuka::core::gcl;
+
+// On disk layout, see shader_cache::header.
+struct header {
+	uint32_t Magic;
+	uint32_t Version;
+	uint64_t Hash;
+	uint64_t WordCount;
+	uint64_t Checksum;
+};
+
+static std::string Directory;
+
+static std::string path_of(uint64_t aHash) {
+	char FileName[32];
+	snprintf(FileName, sizeof(FileName), "/%016llx.spv", (unsigned long long)aHash);
+	return Directory + FileName;
+}
+
+static std::vector<unsigned char> read_file(const std::string& aPath) {
+	std::vector<unsigned char> Byte;
+	FILE* File = fopen(aPath.c_str(), "rb");
+	if (File == NULL) return Byte;
+	int Character;
+	while ((Character = fgetc(File)) != EOF) {
+		Byte.push_back((unsigned char)Character);
+	}
+	fclose(File);
+	return Byte;
+}
+
+static void write_file(const std::string& aPath, const std::vector<unsigned char>& aByte) {
+	FILE* File = fopen(aPath.c_str(), "wb");
+	if (File == NULL) return;
+	fwrite(aByte.data(), 1, aByte.size(), File);
+	fclose(File);
+}
+
+static uint64_t checksum(const std::vector<unsigned int>& aBinary) {
+	const unsigned char* Byte = (const unsigned char*)aBinary.data();
+	uint64_t Hash = 0xcbf29ce484222325ull;
+	for (size_t i = 0; i < aBinary.size() * sizeof(unsigned int); i++) {
+		Hash ^= (uint64_t)Byte[i];
+		Hash *= 0x100000001b3ull;
+	}
+	return Hash;
+}
+
+static std::vector<unsigned int> spirv(unsigned int aSeed, size_t aWordCount) {
+	std::vector<unsigned int> Binary(aWordCount);
+	Binary[0] = 0x07230203;
+	for (size_t i = 1; i < aWordCount; i++) {
+		Binary[i] = aSeed * 2654435761u + (unsigned int)i;
+	}
+	return Binary;
+}
+
+// Stores aBinary to disk, lets aCorrupt edit the file, then loads from disk only.
+template<typename F>
+static bool rejects(uint64_t aHash, const std::vector<unsigned int>& aBinary, F aCorrupt) {
+	shader_cache::store(aHash, aBinary);
+	std::vector<unsigned char> Byte = read_file(path_of(aHash));
+	if (Byte.size() != sizeof(header) + aBinary.size() * sizeof(unsigned int)) return false;
+	aCorrupt(Byte);
+	write_file(path_of(aHash), Byte);
+	shader_cache::clear();
+	std::vector<unsigned int> Loaded;
+	bool isHit = shader_cache::load(aHash, Loaded);
+	// Corrupt entries are deleted.
+	return (!isHit) && (!std::filesystem::exists(path_of(aHash)));
+}
+
+int main() {
+
+	std::error_code ErrorCode;
+	Directory = (std::filesystem::temp_directory_path() / "geodesuka_test_shader_cache").string();
+	std::filesystem::remove_all(Directory, ErrorCode);
+
+	// Hash covers every input.
+	const char* Define[2] = { "A", "B" };
+	uint64_t Hash = shader_cache::hash(0, "void main() {}", 2, Define, "11");
+	TEST_CHECK(Hash == shader_cache::hash(0, "void main() {}", 2, Define, "11"));
+	TEST_CHECK(Hash != shader_cache::hash(1, "void main() {}", 2, Define, "11"));
+	TEST_CHECK(Hash != shader_cache::hash(0, "void main() { }", 2, Define, "11"));
+	TEST_CHECK(Hash != shader_cache::hash(0, "void main() {}", 1, Define, "11"));
+	TEST_CHECK(Hash != shader_cache::hash(0, "void main() {}", 2, Define, "12"));
+	const char* Joined[1] = { "AB" };
+	TEST_CHECK(shader_cache::hash(0, "x", 1, Joined, NULL) != shader_cache::hash(0, "x", 2, Define, NULL));
+
+	// Disk tier is off by default, nothing survives clear().
+	std::vector<unsigned int> Binary = spirv(1, 64);
+	std::vector<unsigned int> Loaded;
+	shader_cache::store(Hash, Binary);
+	TEST_CHECK(shader_cache::load(Hash, Loaded) && (Loaded == Binary));
+	shader_cache::clear();
+	TEST_CHECK(!shader_cache::load(Hash, Loaded));
+
+	// Not SPIR-V, not stored.
+	std::vector<unsigned int> Garbage(16, 0xDEADBEEF);
+	shader_cache::store(Hash + 1, Garbage);
+	TEST_CHECK(!shader_cache::load(Hash + 1, Loaded));
+
+	// Round trip through disk.
+	shader_cache::set_directory(Directory.c_str());
+	shader_cache::store(Hash, Binary);
+	TEST_CHECK(std::filesystem::exists(path_of(Hash)));
+	shader_cache::clear();
+	Loaded.clear();
+	TEST_CHECK(shader_cache::load(Hash, Loaded) && (Loaded == Binary));
+	// Now in memory again, survives losing the file.
+	std::filesystem::remove(path_of(Hash), ErrorCode);
+	TEST_CHECK(shader_cache::load(Hash, Loaded) && (Loaded == Binary));
+	shader_cache::clear();
+	TEST_CHECK(!shader_cache::load(Hash, Loaded));
+
+	// Header word count disagreeing with the file size, either way.
+	TEST_CHECK(rejects(Hash, Binary, [](std::vector<unsigned char>& aByte) {
+		header Header;
+		memcpy(&Header, aByte.data(), sizeof(header));
+		Header.WordCount = 0xFFFFFFFFFFFFull;
+		memcpy(aByte.data(), &Header, sizeof(header));
+	}));
+	TEST_CHECK(rejects(Hash, Binary, [](std::vector<unsigned char>& aByte) {
+		header Header;
+		memcpy(&Header, aByte.data(), sizeof(header));
+		Header.WordCount -= 1;
+		memcpy(aByte.data(), &Header, sizeof(header));
+	}));
+	TEST_CHECK(rejects(Hash, Binary, [](std::vector<unsigned char>& aByte) {
+		header Header;
+		memcpy(&Header, aByte.data(), sizeof(header));
+		Header.WordCount = 0;
+		memcpy(aByte.data(), &Header, sizeof(header));
+	}));
+
+	// Truncated, trailing bytes, header only.
+	TEST_CHECK(rejects(Hash, Binary, [](std::vector<unsigned char>& aByte) { aByte.resize(aByte.size() - 4); }));
+	TEST_CHECK(rejects(Hash, Binary, [](std::vector<unsigned char>& aByte) { aByte.resize(aByte.size() - 1); }));
+	TEST_CHECK(rejects(Hash, Binary, [](std::vector<unsigned char>& aByte) { aByte.push_back(0); }));
+	TEST_CHECK(rejects(Hash, Binary, [](std::vector<unsigned char>& aByte) { aByte.insert(aByte.end(), 4, 0); }));
+	TEST_CHECK(rejects(Hash, Binary, [](std::vector<unsigned char>& aByte) { aByte.resize(sizeof(header)); }));
+	TEST_CHECK(rejects(Hash, Binary, [](std::vector<unsigned char>& aByte) { aByte.resize(sizeof(header) - 1); }));
+
+	// Bad magic, version, hash or checksum.
+	TEST_CHECK(rejects(Hash, Binary, [](std::vector<unsigned char>& aByte) { aByte[0] ^= 1; }));
+	TEST_CHECK(rejects(Hash, Binary, [](std::vector<unsigned char>& aByte) { aByte[4] ^= 1; }));
+	TEST_CHECK(rejects(Hash, Binary, [](std::vector<unsigned char>& aByte) { aByte[8] ^= 1; }));
+	TEST_CHECK(rejects(Hash, Binary, [](std::vector<unsigned char>& aByte) { aByte[aByte.size() - 1] ^= 1; }));
+
+	// Checksum intact but not SPIR-V.
+	TEST_CHECK(rejects(Hash, Binary, [](std::vector<unsigned char>& aByte) {
+		std::vector<unsigned int> Body((aByte.size() - sizeof(header)) / sizeof(unsigned int));
+		memcpy(Body.data(), aByte.data() + sizeof(header), Body.size() * sizeof(unsigned int));
+		Body[0] = 0x03022307;
+		header Header;
+		memcpy(&Header, aByte.data(), sizeof(header));
+		Header.Checksum = checksum(Body);
+		memcpy(aByte.data(), &Header, sizeof(header));
+		memcpy(aByte.data() + sizeof(header), Body.data(), Body.size() * sizeof(unsigned int));
+	}));
+
+	// Rewritten on next store.
+	shader_cache::store(Hash, Binary);
+	shader_cache::clear();
+	TEST_CHECK(shader_cache::load(Hash, Loaded) && (Loaded == Binary));
+
+	// Memory tier keeps the most recently used entries within budget.
+	shader_cache::set_directory(NULL);
+	shader_cache::clear();
+	std::vector<unsigned int> Entry[4] = { spirv(10, 16), spirv(11, 16), spirv(12, 16), spirv(13, 16) };
+	shader_cache::set_budget(3 * 16 * sizeof(unsigned int));
+	for (int i = 0; i < 3; i++) {
+		shader_cache::store(100 + i, Entry[i]);
+	}
+	// Touching the oldest makes the second one the next to go.
+	TEST_CHECK(shader_cache::load(100, Loaded) && (Loaded == Entry[0]));
+	shader_cache::store(103, Entry[3]);
+	TEST_CHECK(!shader_cache::load(101, Loaded));
+	TEST_CHECK(shader_cache::load(100, Loaded) && (Loaded == Entry[0]));
+	TEST_CHECK(shader_cache::load(102, Loaded) && (Loaded == Entry[2]));
+	TEST_CHECK(shader_cache::load(103, Loaded) && (Loaded == Entry[3]));
+
+	// Shrinking the budget evicts at once, least recently used first.
+	shader_cache::set_budget(16 * sizeof(unsigned int));
+	TEST_CHECK(!shader_cache::load(100, Loaded));
+	TEST_CHECK(!shader_cache::load(102, Loaded));
+	TEST_CHECK(shader_cache::load(103, Loaded));
+
+	// Larger than the whole budget, not kept.
+	shader_cache::store(104, spirv(14, 32));
+	TEST_CHECK(!shader_cache::load(104, Loaded));
+
+	std::filesystem::remove_all(Directory, ErrorCode);
+
+	return test_result();
+}
@@ -0,0 +1,228 @@
+#include <geodesuka/core/gcl/shader_reflection.h>
+
+#include <string.h>
+
+#include <vector>
+#include <initializer_list>
+
+#include "test.h"
+
+using namespace geodesuka::core;
+using namespace geodesuka::core::gcl;
+
+enum {
+	OpName				= 5,
+	OpExecutionMode		= 16,
+	OpTypeInt			= 21,
+	OpTypeFloat			= 22,
+	OpTypeVector		= 23,
+	OpTypeImage			= 25,
+	OpTypeSampledImage	= 27,
+	OpTypeArray			= 28,
+	OpTypeRuntimeArray	= 29,
+	OpTypeStruct		= 30,
+	OpTypePointer		= 32,
+	OpConstant			= 43,
+	OpSpecConstant		= 50,
+	OpSpecConstantComposite = 51,
+	OpFunction			= 54,
+	OpVariable			= 59,
+	OpDecorate			= 71,
+	OpMemberDecorate	= 72,
+	OpExecutionModeId	= 331
+};
+
+// Hand assembled SPIR-V, only the instructions reflection reads.
+class module {
+public:
+
+	std::vector<uint32_t> Word;
+
+	module(uint32_t aBound) {
+		Word = { 0x07230203, 0x00010000, 0, aBound, 0 };
+	}
+
+	void op(uint32_t aOp, std::initializer_list<uint32_t> aOperand) {
+		Word.push_back((uint32_t)((aOperand.size() + 1) << 16) | aOp);
+		Word.insert(Word.end(), aOperand.begin(), aOperand.end());
+	}
+
+	void name(uint32_t aID, const char* aName) {
+		size_t Length = strlen(aName);
+		std::vector<uint32_t> String((Length + 4) / 4, 0);
+		memcpy(String.data(), aName, Length);
+		Word.push_back((uint32_t)((String.size() + 2) << 16) | OpName);
+		Word.push_back(aID);
+		Word.insert(Word.end(), String.begin(), String.end());
+	}
+
+	bool reflect(shader_reflection& aReflection, VkShaderStageFlagBits aStage) const {
+		return aReflection.reflect(aStage, Word.size(), Word.data());
+	}
+
+};
+
+int main() {
+
+	shader_reflection Reflection;
+
+	// Resources of a fragment shader.
+	{
+		module M(32);
+		M.name(5, "Camera");
+		M.op(OpDecorate, { 3, 2 });					// Block
+		M.op(OpMemberDecorate, { 3, 0, 35, 0 });	// Offset
+		M.op(OpMemberDecorate, { 3, 1, 35, 16 });
+		M.op(OpDecorate, { 5, 34, 1 });				// DescriptorSet
+		M.op(OpDecorate, { 5, 33, 3 });				// Binding
+		M.op(OpDecorate, { 6, 2 });
+		M.op(OpMemberDecorate, { 6, 0, 35, 16 });
+		M.op(OpDecorate, { 15, 34, 0 });
+		M.op(OpDecorate, { 15, 33, 0 });
+		M.op(OpDecorate, { 16, 6, 4 });				// ArrayStride
+		M.op(OpDecorate, { 17, 2 });
+		M.op(OpMemberDecorate, { 17, 0, 35, 0 });
+		M.op(OpDecorate, { 19, 34, 0 });
+		M.op(OpDecorate, { 19, 33, 1 });
+		M.op(OpDecorate, { 22, 34, 2 });
+		M.op(OpDecorate, { 22, 33, 0 });
+		M.op(OpTypeFloat, { 1, 32 });
+		M.op(OpTypeVector, { 2, 1, 4 });
+		// Uniform block { vec4; float; }
+		M.op(OpTypeStruct, { 3, 2, 1 });
+		M.op(OpTypePointer, { 4, 2, 3 });
+		M.op(OpVariable, { 4, 5, 2 });
+		// Push constant { layout(offset = 16) float; }
+		M.op(OpTypeStruct, { 6, 1 });
+		M.op(OpTypePointer, { 7, 9, 6 });
+		M.op(OpVariable, { 7, 8, 9 });
+		// sampler2D[N], N a spec constant defaulting to 5.
+		M.op(OpTypeInt, { 9, 32, 0 });
+		M.op(OpSpecConstant, { 9, 10, 5 });
+		M.op(OpTypeImage, { 11, 1, 1, 0, 0, 0, 1, 0 });
+		M.op(OpTypeSampledImage, { 12, 11 });
+		M.op(OpTypeArray, { 13, 12, 10 });
+		M.op(OpTypePointer, { 14, 0, 13 });
+		M.op(OpVariable, { 14, 15, 0 });
+		// Storage buffer { float[]; }
+		M.op(OpTypeRuntimeArray, { 16, 1 });
+		M.op(OpTypeStruct, { 17, 16 });
+		M.op(OpTypePointer, { 18, 12, 17 });
+		M.op(OpVariable, { 18, 19, 12 });
+		// Unsized sampler2D[].
+		M.op(OpTypeRuntimeArray, { 20, 12 });
+		M.op(OpTypePointer, { 21, 0, 20 });
+		M.op(OpVariable, { 21, 22, 0 });
+		M.op(OpFunction, { 0, 23, 0, 0 });
+
+		TEST_CHECK(M.reflect(Reflection, VK_SHADER_STAGE_FRAGMENT_BIT));
+		TEST_CHECK(Reflection.Binding.size() == 4);
+		if (Reflection.Binding.size() == 4) {
+			const shader_reflection::binding* B = Reflection.Binding.data();
+			TEST_CHECK((B[0].Set == 1) && (B[0].Binding == 3) && (B[0].Type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER));
+			TEST_CHECK((B[0].Count == 1) && (B[0].Size == 20) && (B[0].Name == "Camera"));
+			TEST_CHECK(B[0].Stage == VK_SHADER_STAGE_FRAGMENT_BIT);
+			TEST_CHECK((B[1].Set == 0) && (B[1].Binding == 0) && (B[1].Type == VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER));
+			TEST_CHECK(B[1].Count == 5);
+			TEST_CHECK((B[2].Binding == 1) && (B[2].Type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER));
+			TEST_CHECK((B[2].Count == 1) && (B[2].Size == 0));
+			TEST_CHECK((B[3].Set == 2) && (B[3].Type == VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER));
+			TEST_CHECK(B[3].Count == 0);
+		}
+		TEST_CHECK(Reflection.PushConstant.size() == 1);
+		if (Reflection.PushConstant.size() == 1) {
+			TEST_CHECK((Reflection.PushConstant[0].Offset == 16) && (Reflection.PushConstant[0].Size == 4));
+		}
+
+		// Reflecting again starts over.
+		TEST_CHECK(M.reflect(Reflection, VK_SHADER_STAGE_FRAGMENT_BIT));
+		TEST_CHECK((Reflection.Binding.size() == 4) && (Reflection.PushConstant.size() == 1));
+	}
+
+	// Work group size from LocalSize.
+	{
+		module M(4);
+		M.op(OpExecutionMode, { 1, 17, 8, 4, 2 });
+		M.op(OpFunction, { 0, 1, 0, 0 });
+		TEST_CHECK(M.reflect(Reflection, VK_SHADER_STAGE_COMPUTE_BIT));
+		TEST_CHECK((Reflection.LocalSize[0] == 8) && (Reflection.LocalSize[1] == 4) && (Reflection.LocalSize[2] == 2));
+	}
+
+	// LocalSizeId names constants declared after it.
+	{
+		module M(8);
+		M.op(OpExecutionModeId, { 1, 38, 3, 4, 5 });
+		M.op(OpTypeInt, { 2, 32, 0 });
+		M.op(OpConstant, { 2, 3, 16 });
+		M.op(OpSpecConstant, { 2, 4, 2 });
+		M.op(OpConstant, { 2, 5, 1 });
+		M.op(OpFunction, { 0, 1, 0, 0 });
+		TEST_CHECK(M.reflect(Reflection, VK_SHADER_STAGE_COMPUTE_BIT));
+		TEST_CHECK((Reflection.LocalSize[0] == 16) && (Reflection.LocalSize[1] == 2) && (Reflection.LocalSize[2] == 1));
+	}
+
+	// A WorkgroupSize built-in overrides the execution mode.
+	{
+		module M(8);
+		M.op(OpExecutionMode, { 1, 17, 1, 1, 1 });
+		M.op(OpDecorate, { 7, 11, 25 });			// BuiltIn WorkgroupSize
+		M.op(OpTypeInt, { 2, 32, 0 });
+		M.op(OpTypeVector, { 3, 2, 3 });
+		M.op(OpSpecConstant, { 2, 4, 32 });
+		M.op(OpConstant, { 2, 5, 1 });
+		M.op(OpSpecConstantComposite, { 3, 7, 4, 5, 5 });
+		M.op(OpFunction, { 0, 1, 0, 0 });
+		TEST_CHECK(M.reflect(Reflection, VK_SHADER_STAGE_COMPUTE_BIT));
+		TEST_CHECK((Reflection.LocalSize[0] == 32) && (Reflection.LocalSize[1] == 1) && (Reflection.LocalSize[2] == 1));
+	}
+
+	// Malformed modules are rejected.
+	{
+		module M(4);
+		M.op(OpTypeFloat, { 1, 32 });
+		std::vector<uint32_t> Word = M.Word;
+		TEST_CHECK(M.reflect(Reflection, VK_SHADER_STAGE_VERTEX_BIT));
+		TEST_CHECK(!Reflection.reflect(VK_SHADER_STAGE_VERTEX_BIT, 0, NULL));
+		TEST_CHECK(!Reflection.reflect(VK_SHADER_STAGE_VERTEX_BIT, 4, Word.data()));
+
+		// Bad magic.
+		Word[0] = 0x03022307;
+		TEST_CHECK(!Reflection.reflect(VK_SHADER_STAGE_VERTEX_BIT, Word.size(), Word.data()));
+
+		// Instruction running past the end.
+		Word = M.Word;
+		TEST_CHECK(!Reflection.reflect(VK_SHADER_STAGE_VERTEX_BIT, Word.size() - 1, Word.data()));
+
+		// Zero word count.
+		Word.push_back(0);
+		TEST_CHECK(!Reflection.reflect(VK_SHADER_STAGE_VERTEX_BIT, Word.size(), Word.data()));
+
+		// Id beyond the bound.
+		module Bound(4);
+		Bound.op(OpTypeFloat, { 4, 32 });
+		TEST_CHECK(!Bound.reflect(Reflection, VK_SHADER_STAGE_VERTEX_BIT));
+	}
+
+	// Cyclic types must not recurse forever.
+	{
+		module M(16);
+		M.op(OpDecorate, { 1, 2 });
+		M.op(OpMemberDecorate, { 1, 0, 35, 0 });
+		M.op(OpDecorate, { 3, 33, 0 });
+		// struct S { S; }
+		M.op(OpTypeStruct, { 1, 1 });
+		M.op(OpTypePointer, { 2, 2, 1 });
+		M.op(OpVariable, { 2, 3, 2 });
+		// A[2] of itself.
+		M.op(OpTypeInt, { 4, 32, 0 });
+		M.op(OpConstant, { 4, 5, 2 });
+		M.op(OpTypeArray, { 6, 6, 5 });
+		M.op(OpTypePointer, { 7, 0, 6 });
+		M.op(OpVariable, { 7, 8, 0 });
+		M.op(OpFunction, { 0, 9, 0, 0 });
+		TEST_CHECK(M.reflect(Reflection, VK_SHADER_STAGE_VERTEX_BIT));
+		TEST_CHECK((Reflection.Binding.size() == 1) && (Reflection.Binding[0].Type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER));
+	}
+
+	return test_result();
+}
@@ -0,0 +1,143 @@
+#!/usr/bin/env python3
+#
+# Embeds engine owned shaders into the library.
+#
+# Reads every shader in res/shader/builtin and writes two files:
+#	src/embedded_shader.inl			GLSL sources, committed, fallback when no SPIR-V is present.
+#	src/embedded_shader_spirv.inl	SPIR-V compiled with --compiler, generated at build time.
+#
+# Without a compiler, or if it cannot be run, only the source table is written, the engine then compiles
+# built-in shaders at runtime like any other shader. Files are only rewritten
+# when their content changes so incremental builds are not invalidated.
+#
+# Usage:
+#	python tool/embed_shader.py [--compiler <glslangValidator>]
+
+import argparse
+import os
+import subprocess
+import sys
+import tempfile
+
+STAGE = {
+	".vert": "VERTEX",
+	".tesc": "TESSELLATION_CONTROL",
+	".tese": "TESSELLATION_EVALUATION",
+	".geom": "GEOMETRY",
+	".frag": "FRAGMENT",
+	".comp": "COMPUTE",
+}
+
+ROOT = os.path.normpath(os.path.join(os.path.dirname(os.path.abspath(__file__)), ".."))
+SOURCE_DIRECTORY = os.path.join(ROOT, "res", "shader", "builtin")
+SOURCE_OUTPUT = os.path.join(ROOT, "src", "embedded_shader.inl")
+SPIRV_OUTPUT = os.path.join(ROOT, "src", "embedded_shader_spirv.inl")
+
+HEADER = "// Generated by tool/embed_shader.py from res/shader/builtin, do not edit.\n"
+
+
+def identifier(name):
+	return "".join(c if c.isalnum() else "_" for c in name)
+
+
+def escape(text):
+	out = []
+	for line in text.splitlines():
+		line = line.replace("\\", "\\\\").replace("\"", "\\\"")
+		out.append("\t\"" + line + "\\n\"")
+	return "\n".join(out) if out else "\t\"\""
+
+
+def write_if_changed(path, text):
+	if os.path.exists(path):
+		with open(path, "r", newline="") as f:
+			if f.read() == text:
+				return
+	with open(path, "w", newline="") as f:
+		f.write(text)
+
+
+class CompilerMissing(Exception):
+	pass
+
+
+def remove_spirv():
+	if os.path.exists(SPIRV_OUTPUT):
+		os.remove(SPIRV_OUTPUT)
+
+
+def compile_spirv(compiler, path):
+	handle, output = tempfile.mkstemp(suffix=".spv")
+	os.close(handle)
+	try:
+		# Matches runtime target in shader.cpp.
+		try:
+			result = subprocess.run([compiler, "-V", "--target-env", "vulkan1.0", "-Os", "-o", output, path], stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+		except OSError:
+			raise CompilerMissing(compiler)
+		if result.returncode != 0:
+			sys.stderr.write(result.stdout.decode(errors="replace"))
+			return None
+		with open(output, "rb") as f:
+			data = f.read()
+	finally:
+		os.remove(output)
+	if (len(data) % 4) != 0:
+		return None
+	return [int.from_bytes(data[i:i + 4], "little") for i in range(0, len(data), 4)]
+
+
+def main():
+	parser = argparse.ArgumentParser()
+	parser.add_argument("--compiler", default=None)
+	args = parser.parse_args()
+
+	shaders = []
+	for name in sorted(os.listdir(SOURCE_DIRECTORY)):
+		ext = os.path.splitext(name)[1]
+		if ext not in STAGE:
+			continue
+		with open(os.path.join(SOURCE_DIRECTORY, name), "r") as f:
+			shaders.append((name, STAGE[ext], f.read()))
+
+	text = HEADER + "\n"
+	for name, stage, source in shaders:
+		text += "static const char* %s_source =\n%s;\n\n" % (identifier(name), escape(source))
+	text += "static const embedded_shader::source EmbeddedSource[] = {\n"
+	for name, stage, source in shaders:
+		text += "\t{ \"%s\", core::gcl::shader::stage::%s, %s_source },\n" % (name, stage, identifier(name))
+	text += "\t{ NULL, core::gcl::shader::stage::UNKNOWN, NULL }\n};\n"
+	write_if_changed(SOURCE_OUTPUT, text)
+
+	if args.compiler is None:
+		remove_spirv()
+		return 0
+
+	text = HEADER + "\n"
+	compiled = []
+	for name, stage, source in shaders:
+		try:
+			words = compile_spirv(args.compiler, os.path.join(SOURCE_DIRECTORY, name))
+		except CompilerMissing:
+			# Same as no compiler, built-in shaders are compiled at runtime.
+			sys.stderr.write("embed_shader: %s not found, embedding sources only\n" % args.compiler)
+			remove_spirv()
+			return 0
+		if words is None:
+			sys.stderr.write("embed_shader: failed to compile %s\n" % name)
+			return 1
+		compiled.append(name)
+		text += "static const uint32_t %s_spirv[] = {\n" % identifier(name)
+		for i in range(0, len(words), 8):
+			text += "\t" + ", ".join("0x%08x" % w for w in words[i:i + 8]) + ",\n"
+		text += "};\n\n"
+	text += "static const embedded_shader::binary EmbeddedBinary[] = {\n"
+	for name in compiled:
+		text += "\t{ \"%s\", sizeof(%s_spirv) / sizeof(uint32_t), %s_spirv },\n" % (name, identifier(name), identifier(name))
+	text += "\t{ NULL, 0, NULL }\n};\n"
+	write_if_changed(SPIRV_OUTPUT, text)
+	return 0
+
+
+if __name__ == "__main__":
+	sys.exit(main())